@@ -23,11 +23,13 @@
 #include "EngineSystems/TimeSystem.h"
 #include "EngineSystems/AudioSystem.h"
 #include "EngineSystems/RenderTextSystems.h"
+#include "EngineSystems/TransformSystem.h"
 
 #include "EngineComponents/Physics/Physics.h"
 #include "EngineComponents/Sprite.h"
 #include "EngineComponents/Time.h"
 #include "EngineComponents/Tilemap.h"
+#include "EngineComponents/Hierarchy.h"
 #include "EngineComponents/Audio/Audio.h"
 #include "EngineComponents/TextComponent.h"
 
@@ -31,14 +31,14 @@ namespace ac
     AudioManager::AudioManager() : nextID(1)
     {
         // ʼƵϵͳ
-        ACMSG("Audio system initialized");
+        AC_LOG_INFO(LogCategory::Audio, "Audio system initialized");
     }
 
     AudioManager::~AudioManager()
     {
         // ƵԴ
         StopAll();
-        ACMSG("Audio system shutdown");
+        AC_LOG_INFO(LogCategory::Audio, "Audio system shutdown");
     }
 
     AudioID AudioManager::RegisterAudio(const std::string& name, const std::string& filePath)
@@ -47,7 +47,7 @@ namespace ac
         auto it = nameToID.find(name);
         if (it != nameToID.end())
         {
-            ACMSG("WARNING: Audio clip '" << name << "' already registered with ID: " << it->second);
+            AC_LOG_WARNING(LogCategory::Audio, "Audio clip '" << name << "' already registered with ID: " << it->second);
             return it->second;
         }
 
@@ -56,7 +56,7 @@ namespace ac
         nameToID[name] = id;
         audioClips[id] = AudioClip(id, name, filePath);
 		audioClips[id].Load(); // Ƶ
-        ACMSG("Registered audio clip '" << name << "' with ID: " << id);
+        AC_LOG_INFO(LogCategory::Audio, "Registered audio clip '" << name << "' with ID: " << id);
         return id;
     }
 
@@ -97,7 +97,7 @@ namespace ac
         auto it = audioClips.find(id);
         if (it == audioClips.end())
         {
-            ACMSG("WARNING: Audio clip with ID " << id << " not found.");
+            AC_LOG_WARNING(LogCategory::Audio, "Audio clip with ID " << id << " not found.");
             return false;
         }
 
@@ -119,7 +119,7 @@ namespace ac
             return Play(id, loop, volume);
         }
         
-        ACMSG("WARNING: Audio clip '" << name << "' not registered.");
+        AC_LOG_WARNING(LogCategory::Audio, "Audio clip '" << name << "' not registered.");
         return false;
     }
 
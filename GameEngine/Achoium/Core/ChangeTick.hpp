@@ -0,0 +1,171 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+namespace ac
+{
+	/**
+	 * @brief Ticks at which a component was added and last accessed mutably.
+	 *
+	 * Stored next to every component, row for row, by both storage backends.
+	 */
+	struct ComponentTicks
+	{
+		/** Tick of the system (or world tick outside systems) that added the component. */
+		uint32_t added = 0;
+
+		/** Tick of the last mutable access to the component. */
+		uint32_t changed = 0;
+	};
+
+	/**
+	 * @brief Checks whether a tick is newer than another, tolerating wrap-around.
+	 *
+	 * @param tick The tick to test.
+	 * @param since The reference tick.
+	 * @return True if tick happened after since.
+	 */
+	constexpr bool IsNewerTick(uint32_t tick, uint32_t since)
+	{
+		return static_cast<int32_t>(tick - since) > 0;
+	}
+
+	/**
+	 * @brief Source of the change ticks of a World.
+	 *
+	 * Every system run gets a fresh tick: components it accesses mutably are
+	 * stamped with it, and the tick it got on its previous run tells which
+	 * changes it has not seen yet. The clock also advances when a system
+	 * finishes, so changes made outside systems (setup code, command buffer
+	 * playback) are always newer than every system that already ran.
+	 *
+	 * The running system is tracked per thread, so systems running concurrently
+	 * on different workers each see their own ticks. Jobs a system submits to
+	 * the JobSystem (ParallelFor chunks included) carry it along, see JobScope.
+	 */
+	class ChangeClock
+	{
+	public:
+		/**
+		 * @brief The system running on a thread.
+		 */
+		struct ActiveSystem
+		{
+			const ChangeClock* clock = nullptr;
+			uint32_t lastRun = 0;
+			uint32_t thisRun = 0;
+		};
+
+	private:
+		static ActiveSystem& Active()
+		{
+			thread_local ActiveSystem active;
+			return active;
+		}
+
+		/** Current world tick; 0 is reserved for "never". */
+		std::atomic<uint32_t> tick{ 1 };
+
+	public:
+		/**
+		 * @brief Returns the system running on the calling thread, of whichever clock, for a job to take along.
+		 */
+		static ActiveSystem Current()
+		{
+			return Active();
+		}
+
+		/**
+		 * @brief Runs a job on the calling thread as part of the system that submitted it.
+		 *
+		 * Changes the job makes get the submitting system's tick instead of the
+		 * world tick a bare worker thread would stamp them with.
+		 */
+		class JobScope
+		{
+		public:
+			/**
+			 * @param system The system running on the submitting thread, from Current().
+			 */
+			explicit JobScope(const ActiveSystem& system) :
+				previous(Active())
+			{
+				Active() = system;
+			}
+
+			~JobScope()
+			{
+				Active() = previous;
+			}
+
+			JobScope(const JobScope&) = delete;
+			JobScope& operator=(const JobScope&) = delete;
+
+		private:
+			ActiveSystem previous;
+		};
+
+		/**
+		 * @brief Marks the calling thread as running a system for the lifetime of the scope.
+		 */
+		class SystemScope
+		{
+		public:
+			/**
+			 * @param clock The clock of the world the system runs on.
+			 * @param lastRun The tick of the system's previous run, updated when the scope ends.
+			 */
+			SystemScope(ChangeClock& clock, uint32_t& lastRun) :
+				clock(clock), lastRun(lastRun), previous(Active())
+			{
+				Active() = ActiveSystem{ &clock, lastRun, clock.Advance() };
+			}
+
+			~SystemScope()
+			{
+				lastRun = Active().thisRun;
+				Active() = previous;
+				clock.Advance();
+			}
+
+			SystemScope(const SystemScope&) = delete;
+			SystemScope& operator=(const SystemScope&) = delete;
+
+		private:
+			ChangeClock& clock;
+			uint32_t& lastRun;
+			ActiveSystem previous;
+		};
+
+		/**
+		 * @brief Returns the tick changes made on the calling thread are stamped with.
+		 *
+		 * @return The running system's tick, or the current world tick outside systems.
+		 */
+		uint32_t Now() const
+		{
+			const ActiveSystem& active = Active();
+			return active.clock == this ? active.thisRun : tick.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Returns the tick of the previous run of the system running on the calling thread.
+		 *
+		 * @return The tick, or 0 outside systems and on a system's first run.
+		 */
+		uint32_t LastRun() const
+		{
+			const ActiveSystem& active = Active();
+			return active.clock == this ? active.lastRun : 0;
+		}
+
+		/**
+		 * @brief Advances the clock.
+		 *
+		 * @return The new tick.
+		 */
+		uint32_t Advance()
+		{
+			return tick.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
+	};
+}
@@ -0,0 +1,222 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <utility>
+#include "ECSDebug.h"
+#include "sparseset.hpp"
+#include "TypeID.hpp"
+namespace ac
+{
+	class World;
+
+	/**
+	 * @brief Generation reserved for entities created through a CommandBuffer that have not been played back yet.
+	 */
+	constexpr uint32_t DEFERRED_GENERATION = UINT32_MAX;
+
+	/**
+	 * @brief Records structural changes to a World and applies them later in one batched pass.
+	 *
+	 * Adding or deleting components and entities while a view iterates the same
+	 * pools invalidates the dense arrays being walked. Systems record those
+	 * changes into a CommandBuffer instead and the buffer plays them back at a
+	 * sync point, where no iteration is in flight.
+	 *
+	 * Playback applies the recorded commands grouped by kind rather than in
+	 * recording order: entities are created first, then components are added
+	 * type by type, then components are deleted type by type, and finally
+	 * entities are deleted. Each type fires OnAdded after its whole batch is
+	 * stored and OnDeleted before any of its batch is removed, so listeners see
+	 * the batch complete; OnAddedBatch and OnDeletedBatch then fire once per
+	 * type. Deleted entities fire OnDeletedBatch for every type they had, after
+	 * all of them are gone. Commands targeting entities that are no longer
+	 * alive at playback are skipped.
+	 *
+	 * A buffer must only be written by one thread at a time. Parallel systems
+	 * use World::GetCommandBuffer(), which hands every worker thread its own
+	 * buffer; the world plays those back at the end of each system phase.
+	 *
+	 * Usage example:
+	 *   CommandBuffer cmd;
+	 *   world.View<Health>().ForEach([&](Entity e, Health& h) {
+	 *       if (h.current <= 0) cmd.DeleteEntity(e);
+	 *   });
+	 *   cmd.Playback(world);
+	 */
+	class CommandBuffer
+	{
+	public:
+		/**
+		 * @brief Records the creation of an entity.
+		 *
+		 * The returned handle is a placeholder that is only valid as a target of
+		 * further commands on this buffer; it is replaced by the real entity at playback.
+		 *
+		 * @param tag Optional tag/name for the entity.
+		 * @return A placeholder handle for the entity.
+		 */
+		Entity CreateEntity(std::string_view tag = "")
+		{
+			Entity id = MakeEntity(static_cast<uint32_t>(createdTags.size()), DEFERRED_GENERATION);
+			createdTags.emplace_back(tag);
+			return id;
+		}
+
+		/**
+		 * @brief Records adding a component to an entity.
+		 *
+		 * @tparam T The component type.
+		 * @param id The entity ID, or a placeholder returned by CreateEntity.
+		 * @param obj The component instance (default constructed if not provided).
+		 */
+		template <class T>
+		void Add(Entity id, T&& obj = {})
+		{
+			ECS_ASSERT(id != NULL_ENTITY, "NULL_ENTITY cannot be operated on by the ECS");
+			Commands<T>().adds.emplace_back(id, std::move(obj));
+		}
+
+		/**
+		 * @brief Records removing a component from an entity.
+		 *
+		 * @tparam T The component type to remove.
+		 * @param id The entity ID, or a placeholder returned by CreateEntity.
+		 */
+		template <class T>
+		void Delete(Entity id)
+		{
+			ECS_ASSERT(id != NULL_ENTITY, "NULL_ENTITY cannot be operated on by the ECS");
+			Commands<T>().deletes.push_back(id);
+		}
+
+		/**
+		 * @brief Records deleting an entity and all its components.
+		 *
+		 * @param id The entity ID, or a placeholder returned by CreateEntity.
+		 */
+		void DeleteEntity(Entity id)
+		{
+			ECS_ASSERT(id != NULL_ENTITY, "NULL_ENTITY cannot be operated on by the ECS");
+			deletedEntities.push_back(id);
+		}
+
+		/**
+		 * @brief Checks if a handle is a placeholder returned by CreateEntity.
+		 */
+		static bool IsDeferred(Entity id)
+		{
+			return id != NULL_ENTITY && EntityGeneration(id) == DEFERRED_GENERATION;
+		}
+
+		/**
+		 * @brief Returns true if no command has been recorded since the last playback.
+		 */
+		bool Empty() const
+		{
+			return createdTags.empty() && usedTypes.empty() && deletedEntities.empty();
+		}
+
+		/**
+		 * @brief Drops all recorded commands, keeping the allocated storage for reuse.
+		 */
+		void Clear()
+		{
+			createdTags.clear();
+			for (size_t typeID : usedTypes)
+				componentCommands[typeID]->Clear();
+			usedTypes.clear();
+			deletedEntities.clear();
+		}
+
+		/**
+		 * @brief Applies all recorded commands to a world and clears the buffer.
+		 *
+		 * Commands recorded by event listeners during playback stay in the buffer
+		 * for the next playback.
+		 *
+		 * @param world The world to modify.
+		 */
+		void Playback(World& world);
+
+	private:
+		/**
+		 * @brief Type-erased per-component command lists.
+		 */
+		class IComponentCommands
+		{
+		public:
+			virtual ~IComponentCommands() = default;
+			virtual void PlaybackAdds(World& world, const std::vector<Entity>& created) = 0;
+			virtual void PlaybackDeletes(World& world, const std::vector<Entity>& created) = 0;
+			virtual void Clear() = 0;
+
+			/** True while the type is listed in usedTypes. */
+			bool queued = false;
+		};
+
+		template <class T>
+		class ComponentCommands : public IComponentCommands
+		{
+		public:
+			void PlaybackAdds(World& world, const std::vector<Entity>& created) override;
+			void PlaybackDeletes(World& world, const std::vector<Entity>& created) override;
+
+			void Clear() override
+			{
+				adds.clear();
+				deletes.clear();
+				queued = false;
+			}
+
+			std::vector<std::pair<Entity, T>> adds;
+			std::vector<Entity> deletes;
+		};
+
+		/**
+		 * @brief Gets the command lists of a component type, creating them on first use.
+		 */
+		template <class T>
+		ComponentCommands<T>& Commands()
+		{
+			size_t typeID = TypeID<ComponentFamily>::Get<T>();
+			if (typeID >= componentCommands.size())
+				componentCommands.resize(typeID + 1);
+			if (componentCommands[typeID] == nullptr)
+				componentCommands[typeID] = std::make_unique<ComponentCommands<T>>();
+			IComponentCommands* commands = componentCommands[typeID].get();
+			if (!commands->queued)
+			{
+				commands->queued = true;
+				usedTypes.push_back(typeID);
+			}
+			return *static_cast<ComponentCommands<T>*>(commands);
+		}
+
+		/**
+		 * @brief Replaces a placeholder handle with the entity created for it.
+		 */
+		static Entity Resolve(Entity id, const std::vector<Entity>& created)
+		{
+			return IsDeferred(id) ? created[EntityIndex(id)] : id;
+		}
+
+		/**
+		 * @brief Applies the commands without guarding against re-entrant recording.
+		 */
+		void Apply(World& world);
+
+		/** Tags of the entities to create, one per placeholder index. */
+		std::vector<std::string> createdTags;
+
+		/** Per-component command lists, indexed by TypeID<ComponentFamily>. */
+		std::vector<std::unique_ptr<IComponentCommands>> componentCommands;
+
+		/** Component type ids with pending commands, in order of first use. */
+		std::vector<size_t> usedTypes;
+
+		/** Entities to delete. */
+		std::vector<Entity> deletedEntities;
+	};
+}
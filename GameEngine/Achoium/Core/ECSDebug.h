@@ -1,21 +1,17 @@
 #pragma once
+#include "Log/Log.h"
 #ifndef ECS_ASSERT
 #define ECS_ASSERT(condition, msg) \
 		if (!(condition)) { \
-			std::cerr << "[ECS error]: " << msg << std::endl; \
-			::abort(); \
+			AC_LOG_FATAL(::ac::LogCategory::ECS, msg); \
 		}
 #endif
-#define ECS_INFO_ENABLED
+// Per-entity trace, compiled out unless AC_LOG_LEVEL is AC_LOG_LEVEL_TRACE.
 #ifndef ECS_INFO
-#ifdef ECS_INFO_ENABLED
-#define ECS_INFO(msg) std::cout << "[ECS info]: " << msg << "\n";
-#else
-#define ECS_INFO(msg);
-#endif
+#define ECS_INFO(msg) AC_LOG_TRACE(::ac::LogCategory::ECS, msg)
 #endif
 #ifndef ECS_MSG
-#define ECS_MSG(msg) std::cout << "[ECS]: " << msg << "\n";
+#define ECS_MSG(msg) AC_LOG_WARNING(::ac::LogCategory::ECS, msg)
 #endif
 
 #define ENTITY_INFO(id) \
@@ -23,7 +19,7 @@
 
 #define ECS_ASSERT_VALID_ENTITY(id) \
 		ECS_ASSERT(id != NULL_ENTITY, "NULL_ENTITY cannot be operated on by the ECS") \
-		ECS_ASSERT(id < maxEnity && id >= 0, "Invalid entity ID out of bounds: " + id);
+		ECS_ASSERT(EntityIndex(id) < maxEnity, "Invalid entity ID out of bounds: " << id);
 
 #define ECS_ASSERT_ALIVE_ENTITY(id) \
-		ECS_ASSERT(entityComponentMasks.Contains(id), "Attempting to access inactive entity with ID: " + id);
+		ECS_ASSERT(entityComponentMasks.Contains(id), "Attempting to access inactive or stale entity with ID: " << id);
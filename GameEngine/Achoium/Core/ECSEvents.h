@@ -1,5 +1,7 @@
 #pragma once
 #include "Event\AllowToken.h"
+#include <span>
+#include "SoA.hpp"
 // Remove this include to avoid circular dependency
 // #include "World.hpp"
 namespace ac
@@ -12,7 +14,7 @@ namespace ac
     struct OnAdded
     {
         Entity ID;
-        const T& component;
+        ComponentRef<const T> component;
         World& world;
     };
 
@@ -32,7 +34,7 @@ namespace ac
     struct OnDeleted
     {
         Entity ID;
-        const T& component;
+        ComponentRef<const T> component;
         World& world;
     };
 
@@ -47,4 +49,52 @@ namespace ac
         AllowToken& operator=(AllowToken&&) = delete;
         friend class World;
     };
+
+    /**
+     * @brief Fired once per component type by batched insertions (CreateEntities, AddBatch, command buffer playback).
+     *
+     * Lets listeners handle thousands of new components in one call instead of one OnAdded each.
+     */
+    template<class T>
+    struct OnAddedBatch
+    {
+        std::span<const Entity> IDs;
+        World& world;
+    };
+
+    template<class T>
+    class AllowToken<OnAddedBatch<T>>
+    {
+    private:
+        AllowToken() = default;
+        AllowToken(const AllowToken&) = delete;
+        AllowToken(AllowToken&&) = delete;
+        AllowToken& operator=(const AllowToken&) = delete;
+        AllowToken& operator=(AllowToken&&) = delete;
+        friend class World;
+    };
+
+    /**
+     * @brief Fired once per component type by batched removals (DeleteEntities, command buffer playback).
+     *
+     * Fires after every component of the batch is gone, so it only carries the IDs.
+     */
+    template<class T>
+    struct OnDeletedBatch
+    {
+        std::span<const Entity> IDs;
+        World& world;
+    };
+
+    template<class T>
+    class AllowToken<OnDeletedBatch<T>>
+    {
+    private:
+        AllowToken() = default;
+        AllowToken(const AllowToken&) = delete;
+        AllowToken(AllowToken&&) = delete;
+        AllowToken& operator=(const AllowToken&) = delete;
+        AllowToken& operator=(AllowToken&&) = delete;
+        friend class World;
+    };
 }
\ No newline at end of file
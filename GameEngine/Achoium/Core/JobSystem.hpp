@@ -0,0 +1,308 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include <memory>
+#include <cstddef>
+#include "ChangeTick.hpp"
+namespace ac
+{
+	/**
+	 * @brief Work-stealing pool of worker threads used by the ECS for parallel work.
+	 *
+	 * Every worker owns a deque: jobs submitted from a worker go to the back of
+	 * its own deque and are popped from the back (LIFO, cache friendly), idle
+	 * workers steal from the front of other deques. Jobs submitted from outside
+	 * the pool go to a shared injection queue.
+	 *
+	 * The deques are not lock-free: each one is guarded by its own mutex, taken
+	 * on every push, pop and steal. Contention stays low because workers mostly
+	 * touch their own deque, and jobs are coarse (whole systems or ParallelFor
+	 * helpers running many chunks), so the lock is not on any per-item path.
+	 *
+	 * Jobs run as part of the ECS system that submitted them (see
+	 * ChangeClock::JobScope), so components they access mutably are stamped
+	 * with that system's change tick.
+	 *
+	 * Threads are started on the first parallel call so that worlds that never
+	 * run parallel code (e.g. unit tests) do not spawn any.
+	 */
+	class JobSystem
+	{
+	public:
+		/**
+		 * @brief Creates a job system.
+		 *
+		 * @param threadCount Number of worker threads, 0 uses hardware_concurrency - 1.
+		 */
+		explicit JobSystem(size_t threadCount = 0) :
+			requestedThreads(threadCount)
+		{
+		}
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		~JobSystem()
+		{
+			{
+				std::lock_guard<std::mutex> lock(sleepMutex);
+				stopping = true;
+			}
+			sleepCondition.notify_all();
+			for (std::thread& worker : workers)
+				worker.join();
+		}
+
+		/**
+		 * @brief Returns the number of worker threads, starting them if needed.
+		 */
+		size_t WorkerCount()
+		{
+			Start();
+			return workers.size();
+		}
+
+		/**
+		 * @brief Returns the index of the calling thread within this pool.
+		 *
+		 * @return 1..WorkerCount() for worker threads, 0 for any other thread.
+		 */
+		size_t WorkerIndex() const
+		{
+			const LocalSlot& slot = Local();
+			return slot.pool == this ? slot.index + 1 : 0;
+		}
+
+		/**
+		 * @brief Returns the largest value WorkerIndex() can return, without starting the workers.
+		 *
+		 * Lets callers size per-thread tables up front.
+		 */
+		size_t MaxWorkerIndex() const
+		{
+			if (requestedThreads != 0)
+				return requestedThreads;
+			return std::max<size_t>(std::thread::hardware_concurrency(), 2) - 1;
+		}
+
+		/**
+		 * @brief Queues a job to run on the pool.
+		 *
+		 * @param job The job to run.
+		 */
+		void Submit(std::function<void()> job)
+		{
+			Start();
+			job = [system = ChangeClock::Current(), job = std::move(job)]()
+				{
+					ChangeClock::JobScope scope(system);
+					job();
+				};
+			pendingJobs.fetch_add(1, std::memory_order_release);
+			const LocalSlot& slot = Local();
+			if (slot.pool == this)
+				queues[slot.index]->Push(std::move(job));
+			else
+				injection.Push(std::move(job));
+			{
+				std::lock_guard<std::mutex> lock(sleepMutex);
+			}
+			sleepCondition.notify_one();
+		}
+
+		/**
+		 * @brief Runs one queued job on the calling thread if there is any.
+		 *
+		 * Used by threads that wait on other jobs so that they help instead of blocking.
+		 *
+		 * @return True if a job was run.
+		 */
+		bool TryRunOne()
+		{
+			std::function<void()> job;
+			if (!Pop(job))
+				return false;
+			job();
+			return true;
+		}
+
+		/**
+		 * @brief Runs func over [0, count) split into chunks of grainSize and waits for completion.
+		 *
+		 * The calling thread takes part in the work. func is called as func(begin, end)
+		 * for disjoint half-open ranges and must be safe to run concurrently.
+		 *
+		 * @param count Number of items.
+		 * @param grainSize Maximum number of items per chunk.
+		 * @param func Callable taking (size_t begin, size_t end).
+		 * @param maxThreads Most threads to run on, the calling one included; 0 for all of them.
+		 */
+		template <class Func>
+		void ParallelFor(size_t count, size_t grainSize, Func&& func, size_t maxThreads = 0)
+		{
+			if (count == 0)
+				return;
+			grainSize = std::max<size_t>(grainSize, 1);
+			size_t chunkCount = (count + grainSize - 1) / grainSize;
+			if (chunkCount == 1 || WorkerCount() == 0 || maxThreads == 1)
+			{
+				func(size_t(0), count);
+				return;
+			}
+
+			std::atomic<size_t> nextChunk{ 0 };
+			std::atomic<size_t> activeHelpers{ 0 };
+			auto runChunks = [&]()
+				{
+					for (size_t chunk = nextChunk.fetch_add(1); chunk < chunkCount; chunk = nextChunk.fetch_add(1))
+					{
+						size_t begin = chunk * grainSize;
+						func(begin, std::min(begin + grainSize, count));
+					}
+				};
+
+			size_t helperCount = std::min(chunkCount - 1, workers.size());
+			if (maxThreads != 0)
+				helperCount = std::min(helperCount, maxThreads - 1);
+			activeHelpers = helperCount;
+			for (size_t i = 0; i < helperCount; ++i)
+				Submit([&]()
+					{
+						runChunks();
+						activeHelpers.fetch_sub(1, std::memory_order_release);
+					});
+
+			runChunks();
+			// Helpers reference this stack frame; run queued jobs while waiting so nested calls cannot starve.
+			while (activeHelpers.load(std::memory_order_acquire) != 0)
+				if (!TryRunOne())
+					std::this_thread::yield();
+		}
+
+	private:
+		/**
+		 * @brief Mutex protected deque of jobs.
+		 */
+		class JobQueue
+		{
+		public:
+			void Push(std::function<void()> job)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				jobs.push_back(std::move(job));
+			}
+
+			bool PopBack(std::function<void()>& job)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (jobs.empty())
+					return false;
+				job = std::move(jobs.back());
+				jobs.pop_back();
+				return true;
+			}
+
+			bool PopFront(std::function<void()>& job)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (jobs.empty())
+					return false;
+				job = std::move(jobs.front());
+				jobs.pop_front();
+				return true;
+			}
+
+		private:
+			std::mutex mutex;
+			std::deque<std::function<void()>> jobs;
+		};
+
+		/**
+		 * @brief Identifies the pool and worker a thread belongs to.
+		 */
+		struct LocalSlot
+		{
+			const JobSystem* pool = nullptr;
+			size_t index = 0;
+		};
+
+		static LocalSlot& Local()
+		{
+			thread_local LocalSlot slot;
+			return slot;
+		}
+
+		/**
+		 * @brief Starts the worker threads if they are not running yet.
+		 */
+		void Start()
+		{
+			std::call_once(startFlag, [this]()
+				{
+					size_t count = MaxWorkerIndex();
+					for (size_t i = 0; i < count; ++i)
+						queues.push_back(std::make_unique<JobQueue>());
+					for (size_t i = 0; i < count; ++i)
+						workers.emplace_back([this, i]() { WorkerLoop(i); });
+				});
+		}
+
+		/**
+		 * @brief Takes a job from the own deque, the injection queue, or another worker.
+		 *
+		 * @param job Receives the job.
+		 * @return True if a job was found.
+		 */
+		bool Pop(std::function<void()>& job)
+		{
+			if (pendingJobs.load(std::memory_order_acquire) == 0)
+				return false;
+
+			const LocalSlot& slot = Local();
+			bool isWorker = slot.pool == this;
+			bool found = (isWorker && queues[slot.index]->PopBack(job)) || injection.PopFront(job);
+			for (size_t i = 0; !found && i < queues.size(); ++i)
+			{
+				size_t victim = isWorker ? (slot.index + 1 + i) % queues.size() : i;
+				found = queues[victim]->PopFront(job);
+			}
+			if (found)
+				pendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+			return found;
+		}
+
+		void WorkerLoop(size_t index)
+		{
+			Local() = LocalSlot{ this, index };
+			while (true)
+			{
+				if (TryRunOne())
+					continue;
+
+				std::unique_lock<std::mutex> lock(sleepMutex);
+				sleepCondition.wait(lock, [this]() { return stopping || pendingJobs.load(std::memory_order_acquire) != 0; });
+				if (stopping && pendingJobs.load(std::memory_order_acquire) == 0)
+					return;
+			}
+		}
+
+		size_t requestedThreads;
+		std::once_flag startFlag;
+		std::vector<std::thread> workers;
+		std::vector<std::unique_ptr<JobQueue>> queues;
+		JobQueue injection;
+
+		/** Number of queued jobs that have not been taken yet. */
+		std::atomic<size_t> pendingJobs{ 0 };
+
+		std::mutex sleepMutex;
+		std::condition_variable sleepCondition;
+		bool stopping = false;
+	};
+}
@@ -0,0 +1,152 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include "ECSDebug.h"
+#include "sparseset.hpp"
+#include "TypeID.hpp"
+namespace ac
+{
+	/**
+	 * @brief Type used to key cached queries by their required components and filters.
+	 */
+	template <class... Ts>
+	struct QueryKey {};
+
+	/**
+	 * @brief Entities matching a set of required and excluded components, kept up to date by a World.
+	 *
+	 * The World updates the list whenever a watched bit of an entity's
+	 * ComponentMask changes, so views created from a query walk the packed
+	 * list instead of matching entities again every frame. Removal swaps the
+	 * last member into the freed slot, like SparseSet::Delete.
+	 */
+	class QueryState
+	{
+	public:
+		/**
+		 * @param required Bits of the components members must have.
+		 * @param excluded Bits of the components members must not have.
+		 * @param unregisteredExcluded TypeID<ComponentFamily> of excluded components that are not registered yet.
+		 */
+		QueryState(const ComponentMask& required, const ComponentMask& excluded, std::vector<size_t> unregisteredExcluded = {}) :
+			required(required), excluded(excluded), unregisteredExcluded(std::move(unregisteredExcluded))
+		{
+		}
+
+		QueryState(const QueryState&) = delete;
+		QueryState& operator=(const QueryState&) = delete;
+
+		/**
+		 * @brief Checks a component mask against the required and excluded components.
+		 */
+		bool Matches(const ComponentMask& mask) const
+		{
+			return (mask & required) == required && (mask & excluded).none();
+		}
+
+		/**
+		 * @brief Adds or removes an entity after a watched bit of its mask changed.
+		 *
+		 * @param id The entity.
+		 * @param mask The entity's current component mask.
+		 */
+		void Update(Entity id, const ComponentMask& mask)
+		{
+			if (Matches(mask))
+				Insert(id);
+			else
+				Remove(id);
+		}
+
+		/**
+		 * @brief Adds an entity if it is not a member yet.
+		 */
+		void Insert(Entity id)
+		{
+			uint32_t index = EntityIndex(id);
+			if (index >= positions.size())
+				positions.resize(index + 1, NOT_MEMBER);
+			if (positions[index] != NOT_MEMBER)
+				return;
+			positions[index] = static_cast<uint32_t>(entities.size());
+			entities.push_back(id);
+		}
+
+		/**
+		 * @brief Removes an entity if it is a member.
+		 */
+		void Remove(Entity id)
+		{
+			uint32_t index = EntityIndex(id);
+			if (index >= positions.size() || positions[index] == NOT_MEMBER)
+				return;
+			uint32_t position = positions[index];
+			Entity last = entities.back();
+			entities[position] = last;
+			positions[EntityIndex(last)] = position;
+			entities.pop_back();
+			positions[index] = NOT_MEMBER;
+		}
+
+		/**
+		 * @brief Turns an excluded component that was not registered when the query was created into a mask bit.
+		 *
+		 * @param typeID The TypeID<ComponentFamily> of the newly registered component.
+		 * @param bitMaskInd Its bitmask index.
+		 * @return True if the query excludes the component.
+		 */
+		bool ResolveExcluded(size_t typeID, size_t bitMaskInd)
+		{
+			for (size_t i = 0; i < unregisteredExcluded.size(); ++i)
+			{
+				if (unregisteredExcluded[i] != typeID)
+					continue;
+				excluded.set(bitMaskInd, true);
+				unregisteredExcluded.erase(unregisteredExcluded.begin() + i);
+				return true;
+			}
+			return false;
+		}
+
+		/**
+		 * @brief Returns the matching entities in iteration order.
+		 */
+		const std::vector<Entity>& Entities() const
+		{
+			return entities;
+		}
+
+		/**
+		 * @brief Returns the bits of the required components.
+		 */
+		const ComponentMask& Required() const
+		{
+			return required;
+		}
+
+		/**
+		 * @brief Returns the bits of the excluded components.
+		 */
+		const ComponentMask& Excluded() const
+		{
+			return excluded;
+		}
+
+	private:
+		/** Value of positions for entity indices that are not members. */
+		static constexpr uint32_t NOT_MEMBER = UINT32_MAX;
+
+		ComponentMask required;
+		ComponentMask excluded;
+
+		/** TypeID<ComponentFamily> of excluded components that were not registered yet. */
+		std::vector<size_t> unregisteredExcluded;
+
+		/** Packed list of matching entities. */
+		std::vector<Entity> entities;
+
+		/** Position in entities of every member, indexed by entity index. */
+		std::vector<uint32_t> positions;
+	};
+}
@@ -0,0 +1,322 @@
+#pragma once
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include "ECSDebug.h"
+#include "JobSystem.hpp"
+#include "ChangeTick.hpp"
+#include "TypeID.hpp"
+namespace ac
+{
+	class World;
+
+	/**
+	 * @brief Declares which components and resources a system reads and writes.
+	 *
+	 * The scheduler runs two systems of the same phase concurrently when neither
+	 * writes anything the other one reads or writes. A default constructed
+	 * SystemAccess is exclusive: the system conflicts with every other system
+	 * and runs on the main thread, which is how all undeclared systems behave.
+	 *
+	 * Systems that create or delete entities or add or remove components must
+	 * record those changes in World::GetCommandBuffer() or stay exclusive.
+	 * Systems that invoke events must stay exclusive.
+	 *
+	 * Usage example:
+	 *   world.AddPostUpdateSystem(Physics2DStep, 1,
+	 *       SystemAccess().Write<RigidBody2D, Transform>().ReadResource<Time>());
+	 */
+	class SystemAccess
+	{
+	public:
+		/**
+		 * @brief Declares components the system reads.
+		 */
+		template <class... Ts>
+		SystemAccess& Read()
+		{
+			declared = true;
+			(Insert(readComponents, TypeID<ComponentFamily>::Get<Ts>()), ...);
+			return *this;
+		}
+
+		/**
+		 * @brief Declares components the system writes (and may read).
+		 */
+		template <class... Ts>
+		SystemAccess& Write()
+		{
+			declared = true;
+			(Insert(writeComponents, TypeID<ComponentFamily>::Get<Ts>()), ...);
+			return *this;
+		}
+
+		/**
+		 * @brief Declares resources the system reads.
+		 */
+		template <class... Ts>
+		SystemAccess& ReadResource()
+		{
+			declared = true;
+			(Insert(readResources, TypeID<ResourceFamily>::Get<Ts>()), ...);
+			return *this;
+		}
+
+		/**
+		 * @brief Declares resources the system writes (and may read).
+		 */
+		template <class... Ts>
+		SystemAccess& WriteResource()
+		{
+			declared = true;
+			(Insert(writeResources, TypeID<ResourceFamily>::Get<Ts>()), ...);
+			return *this;
+		}
+
+		/**
+		 * @brief Requires the system to run on the thread calling World::Update (e.g. for OpenGL calls).
+		 */
+		SystemAccess& MainThread()
+		{
+			mainThread = true;
+			return *this;
+		}
+
+		/**
+		 * @brief Returns true if the system has not declared any access.
+		 */
+		bool IsExclusive() const
+		{
+			return !declared;
+		}
+
+		/**
+		 * @brief Returns true if the system must run on the main thread.
+		 */
+		bool IsMainThread() const
+		{
+			return mainThread || !declared;
+		}
+
+		/**
+		 * @brief Checks whether two systems may not run at the same time.
+		 *
+		 * @param other The access of the other system.
+		 * @return True if either system is exclusive or one writes what the other accesses.
+		 */
+		bool ConflictsWith(const SystemAccess& other) const
+		{
+			if (IsExclusive() || other.IsExclusive())
+				return true;
+			return Overlaps(writeComponents, other.writeComponents) ||
+				Overlaps(writeComponents, other.readComponents) ||
+				Overlaps(readComponents, other.writeComponents) ||
+				Overlaps(writeResources, other.writeResources) ||
+				Overlaps(writeResources, other.readResources) ||
+				Overlaps(readResources, other.writeResources);
+		}
+
+	private:
+		static void Insert(std::vector<size_t>& set, size_t id)
+		{
+			auto it = std::lower_bound(set.begin(), set.end(), id);
+			if (it == set.end() || *it != id)
+				set.insert(it, id);
+		}
+
+		/**
+		 * @brief Checks whether two sorted id lists share an element.
+		 */
+		static bool Overlaps(const std::vector<size_t>& a, const std::vector<size_t>& b)
+		{
+			auto i = a.begin();
+			auto j = b.begin();
+			while (i != a.end() && j != b.end())
+			{
+				if (*i == *j)
+					return true;
+				if (*i < *j)
+					++i;
+				else
+					++j;
+			}
+			return false;
+		}
+
+		bool declared = false;
+		bool mainThread = false;
+		std::vector<size_t> readComponents;
+		std::vector<size_t> writeComponents;
+		std::vector<size_t> readResources;
+		std::vector<size_t> writeResources;
+	};
+
+	/**
+	 * @brief Runs the systems of one phase as a dependency graph.
+	 *
+	 * Systems are ordered by priority, then by the order they were added. For
+	 * every pair of conflicting systems an edge from the earlier to the later one
+	 * is added, so priority keeps ordering systems that share data while systems
+	 * with disjoint access run concurrently on the job system.
+	 */
+	class SystemScheduler
+	{
+	public:
+		/** System function signature. */
+		using SystemFunc = void(*)(World&);
+
+		/**
+		 * @brief Adds a system to the phase.
+		 *
+		 * @param func The system function.
+		 * @param priority Priority level, lower values run first among conflicting systems.
+		 * @param access The data the system touches.
+		 */
+		void Add(SystemFunc func, size_t priority, SystemAccess access)
+		{
+			SystemEntry entry{ func, priority, addedCount++, std::move(access) };
+			auto it = std::upper_bound(systems.begin(), systems.end(), entry, [](const SystemEntry& a, const SystemEntry& b)
+				{
+					return a.priority < b.priority || (a.priority == b.priority && a.order < b.order);
+				});
+			systems.insert(it, std::move(entry));
+			dirty = true;
+		}
+
+		/**
+		 * @brief Returns the number of systems in the phase.
+		 */
+		size_t Size() const
+		{
+			return systems.size();
+		}
+
+		/**
+		 * @brief Runs every system of the phase once, respecting the dependency graph.
+		 *
+		 * Main thread systems run on the calling thread, all others are handed to
+		 * the job system. Returns once every system has finished.
+		 *
+		 * Every system run gets its own change tick from clock, see ChangeClock.
+		 *
+		 * @param world The world passed to the systems.
+		 * @param jobs The job system running worker systems.
+		 * @param clock The change clock of the world.
+		 */
+		void Run(World& world, JobSystem& jobs, ChangeClock& clock)
+		{
+			if (systems.empty())
+				return;
+			if (dirty)
+				Build();
+
+			if (sequential)
+			{
+				for (SystemEntry& system : systems)
+				{
+					ChangeClock::SystemScope scope(clock, system.lastRun);
+					system.func(world);
+				}
+				return;
+			}
+
+			std::vector<std::atomic<size_t>> remaining(systems.size());
+			for (size_t i = 0; i < systems.size(); ++i)
+				remaining[i] = predecessorCount[i];
+			std::atomic<size_t> finished{ 0 };
+			std::mutex mainMutex;
+			std::vector<size_t> mainReady;
+
+			std::function<void(size_t)> schedule;
+			auto runSystem = [&](size_t ind)
+				{
+					{
+						ChangeClock::SystemScope scope(clock, systems[ind].lastRun);
+						systems[ind].func(world);
+					}
+					for (size_t next : successors[ind])
+						if (remaining[next].fetch_sub(1, std::memory_order_acq_rel) == 1)
+							schedule(next);
+					finished.fetch_add(1, std::memory_order_release);
+				};
+			schedule = [&](size_t ind)
+				{
+					if (systems[ind].access.IsMainThread())
+					{
+						std::lock_guard<std::mutex> lock(mainMutex);
+						mainReady.push_back(ind);
+					}
+					else
+						jobs.Submit([&runSystem, ind]() { runSystem(ind); });
+				};
+
+			for (size_t i = 0; i < systems.size(); ++i)
+				if (predecessorCount[i] == 0)
+					schedule(i);
+
+			while (finished.load(std::memory_order_acquire) != systems.size())
+			{
+				size_t ind = SIZE_MAX;
+				{
+					std::lock_guard<std::mutex> lock(mainMutex);
+					if (!mainReady.empty())
+					{
+						// Keep priority order among main thread systems that became ready together.
+						auto it = std::min_element(mainReady.begin(), mainReady.end());
+						ind = *it;
+						mainReady.erase(it);
+					}
+				}
+				if (ind != SIZE_MAX)
+					runSystem(ind);
+				else if (!jobs.TryRunOne())
+					std::this_thread::yield();
+			}
+		}
+
+	private:
+		struct SystemEntry
+		{
+			SystemFunc func;
+			size_t priority;
+			size_t order;
+			SystemAccess access;
+
+			/** Change tick of the previous run, 0 before the first one. */
+			uint32_t lastRun = 0;
+		};
+
+		/**
+		 * @brief Rebuilds the dependency graph after systems were added.
+		 */
+		void Build()
+		{
+			size_t count = systems.size();
+			successors.assign(count, {});
+			predecessorCount.assign(count, 0);
+			sequential = true;
+			for (size_t i = 0; i < count; ++i)
+				for (size_t j = i + 1; j < count; ++j)
+					if (systems[i].access.ConflictsWith(systems[j].access))
+					{
+						successors[i].push_back(j);
+						++predecessorCount[j];
+					}
+					else
+						sequential = false;
+			dirty = false;
+		}
+
+		std::vector<SystemEntry> systems;
+		std::vector<std::vector<size_t>> successors;
+		std::vector<size_t> predecessorCount;
+		size_t addedCount = 0;
+		bool dirty = false;
+
+		/** True when every pair of systems conflicts, so the phase is a plain ordered loop. */
+		bool sequential = true;
+	};
+}
@@ -0,0 +1,410 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <tuple>
+#include <span>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+namespace ac
+{
+	/**
+	 * @brief Opt-in structure-of-arrays layout of a component type.
+	 *
+	 * Components are stored as whole objects next to each other by default.
+	 * Specializing SoALayout makes SparseSet<T> store every listed field of T
+	 * in its own contiguous column instead, so loops that touch a few fields
+	 * of many components only pull those fields into the cache:
+	 *
+	 *   template <>
+	 *   struct SoALayout<Particle>
+	 *   {
+	 *       using Fields = SoAFields<&Particle::position, &Particle::velocity>;
+	 *       using Ref = ParticleRef;           // struct { glm::vec2& position; glm::vec2& velocity; };
+	 *       using ConstRef = ParticleConstRef; // struct { const glm::vec2& position; const glm::vec2& velocity; };
+	 *   };
+	 *
+	 * Ref and ConstRef are aggregates with one reference member per field, in
+	 * the order of Fields. Worlds and views hand them out by value where they
+	 * would hand out T& and const T&, so callbacks take them by value:
+	 *   world.View<Particle>().ForEach([](ParticleRef particle) { particle.position += particle.velocity; });
+	 *
+	 * Members of T that are not listed are not stored. SoA components always
+	 * live in SparseSet pools; they cannot use ComponentStorage::Archetype.
+	 *
+	 * @tparam T The component type.
+	 */
+	template <class T>
+	struct SoALayout {};
+
+	/**
+	 * @brief List of the fields of a component stored in SoA columns.
+	 *
+	 * @tparam Members Pointers to the data members, e.g. &Particle::position.
+	 */
+	template <auto... Members>
+	struct SoAFields {};
+
+	/**
+	 * @brief True when T has a SoALayout specialization.
+	 */
+	template <class T>
+	constexpr bool IsSoAComponent = requires { typename SoALayout<T>::Fields; };
+
+	/**
+	 * @brief Splits a pointer to data member into its class and field type.
+	 */
+	template <class M>
+	struct SoAMember;
+
+	template <class C, class F>
+	struct SoAMember<F C::*> {
+		using Field = F;
+	};
+
+	/**
+	 * @brief Growable contiguous array holding one field of every component of a SoA pool.
+	 *
+	 * Unlike std::vector it stores bool fields as plain bools, so every element
+	 * can be handed out as a reference and every column as a span.
+	 *
+	 * @tparam F The field type, must be default constructible.
+	 */
+	template <class F>
+	class SoAColumn
+	{
+	public:
+		std::size_t size() const
+		{
+			return count;
+		}
+
+		F& operator[](std::size_t i)
+		{
+			return data[i];
+		}
+
+		const F& operator[](std::size_t i) const
+		{
+			return data[i];
+		}
+
+		/**
+		 * @brief Makes room for at least newCapacity elements.
+		 */
+		void reserve(std::size_t newCapacity)
+		{
+			if (newCapacity <= capacity)
+				return;
+			std::unique_ptr<F[]> grown = std::make_unique<F[]>(newCapacity);
+			std::move(data.get(), data.get() + count, grown.get());
+			data = std::move(grown);
+			capacity = newCapacity;
+		}
+
+		void push_back(F&& value)
+		{
+			if (count == capacity)
+				reserve(std::max<std::size_t>(capacity * 2, 16));
+			data[count++] = std::move(value);
+		}
+
+		void pop_back()
+		{
+			data[--count] = F{};
+		}
+
+		void clear()
+		{
+			data.reset();
+			count = capacity = 0;
+		}
+
+		std::span<F> Span()
+		{
+			return { data.get(), count };
+		}
+
+		std::span<const F> Span() const
+		{
+			return { data.get(), count };
+		}
+
+	private:
+		std::unique_ptr<F[]> data;
+		std::size_t count = 0;
+		std::size_t capacity = 0;
+	};
+
+	template <class T, class Fields = typename SoALayout<T>::Fields>
+	class SoAColumns;
+
+	/**
+	 * @brief Row-aligned columns holding the fields of the components of a SoA pool.
+	 *
+	 * Row i of every column belongs to the same component. Used by SparseSet<T>
+	 * in place of std::vector<T> when T has a SoALayout.
+	 *
+	 * @tparam T The component type.
+	 */
+	template <class T, auto... Members>
+	class SoAColumns<T, SoAFields<Members...>>
+	{
+	public:
+		using Ref = typename SoALayout<T>::Ref;
+		using ConstRef = typename SoALayout<T>::ConstRef;
+
+		/** Number of fields of the layout. */
+		static constexpr std::size_t FieldCount = sizeof...(Members);
+
+		std::size_t size() const
+		{
+			return std::get<0>(columns).size();
+		}
+
+		void reserve(std::size_t capacity)
+		{
+			std::apply([capacity](auto&... column) { (column.reserve(capacity), ...); }, columns);
+		}
+
+		void clear()
+		{
+			std::apply([](auto&... column) { (column.clear(), ...); }, columns);
+		}
+
+		/**
+		 * @brief Appends a component, scattering its fields into the columns.
+		 */
+		void emplace_back(T&& obj)
+		{
+			PushRow(std::move(obj), Indices{});
+		}
+
+		void pop_back()
+		{
+			std::apply([](auto&... column) { (column.pop_back(), ...); }, columns);
+		}
+
+		/**
+		 * @brief Overwrites the fields of a row with those of a component.
+		 */
+		void Assign(std::size_t row, T&& obj)
+		{
+			AssignRow(row, std::move(obj), Indices{});
+		}
+
+		/**
+		 * @brief Moves the fields of row src into row dst.
+		 */
+		void MoveRow(std::size_t dst, std::size_t src)
+		{
+			std::apply([dst, src](auto&... column) { ((column[dst] = std::move(column[src])), ...); }, columns);
+		}
+
+		/**
+		 * @brief Gathers the fields of a row back into a component object.
+		 */
+		T Load(std::size_t row) const
+		{
+			T obj{};
+			LoadRow(obj, row, Indices{});
+			return obj;
+		}
+
+		Ref RefAt(std::size_t row)
+		{
+			return MakeRef<Ref>(*this, row, Indices{});
+		}
+
+		ConstRef RefAt(std::size_t row) const
+		{
+			return MakeRef<ConstRef>(*this, row, Indices{});
+		}
+
+		/**
+		 * @brief Returns the column of one field, row-aligned with the other columns and the pool's entities.
+		 *
+		 * Usage example: std::span<glm::vec2> velocities = columns.Column<&RigidBody2D::velocity>();
+		 *
+		 * @tparam Member Pointer to a data member listed in the layout.
+		 */
+		template <auto Member>
+		auto Column()
+		{
+			return std::get<IndexOf<Member>()>(columns).Span();
+		}
+
+		template <auto Member>
+		auto Column() const
+		{
+			return std::get<IndexOf<Member>()>(columns).Span();
+		}
+
+	private:
+		using Indices = std::make_index_sequence<sizeof...(Members)>;
+
+		std::tuple<SoAColumn<typename SoAMember<decltype(Members)>::Field>...> columns;
+
+		template <auto A, auto B>
+		static constexpr bool SameMember()
+		{
+			if constexpr (std::is_same_v<decltype(A), decltype(B)>)
+				return A == B;
+			else
+				return false;
+		}
+
+		template <auto Member>
+		static constexpr std::size_t IndexOf()
+		{
+			constexpr bool matches[] = { SameMember<Member, Members>()... };
+			static_assert((SameMember<Member, Members>() || ...), "Column<Member>() needs a field listed in the SoALayout");
+			std::size_t i = 0;
+			while (!matches[i])
+				++i;
+			return i;
+		}
+
+		template <std::size_t... Is>
+		void PushRow(T&& obj, std::index_sequence<Is...>)
+		{
+			(std::get<Is>(columns).push_back(std::move(obj.*Members)), ...);
+		}
+
+		template <std::size_t... Is>
+		void AssignRow(std::size_t row, T&& obj, std::index_sequence<Is...>)
+		{
+			((std::get<Is>(columns)[row] = std::move(obj.*Members)), ...);
+		}
+
+		template <std::size_t... Is>
+		void LoadRow(T& obj, std::size_t row, std::index_sequence<Is...>) const
+		{
+			((obj.*Members = std::get<Is>(columns)[row]), ...);
+		}
+
+		template <class R, class Self, std::size_t... Is>
+		static R MakeRef(Self& self, std::size_t row, std::index_sequence<Is...>)
+		{
+			return R{ std::get<Is>(self.columns)[row]... };
+		}
+	};
+
+	/**
+	 * @brief Pointer-like handle to a component stored in SoA columns.
+	 *
+	 * Plays the role of T* for SoA components: compares to nullptr, and
+	 * dereferencing yields the layout's Ref, or ConstRef when T is const.
+	 * Like T*, it is invalidated when the pool removes or reorders members.
+	 *
+	 * @tparam T The component type, optionally const.
+	 */
+	template <class T>
+	class SoAPtr
+	{
+	public:
+		using Base = std::remove_const_t<T>;
+		using Columns = std::conditional_t<std::is_const_v<T>, const SoAColumns<Base>, SoAColumns<Base>>;
+		using Reference = std::conditional_t<std::is_const_v<T>, typename SoALayout<Base>::ConstRef, typename SoALayout<Base>::Ref>;
+
+		SoAPtr() = default;
+
+		SoAPtr(std::nullptr_t)
+		{
+		}
+
+		SoAPtr(Columns* columns, std::size_t row) :
+			columns(columns), row(row)
+		{
+		}
+
+		/**
+		 * @brief Converts a handle to a mutable component into a read-only one.
+		 */
+		template <class U> requires (std::is_const_v<T> && std::is_same_v<U, Base>)
+		SoAPtr(const SoAPtr<U>& other) :
+			columns(other.columns), row(other.row)
+		{
+		}
+
+		Reference operator*() const
+		{
+			return columns->RefAt(row);
+		}
+
+		/**
+		 * @brief Holds the Reference so -> can reach its members.
+		 */
+		struct Arrow
+		{
+			Reference reference;
+
+			Reference* operator->()
+			{
+				return &reference;
+			}
+		};
+
+		Arrow operator->() const
+		{
+			return Arrow{ **this };
+		}
+
+		/**
+		 * @brief Gets the row of the component in the columns of its pool, which is its dense index in the SparseSet.
+		 */
+		std::size_t Row() const
+		{
+			return row;
+		}
+
+		explicit operator bool() const
+		{
+			return columns != nullptr;
+		}
+
+		bool operator==(std::nullptr_t) const
+		{
+			return columns == nullptr;
+		}
+
+		bool operator==(const SoAPtr& other) const = default;
+
+	private:
+		template <class U>
+		friend class SoAPtr;
+
+		Columns* columns = nullptr;
+		std::size_t row = 0;
+	};
+
+	/**
+	 * @brief How SparseSet<T> stores T and what it hands out for it, selected by whether T has a SoALayout.
+	 */
+	template <class T, bool SoA = IsSoAComponent<std::remove_const_t<T>>>
+	struct ComponentLayout {
+		using Container = std::vector<std::remove_const_t<T>>;
+		using Pointer = T*;
+		using Reference = T&;
+	};
+
+	template <class T>
+	struct ComponentLayout<T, true> {
+		using Container = SoAColumns<std::remove_const_t<T>>;
+		using Pointer = SoAPtr<T>;
+		using Reference = typename SoAPtr<T>::Reference;
+	};
+
+	/**
+	 * @brief What a World or view hands out in place of T*: T* itself, or SoAPtr<T> for SoA components.
+	 */
+	template <class T>
+	using ComponentPtr = typename ComponentLayout<T>::Pointer;
+
+	/**
+	 * @brief What a World or view hands out in place of T&: T& itself, or the layout's Ref/ConstRef for SoA components.
+	 */
+	template <class T>
+	using ComponentRef = typename ComponentLayout<T>::Reference;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+namespace ac
+{
+	/**
+	 * @brief Value used for "no id assigned" in tables indexed by type id.
+	 */
+	constexpr size_t INVALID_TYPE_ID = SIZE_MAX;
+
+	/** Tag for component type ids. */
+	struct ComponentFamily {};
+
+	/** Tag for resource type ids. */
+	struct ResourceFamily {};
+
+	/** Tag for event type ids. */
+	struct EventFamily {};
+
+	/** Tag for cached query ids. */
+	struct QueryFamily {};
+
+	/**
+	 * @brief Hands out dense, per-family ids for C++ types.
+	 *
+	 * Every type gets its id the first time it is queried and keeps it for the
+	 * whole run, so tables can be indexed directly instead of hashing
+	 * std::type_index. Ids are held in function-local statics rather than
+	 * template variables so they are valid even when queried during static
+	 * initialization (e.g. by a global World).
+	 *
+	 * Usage example:
+	 *   size_t id = TypeID<ComponentFamily>::Get<Transform>();
+	 *
+	 * @tparam Family Tag type separating independent id ranges.
+	 */
+	template <class Family>
+	class TypeID
+	{
+	private:
+		/**
+		 * @brief Returns the next unused id of this family.
+		 */
+		static size_t Next()
+		{
+			static std::atomic<size_t> counter{ 0 };
+			return counter.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		template <class T>
+		static size_t Assign()
+		{
+			static const size_t id = Next();
+			return id;
+		}
+
+	public:
+		/**
+		 * @brief Gets the id of a type; const and volatile qualifiers are ignored.
+		 *
+		 * @tparam T The type.
+		 * @return The id of T within this family.
+		 */
+		template <class T>
+		static size_t Get()
+		{
+			return Assign<std::remove_cv_t<T>>();
+		}
+	};
+}
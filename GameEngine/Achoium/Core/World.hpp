@@ -2,6 +2,11 @@
 
 #include "ECSDebug.h"
 #include "sparseset.hpp"
+#include "archetype.hpp"
+#include "TypeID.hpp"
+#include "Scheduler.hpp"
+#include "CommandBuffer.hpp"
+#include "Query.hpp"
 #include <iostream>
 #include "ECSEvents.h"
 #include "Event\Event.hpp"
@@ -25,38 +30,71 @@ namespace ac
 	private:
 		
 
-		/** The next entity ID to be assigned. */
-		Entity maxEnity = 0;
-
-		/** Bitmask type for tracking which components an entity has. */
-		using ComponentMask = std::bitset<MAX_COMPONENTS>;
+		/** The next entity index to be assigned. */
+		uint32_t maxEnity = 0;
 
 		/** Maps entities to their component masks. */
 		SparseSet<ComponentMask> entityComponentMasks;
 
-		/** Pool of available entity IDs for reuse. */
+		/** Pool of recycled entity handles, already carrying their next generation. */
 		std::vector<Entity> entityPool;
 
 		/** Maps entities to debug names/tags. */
 		std::unordered_map<Entity, std::string> entityTag;
 
-		/** Maps component types to their bitmask indices. */
-		std::unordered_map<std::type_index, size_t> typeToBitMaskInd;
+		/** Maps component type ids (TypeID<ComponentFamily>) to their bitmask indices. */
+		std::vector<size_t> typeToBitMaskInd;
 
 		/** Stores all component pools, one per component type. */
 		std::vector<std::unique_ptr<ISparseSet>> ComponentPools;
 
-		/** Maps resource types to their indices. */
-		std::unordered_map<std::type_index, size_t> resourceID;
+		/** Fires OnDeletedBatch of each component type, indexed by bitmask index. */
+		std::vector<void(World::*)(std::span<const Entity>)> deletedBatchNotifiers;
+
+		/** Tables for components registered with ComponentStorage::Archetype. */
+		ArchetypeStorage archetypes;
+
+		/** Worker pool used for parallel view iteration. */
+		JobSystem jobSystem;
+
+		/** Number of ParallelForEach calls in flight, checked by structural changes in debug builds. */
+		std::atomic<uint32_t> parallelIterations{ 0 };
+
+		/** Source of the ticks components are stamped with when added or accessed mutably. */
+		ChangeClock changeClock;
+
+		/** Cached queries, indexed by TypeID<QueryFamily> of their key; nullptr if not created. */
+		std::vector<std::unique_ptr<QueryState>> queries;
 
-		/** Stores all resources. */
+		/** Created queries, in creation order. */
+		std::vector<QueryState*> queryList;
+
+		/** Queries watching each bitmask index, as required or excluded component. */
+		std::array<std::vector<QueryState*>, MAX_COMPONENTS> queriesByComponent;
+
+		/** Guards query lookup and creation, which may happen in systems running concurrently. */
+		std::mutex queryMutex;
+
+		/** Deferred commands, one buffer per thread: index 0 for the main thread, then one per worker. */
+		std::vector<CommandBuffer> commandBuffers;
+
+		/** Stores all resources, indexed by TypeID<ResourceFamily>; nullptr if not added. */
 		std::vector<std::shared_ptr<void>> resourceList;
 
-		std::array<std::vector<void(*)(World&)>, MAX_SYSTEM_LAYER> preUpdateSystems;
+		/** Systems of the pre-update phase. */
+		SystemScheduler preUpdateSystems;
+
+		/** Systems of the fixed-update phase, run fixedUpdateCount times per Update. */
+		SystemScheduler fixedUpdateSystems;
+
+		/** Number of times the fixed-update phase runs in the next Update. */
+		size_t fixedUpdateCount = 1;
 
-		std::array<std::vector<void(*)(World&)>, MAX_SYSTEM_LAYER> updateSystems;
+		/** Systems of the update phase. */
+		SystemScheduler updateSystems;
 
-		std::array<std::vector<void(*)(World&)>, MAX_SYSTEM_LAYER> postUpdateSystems;
+		/** Systems of the post-update phase. */
+		SystemScheduler postUpdateSystems;
 
 		/**
 		 * @brief Retrieves the tag/name of an entity.
@@ -73,10 +111,17 @@ namespace ac
 
 #define ECS_ASSERT_VALID_ENTITY(id) \
 		ECS_ASSERT(id != NULL_ENTITY, "NULL_ENTITY cannot be operated on by the ECS") \
-		ECS_ASSERT(id < maxEnity && id >= 0, "Invalid entity ID out of bounds: " + id);
+		ECS_ASSERT(EntityIndex(id) < maxEnity, "Invalid entity ID out of bounds: " << id);
 
 #define ECS_ASSERT_ALIVE_ENTITY(id) \
-		ECS_ASSERT(entityComponentMasks.Contains(id), "Attempting to access inactive entity with ID: " + id);
+		ECS_ASSERT(entityComponentMasks.Contains(id), "Attempting to access inactive or stale entity with ID: " << id);
+
+#ifdef _DEBUG
+#define ECS_ASSERT_NO_PARALLEL_ITERATION() \
+		ECS_ASSERT(parallelIterations.load() == 0, "Structural change to the World inside ParallelForEach is not allowed");
+#else
+#define ECS_ASSERT_NO_PARALLEL_ITERATION()
+#endif
 
 		/**
 		 * @brief Gets the component ID for a specific component type.
@@ -87,11 +132,10 @@ namespace ac
 		template<class T>
 		size_t GetComponentID()
 		{
-			std::type_index ind(typeid(T));
-			auto  t = typeToBitMaskInd.find(ind);
-			if (t == typeToBitMaskInd.end())
+			size_t typeID = TypeID<ComponentFamily>::Get<T>();
+			if (typeID >= typeToBitMaskInd.size())
 				return UINT64_MAX;
-			return t->second;
+			return typeToBitMaskInd[typeID];
 		}
 
 		/**
@@ -108,6 +152,162 @@ namespace ac
 			return static_cast<SparseSet<T>*>(ComponentPools[ind].get());
 		}
 
+		/**
+		 * @brief Gets the type-erased pool for a component type, whatever its storage.
+		 *
+		 * @tparam T The component type.
+		 * @return Pointer to the pool for the specified component type.
+		 */
+		template<class T>
+		ISparseSet* GetPoolPtr()
+		{
+			size_t ind = GetComponentID<T>();
+			ECS_ASSERT(ind != UINT64_MAX, "Try to access a type that does not exist");
+			return ComponentPools[ind].get();
+		}
+
+		/**
+		 * @brief Gets a component of an entity from whichever storage holds the type.
+		 *
+		 * Unless T is const the component is stamped as changed.
+		 *
+		 * @tparam T The component type, optionally const.
+		 * @param id The entity ID.
+		 * @param bitMaskInd The bitmask index of the component type.
+		 * @return Pointer to the component, or nullptr if the entity doesn't have it.
+		 */
+		template<class T>
+		ComponentPtr<T> GetComponentPtr(Entity id, size_t bitMaskInd)
+		{
+			using Type = std::remove_const_t<T>;
+			ComponentTicks* ticks = nullptr;
+			ComponentPtr<Type> o;
+			if constexpr (IsSoAComponent<Type>)
+				o = static_cast<SparseSet<Type>*>(ComponentPools[bitMaskInd].get())->Get(id, ticks);
+			else
+				o = archetypes.IsArchetypeComponent(bitMaskInd) ?
+					archetypes.Get<Type>(id, bitMaskInd, ticks) :
+					static_cast<SparseSet<Type>*>(ComponentPools[bitMaskInd].get())->Get(id, ticks);
+			if constexpr (!std::is_const_v<T>)
+				if (o != nullptr)
+					ticks->changed = changeClock.Now();
+			return o;
+		}
+
+		/**
+		 * @brief Gets the pool for an entry of a view; nullptr for optional components that were never registered.
+		 *
+		 * @tparam Entry A component type or Optional<T>.
+		 */
+		template<class Entry>
+		ISparseSet* GetViewPoolPtr()
+		{
+			if constexpr (ViewEntry<Entry>::optional)
+			{
+				size_t ind = GetComponentID<typename ViewEntry<Entry>::Component>();
+				return ind == UINT64_MAX ? nullptr : ComponentPools[ind].get();
+			}
+			else
+				return GetPoolPtr<Entry>();
+		}
+
+		/**
+		 * @brief Sets the bits of excluded components that are registered.
+		 *
+		 * @param unregistered If given, receives the TypeID<ComponentFamily> of excluded components that are not registered.
+		 */
+		template<class... Ts>
+		void CollectExcluded(ComponentMask& excluded, Exclude<Ts...>, std::vector<size_t>* unregistered = nullptr)
+		{
+			size_t bitMaskInds[] = { GetComponentID<Ts>()..., UINT64_MAX };
+			size_t typeIDs[] = { TypeID<ComponentFamily>::Get<Ts>()..., INVALID_TYPE_ID };
+			for (size_t i = 0; i < sizeof...(Ts); ++i)
+			{
+				if (bitMaskInds[i] != UINT64_MAX)
+					excluded.set(bitMaskInds[i], true);
+				else if (unregistered != nullptr)
+					unregistered->push_back(typeIDs[i]);
+			}
+		}
+
+		template<class... Ts>
+		void CollectExcluded(ComponentMask&, Optional<Ts...>, std::vector<size_t>* = nullptr)
+		{
+		}
+
+		/**
+		 * @brief Gets the cached query for a list of required components and filters, creating it on first use.
+		 *
+		 * A new query is filled from the component masks of all live entities.
+		 */
+		template<class... Components, class... Filters>
+		QueryState& GetOrCreateQuery(Filters... filters)
+		{
+			std::lock_guard<std::mutex> lock(queryMutex);
+			size_t queryID = TypeID<QueryFamily>::Get<QueryKey<type_list<std::remove_const_t<Components>...>, Filters...>>();
+			if (queryID < queries.size() && queries[queryID] != nullptr)
+				return *queries[queryID];
+
+			size_t bitMaskInds[] = { GetComponentID<Components>()... };
+			ComponentMask required;
+			for (size_t bitMaskInd : bitMaskInds)
+			{
+				ECS_ASSERT(bitMaskInd != UINT64_MAX, "Try to access a type that does not exist");
+				required.set(bitMaskInd, true);
+			}
+			ComponentMask excluded;
+			std::vector<size_t> unregistered;
+			(CollectExcluded(excluded, filters, &unregistered), ...);
+			std::unique_ptr<QueryState> query = std::make_unique<QueryState>(required, excluded, std::move(unregistered));
+
+			const std::vector<Entity>& ids = entityComponentMasks.Entities();
+			const std::vector<ComponentMask>& masks = entityComponentMasks.Data();
+			for (size_t i = 0; i < ids.size(); ++i)
+				if (query->Matches(masks[i]))
+					query->Insert(ids[i]);
+
+			ComponentMask watched = required | excluded;
+			for (size_t i = 0; i < MAX_COMPONENTS; ++i)
+				if (watched[i])
+					queriesByComponent[i].push_back(query.get());
+			queryList.push_back(query.get());
+			if (queryID >= queries.size())
+				queries.resize(queryID + 1);
+			queries[queryID] = std::move(query);
+			return *queries[queryID];
+		}
+
+		/**
+		 * @brief Updates the queries watching a component after it was added to or removed from an entity.
+		 *
+		 * @param id The entity.
+		 * @param bitMaskInd The bitmask index of the component.
+		 * @param mask The entity's new component mask.
+		 */
+		void UpdateQueries(Entity id, size_t bitMaskInd, const ComponentMask& mask)
+		{
+			for (QueryState* query : queriesByComponent[bitMaskInd])
+				query->Update(id, mask);
+		}
+
+		/**
+		 * @brief Builds a view over the given entries.
+		 *
+		 * @param excluded Bits of the components matching entities must not have.
+		 * @param members Entities of a cached query to walk, nullptr to match entities while iterating.
+		 */
+		template<class... Entries>
+		SimpleView<Entries...> MakeView(std::type_identity<SimpleView<Entries...>>, const ComponentMask& excluded,
+			const std::vector<Entity>* members = nullptr)
+		{
+			std::array<ISparseSet*, sizeof...(Entries)> pools = { GetViewPoolPtr<Entries>()... };
+			ComponentMask required;
+			((ViewEntry<Entries>::optional ? void() : void(required.set(GetComponentID<typename ViewEntry<Entries>::Component>(), true))), ...);
+			return { pools,
+				ViewContext{ &entityComponentMasks, &jobSystem, &parallelIterations, changeClock.Now(), changeClock.LastRun(), members },
+				required, excluded };
+		}
+
 		/**
 		 * @brief Validates system priority to ensure it's within bounds.
 		 * 
@@ -120,11 +320,235 @@ namespace ac
 			return priority;
 		}
 
+		/**
+		 * @brief Gets the bitmask index of a component type, registering the type on first use.
+		 *
+		 * @tparam T The component type.
+		 * @return The component's bitmask index.
+		 */
+		template<class T>
+		size_t GetOrRegisterComponentID()
+		{
+			size_t bitMaskInd = GetComponentID<T>();
+			if (bitMaskInd == UINT64_MAX)
+			{
+				RegisterType<T>();
+				bitMaskInd = GetComponentID<T>();
+			}
+			return bitMaskInd;
+		}
+
+		/**
+		 * @brief Stores a component for a live entity without firing OnAdded.
+		 *
+		 * @tparam T The component type.
+		 * @param id The entity ID.
+		 * @param bitMaskInd The bitmask index of the component type.
+		 * @param obj The component instance.
+		 * @return Pointer to the stored component.
+		 */
+		template<class T>
+		ComponentPtr<T> StoreComponent(Entity id, size_t bitMaskInd, T&& obj)
+		{
+			ComponentMask* mask = entityComponentMasks.Get(id);
+			mask->set(bitMaskInd, true);
+			UpdateQueries(id, bitMaskInd, *mask);
+
+			if constexpr (!IsSoAComponent<T>)
+				if (archetypes.IsArchetypeComponent(bitMaskInd))
+					return &archetypes.Set<T>(id, bitMaskInd, std::move(obj), changeClock.Now());
+			return static_cast<SparseSet<T>*>(ComponentPools[bitMaskInd].get())->Set(id, std::move(obj), changeClock.Now());
+		}
+
+		/**
+		 * @brief Stores one component per entity for a batch of live entities without firing events.
+		 *
+		 * Sparse set pools reserve room for the whole batch up front.
+		 *
+		 * @tparam T The component type.
+		 * @param ids The entities, which must be alive.
+		 * @param bitMaskInd The bitmask index of the component type.
+		 * @param source Callable returning the component for the i-th entity.
+		 */
+		template<class T, class Source>
+		void StoreBatch(std::span<const Entity> ids, size_t bitMaskInd, Source&& source)
+		{
+			uint32_t tick = changeClock.Now();
+			if constexpr (!IsSoAComponent<T>)
+			{
+				if (archetypes.IsArchetypeComponent(bitMaskInd))
+				{
+					for (size_t i = 0; i < ids.size(); ++i)
+					{
+						ComponentMask* mask = entityComponentMasks.Get(ids[i]);
+						mask->set(bitMaskInd, true);
+						UpdateQueries(ids[i], bitMaskInd, *mask);
+						archetypes.Set<T>(ids[i], bitMaskInd, T(source(i)), tick);
+					}
+					return;
+				}
+			}
+
+			SparseSet<T>* pool = static_cast<SparseSet<T>*>(ComponentPools[bitMaskInd].get());
+			pool->Reserve(pool->Size() + ids.size());
+			for (size_t i = 0; i < ids.size(); ++i)
+			{
+				ComponentMask* mask = entityComponentMasks.Get(ids[i]);
+				mask->set(bitMaskInd, true);
+				UpdateQueries(ids[i], bitMaskInd, *mask);
+				pool->Set(ids[i], T(source(i)), tick);
+			}
+		}
+
+		/**
+		 * @brief Fires the added events for a batch of stored components.
+		 *
+		 * OnAdded<T> is only built per entity when someone listens for it; the
+		 * component is looked up again for each event so listeners that change
+		 * the world cannot leave later events dangling. OnAddedBatch<T> follows
+		 * once for the whole batch.
+		 *
+		 * @tparam T The component type.
+		 * @param ids The entities that received the component.
+		 * @param bitMaskInd The bitmask index of the component type.
+		 */
+		template<class T>
+		void NotifyAddedBatch(std::span<const Entity> ids, size_t bitMaskInd)
+		{
+			EventManager& eventManager = GetResourse<EventManager>();
+			if (eventManager.HasListeners<OnAdded<T>>())
+			{
+				for (Entity id : ids)
+				{
+					ComponentPtr<const T> o = IsAlive(id) ? GetComponentPtr<const T>(id, bitMaskInd) : nullptr;
+					if (o != nullptr)
+						eventManager.Invoke(OnAdded<T>{id, *o, *this}, AllowToken<OnAdded<T>>());
+				}
+			}
+			if (eventManager.HasListeners<OnAddedBatch<T>>())
+				eventManager.Invoke(OnAddedBatch<T>{ids, *this}, AllowToken<OnAddedBatch<T>>());
+		}
+
+		/**
+		 * @brief Fires OnDeletedBatch<T> for components that are already removed.
+		 *
+		 * @tparam T The component type.
+		 * @param ids The entities that lost the component.
+		 */
+		template<class T>
+		void NotifyDeletedBatch(std::span<const Entity> ids)
+		{
+			EventManager& eventManager = GetResourse<EventManager>();
+			if (!ids.empty() && eventManager.HasListeners<OnDeletedBatch<T>>())
+				eventManager.Invoke(OnDeletedBatch<T>{ids, *this}, AllowToken<OnDeletedBatch<T>>());
+		}
+
+		/**
+		 * @brief Adds a batch of recorded components, then fires their added events.
+		 *
+		 * Entries whose entity is no longer alive are skipped.
+		 *
+		 * @tparam T The component type.
+		 * @param adds Pairs of entity and component; entries are moved from.
+		 */
+		template<class T>
+		void PlaybackAdds(std::vector<std::pair<Entity, T>>& adds)
+		{
+			ECS_ASSERT_NO_PARALLEL_ITERATION();
+			size_t bitMaskInd = GetOrRegisterComponentID<T>();
+			std::vector<Entity> stored;
+			stored.reserve(adds.size());
+			for (auto& [id, obj] : adds)
+			{
+				if (!IsAlive(id))
+					continue;
+				StoreComponent<T>(id, bitMaskInd, std::move(obj));
+				stored.push_back(id);
+			}
+			NotifyAddedBatch<T>(stored, bitMaskInd);
+		}
+
+		/**
+		 * @brief Removes a batch of recorded components, then fires their deleted events.
+		 *
+		 * OnDeleted<T> fires for every component while the whole batch still
+		 * exists, then the components are removed and OnDeletedBatch<T> fires
+		 * once. Entries whose entity is no longer alive or lacks the component
+		 * are skipped, and so are duplicates.
+		 *
+		 * @tparam T The component type.
+		 * @param ids The entities to remove the component from.
+		 */
+		template<class T>
+		void PlaybackDeletes(const std::vector<Entity>& ids)
+		{
+			ECS_ASSERT_NO_PARALLEL_ITERATION();
+			size_t bitMaskInd = GetComponentID<T>();
+			if (bitMaskInd == UINT64_MAX)
+				return;
+
+			std::vector<Entity> removed;
+			removed.reserve(ids.size());
+			for (Entity id : ids)
+				if (IsAlive(id) && (*entityComponentMasks.Get(id))[bitMaskInd])
+					removed.push_back(id);
+			std::sort(removed.begin(), removed.end());
+			removed.erase(std::unique(removed.begin(), removed.end()), removed.end());
+
+			// Listeners may change the world, so every component is looked up again
+			EventManager& eventManager = GetResourse<EventManager>();
+			if (eventManager.HasListeners<OnDeleted<T>>())
+			{
+				for (Entity id : removed)
+				{
+					ComponentPtr<const T> o = IsAlive(id) ? GetComponentPtr<const T>(id, bitMaskInd) : nullptr;
+					if (o != nullptr)
+						eventManager.Invoke(OnDeleted<T>{id, *o, *this}, AllowToken<OnDeleted<T>>());
+				}
+			}
+
+			size_t kept = 0;
+			for (Entity id : removed)
+			{
+				ComponentMask* mask = IsAlive(id) ? entityComponentMasks.Get(id) : nullptr;
+				if (mask == nullptr || !(*mask)[bitMaskInd])
+					continue;
+				mask->set(bitMaskInd, false);
+				UpdateQueries(id, bitMaskInd, *mask);
+				ComponentPools[bitMaskInd]->Delete(id);
+				removed[kept++] = id;
+			}
+			removed.resize(kept);
+			NotifyDeletedBatch<T>(removed);
+		}
+
+		/**
+		 * @brief Frees the bookkeeping of an entity whose sparse set components are already deleted.
+		 *
+		 * @param id The entity to release.
+		 */
+		void ReleaseEntity(Entity id)
+		{
+			if (entityTag.find(id) != entityTag.end())
+				entityTag.erase(id);
+			archetypes.RemoveEntity(id);
+			for (QueryState* query : queryList)
+				query->Remove(id);
+
+			entityComponentMasks.Delete(id);
+			uint32_t generation = EntityGeneration(id) + 1;
+			if (generation == DEFERRED_GENERATION)
+				generation = 0;
+			entityPool.push_back(MakeEntity(EntityIndex(id), generation));
+		}
+
 		template<class... Ts>
 		friend class SimpleView;
+		friend class CommandBuffer;
 	public:
 
-		World()
+		World() :
+			commandBuffers(jobSystem.MaxWorkerIndex() + 1)
 		{
 			AddResource<EventManager>(new EventManager());
 		}
@@ -140,14 +564,15 @@ namespace ac
 		template<class T>
 		void AddResource(T* obj)
 		{
-			auto it = resourceID.find(typeid(T));
-			if (it != resourceID.end())
+			size_t typeID = TypeID<ResourceFamily>::Get<T>();
+			if (typeID >= resourceList.size())
+				resourceList.resize(typeID + 1);
+			if (resourceList[typeID] != nullptr)
 			{
 				ECS_MSG("WARNING try to add a resource that is already added");
 				return;
 			}
-			resourceID[typeid(T)] = resourceList.size();
-			resourceList.push_back(std::shared_ptr<T>(obj));
+			resourceList[typeID] = std::shared_ptr<T>(obj);
 		}
 
 		/**
@@ -159,9 +584,9 @@ namespace ac
 		template<class T>
 		T& GetResourse()
 		{
-			auto it = resourceID.find(typeid(T));
-			ECS_ASSERT(it != resourceID.end(), "Try to access unregistered resourse");
-			T* t = static_cast<T*>(resourceList[it->second].get());
+			size_t typeID = TypeID<ResourceFamily>::Get<T>();
+			ECS_ASSERT(typeID < resourceList.size() && resourceList[typeID] != nullptr, "Try to access unregistered resourse");
+			T* t = static_cast<T*>(resourceList[typeID].get());
 			return *t;
 		}
 
@@ -177,6 +602,14 @@ namespace ac
 			typeToBitMaskInd.clear();
 
 			ComponentPools.clear();
+			deletedBatchNotifiers.clear();
+			archetypes.Clear();
+			queries.clear();
+			queryList.clear();
+			for (std::vector<QueryState*>& watchers : queriesByComponent)
+				watchers.clear();
+			for (CommandBuffer& buffer : commandBuffers)
+				buffer.Clear();
 			maxEnity = 0;
 		}
 
@@ -188,13 +621,12 @@ namespace ac
 		 */
 		Entity CreateEntity(std::string_view str = "")
 		{
+			ECS_ASSERT_NO_PARALLEL_ITERATION();
 			Entity id;
-			if (maxEnity == 1000)
-				maxEnity = maxEnity;
 			if (entityPool.empty())
 			{
-				ECS_ASSERT(maxEnity < NULL_ENTITY, "Enity Exceed max Entity");
-				id = maxEnity++;
+				ECS_ASSERT(maxEnity < UINT32_MAX, "Enity Exceed max Entity");
+				id = MakeEntity(maxEnity++, 0);
 			}
 			else
 				id = entityPool.back(), entityPool.pop_back();
@@ -209,40 +641,178 @@ namespace ac
 		/**
 		 * @brief Deletes an entity and all its components.
 		 *
+		 * No OnDeleted events are fired; every component type the entity had
+		 * fires OnDeletedBatch for it once the entity is gone, as in DeleteEntities.
+		 *
 		 * @param id The entity to delete.
 		 */
 		void DeleteEntity(Entity id)
 		{
 			ECS_ASSERT_VALID_ENTITY(id);
 			ECS_ASSERT_ALIVE_ENTITY(id);
+			ECS_ASSERT_NO_PARALLEL_ITERATION();
 
-			if (entityTag.find(id) != entityTag.end())
-				entityTag.erase(id);
-
-			ComponentMask* mask = entityComponentMasks.Get(id);
-			for (int i = 0; i < mask->size(); ++i)
-				if ((*mask)[i])
+			ComponentMask mask = *entityComponentMasks.Get(id);
+			for (size_t i = 0; i < ComponentPools.size(); ++i)
+				if (mask[i] && !archetypes.IsArchetypeComponent(i))
 					ComponentPools[i]->Delete(id);
+			ReleaseEntity(id);
+			for (size_t i = 0; i < ComponentPools.size(); ++i)
+				if (mask[i])
+					(this->*deletedBatchNotifiers[i])(std::span<const Entity>(&id, 1));
+		}
 
-			entityComponentMasks.Delete(id);
-			entityPool.push_back(id);
+		/**
+		 * @brief Creates many entities at once, optionally with a copy of the given components each.
+		 *
+		 * Component pools reserve room for the whole batch and every component
+		 * type fires its added events once all entities are populated (see
+		 * OnAddedBatch). Much faster than CreateEntity plus Add per entity when
+		 * spawning tilemaps, particles or projectiles.
+		 *
+		 * Usage example:
+		 *   auto tiles = world.CreateEntities(100 * 100, Transform(), Sprite());
+		 *
+		 * @tparam Ts The component types.
+		 * @param count Number of entities to create.
+		 * @param prototype Components copied into every new entity.
+		 * @return The new entity IDs.
+		 */
+		template<class... Ts>
+		std::vector<Entity> CreateEntities(size_t count, const Ts&... prototype)
+		{
+			ECS_ASSERT_NO_PARALLEL_ITERATION();
+			std::vector<Entity> ids;
+			ids.reserve(count);
+			size_t recycled = std::min(count, entityPool.size());
+			ids.insert(ids.end(), entityPool.rbegin(), entityPool.rbegin() + recycled);
+			entityPool.resize(entityPool.size() - recycled);
+			ECS_ASSERT(count - recycled <= UINT32_MAX - maxEnity, "Enity Exceed max Entity");
+			for (size_t i = recycled; i < count; ++i)
+				ids.push_back(MakeEntity(maxEnity++, 0));
+
+			entityComponentMasks.Reserve(entityComponentMasks.Size() + count);
+			for (Entity id : ids)
+				entityComponentMasks.Set(id, {});
+
+			// Without components (as CommandBuffer::Apply creates them) there is nothing to store
+			if constexpr (sizeof...(Ts) > 0)
+			{
+				size_t bitMaskInds[] = { GetOrRegisterComponentID<Ts>()... };
+				size_t typeInd = 0;
+				(StoreBatch<Ts>(ids, bitMaskInds[typeInd++], [&prototype](size_t) -> const Ts& { return prototype; }), ...);
+				typeInd = 0;
+				(NotifyAddedBatch<Ts>(ids, bitMaskInds[typeInd++]), ...);
+			}
+			ECS_INFO("Entities Created: " << count);
+			return ids;
+		}
+
+		/**
+		 * @brief Adds one component to each of many entities.
+		 *
+		 * Equivalent to calling Add for every pair, but reserves pool capacity once
+		 * and fires the added events after the whole batch is stored.
+		 *
+		 * @tparam T The component type.
+		 * @param ids The entities, which must be alive.
+		 * @param components The components, one per entity.
+		 */
+		template<class T>
+		void AddBatch(std::span<const Entity> ids, std::span<const T> components)
+		{
+			ECS_ASSERT(ids.size() == components.size(), "AddBatch needs exactly one component per entity");
+			ECS_ASSERT_NO_PARALLEL_ITERATION();
+			for (Entity id : ids)
+			{
+				ECS_ASSERT_VALID_ENTITY(id);
+				ECS_ASSERT_ALIVE_ENTITY(id);
+			}
+			size_t bitMaskInd = GetOrRegisterComponentID<T>();
+			StoreBatch<T>(ids, bitMaskInd, [&components](size_t i) -> const T& { return components[i]; });
+			NotifyAddedBatch<T>(ids, bitMaskInd);
+		}
+
+		/**
+		 * @brief Deletes many entities and all their components.
+		 *
+		 * Walks the component pools one at a time instead of entity by entity.
+		 * Like DeleteEntity, no OnDeleted events are fired; instead every
+		 * component type the entities had fires OnDeletedBatch once, after all
+		 * of them are deleted. Duplicate IDs are ignored.
+		 *
+		 * @param ids The entities to delete.
+		 */
+		void DeleteEntities(std::span<const Entity> ids)
+		{
+			ECS_ASSERT_NO_PARALLEL_ITERATION();
+			for (Entity id : ids)
+			{
+				ECS_ASSERT_VALID_ENTITY(id);
+				ECS_ASSERT_ALIVE_ENTITY(id);
+			}
+			// Clearing the mask bits as we go skips duplicate IDs; archetype rows go with ReleaseEntity
+			std::vector<std::vector<Entity>> removed(ComponentPools.size());
+			for (size_t i = 0; i < ComponentPools.size(); ++i)
+			{
+				bool archetype = archetypes.IsArchetypeComponent(i);
+				ISparseSet* pool = ComponentPools[i].get();
+				for (Entity id : ids)
+				{
+					ComponentMask* mask = entityComponentMasks.Get(id);
+					if (mask == nullptr || !(*mask)[i])
+						continue;
+					mask->set(i, false);
+					if (!archetype)
+						pool->Delete(id);
+					removed[i].push_back(id);
+				}
+			}
+			for (Entity id : ids)
+				if (entityComponentMasks.Contains(id))
+					ReleaseEntity(id);
+			for (size_t i = 0; i < removed.size(); ++i)
+				(this->*deletedBatchNotifiers[i])(removed[i]);
 		}
 
 
 		/**
 		 * @brief Registers a component type with the world.
 		 *
+		 * Types that are usually iterated together (e.g. Transform and RigidBody2D)
+		 * can be registered with ComponentStorage::Archetype so that entities sharing
+		 * the same set of such components are stored in one contiguous table.
+		 * Types that are added and removed often should stay in SparseSet pools.
+		 * Must be called before the first Add of the type to select a storage mode.
+		 *
 		 * @tparam T The component type to register.
+		 * @param storage The storage backend for the type.
 		 */
 		template <class T>
-		void RegisterType()
+		void RegisterType(ComponentStorage storage = ComponentStorage::SparseSet)
 		{
 			ECS_ASSERT(ComponentPools.size() < MAX_COMPONENTS, "Type of Component greate than MAX_COMPONENTS");
-			std::type_index typeID(typeid(T));
-			typeToBitMaskInd[typeID] = ComponentPools.size();
-			ComponentPools.push_back(std::make_unique<SparseSet<T>>());
-			GetResourse<EventManager>().RegisterEvent<OnAdded<T>>()
-				.RegisterEvent<OnDeleted<T>>();
+			ECS_ASSERT(!IsSoAComponent<T> || storage == ComponentStorage::SparseSet, "Components with a SoALayout can only use SparseSet storage");
+			size_t typeID = TypeID<ComponentFamily>::Get<T>();
+			size_t bitMaskInd = ComponentPools.size();
+			if (typeID >= typeToBitMaskInd.size())
+				typeToBitMaskInd.resize(typeID + 1, UINT64_MAX);
+			typeToBitMaskInd[typeID] = bitMaskInd;
+			if (storage == ComponentStorage::Archetype)
+			{
+				archetypes.RegisterComponent<T>(bitMaskInd);
+				ComponentPools.push_back(std::make_unique<ArchetypePool<T>>(&archetypes, bitMaskInd));
+			}
+			else
+				ComponentPools.push_back(std::make_unique<SparseSet<T>>());
+			deletedBatchNotifiers.push_back(&World::NotifyDeletedBatch<T>);
+			for (QueryState* query : queryList)
+				if (query->ResolveExcluded(typeID, bitMaskInd))
+					queriesByComponent[bitMaskInd].push_back(query);
+			GetResourse<EventManager>().template RegisterEvent<OnAdded<T>>()
+				.template RegisterEvent<OnAddedBatch<T>>()
+				.template RegisterEvent<OnDeleted<T>>()
+				.template RegisterEvent<OnDeletedBatch<T>>();
 
 			ECS_INFO("Registerd component: " << typeid(T).name() << " with index of: " << ComponentPools.size() - 1);
 		}
@@ -259,22 +829,11 @@ namespace ac
 		{
 			ECS_ASSERT_VALID_ENTITY(id);
 			ECS_ASSERT_ALIVE_ENTITY(id);
-			auto t = typeToBitMaskInd.find(typeid(T));
-			if (t == typeToBitMaskInd.end())
-			{
-				RegisterType<T>();
-				t = typeToBitMaskInd.find(typeid(T));
-			}
+			ECS_ASSERT_NO_PARALLEL_ITERATION();
+			size_t bitMaskInd = GetOrRegisterComponentID<T>();
 
-			size_t bitMaskInd = t->second;
-			ComponentMask* mask = entityComponentMasks.Get(id);
-			mask->set(bitMaskInd, true);
-
-			ISparseSet* set = ComponentPools[bitMaskInd].get();
-			SparseSet<T>* p = static_cast<SparseSet<T>*>(set);
-
-			T& o = p->Set(id, std::move(obj));
-			GetResourse<EventManager>().Invoke(OnAdded<T>{id, o, *this}, AllowToken<OnAdded<T>>());
+			ComponentPtr<const T> o = StoreComponent<T>(id, bitMaskInd, std::move(obj));
+			GetResourse<EventManager>().Invoke(OnAdded<T>{id, *o, *this}, AllowToken<OnAdded<T>>());
 		}
 
 		/**
@@ -288,17 +847,16 @@ namespace ac
 		{
 			ECS_ASSERT_VALID_ENTITY(id);
 			ECS_ASSERT_ALIVE_ENTITY(id);
-			auto t = typeToBitMaskInd.find(typeid(T));
-			ECS_ASSERT(t != typeToBitMaskInd.end(), "Try to delete component that have never been addded");
-
-			SparseSet<T>* p = static_cast<SparseSet<T>*>(ComponentPools[t->second].get());
+			ECS_ASSERT_NO_PARALLEL_ITERATION();
+			size_t bitMaskInd = GetComponentID<T>();
+			ECS_ASSERT(bitMaskInd != UINT64_MAX, "Try to delete component that have never been addded");
 
-			T& o= *(p->Get(id));
-			GetResourse<EventManager>().Invoke(OnDeleted<T>{id, o, *this}, AllowToken<OnDeleted<T>>());
+			ComponentPtr<const T> o = GetComponentPtr<const T>(id, bitMaskInd);
+			GetResourse<EventManager>().Invoke(OnDeleted<T>{id, *o, *this}, AllowToken<OnDeleted<T>>());
 
-			size_t bitMaskInd = t->second;
 			ComponentMask* mask = entityComponentMasks.Get(id);
 			mask->set(bitMaskInd, false);
+			UpdateQueries(id, bitMaskInd, *mask);
 
 			ComponentPools[bitMaskInd]->Delete(id);
 		}
@@ -308,21 +866,22 @@ namespace ac
 		 *
 		 * Usage example: ecs.Get<Transform>(player);
 		 *
-		 * @tparam T The component type.
+		 * The component is stamped as changed; use Get<const T> to read it
+		 * without affecting Changed<T>() filters.
+		 *
+		 * @tparam T The component type, optionally const.
 		 * @param id The entity ID.
-		 * @return Reference to the component.
+		 * @return Reference to the component; for SoA components the layout's Ref or ConstRef.
 		 */
 		template <typename T>
-		T& Get(Entity id) {
+		ComponentRef<T> Get(Entity id) {
 			ECS_ASSERT_VALID_ENTITY(id);
 			ECS_ASSERT_ALIVE_ENTITY(id);
 
-			auto t = typeToBitMaskInd.find(typeid(T));
-			ECS_ASSERT(t != typeToBitMaskInd.end(), "Tryed to get component that is never registerd");
-
-			SparseSet<T>* p = static_cast<SparseSet<T>*>(ComponentPools[t->second].get());
+			size_t bitMaskInd = GetComponentID<T>();
+			ECS_ASSERT(bitMaskInd != UINT64_MAX, "Tryed to get component that is never registerd");
 
-			return *(p->Get(id));
+			return *GetComponentPtr<T>(id, bitMaskInd);
 		}
 
 		/**
@@ -330,21 +889,37 @@ namespace ac
 		 *
 		 * Usage example: ecs.GetPtr<Transform>(player);
 		 *
-		 * @tparam T The component type.
+		 * Like Get, the component is stamped as changed unless T is const.
+		 *
+		 * @tparam T The component type, optionally const.
 		 * @param id The entity ID.
-		 * @return Pointer to the component, or nullptr if the entity doesn't have the component.
+		 * @return Pointer to the component, or nullptr if the entity doesn't have the component
+		 *         or the handle refers to a deleted entity.
 		 */
 		template <typename T>
-		T* GetPtr(Entity id) {
+		ComponentPtr<T> GetPtr(Entity id) {
 			ECS_ASSERT_VALID_ENTITY(id);
-			ECS_ASSERT_ALIVE_ENTITY(id);
+			if (!IsAlive(id))
+				return nullptr;
 
-			auto t = typeToBitMaskInd.find(typeid(T));
-			ECS_ASSERT(t != typeToBitMaskInd.end(), "Tryed to get component that is never registerd");
+			size_t bitMaskInd = GetComponentID<T>();
+			ECS_ASSERT(bitMaskInd != UINT64_MAX, "Tryed to get component that is never registerd");
 
-			SparseSet<T>* p = static_cast<SparseSet<T>*>(ComponentPools[t->second].get());
+			return GetComponentPtr<T>(id, bitMaskInd);
+		}
 
-			return p->Get(id);
+		/**
+		 * @brief Checks if a handle refers to a live entity.
+		 *
+		 * Handles kept across frames become stale once their entity is deleted,
+		 * even if the index has been reused since.
+		 *
+		 * @param id The entity handle.
+		 * @return True if the entity exists and the handle's generation is current.
+		 */
+		bool IsAlive(Entity id)
+		{
+			return id != NULL_ENTITY && entityComponentMasks.Contains(id);
 		}
 
 		/**
@@ -381,25 +956,204 @@ namespace ac
 		template <typename T>
 		bool Has(Entity id)
 		{
-			auto t = typeToBitMaskInd.find(typeid(T));
-			if (t == typeToBitMaskInd.end())
+			size_t bitMaskInd = GetComponentID<T>();
+			if (bitMaskInd == UINT64_MAX)
 				return false;
 			ComponentMask* p = entityComponentMasks.Get(id);
 			if (p == nullptr)
 				return false;
-			return (*p)[t->second];
+			return (*p)[bitMaskInd];
 		}
 
 		/**
 		 * @brief Creates a view for iterating over entities with specific components.
 		 *
-		 * @tparam Components The component types to include in the view.
-		 * @return A SimpleView object for the specified component types.
+		 * Components the view only reads should be requested as const
+		 * (View<const Transform>), the others are stamped as changed.
+		 *
+		 * Usage example:
+		 *   world.View<AudioSource>(Exclude<Muted>{}, Optional<const Transform>{}).ForEach(
+		 *       [](Entity e, AudioSource& source, const Transform* transform) { ... });
+		 *
+		 * @tparam Components The component types entities must have.
+		 * @param filters Exclude<Ts...> and Optional<Ts...> filters.
+		 * @return A SimpleView object for the specified component types, followed by the optional ones.
+		 */
+		template <typename... Components, typename... Filters>
+		auto View(Filters... filters) {
+			ComponentMask excluded;
+			(CollectExcluded(excluded, filters), ...);
+			return MakeView(std::type_identity<typename FilteredView<SimpleView<Components...>, Filters...>::type>{}, excluded);
+		}
+
+		/**
+		 * @brief Creates a view over the entities of a cached query.
+		 *
+		 * The first call for a list of components and filters registers a query
+		 * that keeps a packed list of the matching entities; Add, Delete and
+		 * DeleteEntity update it as component masks change. Every later call
+		 * with the same arguments reuses it, so the view walks the list without
+		 * matching entities or picking a driving pool. Worth it for views that
+		 * run every frame; one-off iteration should keep using View.
+		 *
+		 * Views whose required components are all archetype-backed walk the
+		 * matching tables directly, which already needs no per-entity matching.
+		 *
+		 * Usage example:
+		 *   world.Query<Transform, const Velocity>(Exclude<Frozen>{}).ForEach(
+		 *       [](Transform& transform, const Velocity& velocity) { ... });
+		 *
+		 * @tparam Components The component types entities must have.
+		 * @param filters Exclude<Ts...> and Optional<Ts...> filters.
+		 * @return A SimpleView driven by the query's entities.
+		 */
+		template <typename... Components, typename... Filters>
+		auto Query(Filters... filters) {
+			QueryState& query = GetOrCreateQuery<Components...>(filters...);
+			return MakeView(std::type_identity<typename FilteredView<SimpleView<Components...>, Filters...>::type>{},
+				query.Excluded(), &query.Entities());
+		}
+
+		/**
+		 * @brief Returns a tick to compare later changes against, for code that does not run as a system.
+		 *
+		 * Components added or changed outside systems after this call pass
+		 * Changed<T>(tick) and Added<T>(tick) filters. Inside a system this is
+		 * the system's own tick.
+		 *
+		 * @return The current change tick.
+		 */
+		uint32_t GetChangeTick()
+		{
+			uint32_t tick = changeClock.Now();
+			changeClock.Advance();
+			return tick;
+		}
+
+		/**
+		 * @brief Returns the tick of the previous run of the calling system.
+		 *
+		 * Jobs a system submits to the job system see the system's tick too, so
+		 * it can be read there as well as once up front and passed to IsChanged.
+		 *
+		 * @return The tick, or 0 outside systems and on a system's first run.
 		 */
-		template <typename... Components>
-		SimpleView<Components...> View() {
-			// Pass a copy of array from fold expression into view.
-			return { { GetSparseSetPtr<Components>()... } };
+		uint32_t GetLastRunTick()
+		{
+			return changeClock.LastRun();
+		}
+
+		/**
+		 * @brief Checks whether a component of an entity changed after a tick.
+		 *
+		 * Does not stamp the component and is safe to call from ParallelForEach.
+		 *
+		 * @tparam T The component type.
+		 * @param id The entity ID.
+		 * @param sinceTick A tick from GetChangeTick() or GetLastRunTick().
+		 * @return True if the entity has T and it was added or changed after sinceTick.
+		 */
+		template <typename T>
+		bool IsChanged(Entity id, uint32_t sinceTick)
+		{
+			size_t bitMaskInd = GetComponentID<T>();
+			if (bitMaskInd == UINT64_MAX)
+				return false;
+			const ComponentTicks* ticks = ComponentPools[bitMaskInd]->GetTicks(id);
+			return ticks != nullptr && IsNewerTick(ticks->changed, sinceTick);
+		}
+
+		/**
+		 * @brief Gets the pool of a component with a SoALayout, for loops that walk its field columns directly.
+		 *
+		 * Rows of pool.Columns() line up with pool.Entities(). Writing through
+		 * the columns does not stamp change ticks, and adding or removing T
+		 * reorders the rows.
+		 *
+		 * @tparam T The component type, must be registered.
+		 * @return Reference to the pool.
+		 */
+		template <typename T> requires IsSoAComponent<T>
+		SparseSet<T>& GetSoAPool()
+		{
+			return *GetSparseSetPtr<T>();
+		}
+
+		/**
+		 * @brief Returns the layout version of a component's pool, see ISparseSet::LayoutVersion.
+		 *
+		 * Pointers from GetUntrackedPtr stay valid while the versions of their
+		 * pools are unchanged.
+		 *
+		 * @tparam T The component type, must be registered.
+		 * @return The layout version.
+		 */
+		template <typename T>
+		uint64_t GetLayoutVersion()
+		{
+			return GetPoolPtr<T>()->LayoutVersion();
+		}
+
+		/**
+		 * @brief Retrieves a component and its change ticks without stamping it.
+		 *
+		 * For systems that cache component addresses across frames: they write
+		 * through the cached pointers and stamp ticks->changed with
+		 * GetChangeTick() themselves.
+		 *
+		 * @tparam T The component type.
+		 * @param id The entity ID.
+		 * @param ticks Receives a pointer to the ticks, untouched if the entity doesn't have the component.
+		 * @return Pointer to the component, or nullptr if the entity doesn't have it.
+		 */
+		template <typename T>
+		ComponentPtr<T> GetUntrackedPtr(Entity id, ComponentTicks*& ticks)
+		{
+			size_t bitMaskInd = GetComponentID<T>();
+			ECS_ASSERT(bitMaskInd != UINT64_MAX, "Tryed to get component that is never registerd");
+			if constexpr (IsSoAComponent<T>)
+				return static_cast<SparseSet<T>*>(ComponentPools[bitMaskInd].get())->Get(id, ticks);
+			else
+				return archetypes.IsArchetypeComponent(bitMaskInd) ?
+					archetypes.Get<T>(id, bitMaskInd, ticks) :
+					static_cast<SparseSet<T>*>(ComponentPools[bitMaskInd].get())->Get(id, ticks);
+		}
+
+		/**
+		 * @brief Returns the worker pool owned by the world.
+		 *
+		 * @return Reference to the job system.
+		 */
+		JobSystem& GetJobSystem()
+		{
+			return jobSystem;
+		}
+
+		/**
+		 * @brief Returns the command buffer of the calling thread.
+		 *
+		 * Every worker thread of the world's job system gets its own buffer, so
+		 * systems running concurrently (or inside ParallelForEach) can record
+		 * structural changes without locking. The buffers are played back at the
+		 * end of each system phase, or explicitly by FlushCommands.
+		 *
+		 * @return Reference to the calling thread's command buffer.
+		 */
+		CommandBuffer& GetCommandBuffer()
+		{
+			return commandBuffers[jobSystem.WorkerIndex()];
+		}
+
+		/**
+		 * @brief Plays back the per-thread command buffers, main thread first.
+		 *
+		 * Must be called while no system or parallel iteration is running.
+		 */
+		void FlushCommands()
+		{
+			ECS_ASSERT_NO_PARALLEL_ITERATION();
+			for (CommandBuffer& buffer : commandBuffers)
+				buffer.Playback(*this);
 		}
 
 		/**
@@ -420,42 +1174,96 @@ namespace ac
 			return ComponentPools.size();
 		}
 
+		/**
+		 * @brief Returns the number of entities that have a component.
+		 *
+		 * @tparam T The component type.
+		 * @return The component count.
+		 */
+		template<class T>
+		std::size_t GetComponentCount() {
+			return GetPoolPtr<T>()->Size();
+		}
+
 		/**
 		 * @brief Adds a system to be executed during the pre-update phase.
 		 * 
+		 * Systems that declare their access may run concurrently with other
+		 * systems of the phase they do not conflict with, see SystemAccess.
+		 * 
 		 * @param systemFunc Function pointer to the system (void(*)(World&)).
 		 * @param priority Priority level (0-9), lower values execute first.
+		 * @param access Components and resources the system uses, exclusive if omitted.
 		 * @return Reference to this World for chaining.
 		 */
-		World& AddPreUpdateSystem(void(*systemFunc)(World&), size_t priority)
+		World& AddPreUpdateSystem(void(*systemFunc)(World&), size_t priority, SystemAccess access = {})
 		{
-			preUpdateSystems[ValidatePriority(priority)].push_back(systemFunc);
+			preUpdateSystems.Add(systemFunc, ValidatePriority(priority), std::move(access));
 			return *this;
 		}
 
+		/**
+		 * @brief Adds a system to be executed during the fixed-update phase.
+		 * 
+		 * The phase runs between pre-update and update, as many times per
+		 * Update as set by SetFixedUpdateCount, so its systems should advance
+		 * the world by a fixed time step rather than by the frame's delta.
+		 * 
+		 * @param systemFunc Function pointer to the system (void(*)(World&)).
+		 * @param priority Priority level (0-9), lower values execute first.
+		 * @param access Components and resources the system uses, exclusive if omitted.
+		 * @return Reference to this World for chaining.
+		 */
+		World& AddFixedUpdateSystem(void(*systemFunc)(World&), size_t priority, SystemAccess access = {})
+		{
+			fixedUpdateSystems.Add(systemFunc, ValidatePriority(priority), std::move(access));
+			return *this;
+		}
+
+		/**
+		 * @brief Sets how many times the fixed-update phase runs in the following Update calls.
+		 * 
+		 * Meant to be called every frame by the clock owning the fixed step,
+		 * from a pre-update system. Defaults to 1, once per Update.
+		 * 
+		 * @param count Number of fixed steps, 0 to skip the phase.
+		 */
+		void SetFixedUpdateCount(size_t count)
+		{
+			fixedUpdateCount = count;
+		}
+
 		/**
 		 * @brief Adds a system to be executed during the update phase.
 		 * 
+		 * Systems that declare their access may run concurrently with other
+		 * systems of the phase they do not conflict with, see SystemAccess.
+		 * 
 		 * @param systemFunc Function pointer to the system (void(*)(World&)).
 		 * @param priority Priority level (0-9), lower values execute first.
+		 * @param access Components and resources the system uses, exclusive if omitted.
 		 * @return Reference to this World for chaining.
 		 */
-		World& AddUpdateSystem(void(*systemFunc)(World&), size_t priority)
+		World& AddUpdateSystem(void(*systemFunc)(World&), size_t priority, SystemAccess access = {})
 		{
-			updateSystems[ValidatePriority(priority)].push_back(systemFunc);
+			updateSystems.Add(systemFunc, ValidatePriority(priority), std::move(access));
 			return *this;
 		}
 
 		/**
 		 * @brief Adds a system to be executed during the post-update phase.
 		 * 
+		 * Systems that declare their access may run concurrently with other
+		 * systems of the phase they do not conflict with, see SystemAccess.
+		 * 
 		 * @param systemFunc Function pointer to the system (void(*)(World&)).
 		 * @param priority Priority level (0-9), lower values execute first.
+		 * @param access Components and resources the system uses, exclusive if omitted.
 		 * @return Reference to this World for chaining.
 		 */
-		World& AddPostUpdateSystem(void(*systemFunc)(World&), size_t priority)
+		World& AddPostUpdateSystem(void(*systemFunc)(World&), size_t priority, SystemAccess access = {})
 		{
-			postUpdateSystems[ValidatePriority(priority)].push_back(systemFunc);
+			postUpdateSystems.Add(systemFunc, ValidatePriority(priority), std::move(access));
 			return *this;
 		}
 
@@ -464,16 +1272,24 @@ namespace ac
 		 * 
 		 * Systems with lower priority values execute first.
 		 * Within the same priority level, systems execute in the order they were added.
+		 * Commands recorded into the per-thread command buffers are played back afterwards.
 		 */
 		void RunPreUpdateSystems()
 		{
-			for (size_t priority = 0; priority < preUpdateSystems.size(); ++priority)
-			{
-				for (auto& system : preUpdateSystems[priority])
-				{
-					system(*this);
-				}
-			}
+			preUpdateSystems.Run(*this, jobSystem, changeClock);
+			FlushCommands();
+		}
+
+		/**
+		 * @brief Executes all fixed-update systems in order of priority, once.
+		 * 
+		 * Update calls this as many times as set by SetFixedUpdateCount.
+		 * Commands recorded into the per-thread command buffers are played back after each run.
+		 */
+		void RunFixedUpdateSystems()
+		{
+			fixedUpdateSystems.Run(*this, jobSystem, changeClock);
+			FlushCommands();
 		}
 
 		/**
@@ -481,16 +1297,12 @@ namespace ac
 		 * 
 		 * Systems with lower priority values execute first.
 		 * Within the same priority level, systems execute in the order they were added.
+		 * Commands recorded into the per-thread command buffers are played back afterwards.
 		 */
 		void RunUpdateSystems()
 		{
-			for (size_t priority = 0; priority < updateSystems.size(); ++priority)
-			{
-				for (auto& system : updateSystems[priority])
-				{
-					system(*this);
-				}
-			}
+			updateSystems.Run(*this, jobSystem, changeClock);
+			FlushCommands();
 		}
 
 		/**
@@ -498,23 +1310,78 @@ namespace ac
 		 * 
 		 * Systems with lower priority values execute first.
 		 * Within the same priority level, systems execute in the order they were added.
+		 * Commands recorded into the per-thread command buffers are played back afterwards.
 		 */
 		void RunPostUpdateSystems()
 		{
-			for (size_t priority = 0; priority < postUpdateSystems.size(); ++priority)
-			{
-				for (auto& system : postUpdateSystems[priority])
-				{
-					system(*this);
-				}
-			}
+			postUpdateSystems.Run(*this, jobSystem, changeClock);
+			FlushCommands();
 		}
 
 		void Update()
 		{
 			RunPreUpdateSystems();
+			for (size_t i = 0; i < fixedUpdateCount; ++i)
+				RunFixedUpdateSystems();
 			RunUpdateSystems();
 			RunPostUpdateSystems();
 		}
 	};
+
+	template <class T>
+	void CommandBuffer::ComponentCommands<T>::PlaybackAdds(World& world, const std::vector<Entity>& created)
+	{
+		if (adds.empty())
+			return;
+		for (auto& add : adds)
+			add.first = Resolve(add.first, created);
+		world.PlaybackAdds<T>(adds);
+	}
+
+	template <class T>
+	void CommandBuffer::ComponentCommands<T>::PlaybackDeletes(World& world, const std::vector<Entity>& created)
+	{
+		if (deletes.empty())
+			return;
+		for (Entity& id : deletes)
+			id = Resolve(id, created);
+		world.PlaybackDeletes<T>(deletes);
+	}
+
+	inline void CommandBuffer::Apply(World& world)
+	{
+		std::vector<Entity> created = world.CreateEntities(createdTags.size());
+		for (size_t i = 0; i < created.size(); ++i)
+			if (!createdTags[i].empty())
+				world.entityTag[created[i]] = createdTags[i];
+
+		for (size_t typeID : usedTypes)
+			componentCommands[typeID]->PlaybackAdds(world, created);
+		for (size_t typeID : usedTypes)
+			componentCommands[typeID]->PlaybackDeletes(world, created);
+
+		std::vector<Entity> deleted;
+		deleted.reserve(deletedEntities.size());
+		for (Entity id : deletedEntities)
+		{
+			id = Resolve(id, created);
+			if (world.IsAlive(id))
+				deleted.push_back(id);
+		}
+		world.DeleteEntities(deleted);
+	}
+
+	inline void CommandBuffer::Playback(World& world)
+	{
+		if (Empty())
+			return;
+		// Listeners may record new commands while this batch is applied; they land in *this.
+		CommandBuffer pending;
+		std::swap(*this, pending);
+		pending.Apply(world);
+		pending.Clear();
+		// Hand the cleared storage back for reuse unless new commands were recorded.
+		if (Empty())
+			std::swap(*this, pending);
+	}
 }
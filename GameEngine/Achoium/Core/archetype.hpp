@@ -0,0 +1,615 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <bitset>
+#include <unordered_map>
+#include <memory>
+#include "ECSDebug.h"
+#include "sparseset.hpp"
+namespace ac
+{
+	/**
+	 * @brief Type-erased interface for a single component column of an archetype table.
+	 *
+	 * Every archetype owns one column per component type in its mask. Rows of
+	 * all columns line up, so row i of every column belongs to the same entity.
+	 */
+	class IArchetypeColumn
+	{
+	public:
+		virtual ~IArchetypeColumn() = default;
+
+		/** Change ticks of each row; kept in line with the values by the derived column. */
+		std::vector<ComponentTicks> ticks;
+
+		/**
+		 * @brief Creates an empty column holding the same component type.
+		 * @return A new, empty column.
+		 */
+		virtual std::unique_ptr<IArchetypeColumn> CloneEmpty() const = 0;
+
+		/**
+		 * @brief Moves the value at row to the back of another column of the same type.
+		 *
+		 * The source row is left in a moved-from state and must be removed afterwards.
+		 *
+		 * @param row The row to move from.
+		 * @param dst The column to append the value to.
+		 */
+		virtual void MoveRowTo(std::size_t row, IArchetypeColumn& dst) = 0;
+
+		/**
+		 * @brief Removes a row by moving the last row into its place.
+		 * @param row The row to remove.
+		 */
+		virtual void SwapRemove(std::size_t row) = 0;
+
+		/**
+		 * @brief Removes all rows from the column.
+		 */
+		virtual void Clear() = 0;
+	};
+
+	/**
+	 * @brief Contiguous storage for one component type inside an archetype table.
+	 *
+	 * @tparam Type The component type stored in this column.
+	 */
+	template <typename Type>
+	class ArchetypeColumn final : public IArchetypeColumn
+	{
+	public:
+		/** The component values, one per row of the owning archetype. */
+		std::vector<Type> data;
+
+		std::unique_ptr<IArchetypeColumn> CloneEmpty() const override
+		{
+			return std::make_unique<ArchetypeColumn<Type>>();
+		}
+
+		void MoveRowTo(std::size_t row, IArchetypeColumn& dst) override
+		{
+			static_cast<ArchetypeColumn<Type>&>(dst).data.emplace_back(std::move(data[row]));
+			dst.ticks.push_back(ticks[row]);
+		}
+
+		void SwapRemove(std::size_t row) override
+		{
+			if (row != data.size() - 1)
+			{
+				data[row] = std::move(data.back());
+				ticks[row] = ticks.back();
+			}
+			data.pop_back();
+			ticks.pop_back();
+		}
+
+		void Clear() override
+		{
+			data.clear();
+			ticks.clear();
+		}
+	};
+
+	/**
+	 * @brief A table of all entities that share exactly the same set of archetype components.
+	 *
+	 * Components are stored column by column, so iterating every entity of an
+	 * archetype is a linear walk over contiguous arrays with no membership checks.
+	 */
+	struct Archetype
+	{
+		/** The archetype-stored components every row of this table has. */
+		ComponentMask mask;
+
+		/** The entity owning each row. */
+		std::vector<Entity> entities;
+
+		/** One column per component bit set in mask, nullptr otherwise. */
+		std::array<std::unique_ptr<IArchetypeColumn>, MAX_COMPONENTS> columns;
+
+		/**
+		 * @brief Gets the typed column for a component.
+		 *
+		 * @tparam T The component type.
+		 * @param componentID The bitmask index of the component.
+		 * @return Pointer to the column, or nullptr if the archetype does not store T.
+		 */
+		template <class T>
+		ArchetypeColumn<T>* Column(std::size_t componentID)
+		{
+			return static_cast<ArchetypeColumn<T>*>(columns[componentID].get());
+		}
+
+		/**
+		 * @brief Returns the number of rows (entities) in the table.
+		 */
+		std::size_t Size() const
+		{
+			return entities.size();
+		}
+	};
+
+	/**
+	 * @brief Row address of an entity inside the archetype storage.
+	 */
+	struct ArchetypeLocation
+	{
+		std::size_t archetype; ///< Index of the archetype table
+		std::size_t row;       ///< Row inside that table
+	};
+
+	/**
+	 * @brief Owns every archetype table of a World.
+	 *
+	 * Only components registered with ComponentStorage::Archetype live here. An
+	 * entity moves to a different table whenever one of its archetype components
+	 * is added or removed; components kept in SparseSet pools are unaffected.
+	 */
+	class ArchetypeStorage
+	{
+	private:
+		/** All archetype tables, created on demand. */
+		std::vector<std::unique_ptr<Archetype>> archetypes;
+
+		/** Maps a component mask to its table index. */
+		std::unordered_map<ComponentMask, std::size_t> archetypeIndex;
+
+		/** Maps entities to their table and row. */
+		SparseSet<ArchetypeLocation> locations;
+
+		/** Empty column per registered component, used to build new tables. */
+		std::array<std::unique_ptr<IArchetypeColumn>, MAX_COMPONENTS> prototypes;
+
+		/** Number of entities that have each component. */
+		std::array<std::size_t, MAX_COMPONENTS> componentCounts{};
+
+		/** Bits of all components stored in archetypes. */
+		ComponentMask archetypeComponents;
+
+		/** Bumped whenever rows are added to or removed from any table. */
+		uint64_t layoutVersion = 0;
+
+		/**
+		 * @brief Finds or creates the table for a component mask.
+		 *
+		 * @param mask The archetype components of the table.
+		 * @return Index of the table.
+		 */
+		std::size_t GetOrCreateArchetype(const ComponentMask& mask)
+		{
+			auto it = archetypeIndex.find(mask);
+			if (it != archetypeIndex.end())
+				return it->second;
+
+			auto archetype = std::make_unique<Archetype>();
+			archetype->mask = mask;
+			for (std::size_t i = 0; i < MAX_COMPONENTS; ++i)
+				if (mask[i])
+					archetype->columns[i] = prototypes[i]->CloneEmpty();
+
+			std::size_t ind = archetypes.size();
+			archetypes.push_back(std::move(archetype));
+			archetypeIndex[mask] = ind;
+			return ind;
+		}
+
+		/**
+		 * @brief Removes a row from a table and patches the location of the row moved into its place.
+		 *
+		 * @param archetypeInd The table index.
+		 * @param row The row to remove.
+		 */
+		void RemoveRow(std::size_t archetypeInd, std::size_t row)
+		{
+			Archetype& archetype = *archetypes[archetypeInd];
+			for (std::size_t i = 0; i < MAX_COMPONENTS; ++i)
+				if (archetype.mask[i])
+					archetype.columns[i]->SwapRemove(row);
+
+			Entity last = archetype.entities.back();
+			archetype.entities[row] = last;
+			archetype.entities.pop_back();
+			if (row < archetype.entities.size())
+				locations.GetRef(last).row = row;
+			++layoutVersion;
+		}
+
+		/**
+		 * @brief Moves an entity to the table matching newMask, carrying over shared components.
+		 *
+		 * @param id The entity to move.
+		 * @param newMask The archetype components the entity will have.
+		 * @return The location of the entity in its new table.
+		 */
+		ArchetypeLocation MoveEntity(Entity id, const ComponentMask& newMask)
+		{
+			std::size_t dstInd = GetOrCreateArchetype(newMask);
+			Archetype& dst = *archetypes[dstInd];
+
+			ArchetypeLocation* old = locations.Get(id);
+			if (old != nullptr)
+			{
+				Archetype& src = *archetypes[old->archetype];
+				for (std::size_t i = 0; i < MAX_COMPONENTS; ++i)
+					if (src.mask[i] && newMask[i])
+						src.columns[i]->MoveRowTo(old->row, *dst.columns[i]);
+				RemoveRow(old->archetype, old->row);
+			}
+
+			dst.entities.push_back(id);
+			++layoutVersion;
+			ArchetypeLocation location{ dstInd, dst.entities.size() - 1 };
+			locations.Set(id, ArchetypeLocation(location));
+			return location;
+		}
+
+	public:
+		/**
+		 * @brief Registers a component type to be stored in archetype tables.
+		 *
+		 * @tparam T The component type.
+		 * @param componentID The bitmask index assigned to the component by the World.
+		 */
+		template <class T>
+		void RegisterComponent(std::size_t componentID)
+		{
+			prototypes[componentID] = std::make_unique<ArchetypeColumn<T>>();
+			archetypeComponents.set(componentID, true);
+		}
+
+		/**
+		 * @brief Checks whether a component is stored in archetype tables.
+		 *
+		 * @param componentID The bitmask index of the component.
+		 * @return True if the component uses archetype storage.
+		 */
+		bool IsArchetypeComponent(std::size_t componentID) const
+		{
+			return archetypeComponents[componentID];
+		}
+
+		/**
+		 * @brief Adds or overwrites a component of an entity.
+		 *
+		 * @tparam T The component type.
+		 * @param id The entity.
+		 * @param componentID The bitmask index of the component.
+		 * @param obj The component value.
+		 * @param tick The change tick to stamp the component with.
+		 * @return Reference to the stored component.
+		 */
+		template <class T>
+		T& Set(Entity id, std::size_t componentID, T&& obj, uint32_t tick = 0)
+		{
+			ArchetypeLocation* location = locations.Get(id);
+			if (location != nullptr && archetypes[location->archetype]->mask[componentID])
+			{
+				ArchetypeColumn<T>* column = archetypes[location->archetype]->Column<T>(componentID);
+				T& o = column->data[location->row];
+				o = std::forward<T>(obj);
+				column->ticks[location->row].changed = tick;
+				return o;
+			}
+
+			ComponentMask newMask;
+			if (location != nullptr)
+				newMask = archetypes[location->archetype]->mask;
+			newMask.set(componentID, true);
+
+			ArchetypeLocation newLocation = MoveEntity(id, newMask);
+			ArchetypeColumn<T>* column = archetypes[newLocation.archetype]->Column<T>(componentID);
+			column->data.emplace_back(std::forward<T>(obj));
+			column->ticks.push_back(ComponentTicks{ tick, tick });
+			++componentCounts[componentID];
+			return column->data.back();
+		}
+
+		/**
+		 * @brief Removes a component from an entity.
+		 *
+		 * @param id The entity.
+		 * @param componentID The bitmask index of the component.
+		 */
+		void Remove(Entity id, std::size_t componentID)
+		{
+			ArchetypeLocation* location = locations.Get(id);
+			if (location == nullptr || !archetypes[location->archetype]->mask[componentID])
+				return;
+
+			ComponentMask newMask = archetypes[location->archetype]->mask;
+			newMask.set(componentID, false);
+
+			if (newMask.none())
+			{
+				RemoveEntity(id);
+				return;
+			}
+			--componentCounts[componentID];
+			MoveEntity(id, newMask);
+		}
+
+		/**
+		 * @brief Removes an entity and all of its archetype components.
+		 *
+		 * @param id The entity.
+		 */
+		void RemoveEntity(Entity id)
+		{
+			ArchetypeLocation* location = locations.Get(id);
+			if (location == nullptr)
+				return;
+
+			Archetype& archetype = *archetypes[location->archetype];
+			for (std::size_t i = 0; i < MAX_COMPONENTS; ++i)
+				if (archetype.mask[i])
+					--componentCounts[i];
+
+			RemoveRow(location->archetype, location->row);
+			locations.Delete(id);
+		}
+
+		/**
+		 * @brief Checks whether an entity has an archetype component.
+		 *
+		 * @param id The entity.
+		 * @param componentID The bitmask index of the component.
+		 * @return True if the entity has the component.
+		 */
+		bool Contains(Entity id, std::size_t componentID)
+		{
+			ArchetypeLocation* location = locations.Get(id);
+			return location != nullptr && archetypes[location->archetype]->mask[componentID];
+		}
+
+		/**
+		 * @brief Gets a component of an entity.
+		 *
+		 * @tparam T The component type.
+		 * @param id The entity.
+		 * @param componentID The bitmask index of the component.
+		 * @return Pointer to the component, or nullptr if the entity does not have it.
+		 */
+		template <class T>
+		T* Get(Entity id, std::size_t componentID)
+		{
+			ArchetypeLocation* location = locations.Get(id);
+			if (location == nullptr)
+				return nullptr;
+			ArchetypeColumn<T>* column = archetypes[location->archetype]->Column<T>(componentID);
+			if (column == nullptr)
+				return nullptr;
+			return &column->data[location->row];
+		}
+
+		/**
+		 * @brief Gets a component of an entity together with its change ticks.
+		 *
+		 * @tparam T The component type.
+		 * @param id The entity.
+		 * @param componentID The bitmask index of the component.
+		 * @param outTicks Receives a pointer to the ticks, untouched if the entity does not have the component.
+		 * @return Pointer to the component, or nullptr if the entity does not have it.
+		 */
+		template <class T>
+		T* Get(Entity id, std::size_t componentID, ComponentTicks*& outTicks)
+		{
+			ArchetypeLocation* location = locations.Get(id);
+			if (location == nullptr)
+				return nullptr;
+			ArchetypeColumn<T>* column = archetypes[location->archetype]->Column<T>(componentID);
+			if (column == nullptr)
+				return nullptr;
+			outTicks = &column->ticks[location->row];
+			return &column->data[location->row];
+		}
+
+		/**
+		 * @brief Gets the change ticks of an entity's component.
+		 *
+		 * @param id The entity.
+		 * @param componentID The bitmask index of the component.
+		 * @return Pointer to the ticks, or nullptr if the entity does not have the component.
+		 */
+		ComponentTicks* GetTicks(Entity id, std::size_t componentID)
+		{
+			ArchetypeLocation* location = locations.Get(id);
+			if (location == nullptr || !archetypes[location->archetype]->mask[componentID])
+				return nullptr;
+			return &archetypes[location->archetype]->columns[componentID]->ticks[location->row];
+		}
+
+		/**
+		 * @brief Returns how many entities have a component.
+		 *
+		 * @param componentID The bitmask index of the component.
+		 */
+		std::size_t Count(std::size_t componentID) const
+		{
+			return componentCounts[componentID];
+		}
+
+		/**
+		 * @brief Calls func for every table whose mask contains all required components.
+		 *
+		 * @tparam Func Callable taking an Archetype&.
+		 * @param required The components the table must have.
+		 * @param func The function to execute for every matching, non-empty table.
+		 */
+		template <class Func>
+		void ForEachMatching(const ComponentMask& required, Func&& func)
+		{
+			for (auto& archetype : archetypes)
+				if (!archetype->entities.empty() && (archetype->mask & required) == required)
+					func(*archetype);
+		}
+
+		/**
+		 * @brief Returns the number of archetype tables, including empty ones.
+		 */
+		std::size_t ArchetypeCount() const
+		{
+			return archetypes.size();
+		}
+
+		/**
+		 * @brief Gets an archetype table by index.
+		 *
+		 * @param ind Index of the table, less than ArchetypeCount().
+		 * @return Reference to the table.
+		 */
+		Archetype& GetArchetype(std::size_t ind)
+		{
+			return *archetypes[ind];
+		}
+
+		/**
+		 * @brief Removes every table, entity and component registration.
+		 */
+		void Clear()
+		{
+			archetypes.clear();
+			archetypeIndex.clear();
+			locations.Clear();
+			for (auto& prototype : prototypes)
+				prototype.reset();
+			componentCounts.fill(0);
+			archetypeComponents.reset();
+			++layoutVersion;
+		}
+
+		/**
+		 * @brief Returns a counter that changes whenever rows are added to, removed from or moved between tables.
+		 */
+		uint64_t LayoutVersion() const
+		{
+			return layoutVersion;
+		}
+	};
+
+	/**
+	 * @brief ISparseSet adapter that exposes one archetype component like a pool.
+	 *
+	 * The World keeps one pool per component type; for archetype components this
+	 * adapter forwards every operation to the shared ArchetypeStorage so that
+	 * masks, views and entity deletion work regardless of the storage mode.
+	 *
+	 * @tparam Type The component type.
+	 */
+	template <typename Type>
+	class ArchetypePool final : public ISparseSet
+	{
+	private:
+		/** The storage that owns the component data. */
+		ArchetypeStorage* storage;
+
+		/** The bitmask index of the component. */
+		std::size_t componentID;
+
+	public:
+		ArchetypePool(ArchetypeStorage* storage, std::size_t componentID) :
+			storage(storage), componentID(componentID)
+		{
+		}
+
+		void Delete(Entity entity) override
+		{
+			storage->Remove(entity, componentID);
+		}
+
+		void Clear() override
+		{
+			for (Entity id : GetEntityList())
+				storage->Remove(id, componentID);
+		}
+
+		std::size_t Size() override
+		{
+			return storage->Count(componentID);
+		}
+
+		bool Contains(Entity id) override
+		{
+			return storage->Contains(id, componentID);
+		}
+
+		ComponentTicks* GetTicks(Entity id) override
+		{
+			return storage->GetTicks(id, componentID);
+		}
+
+		std::vector<Entity> GetEntityList() override
+		{
+			std::vector<Entity> result;
+			ComponentMask required;
+			required.set(componentID, true);
+			storage->ForEachMatching(required, [&result](Archetype& archetype)
+				{
+					result.insert(result.end(), archetype.entities.begin(), archetype.entities.end());
+				});
+			return result;
+		}
+
+		ComponentStorage StorageMode() const override
+		{
+			return ComponentStorage::Archetype;
+		}
+
+		uint64_t LayoutVersion() const override
+		{
+			return storage->LayoutVersion();
+		}
+
+		/**
+		 * @brief Retrieves the component of an entity.
+		 *
+		 * @param id The entity ID.
+		 * @return A pointer to the component, or nullptr if the entity does not have it.
+		 */
+		Type* Get(Entity id)
+		{
+			return storage->Get<Type>(id, componentID);
+		}
+
+		/**
+		 * @brief Retrieves the component of an entity together with its change ticks.
+		 *
+		 * @param id The entity ID.
+		 * @param outTicks Receives a pointer to the ticks, untouched if the entity does not have the component.
+		 * @return A pointer to the component, or nullptr if the entity does not have it.
+		 */
+		Type* Get(Entity id, ComponentTicks*& outTicks)
+		{
+			return storage->Get<Type>(id, componentID, outTicks);
+		}
+
+		/**
+		 * @brief Retrieves a reference to the component of an entity.
+		 *
+		 * @param id The entity ID.
+		 * @return A reference to the component.
+		 */
+		Type& GetRef(Entity id)
+		{
+			Type* p = Get(id);
+			ECS_ASSERT(p != nullptr, "GetRef called on invalid entity with ID " << id);
+			return *p;
+		}
+
+		/**
+		 * @brief Returns the storage that owns the component data.
+		 */
+		ArchetypeStorage* Storage() const
+		{
+			return storage;
+		}
+
+		/**
+		 * @brief Returns the bitmask index of the component.
+		 */
+		std::size_t ComponentID() const
+		{
+			return componentID;
+		}
+	};
+}
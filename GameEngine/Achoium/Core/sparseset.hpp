@@ -11,13 +11,19 @@
 #include <type_traits>
 #include <cstdint>
 #include "ECSDebug.h"
+#include "JobSystem.hpp"
+#include "ChangeTick.hpp"
+#include "SoA.hpp"
 namespace ac
 {
 
     /**
      * @brief Entity identifier type.
      *
-     * Entities are represented as 64-bit unsigned integers.
+     * Entities are represented as 64-bit unsigned integers. The low 32 bits hold
+     * the entity index and the high 32 bits hold a generation that is bumped
+     * every time the index is recycled, so handles to deleted entities never
+     * alias newly created ones.
     */
     using Entity = uint64_t;
 
@@ -43,6 +49,40 @@ namespace ac
      */
     constexpr Entity NULL_ENTITY = UINT64_MAX;
 
+    /**
+     * @brief Extracts the index part of an entity handle.
+     *
+     * @param id The entity handle.
+     * @return The index used to address per-entity storage.
+     */
+    constexpr uint32_t EntityIndex(Entity id)
+    {
+        return static_cast<uint32_t>(id);
+    }
+
+    /**
+     * @brief Extracts the generation part of an entity handle.
+     *
+     * @param id The entity handle.
+     * @return How many times the index has been recycled.
+     */
+    constexpr uint32_t EntityGeneration(Entity id)
+    {
+        return static_cast<uint32_t>(id >> 32);
+    }
+
+    /**
+     * @brief Builds an entity handle from an index and a generation.
+     *
+     * @param index The entity index.
+     * @param generation The generation of the index.
+     * @return The packed entity handle.
+     */
+    constexpr Entity MakeEntity(uint32_t index, uint32_t generation)
+    {
+        return (static_cast<Entity>(generation) << 32) | index;
+    }
+
     /**
      * @brief Maximum number of component types supported by the ECS.
      */
@@ -52,6 +92,24 @@ namespace ac
 	 */
 	constexpr size_t MAX_SYSTEM_LAYER = 10;
 
+	/**
+	 * @brief Bitmask type for tracking which components an entity has.
+	 */
+	using ComponentMask = std::bitset<MAX_COMPONENTS>;
+
+	/**
+	 * @brief Storage backend used for a component type.
+	 *
+	 * - SparseSet: one pool per component type, cheap add/remove.
+	 * - Archetype: entities with the same set of archetype components share a
+	 *   table with one contiguous column per component, fast multi-component iteration.
+	 */
+	enum class ComponentStorage
+	{
+		SparseSet,
+		Archetype
+	};
+
     /**
      * @brief Interface for sparse set implementations.
      *
@@ -93,11 +151,36 @@ namespace ac
 		 */
 		virtual bool Contains(Entity id) = 0;
 
+		/**
+		 * @brief Returns the change ticks of an entity's component.
+		 * @param id The entity ID.
+		 * @return Pointer to the ticks, or nullptr if the entity is not in the set.
+		 */
+		virtual ComponentTicks* GetTicks(Entity id) = 0;
+
 		/**
 		 * @brief Returns a list of all entities in the sparse set.
 		 * @return A vector containing all entity IDs.
 		 */
 		virtual std::vector<Entity> GetEntityList() = 0;
+
+		/**
+		 * @brief Returns the storage backend of this pool.
+		 * @return ComponentStorage::SparseSet unless overridden.
+		 */
+		virtual ComponentStorage StorageMode() const
+		{
+			return ComponentStorage::SparseSet;
+		}
+
+		/**
+		 * @brief Returns a counter that changes whenever members are added, removed or moved in memory.
+		 *
+		 * Systems that cache component addresses or row indices across frames
+		 * rebuild their cache when it changes.
+		 * @return The current layout version.
+		 */
+		virtual uint64_t LayoutVersion() const = 0;
 	};
 
 	/**
@@ -105,28 +188,105 @@ namespace ac
 	 *
 	 * It provides fast access, insertion, and deletion operations for entities.
 	 * The SparseSet uses a dense array for storing entities and their data,
-	 * and a sparse array for mapping entity IDs to indices in the dense array.
+	 * and a sparse array for mapping entity indices to indices in the dense array.
+	 * The dense array keeps the full handle, so a handle with an outdated
+	 * generation is rejected by the same comparison that checks membership.
+	 *
+	 * Types with a SoALayout are stored field by field in SoAColumns; their
+	 * members are then handed out as SoAPtr and the layout's Ref instead of
+	 * Type* and Type&.
 	 *
 	 * @tparam Type The type of data associated with entities.
 	 */
 	template <typename Type>
 	struct SparseSet final : public ISparseSet
 	{
+	public:
+		/** Type handed out in place of Type*. */
+		using Pointer = ComponentPtr<Type>;
+
+		/** Type handed out in place of Type&. */
+		using Reference = ComponentRef<Type>;
+
 	private:
+		/** Number of entity slots per page of the sparse array. */
+		static constexpr size_t PageSize = 1024;
+
+		/** Whether the members are stored in SoA columns. */
+		static constexpr bool IsSoA = IsSoAComponent<Type>;
+
 		/** Stores the data associated with entities. */
-		std::vector<Type> objects;
+		typename ComponentLayout<Type>::Container objects;
 
 		/** Stores the list of entities in the sparse set. */
 		std::vector<Entity> dense;
 
-		/** Maps entities to their indices in the dense list. */
-		std::vector<size_t> sparse;
+		/** Change ticks of each member, parallel to dense. */
+		std::vector<ComponentTicks> ticks;
+
+		/**
+		 * Maps entities to their indices in the dense list.
+		 * Pages are allocated on first use and freed once empty; nullptr marks an empty page.
+		 */
+		std::vector<std::unique_ptr<size_t[]>> sparsePages;
+
+		/** Number of members stored in each page of sparsePages. */
+		std::vector<uint32_t> pageCounts;
 
-		/** Maximum value for entity IDs. */
-		uint32_t maxValue;
+		/** Bumped whenever rows are added, removed, reassigned to another entity or reallocated. */
+		uint64_t layoutVersion = 0;
 
 		/** Represents an invalid entity index. */
-		const size_t Tombstone = UINT64_MAX;
+		static constexpr size_t Tombstone = UINT64_MAX;
+
+		/**
+		 * @brief Finds the sparse slot of an entity without allocating.
+		 *
+		 * @param element The entity ID.
+		 * @return Pointer to the slot, or nullptr if its page is not allocated.
+		 */
+		size_t* FindSlot(Entity element) const
+		{
+			size_t page = EntityIndex(element) / PageSize;
+			if (page >= sparsePages.size() || sparsePages[page] == nullptr)
+				return nullptr;
+			return &sparsePages[page][EntityIndex(element) % PageSize];
+		}
+
+		/**
+		 * @brief Gets the sparse slot of an entity, allocating its page if needed.
+		 *
+		 * @param element The entity ID.
+		 * @return Reference to the slot.
+		 */
+		size_t& EnsureSlot(Entity element)
+		{
+			size_t page = EntityIndex(element) / PageSize;
+			if (page >= sparsePages.size())
+			{
+				sparsePages.resize(page + 1);
+				pageCounts.resize(page + 1, 0);
+			}
+			if (sparsePages[page] == nullptr)
+			{
+				sparsePages[page] = std::make_unique<size_t[]>(PageSize);
+				std::fill_n(sparsePages[page].get(), PageSize, Tombstone);
+			}
+			return sparsePages[page][EntityIndex(element) % PageSize];
+		}
+
+		/**
+		 * @brief Clears the sparse slot of an entity and frees its page once empty.
+		 *
+		 * @param element The entity ID.
+		 */
+		void ReleaseSlot(Entity element)
+		{
+			size_t page = EntityIndex(element) / PageSize;
+			sparsePages[page][EntityIndex(element) % PageSize] = Tombstone;
+			if (--pageCounts[page] == 0)
+				sparsePages[page].reset();
+		}
 
 		/**
 		 * @brief Retrieves the dense index of an entity.
@@ -134,23 +294,57 @@ namespace ac
 		 * @param element The entity ID.
 		 * @return The index in the dense array, or Tombstone if the entity is not found.
 		 */
-		size_t GetDenseID(Entity element)
+		size_t GetDenseID(Entity element) const
 		{
-			if (!Contains(element))
+			size_t* slot = FindSlot(element);
+			if (slot == nullptr || *slot >= dense.size() || dense[*slot] != element)
 				return Tombstone;
-			return sparse[element];
+			return *slot;
+		}
+
+		/**
+		 * @brief Points at the data of a dense row.
+		 */
+		Pointer RowPtr(size_t row)
+		{
+			if constexpr (IsSoA)
+				return Pointer(&objects, row);
+			else
+				return &objects[row];
+		}
+
+		/**
+		 * @brief Overwrites the data of a dense row.
+		 */
+		void AssignRow(size_t row, Type&& obj)
+		{
+			if constexpr (IsSoA)
+				objects.Assign(row, std::move(obj));
+			else
+				objects[row] = std::move(obj);
+		}
+
+		/**
+		 * @brief Moves the data of dense row src into row dst.
+		 */
+		void MoveRow(size_t dst, size_t src)
+		{
+			if constexpr (IsSoA)
+				objects.MoveRow(dst, src);
+			else
+				objects[dst] = std::move(objects[src]);
 		}
 
 	public:
 		/**
-		 * @brief Constructor to initialize the sparse set with a maximum value for entity IDs.
+		 * @brief Constructor to initialize the sparse set.
 		 *
-		 * @param maxValue The maximum value for entity IDs. Default is 1000.
+		 * @param maxValue Expected highest entity ID, used to reserve the page table. Default is 1000.
 		 */
 		SparseSet(uint32_t maxValue = 1000)
 		{
-			this->maxValue = maxValue;
-			sparse.resize(maxValue + 1, Tombstone);
+			sparsePages.reserve(maxValue / PageSize + 1);
+			pageCounts.reserve(maxValue / PageSize + 1);
 		}
 
 		/**
@@ -159,7 +353,7 @@ namespace ac
 		~SparseSet() override
 		{
 			dense.clear();
-			sparse.clear();
+			sparsePages.clear();
 			objects.clear();
 		}
 
@@ -169,35 +363,64 @@ namespace ac
 		void Clear() override
 		{
 			dense.clear();
-			sparse.clear();
-			sparse.resize(1001);
-			maxValue = 1000;
+			sparsePages.clear();
+			pageCounts.clear();
 			objects.clear();
+			ticks.clear();
+			++layoutVersion;
 		}
 
 		/**
 		 * @brief Adds or updates an entity with associated data in the sparse set.
 		 *
+		 * A new member is stamped as added and changed at tick, an existing one as changed.
+		 *
 		 * @param element The entity ID.
 		 * @param obj The data to associate with the entity.
+		 * @param tick The change tick to stamp the member with.
 		 * @return A pointer to the data associated with the entity.
 		 */
-		Type& Set(Entity element, Type&& obj)
+		Pointer Set(Entity element, Type&& obj, uint32_t tick = 0)
 		{
-			if (element > maxValue)
-				sparse.resize(10 * maxValue);
-			if (Contains(element))
+			size_t ind = GetDenseID(element);
+			if (ind != Tombstone)
+			{
+				AssignRow(ind, std::forward<Type>(obj));
+				ticks[ind].changed = tick;
+				return RowPtr(ind);
+			}
+
+			size_t& slot = EnsureSlot(element);
+			if (slot < dense.size() && EntityIndex(dense[slot]) == EntityIndex(element))
 			{
-				size_t ind = GetDenseID(element);
-				objects[ind] = obj;
-				return objects[ind];
+				// A row left behind by an older generation of the same index.
+				dense[slot] = element;
+				AssignRow(slot, std::forward<Type>(obj));
+				ticks[slot] = ComponentTicks{ tick, tick };
+				++layoutVersion;
+				return RowPtr(slot);
 			}
 
-			
+			slot = dense.size();
+			++pageCounts[EntityIndex(element) / PageSize];
 			dense.push_back(element);
 			objects.emplace_back(std::forward<Type>(obj));
-			sparse[element] = dense.size() - 1;
-			return objects.back();
+			ticks.push_back(ComponentTicks{ tick, tick });
+			++layoutVersion;
+			return RowPtr(dense.size() - 1);
+		}
+
+		/**
+		 * @brief Reserves dense storage so that inserting up to capacity members does not reallocate.
+		 *
+		 * @param capacity The total number of members to make room for.
+		 */
+		void Reserve(std::size_t capacity)
+		{
+			dense.reserve(capacity);
+			objects.reserve(capacity);
+			ticks.reserve(capacity);
+			++layoutVersion;
 		}
 
 		/**
@@ -208,7 +431,7 @@ namespace ac
 		 */
 		bool Contains(Entity element) override
 		{
-			return sparse[element] < dense.size() && dense[sparse[element]] == element;
+			return GetDenseID(element) != Tombstone;
 		}
 
 		/**
@@ -217,12 +440,36 @@ namespace ac
 		 * @param id The entity ID.
 		 * @return A pointer to the data associated with the entity, or nullptr if the entity is not found.
 		 */
-		Type* Get(Entity id)
+		Pointer Get(Entity id)
+		{
+			size_t index = GetDenseID(id);
+			if (index == Tombstone)
+				return nullptr;
+			return RowPtr(index);
+		}
+
+		/**
+		 * @brief Retrieves the data and change ticks associated with the specified entity.
+		 *
+		 * @param id The entity ID.
+		 * @param outTicks Receives a pointer to the ticks of the entity, untouched if it is not found.
+		 * @return A pointer to the data associated with the entity, or nullptr if the entity is not found.
+		 */
+		Pointer Get(Entity id, ComponentTicks*& outTicks)
+		{
+			size_t index = GetDenseID(id);
+			if (index == Tombstone)
+				return nullptr;
+			outTicks = &ticks[index];
+			return RowPtr(index);
+		}
+
+		ComponentTicks* GetTicks(Entity id) override
 		{
-			if (!Contains(id))
+			size_t index = GetDenseID(id);
+			if (index == Tombstone)
 				return nullptr;
-			std::size_t index = GetDenseID(id);
-			return &objects[index];
+			return &ticks[index];
 		}
 
 		/**
@@ -232,13 +479,13 @@ namespace ac
 		 * @return A reference to the data associated with the entity.
 		 * @throws An assertion failure if the entity is not found.
 		 */
-		Type& GetRef(Entity id)
+		Reference GetRef(Entity id)
 		{
-			if (!Contains(id))
+			size_t index = GetDenseID(id);
+			if (index == Tombstone)
 				ECS_ASSERT(false, "GetRef called on invalid entity with ID " << id);
-			std::size_t index = GetDenseID(id);
 
-			return objects[index];
+			return *RowPtr(index);
 		}
 
 		/**
@@ -248,17 +495,26 @@ namespace ac
 		 */
 		void Delete(Entity element) override
 		{
-			if (!Contains(element))
+			size_t targetInd = GetDenseID(element);
+			if (targetInd == Tombstone)
 				return;
 
 			Entity lastElement = dense.back();
-			size_t targetInd = GetDenseID(element);
 			dense[targetInd] = lastElement;
-			sparse[lastElement] = targetInd;
-			objects[targetInd] = objects.back();
+			*FindSlot(lastElement) = targetInd;
+			MoveRow(targetInd, dense.size() - 1);
+			ticks[targetInd] = ticks.back();
+			ReleaseSlot(element);
 
 			objects.pop_back();
 			dense.pop_back();
+			ticks.pop_back();
+			++layoutVersion;
+		}
+
+		uint64_t LayoutVersion() const override
+		{
+			return layoutVersion;
 		}
 
 		/**
@@ -281,6 +537,16 @@ namespace ac
 			return dense;
 		}
 
+		/**
+		 * @brief Retrieves the dense list of entities without copying.
+		 *
+		 * @return A const reference to the dense entity array.
+		 */
+		const std::vector<Entity>& Entities() const
+		{
+			return dense;
+		}
+
 		/**
 		 * @brief Checks if the sparse set is empty.
 		 *
@@ -296,11 +562,34 @@ namespace ac
 		 *
 		 * @return A const reference to the vector of data.
 		 */
-		const std::vector<Type>& Data() const
+		const std::vector<Type>& Data() const requires (!IsSoA)
+		{
+			return objects;
+		}
+
+		/**
+		 * @brief Retrieves the field columns of a SoA pool, row-aligned with Entities().
+		 *
+		 * Lets hot loops walk the fields they need as plain contiguous arrays:
+		 *   std::span<float> masses = pool.Columns().Column<&RigidBody2D::mass>();
+		 *
+		 * @return A reference to the columns.
+		 */
+		auto& Columns() requires IsSoA
 		{
 			return objects;
 		}
 
+		/**
+		 * @brief Retrieves the change ticks of the members, parallel to Entities().
+		 *
+		 * @return A reference to the vector of ticks.
+		 */
+		std::vector<ComponentTicks>& Ticks()
+		{
+			return ticks;
+		}
+
 		/**
 		 * @brief Prints the dense list of data associated with entities.
 		 */
@@ -314,6 +603,30 @@ namespace ac
 		}
 	};
 
+	/**
+	 * @brief World state a view needs for parallel iteration, matching and change detection.
+	 */
+	struct ViewContext
+	{
+		/** Component masks of all entities, used to match entities against required and excluded components. */
+		SparseSet<ComponentMask>* masks = nullptr;
+
+		/** Worker pool used by ParallelForEach. */
+		JobSystem* jobs = nullptr;
+
+		/** Number of parallel iterations in flight; structural changes are rejected while non-zero (debug only). */
+		std::atomic<uint32_t>* parallelIterations = nullptr;
+
+		/** Tick mutable components are stamped with when visited. */
+		uint32_t tick = 0;
+
+		/** Tick of the previous run of the system creating the view, used by Changed<T>() and Added<T>(). */
+		uint32_t lastRun = 0;
+
+		/** Entities of a cached query; when set, sparse-driven views walk this list and skip matching. */
+		const std::vector<Entity>* members = nullptr;
+	};
+
 	/**
 	 * @brief A type list that holds multiple component types.
 	 *
@@ -339,13 +652,95 @@ namespace ac
 		static constexpr std::size_t size = sizeof...(Types);
 	};
 
+	class ArchetypeStorage;
+	template <typename Type>
+	class ArchetypeColumn;
+	template <typename Type>
+	class ArchetypePool;
+
+	/**
+	 * @brief View filter: entities that have any of Ts are skipped.
+	 *
+	 * Usage example: world.View<Transform>(Exclude<Static>{});
+	 */
+	template <class... Ts>
+	struct Exclude {};
+
+	/**
+	 * @brief View filter: Ts are fetched when present and passed to callbacks as pointers, nullptr when absent.
+	 *
+	 * Usage example:
+	 *   world.View<AudioSource>(Optional<const Transform>{}).ForEach(
+	 *       [](Entity e, AudioSource& source, const Transform* transform) { ... });
+	 */
+	template <class... Ts>
+	struct Optional {};
+
+	/**
+	 * @brief Describes how an entry of a view's parameter pack is matched and passed to callbacks.
+	 *
+	 * @tparam T A component type, possibly const, or Optional<T>.
+	 */
+	template <class T>
+	struct ViewEntry {
+		/** The component type, possibly const. */
+		using Component = T;
+
+		/** Type handed to callbacks for this entry. */
+		using Arg = ComponentRef<T>;
+
+		/** Whether entities without the component still match. */
+		static constexpr bool optional = false;
+	};
+
+	template <class T>
+	struct ViewEntry<Optional<T>> {
+		using Component = T;
+		using Arg = ComponentPtr<T>;
+		static constexpr bool optional = true;
+	};
+
+	template <typename... Components>
+	class SimpleView;
+
+	/**
+	 * @brief Computes the view type for a list of required components and filters.
+	 *
+	 * Every Optional<Ts...> filter appends one Optional<T> entry per type, Exclude filters add none.
+	 */
+	template <class View, class... Filters>
+	struct FilteredView {
+		using type = View;
+	};
+
+	template <class... Entries, class... Ts, class... Rest>
+	struct FilteredView<SimpleView<Entries...>, Optional<Ts...>, Rest...> :
+		FilteredView<SimpleView<Entries..., Optional<Ts>...>, Rest...> {};
+
+	template <class... Entries, class... Ts, class... Rest>
+	struct FilteredView<SimpleView<Entries...>, Exclude<Ts...>, Rest...> :
+		FilteredView<SimpleView<Entries...>, Rest...> {};
+
 	/**
 	 * @brief SimpleView is a utility class for iterating over entities that have specific components.
 	 *
 	 * It provides efficient access to entities and their associated components,
 	 * allowing operations to be performed on matching entities.
 	 *
-	 * @tparam Components The types of components to include in the view.
+	 * Components requested as const (View<const Transform>) are read-only. Every
+	 * other component is stamped as changed for each entity the view visits,
+	 * which is what Changed<T>() filters of later systems see; read-only systems
+	 * should therefore ask for const components.
+	 *
+	 * When the view is created by a World, whether an entity matches is decided
+	 * by one masked compare of its ComponentMask against the required and
+	 * excluded components; the component pools are only touched for entities
+	 * that match.
+	 *
+	 * Components with a SoALayout are handed to callbacks as their layout's
+	 * Ref or ConstRef by value instead of by reference.
+	 *
+	 * @tparam Components The types of components to include in the view; Optional<T> entries may be absent.
 	 */
 	template <typename... Components>
 	class SimpleView {
@@ -353,23 +748,104 @@ namespace ac
 		/** A type list representing the component types in the view. */
 		using componentTypes = type_list<Components...>;
 
-		/** Pools for components in the view. */
+		/** Index sequence over the components of the view. */
+		using ComponentIndices = std::make_index_sequence<sizeof...(Components)>;
+
+		static_assert((!ViewEntry<Components>::optional || ...), "A view needs at least one required component");
+
+		/** Matching and argument traits of the entry at Index. */
+		template <std::size_t Index>
+		using EntryAt = ViewEntry<typename componentTypes::template get<Index>>;
+
+		/** Unqualified component type of the entry at Index. */
+		template <std::size_t Index>
+		using BaseAt = std::remove_const_t<typename EntryAt<Index>::Component>;
+
+		/** Pointers to the components of one entity, nullptr for absent optional ones. */
+		using ComponentPointers = std::tuple<ComponentPtr<typename ViewEntry<Components>::Component>...>;
+
+		/** Archetype columns of one table for every entry, nullptr where the table has none. */
+		using TableColumns = std::tuple<ArchetypeColumn<std::remove_const_t<typename ViewEntry<Components>::Component>>*...>;
+
+		/** Change ticks of the components of one entity, in view order. */
+		using TickArray = std::array<ComponentTicks*, sizeof...(Components)>;
+
+		/**
+		 * @brief Restricts iteration to entities whose component was added or changed after a tick.
+		 */
+		struct TickFilter {
+			std::size_t index;  ///< Index of the filtered component in the view
+			bool added;         ///< Compare the added tick instead of the changed tick
+			uint32_t since;     ///< Only ticks newer than this pass
+		};
+
+		/** Pools for components in the view; nullptr for optional components that were never registered. */
 		std::array<ISparseSet*, sizeof...(Components)> m_viewPools;
 
-		/** Sparse set with the smallest number of components. */
+		/** Required pool with the smallest number of components. */
 		ISparseSet* m_smallest = nullptr;
 
+		/** Dense entity array of the smallest SparseSet-backed required pool, walked in place during iteration. */
+		const std::vector<Entity>* m_driver = nullptr;
+
+		/** Change ticks of the driving pool, parallel to m_driver. */
+		const std::vector<ComponentTicks>* m_driverTicks = nullptr;
+
+		/** Index in the view of the driving pool. */
+		std::size_t m_driverIndex = 0;
+
+		/** Whether each pool in the view is backed by archetype storage. */
+		std::array<bool, sizeof...(Components)> m_isArchetype{};
+
+		/** True when every required component of the view lives in archetype storage. */
+		bool m_allArchetype = false;
+
+		/** Bitmask indices of the archetype-backed components. */
+		std::array<std::size_t, sizeof...(Components)> m_componentIDs{};
+
+		/** Components an archetype table must have to match, only filled when m_allArchetype is set. */
+		ComponentMask m_required;
+
+		/** Components an entity must have, as bits of its ComponentMask. */
+		ComponentMask m_maskRequired;
+
+		/** Components an entity must not have, as bits of its ComponentMask. */
+		ComponentMask m_maskExcluded;
+
+		/** True when entities have to be matched against their ComponentMask. */
+		bool m_checkMask = false;
+
+		/** Active Changed/Added filters, at most one per component. */
+		std::array<TickFilter, sizeof...(Components)> m_filters{};
+
+		/** Number of entries of m_filters in use. */
+		std::size_t m_filterCount = 0;
+
+		/** World state used by ParallelForEach, matching and change detection. */
+		ViewContext m_context;
+
 		/**
-		 * @brief Checks if all pools in the view contain the specified entity.
-		 *
-		 * @param id The entity ID.
-		 * @return True if all pools contain the entity, false otherwise.
+		 * @brief Returns the index of the first required entry.
 		 */
-		bool AllContain(Entity id) {
-			return std::all_of(m_viewPools.begin(), m_viewPools.end(), [id](ISparseSet* pool)
-				{
-					return pool->Contains(id);
-				});
+		static constexpr std::size_t FirstRequired() {
+			constexpr bool optional[] = { ViewEntry<Components>::optional... };
+			std::size_t i = 0;
+			while (optional[i])
+				++i;
+			return i;
+		}
+
+		/**
+		 * @brief Returns the index of a component type in the view, or the component count if absent.
+		 */
+		template <class T>
+		static constexpr std::size_t IndexOf() {
+			constexpr bool matches[] = {
+				std::is_same_v<std::remove_const_t<typename ViewEntry<Components>::Component>, std::remove_const_t<T>>... };
+			for (std::size_t i = 0; i < sizeof...(Components); ++i)
+				if (matches[i])
+					return i;
+			return sizeof...(Components);
 		}
 
 		/**
@@ -380,73 +856,496 @@ namespace ac
 		 */
 		template <std::size_t Index>
 		auto GetPoolAt() {
-			using componentType = typename componentTypes::template get<Index>;
-			return static_cast<SparseSet<componentType>*>(m_viewPools[Index]);
+			return static_cast<SparseSet<BaseAt<Index>>*>(m_viewPools[Index]);
+		}
+
+		/**
+		 * @brief Retrieves a specific archetype-backed pool by index.
+		 *
+		 * @tparam Index The index of the component pool.
+		 * @return A pointer to the archetype pool adapter.
+		 */
+		template <std::size_t Index>
+		auto GetArchetypePoolAt() {
+			return static_cast<ArchetypePool<BaseAt<Index>>*>(m_viewPools[Index]);
+		}
+
+		/**
+		 * @brief Returns the archetype storage, only valid when m_allArchetype is set.
+		 */
+		auto Storage() {
+			return GetArchetypePoolAt<FirstRequired()>()->Storage();
 		}
 
 		/**
-		 * @brief Creates a tuple of components for the specified entity.
+		 * @brief Looks up a component of an entity in the pool at Index through its typed interface.
 		 *
+		 * @tparam Index The index of the component pool.
 		 * @param id The entity ID.
-		 * @param indices The indices of the components.
-		 * @return A tuple containing references to the components.
+		 * @param ticks Receives a pointer to the change ticks of the component.
+		 * @return A pointer to the component, or nullptr if the entity does not have it.
+		 */
+		template <std::size_t Index>
+		ComponentPtr<BaseAt<Index>> TryGetAt(Entity id, ComponentTicks*& ticks) {
+			ticks = nullptr;
+			if constexpr (EntryAt<Index>::optional)
+				if (m_viewPools[Index] == nullptr)
+					return nullptr;
+			if constexpr (!IsSoAComponent<BaseAt<Index>>)
+				if (m_isArchetype[Index])
+					return GetArchetypePoolAt<Index>()->Get(id, ticks);
+			return GetPoolAt<Index>()->Get(id, ticks);
+		}
+
+		/**
+		 * @brief Looks up every component of an entity, stopping at the first missing required one.
+		 *
+		 * @param id The entity ID.
+		 * @param out Receives a pointer to each component.
+		 * @param ticks Receives a pointer to the change ticks of each component.
+		 * @return True if the entity has all required components of the view.
 		 */
 		template <std::size_t... Indices>
-		auto MakeComponentTuple(Entity id, std::index_sequence<Indices...>) {
-			return std::make_tuple((std::ref(GetPoolAt<Indices>()->GetRef(id)))...);
+		bool FetchComponents(Entity id, ComponentPointers& out, TickArray& ticks, std::index_sequence<Indices...>) {
+			return (((std::get<Indices>(out) = TryGetAt<Indices>(id, ticks[Indices])) != nullptr || EntryAt<Indices>::optional) && ...);
 		}
 
 		/**
-		 * @brief Internal implementation for iterating over entities in the view.
+		 * @brief Picks the smallest SparseSet-backed required pool to drive iteration.
+		 */
+		template <std::size_t... Indices>
+		void FindDriver(std::index_sequence<Indices...>) {
+			((!EntryAt<Indices>::optional && !m_isArchetype[Indices] &&
+				(m_driver == nullptr || GetPoolAt<Indices>()->Size() < m_driver->size()) ?
+				void((m_driver = &GetPoolAt<Indices>()->Entities(), m_driverTicks = &GetPoolAt<Indices>()->Ticks(), m_driverIndex = Indices)) :
+				void()), ...);
+		}
+
+		/**
+		 * @brief Collects the bitmask indices of the archetype-backed pools and the components tables must have.
+		 */
+		template <std::size_t... Indices>
+		void InitArchetype(std::index_sequence<Indices...>) {
+			((m_isArchetype[Indices] ? void(m_componentIDs[Indices] = GetArchetypePoolAt<Indices>()->ComponentID()) : void()), ...);
+			if (m_allArchetype)
+				((!EntryAt<Indices>::optional ? void(m_required.set(m_componentIDs[Indices], true)) : void()), ...);
+		}
+
+		/**
+		 * @brief Checks whether some excluded component is not stored in archetype tables, so tables cannot rule it out.
+		 */
+		bool ExcludesOutsideTables() {
+			for (std::size_t i = 0; i < MAX_COMPONENTS; ++i)
+				if (m_maskExcluded[i] && !Storage()->IsArchetypeComponent(i))
+					return true;
+			return false;
+		}
+
+		/**
+		 * @brief Checks an entity's ComponentMask against the required and excluded components.
+		 */
+		bool MatchesMask(Entity id) const {
+			const ComponentMask* mask = m_context.masks->Get(id);
+			return mask != nullptr && (*mask & m_maskRequired) == m_maskRequired && (*mask & m_maskExcluded).none();
+		}
+
+		/**
+		 * @brief Checks whether an archetype table can hold matching entities.
+		 */
+		template <class Table>
+		bool MatchesTable(const Table& archetype) const {
+			return (archetype.mask & m_required) == m_required && (archetype.mask & m_maskExcluded).none();
+		}
+
+		/**
+		 * @brief Registers a Changed/Added filter, replacing an earlier one on the same component.
+		 */
+		template <class T>
+		void AddFilter(bool added, uint32_t sinceTick) {
+			constexpr std::size_t index = IndexOf<T>();
+			static_assert(index < sizeof...(Components), "Changed<T>() and Added<T>() need T to be a component of the view");
+			std::size_t slot = 0;
+			while (slot < m_filterCount && m_filters[slot].index != index)
+				++slot;
+			m_filters[slot] = TickFilter{ index, added, sinceTick };
+			m_filterCount = std::max(m_filterCount, slot + 1);
+		}
+
+		/**
+		 * @brief Checks one filter against the ticks of its component.
+		 */
+		static bool Passes(const TickFilter& filter, const ComponentTicks& ticks) {
+			return IsNewerTick(filter.added ? ticks.added : ticks.changed, filter.since);
+		}
+
+		/**
+		 * @brief Checks the filters on the driving pool against its dense row i, before any lookup.
+		 */
+		bool DriverPasses(std::size_t i) const {
+			for (std::size_t f = 0; f < m_filterCount; ++f)
+				if (m_filters[f].index == m_driverIndex && !Passes(m_filters[f], (*m_driverTicks)[i]))
+					return false;
+			return true;
+		}
+
+		/**
+		 * @brief Checks every filter against the ticks of an entity's components; absent components fail.
+		 */
+		bool PassesFilters(const TickArray& ticks) const {
+			for (std::size_t f = 0; f < m_filterCount; ++f)
+			{
+				const ComponentTicks* t = ticks[m_filters[f].index];
+				if (t == nullptr || !Passes(m_filters[f], *t))
+					return false;
+			}
+			return true;
+		}
+
+		/**
+		 * @brief Stamps the present mutable components of an entity as changed at the view's tick.
+		 */
+		template <std::size_t... Indices>
+		void MarkChanged(const TickArray& ticks, std::index_sequence<Indices...>) const {
+			((std::is_const_v<typename EntryAt<Indices>::Component> || ticks[Indices] == nullptr ?
+				void() : void(ticks[Indices]->changed = m_context.tick)), ...);
+		}
+
+		/**
+		 * @brief Matches the entity at dense row i of the driving pool and fetches its components.
+		 *
+		 * @return True if the entity matches the view and passes its filters.
+		 */
+		bool FetchSparse(std::size_t i, ComponentPointers& out, TickArray& ticks) {
+			if (!DriverPasses(i))
+				return false;
+			Entity id = (*m_driver)[i];
+			if (m_checkMask && !MatchesMask(id))
+				return false;
+			return FetchComponents(id, out, ticks, ComponentIndices{}) && PassesFilters(ticks);
+		}
+
+		/**
+		 * @brief Gets the columns of a table for every archetype-backed entry of the view.
+		 */
+		template <class Table, std::size_t... Indices>
+		TableColumns GetColumns(Table& archetype, std::index_sequence<Indices...>) {
+			return TableColumns(m_isArchetype[Indices] ?
+				archetype.template Column<BaseAt<Indices>>(m_componentIDs[Indices]) : nullptr...);
+		}
+
+		/**
+		 * @brief Fetches the component at Index for a row of a matching archetype table.
+		 *
+		 * Components of the table come straight from its columns; optional
+		 * components stored elsewhere are looked up by entity.
+		 */
+		template <std::size_t Index>
+		void FetchRowAt(const TableColumns& columns, Entity id, std::size_t row, ComponentPointers& out, TickArray& ticks) {
+			auto column = std::get<Index>(columns);
+			if constexpr (!IsSoAComponent<BaseAt<Index>>) {
+				if (column != nullptr) {
+					std::get<Index>(out) = &column->data[row];
+					ticks[Index] = &column->ticks[row];
+					return;
+				}
+			}
+			if (m_isArchetype[Index]) {
+				std::get<Index>(out) = nullptr;
+				ticks[Index] = nullptr;
+			}
+			else
+				std::get<Index>(out) = TryGetAt<Index>(id, ticks[Index]);
+		}
+
+		/**
+		 * @brief Fetches the components of a row of a matching archetype table.
+		 *
+		 * @return True if the row matches the view and passes its filters.
+		 */
+		template <class Table, std::size_t... Indices>
+		bool FetchRow(Table& archetype, const TableColumns& columns, std::size_t row,
+			ComponentPointers& out, TickArray& ticks, std::index_sequence<Indices...>) {
+			Entity id = archetype.entities[row];
+			if (m_checkMask && !MatchesMask(id))
+				return false;
+			(FetchRowAt<Indices>(columns, id, row, out, ticks), ...);
+			return PassesFilters(ticks);
+		}
+
+		/**
+		 * @brief Turns a fetched pointer into the argument type of its entry.
+		 */
+		template <std::size_t Index>
+		static typename EntryAt<Index>::Arg ToArg(ComponentPtr<typename EntryAt<Index>::Component> component) {
+			if constexpr (EntryAt<Index>::optional)
+				return component;
+			else
+				return *component;
+		}
+
+		/**
+		 * @brief Calls func with or without the entity ID depending on its signature.
+		 *
+		 * @param func The function to execute.
+		 * @param id The entity ID.
+		 * @param components The components of the entity.
+		 */
+		template <typename Func>
+		static void InvokeFunc(Func& func, Entity id, typename ViewEntry<Components>::Arg... components) {
+			if constexpr (std::is_invocable_v<Func&, Entity, typename ViewEntry<Components>::Arg...>)
+			{
+				func(id, components...);
+			}
+			else if constexpr (std::is_invocable_v<Func&, typename ViewEntry<Components>::Arg...>) {
+				func(components...);
+			}
+			else {
+				static_assert(std::is_invocable_v<Func&, typename ViewEntry<Components>::Arg...>,
+					"Bad lambda provided to .ForEach(), parameter pack does not match lambda args");
+			}
+		}
+
+		/**
+		 * @brief Stamps and invokes func for an entity whose components have been fetched.
+		 */
+		template <typename Func, std::size_t... Indices>
+		void Visit(Func& func, Entity id, const ComponentPointers& components, const TickArray& ticks, std::index_sequence<Indices...> inds) {
+			MarkChanged(ticks, inds);
+			InvokeFunc(func, id, ToArg<Indices>(std::get<Indices>(components))...);
+		}
+
+		/**
+		 * @brief Visits rows [begin, end) of a matching archetype table.
+		 */
+		template <typename Func, class Table>
+		void VisitArchetypeRows(Func& func, Table& archetype, std::size_t begin, std::size_t end) {
+			TableColumns columns = GetColumns(archetype, ComponentIndices{});
+			ComponentPointers components;
+			TickArray ticks;
+			for (std::size_t row = begin; row < end; ++row)
+				if (FetchRow(archetype, columns, row, components, ticks, ComponentIndices{}))
+					Visit(func, archetype.entities[row], components, ticks, ComponentIndices{});
+		}
+
+		/**
+		 * @brief Walks the dense array of the driving pool in place and looks up the other components.
+		 *
+		 * Removing the current entity inside func is safe: the entity swapped into
+		 * its slot is visited next.
 		 *
-		 * @tparam Func The type of the function to execute.
 		 * @param func The function to execute for each entity.
 		 */
 		template <typename Func>
-		void ForEachImpl(Func func) {
-			auto inds = std::make_index_sequence<sizeof...(Components)>{};
-
-			for (Entity id : m_smallest->GetEntityList()) {
-				if (AllContain(id)) {
-					if constexpr (std::is_invocable_v<Func, Entity, Components&...>)
-					{
-						std::apply(func, std::tuple_cat(std::make_tuple(id), MakeComponentTuple(id, inds)));
-					}
-					else if constexpr (std::is_invocable_v<Func, Components&...>) {
-						std::apply(func, MakeComponentTuple(id, inds));
-					}
-					else {
-						ECS_ASSERT(false,
-							"Bad lambda provided to .ForEach(), parameter pack does not match lambda args");
-					}
-				}
+		void ForEachSparse(Func& func) {
+			const std::vector<Entity>& entities = *m_driver;
+			ComponentPointers components;
+			TickArray ticks;
+			for (std::size_t i = 0; i < entities.size();) {
+				Entity id = entities[i];
+				if (FetchSparse(i, components, ticks))
+					Visit(func, id, components, ticks, ComponentIndices{});
+				if (i < entities.size() && entities[i] != id)
+					continue;
+				++i;
 			}
 		}
 
-	public:
-		/** Function signature for iterating components. */
-		using ForEachFunc = std::function<void(Components&...)>;
+		/**
+		 * @brief Walks every matching archetype table row by row.
+		 *
+		 * No membership checks are needed since every row of a matching table
+		 * has all required components. Adding or removing archetype components
+		 * inside func moves rows between tables and is not allowed.
+		 *
+		 * @param func The function to execute for each entity.
+		 */
+		template <typename Func>
+		void ForEachArchetype(Func& func) {
+			Storage()->ForEachMatching(m_required, [&](auto& archetype)
+				{
+					if (MatchesTable(archetype))
+						VisitArchetypeRows(func, archetype, 0, archetype.entities.size());
+				});
+		}
+
+		/**
+		 * @brief Splits the dense array of the driving pool into chunks run on the worker pool.
+		 *
+		 * @param func The function to execute for each entity.
+		 * @param grainSize Number of entities per chunk.
+		 */
+		template <typename Func>
+		void ParallelForEachSparse(Func& func, std::size_t grainSize) {
+			m_context.jobs->ParallelFor(m_driver->size(), grainSize, [&](std::size_t begin, std::size_t end)
+				{
+					ComponentPointers components;
+					TickArray ticks;
+					for (std::size_t i = begin; i < end; ++i)
+						if (FetchSparse(i, components, ticks))
+							Visit(func, (*m_driver)[i], components, ticks, ComponentIndices{});
+				});
+		}
+
+		/**
+		 * @brief Splits the rows of every matching archetype table into chunks run on the worker pool.
+		 *
+		 * @param func The function to execute for each entity.
+		 * @param grainSize Number of entities per chunk.
+		 */
+		template <typename Func>
+		void ParallelForEachArchetype(Func& func, std::size_t grainSize) {
+			JobSystem* jobs = m_context.jobs;
+			Storage()->ForEachMatching(m_required, [&](auto& archetype)
+				{
+					if (!MatchesTable(archetype))
+						return;
+					jobs->ParallelFor(archetype.entities.size(), grainSize, [&](std::size_t begin, std::size_t end)
+						{
+							VisitArchetypeRows(func, archetype, begin, end);
+						});
+				});
+		}
 
-		/** Function signature for iterating components with entity ID. */
-		using ForEachFuncWithID = std::function<void(Entity, Components&...)>;
+		/**
+		 * @brief Internal implementation for iterating over entities in the view.
+		 *
+		 * @tparam Func The type of the function to execute.
+		 * @param func The function to execute for each entity.
+		 */
+		template <typename Func>
+		void ForEachImpl(Func& func) {
+			if (m_allArchetype)
+				ForEachArchetype(func);
+			else
+				ForEachSparse(func);
+		}
 
+	public:
 		/**
 		 * @brief Constructor to initialize the view with component pools.
 		 *
+		 * Without a ComponentMask pool in the context, entities are matched by
+		 * looking them up in every required pool and excluded components are ignored.
+		 *
 		 * @param pools An array of sparse sets representing the component pools.
+		 * @param context World state used for parallel iteration, matching and change detection.
+		 * @param required Bits of the required components in the entities' ComponentMask.
+		 * @param excluded Bits of the excluded components in the entities' ComponentMask.
 		 */
-		SimpleView(std::array<ISparseSet*, sizeof...(Components)> pools) :
-			m_viewPools{ pools }
+		SimpleView(std::array<ISparseSet*, sizeof...(Components)> pools, ViewContext context = {},
+			const ComponentMask& required = {}, const ComponentMask& excluded = {}) :
+			m_viewPools{ pools }, m_maskRequired(required), m_maskExcluded(excluded), m_context(context)
 		{
 			ECS_ASSERT(componentTypes::size == m_viewPools.size(), "Component type list and pool array size mismatch");
 
-			auto smallestPool = std::min_element(m_viewPools.begin(), m_viewPools.end(),
-				[](ISparseSet* a, ISparseSet* b) { return a->Size() < b->Size(); }
-			);
+			constexpr std::array<bool, sizeof...(Components)> optional = { ViewEntry<Components>::optional... };
+			m_allArchetype = true;
+			for (std::size_t i = 0; i < m_viewPools.size(); ++i)
+			{
+				if (m_viewPools[i] == nullptr)
+				{
+					ECS_ASSERT(optional[i], "Initializing view with a missing pool");
+					continue;
+				}
+				m_isArchetype[i] = m_viewPools[i]->StorageMode() == ComponentStorage::Archetype;
+				if (optional[i])
+					continue;
+				m_allArchetype &= m_isArchetype[i];
+				if (m_smallest == nullptr || m_viewPools[i]->Size() < m_smallest->Size())
+					m_smallest = m_viewPools[i];
+			}
+			ECS_ASSERT(m_smallest != nullptr, "Initializing invalid/empty view");
+
+			InitArchetype(ComponentIndices{});
+			if (!m_allArchetype && m_context.members != nullptr)
+			{
+				// Query members are known to match, no entry of the view drives the tick filters
+				m_driver = m_context.members;
+				m_driverIndex = sizeof...(Components);
+			}
+			else if (!m_allArchetype)
+				FindDriver(ComponentIndices{});
+
+			// Archetype tables already guarantee the required components and rule out excluded
+			// archetype components; sparse-driven views need the mask once an entity can miss a
+			// required component or carry an excluded one.
+			std::size_t requiredCount = std::count(optional.begin(), optional.end(), false);
+			if (m_context.masks != nullptr)
+				m_checkMask = m_allArchetype ? ExcludesOutsideTables() :
+					m_context.members == nullptr && (requiredCount > 1 || m_maskExcluded.any());
+		}
+
+		/**
+		 * @brief Only visits entities whose component T changed since the calling system last ran.
+		 *
+		 * Outside of a system every entity with T passes. Chain before iterating:
+		 *   world.View<const Transform, Sprite>().Changed<Transform>().ForEach(...);
+		 *
+		 * @tparam T A component of the view.
+		 */
+		template <class T>
+		SimpleView& Changed() & {
+			AddFilter<T>(false, m_context.lastRun);
+			return *this;
+		}
+
+		template <class T>
+		SimpleView Changed() && {
+			AddFilter<T>(false, m_context.lastRun);
+			return std::move(*this);
+		}
+
+		/**
+		 * @brief Only visits entities whose component T changed after the given tick.
+		 *
+		 * @tparam T A component of the view.
+		 * @param sinceTick A tick returned by World::GetChangeTick().
+		 */
+		template <class T>
+		SimpleView& Changed(uint32_t sinceTick) & {
+			AddFilter<T>(false, sinceTick);
+			return *this;
+		}
+
+		template <class T>
+		SimpleView Changed(uint32_t sinceTick) && {
+			AddFilter<T>(false, sinceTick);
+			return std::move(*this);
+		}
+
+		/**
+		 * @brief Only visits entities that received component T since the calling system last ran.
+		 *
+		 * @tparam T A component of the view.
+		 */
+		template <class T>
+		SimpleView& Added() & {
+			AddFilter<T>(true, m_context.lastRun);
+			return *this;
+		}
+
+		template <class T>
+		SimpleView Added() && {
+			AddFilter<T>(true, m_context.lastRun);
+			return std::move(*this);
+		}
 
-			ECS_ASSERT(smallestPool != m_viewPools.end(), "Initializing invalid/empty view");
+		/**
+		 * @brief Only visits entities that received component T after the given tick.
+		 *
+		 * @tparam T A component of the view.
+		 * @param sinceTick A tick returned by World::GetChangeTick().
+		 */
+		template <class T>
+		SimpleView& Added(uint32_t sinceTick) & {
+			AddFilter<T>(true, sinceTick);
+			return *this;
+		}
 
-			m_smallest = *smallestPool;
+		template <class T>
+		SimpleView Added(uint32_t sinceTick) && {
+			AddFilter<T>(true, sinceTick);
+			return std::move(*this);
 		}
 
 		/**
@@ -454,12 +1353,124 @@ namespace ac
 		 *
 		 * Access components that are part of a pack like such:
 		 * - auto [componentA, componentB] = pack.components;
+		 *
+		 * Optional components are held as pointers.
 		 */
 		struct Pack {
 			Entity id;
-			std::tuple<Components&...> components;
+			std::tuple<typename ViewEntry<Components>::Arg...> components;
+		};
+
+		/**
+		 * @brief Forward iterator over the matching entities of a view.
+		 *
+		 * Dereferencing yields a tuple of the entity ID and references to its components:
+		 *   for (auto [id, transform, sprite] : world.View<Transform, Sprite>()) { ... }
+		 */
+		class Iterator {
+		public:
+			using value_type = std::tuple<Entity, typename ViewEntry<Components>::Arg...>;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+
+			/** Position value of the end iterator. */
+			static constexpr std::size_t End = SIZE_MAX;
+
+			Iterator(SimpleView* view, std::size_t table, std::size_t row) :
+				m_view(view), m_table(table), m_row(row)
+			{
+				Settle();
+			}
+
+			value_type operator*() const {
+				return Dereference(ComponentIndices{});
+			}
+
+			Iterator& operator++() {
+				++m_row;
+				Settle();
+				return *this;
+			}
+
+			bool operator==(const Iterator& other) const {
+				return m_table == other.m_table && m_row == other.m_row;
+			}
+
+			bool operator!=(const Iterator& other) const {
+				return !(*this == other);
+			}
+
+		private:
+			SimpleView* m_view;
+			std::size_t m_table;  ///< Archetype table index, 0 when driven by a SparseSet
+			std::size_t m_row;    ///< Row in the table, or index in the driving dense array
+			Entity m_id = NULL_ENTITY;
+			ComponentPointers m_components;
+
+			template <std::size_t... Indices>
+			value_type Dereference(std::index_sequence<Indices...>) const {
+				return value_type(m_id, ToArg<Indices>(std::get<Indices>(m_components))...);
+			}
+
+			/**
+			 * @brief Advances to the first matching entity at or after the current position.
+			 */
+			void Settle() {
+				if (m_table == End)
+					return;
+				if (m_view->m_allArchetype)
+					SettleArchetype();
+				else
+					SettleSparse();
+			}
+
+			void SettleSparse() {
+				const std::vector<Entity>& entities = *m_view->m_driver;
+				TickArray ticks;
+				for (; m_row < entities.size(); ++m_row) {
+					if (m_view->FetchSparse(m_row, m_components, ticks)) {
+						m_view->MarkChanged(ticks, ComponentIndices{});
+						m_id = entities[m_row];
+						return;
+					}
+				}
+				m_table = m_row = End;
+			}
+
+			void SettleArchetype() {
+				auto storage = m_view->Storage();
+				TickArray ticks;
+				for (; m_table < storage->ArchetypeCount(); ++m_table, m_row = 0) {
+					auto& archetype = storage->GetArchetype(m_table);
+					if (!m_view->MatchesTable(archetype))
+						continue;
+					TableColumns columns = m_view->GetColumns(archetype, ComponentIndices{});
+					for (; m_row < archetype.Size(); ++m_row) {
+						if (m_view->FetchRow(archetype, columns, m_row, m_components, ticks, ComponentIndices{})) {
+							m_view->MarkChanged(ticks, ComponentIndices{});
+							m_id = archetype.entities[m_row];
+							return;
+						}
+					}
+				}
+				m_table = m_row = End;
+			}
 		};
 
+		/**
+		 * @brief Returns an iterator to the first matching entity.
+		 */
+		Iterator begin() {
+			return Iterator(this, 0, 0);
+		}
+
+		/**
+		 * @brief Returns the end iterator.
+		 */
+		Iterator end() {
+			return Iterator(this, Iterator::End, Iterator::End);
+		}
+
 		/**
 		 * @brief Returns a vector of packs for all matching entities.
 		 *
@@ -470,34 +1481,60 @@ namespace ac
 		 *     auto [a1, b1] = packed[i].components;
 		 *   }
 		 *
+		 * Allocates the result; prefer ForEach or range-for when indices are not needed.
+		 *
 		 * @return A vector of Pack objects.
 		 */
 		std::vector<Pack> GetPacked() {
-			auto inds = std::make_index_sequence<sizeof...(Components)>{};
 			std::vector<Pack> result;
-
-			for (Entity id : m_smallest->GetEntityList())
-				if (AllContain(id))
-					result.push_back({ id, MakeComponentTuple(id, inds) });
+			result.reserve(m_smallest->Size());
+			ForEach([&result](Entity id, typename ViewEntry<Components>::Arg... components)
+				{
+					result.push_back({ id, std::tuple<typename ViewEntry<Components>::Arg...>(components...) });
+				});
 			return result;
 		}
 
 		/**
-		 * @brief Executes a lambda on all entities matching the parameter pack.
+		 * @brief Executes a callable on all entities matching the parameter pack.
 		 *
-		 * @param func The lambda function to execute, includes Entity ID.
+		 * The callable takes either (Entity, Components&...) or (Components&...),
+		 * with a pointer in place of the reference for Optional components.
+		 * It is invoked directly without type erasure and nothing is allocated.
+		 *
+		 * @param func The callable to execute for every matching entity.
 		 */
-		void ForEach(ForEachFuncWithID func) {
+		template <typename Func>
+		void ForEach(Func&& func) {
 			ForEachImpl(func);
 		}
 
 		/**
-		 * @brief Executes a lambda on all entities matching the parameter pack without entity ID.
+		 * @brief Executes a callable on all matching entities, split into chunks run on the worker pool.
 		 *
-		 * @param func The lambda function to execute, components only.
+		 * The callable has the same signature as for ForEach and is called
+		 * concurrently for different entities, so it must only touch the components
+		 * it receives (or other thread-safe state). Creating or deleting entities
+		 * and adding or removing components is not allowed and is asserted in debug builds.
+		 *
+		 * @param func The callable to execute for every matching entity.
+		 * @param grainSize Number of entities handed to a worker at a time.
 		 */
-		void ForEach(ForEachFunc func) {
-			ForEachImpl(func);
+		template <typename Func>
+		void ParallelForEach(Func&& func, std::size_t grainSize = 256) {
+			ECS_ASSERT(m_context.jobs != nullptr, "ParallelForEach called on a view without a World job system");
+#ifdef _DEBUG
+			if (m_context.parallelIterations != nullptr)
+				m_context.parallelIterations->fetch_add(1);
+#endif
+			if (m_allArchetype)
+				ParallelForEachArchetype(func, grainSize);
+			else
+				ParallelForEachSparse(func, grainSize);
+#ifdef _DEBUG
+			if (m_context.parallelIterations != nullptr)
+				m_context.parallelIterations->fetch_sub(1);
+#endif
 		}
 	};
 }
@@ -1,28 +1,17 @@
-
 #ifndef DEBUG_H
 #define DEBUG_H
 
-#define SHOW_MESSAGE
-#define SHOW_WARNING
-#define SHOW_ERROR
+#include "Log/Log.h"
 
-#ifdef SHOW_MESSAGE
-	#define ACMSG(str) std::cout<< "[AC msg]: " << str << std::endl
-#else
-	#define ACDEBUG(str)
-#endif
+/*
+ * Engine-wide message macros, routed through the asynchronous Logger.
+ * Which of them survive compilation is controlled by AC_LOG_LEVEL (see Log/Log.h).
+ */
+#define ACMSG(str) AC_LOG_INFO(::ac::LogCategory::General, str)
 
-#ifdef SHOW_WARNING
-	#define ACWARN(str) std::cout<< "[AC Warning]: " << str << std::endl
-#else
-	#define ACWARN(str)
-#endif
+#define ACWARN(str) AC_LOG_WARNING(::ac::LogCategory::General, str)
 
-#ifdef SHOW_ERROR
-#define ACERR(str) std::cout<< "[AC ERROR!!!]: " << str << std::endl; abort()
-#else
-	#define ACERR(str) abort();
-#endif
+#define ACERR(str) AC_LOG_FATAL(::ac::LogCategory::General, str)
 
 #define ACASSERT(expr, msg)  \
 		if (!(expr)) { \
@@ -73,7 +73,7 @@ namespace ac
             AudioID id = audioManager.GetAudioID(name);
             if (id == INVALID_AUDIO_ID)
             {
-                ACMSG("WARNING: Audio clip '" << name << "' not registered.");
+                AC_LOG_WARNING(LogCategory::Audio, "Audio clip '" << name << "' not registered.");
                 return AudioSource();
             }
             return AudioSource(id, looping, vol, audioType, autoPlay);
@@ -0,0 +1,78 @@
+#include "acpch.h"
+#include "Hierarchy.h"
+#include "Math/Transform.h"
+#include "Debug.h"
+namespace ac
+{
+	/**
+	 * @brief Removes a child from the Children of its current parent, if the parent still exists.
+	 */
+	static void DetachFromParent(World& world, Entity child)
+	{
+		const Parent* parent = world.GetPtr<const Parent>(child);
+		if (parent == nullptr || !world.IsAlive(parent->entity))
+			return;
+		Children* children = world.GetPtr<Children>(parent->entity);
+		if (children != nullptr)
+			std::erase(children->entities, child);
+	}
+
+	/**
+	 * @brief Marks the Transform of an entity as changed so its WorldTransform is recomputed.
+	 */
+	static void MarkTransformChanged(World& world, Entity entity)
+	{
+		world.GetPtr<Transform>(entity);
+	}
+
+	bool IsDescendant(World& world, Entity entity, Entity ancestor)
+	{
+		for (const Parent* parent = world.GetPtr<const Parent>(entity); parent != nullptr; parent = world.GetPtr<const Parent>(parent->entity))
+			if (parent->entity == ancestor)
+				return true;
+		return false;
+	}
+
+	void SetParent(World& world, Entity child, Entity parent)
+	{
+		ACASSERT(parent != child && !IsDescendant(world, parent, child),
+			"SetParent would create a cycle: " << parent << " is " << child << " or one of its descendants");
+
+		DetachFromParent(world, child);
+		if (world.Has<Parent>(child))
+			world.Get<Parent>(child).entity = parent;
+		else
+			world.Add<Parent>(child, Parent{ parent });
+
+		if (!world.Has<Children>(parent))
+			world.Add<Children>(parent, Children{});
+		std::vector<Entity>& siblings = world.Get<Children>(parent).entities;
+		std::erase_if(siblings, [&world](Entity sibling) { return !world.IsAlive(sibling); });
+		siblings.push_back(child);
+	}
+
+	void RemoveParent(World& world, Entity child)
+	{
+		if (!world.Has<Parent>(child))
+			return;
+		DetachFromParent(world, child);
+		world.Delete<Parent>(child);
+		MarkTransformChanged(world, child);
+	}
+
+	void DeleteHierarchy(World& world, Entity root)
+	{
+		RemoveParent(world, root);
+		std::vector<Entity> entities{ root };
+		for (size_t i = 0; i < entities.size(); ++i)
+		{
+			const Children* children = world.GetPtr<const Children>(entities[i]);
+			if (children == nullptr)
+				continue;
+			for (Entity child : children->entities)
+				if (world.IsAlive(child))
+					entities.push_back(child);
+		}
+		world.DeleteEntities(entities);
+	}
+}
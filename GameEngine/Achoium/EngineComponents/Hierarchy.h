@@ -0,0 +1,104 @@
+#pragma once
+#include <vector>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "Core/World.hpp"
+namespace ac
+{
+	/**
+	 * @brief Makes an entity's Transform relative to another entity.
+	 *
+	 * Use SetParent and RemoveParent instead of adding or deleting this
+	 * component directly so the parent's Children stay in sync.
+	 */
+	struct Parent
+	{
+		Entity entity = NULL_ENTITY; ///< The parent entity
+	};
+
+	/**
+	 * @brief The entities whose Parent is this entity, maintained by SetParent and RemoveParent.
+	 *
+	 * May hold handles of children that were deleted since; they are skipped.
+	 */
+	struct Children
+	{
+		std::vector<Entity> entities; ///< The child entities
+	};
+
+	/**
+	 * @brief World-space matrix of an entity, computed from its Transform and its parents' by TransformPropagationSystem.
+	 *
+	 * Every entity with a Transform gets one. It lags behind Transform changes
+	 * made after the propagation system ran in the current frame, so systems
+	 * that read it should run after it. Read it as const: mutable access marks
+	 * it as changed.
+	 */
+	struct WorldTransform
+	{
+		glm::mat4 matrix{ 1.0f }; ///< Maps the entity's local space to world space
+
+		/**
+		 * @brief Gets the world-space position of the entity.
+		 */
+		glm::vec3 Position() const
+		{
+			return glm::vec3(matrix[3]);
+		}
+	};
+
+	/**
+	 * @brief The Transform an entity had before the last fixed step, so it can be drawn between steps.
+	 *
+	 * PhysicsSystem::SaveInterpolationState gives every rigid body one and
+	 * records it before each fixed step; other entities moved by fixed-update
+	 * systems can be given one too. InterpolateTransformsSystem then blends it
+	 * with the current Transform by Time::InterpolationAlpha into the
+	 * WorldTransform. Only entities outside any hierarchy are blended.
+	 */
+	struct InterpolatedTransform
+	{
+		glm::vec3 previousPosition{ 0.0f };             ///< Position before the last fixed step
+		glm::quat previousRotation{ 1.0f, 0.0f, 0.0f, 0.0f }; ///< Rotation before the last fixed step
+		glm::vec3 previousScale{ 1.0f };                ///< Scale before the last fixed step
+		bool saved = false;                             ///< Whether a fixed step recorded the previous state yet
+	};
+
+	/**
+	 * @brief Attaches an entity to a parent, detaching it from its previous parent first.
+	 *
+	 * The child's Transform is kept as is and becomes relative to the parent.
+	 *
+	 * @param world The world both entities live in.
+	 * @param child The entity to attach.
+	 * @param parent The new parent; must not be the child or one of its descendants.
+	 */
+	void SetParent(World& world, Entity child, Entity parent);
+
+	/**
+	 * @brief Checks whether an entity is below another one in a hierarchy.
+	 *
+	 * @param world The world both entities live in.
+	 * @param entity The entity to check.
+	 * @param ancestor The possible parent, grandparent and so on.
+	 * @return True if ancestor is met walking up the parents of entity.
+	 */
+	bool IsDescendant(World& world, Entity entity, Entity ancestor);
+
+	/**
+	 * @brief Detaches an entity from its parent; its Transform becomes world-space again.
+	 *
+	 * @param world The world the entity lives in.
+	 * @param child The entity to detach.
+	 */
+	void RemoveParent(World& world, Entity child);
+
+	/**
+	 * @brief Deletes an entity together with all its descendants.
+	 *
+	 * @param world The world the entities live in.
+	 * @param root The entity to delete.
+	 */
+	void DeleteHierarchy(World& world, Entity root);
+}
@@ -0,0 +1,57 @@
+#pragma once
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+
+namespace ac
+{
+    /**
+     * @brief Axis-aligned bounding box in the XY plane.
+     */
+    struct AABB2D
+    {
+        glm::vec2 min{ 0, 0 }; ///< Lower-left corner
+        glm::vec2 max{ 0, 0 }; ///< Upper-right corner
+
+        /**
+         * @brief Checks if this box and another one intersect or touch.
+         */
+        bool Overlaps(const AABB2D& other) const
+        {
+            return min.x <= other.max.x && other.min.x <= max.x &&
+                   min.y <= other.max.y && other.min.y <= max.y;
+        }
+
+        /**
+         * @brief Checks if another box lies completely inside this one.
+         */
+        bool Contains(const AABB2D& other) const
+        {
+            return min.x <= other.min.x && min.y <= other.min.y &&
+                   other.max.x <= max.x && other.max.y <= max.y;
+        }
+
+        /**
+         * @brief Perimeter of the box, the cost measure of the AABB tree.
+         */
+        float Perimeter() const
+        {
+            return 2.0f * ((max.x - min.x) + (max.y - min.y));
+        }
+
+        /**
+         * @brief Returns the box grown by margin on every side.
+         */
+        AABB2D Expanded(float margin) const
+        {
+            return { min - glm::vec2(margin), max + glm::vec2(margin) };
+        }
+
+        /**
+         * @brief Returns the smallest box containing both boxes.
+         */
+        static AABB2D Union(const AABB2D& a, const AABB2D& b)
+        {
+            return { glm::min(a.min, b.min), glm::max(a.max, b.max) };
+        }
+    };
+}
@@ -0,0 +1,197 @@
+#include "acpch.h"
+#include "Broadphase2D.h"
+#include "EngineComponents/Physics/CollisionLayer.h"
+#include <numeric>
+
+namespace ac
+{
+    Broadphase2D::Broadphase2D(BroadphaseMethod2D method)
+        : m_method(method)
+    {
+    }
+
+    void Broadphase2D::SetMethod(BroadphaseMethod2D method)
+    {
+        if (method == m_method)
+            return;
+
+        m_method = method;
+        m_tree.Clear();
+        m_treeProxies.clear();
+        m_sweepOrder.clear();
+    }
+
+    void Broadphase2D::FindPairs(const std::vector<BroadphaseProxy2D>& proxies, const CollisionLayer& layers, std::vector<BroadphasePair2D>& pairs)
+    {
+        pairs.clear();
+        switch (m_method)
+        {
+        case BroadphaseMethod2D::BruteForce:
+            FindPairsBruteForce(proxies, layers, pairs);
+            return;
+        case BroadphaseMethod2D::AABBTree:
+            FindPairsTree(proxies, layers, pairs);
+            break;
+        case BroadphaseMethod2D::SweepAndPrune:
+            FindPairsSweep(proxies, layers, pairs);
+            break;
+        }
+
+        // Report pairs in the order the brute force finds them, so the narrowphase resolves them the same way whatever the method
+        std::sort(pairs.begin(), pairs.end(), [](const BroadphasePair2D& lhs, const BroadphasePair2D& rhs)
+            {
+                return lhs.a != rhs.a ? lhs.a < rhs.a : lhs.b < rhs.b;
+            });
+    }
+
+    void Broadphase2D::FindPairsBruteForce(const std::vector<BroadphaseProxy2D>& proxies, const CollisionLayer& layers, std::vector<BroadphasePair2D>& pairs)
+    {
+        uint32_t count = static_cast<uint32_t>(proxies.size());
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t mask = layers.GetCollisionMask(proxies[i].layer);
+            for (uint32_t j = i + 1; j < count; ++j)
+            {
+                if (proxies[i].sleeping && proxies[j].sleeping)
+                    continue;
+                if ((mask & CollisionLayer::GetLayerBit(proxies[j].layer)) != 0 && proxies[i].aabb.Overlaps(proxies[j].aabb))
+                    pairs.push_back({ i, j });
+            }
+        }
+    }
+
+    void Broadphase2D::FindPairsTree(const std::vector<BroadphaseProxy2D>& proxies, const CollisionLayer& layers, std::vector<BroadphasePair2D>& pairs)
+    {
+        ++m_frame;
+        uint32_t count = static_cast<uint32_t>(proxies.size());
+
+        // Refit: only colliders that left their fat AABB are reinserted; sleeping ones have not moved
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const BroadphaseProxy2D& proxy = proxies[i];
+            glm::vec2 size = proxy.aabb.max - proxy.aabb.min;
+            float margin = aabbMargin * std::max(size.x, size.y);
+
+            auto [it, inserted] = m_treeProxies.try_emplace(proxy.key);
+            TreeProxy& treeProxy = it->second;
+            if (!inserted && treeProxy.layer == proxy.layer)
+            {
+                if (!proxy.sleeping)
+                    m_tree.MoveProxy(treeProxy.node, proxy.aabb, margin);
+                m_tree.SetUserData(treeProxy.node, i);
+            }
+            else
+            {
+                // The layer bits of the ancestors only ever grow, so a collider that changed layers is inserted again
+                if (!inserted)
+                    m_tree.DestroyProxy(treeProxy.node);
+                treeProxy.node = m_tree.CreateProxy(proxy.aabb, margin, CollisionLayer::GetLayerBit(proxy.layer), i);
+                treeProxy.layer = proxy.layer;
+            }
+            treeProxy.frame = m_frame;
+        }
+
+        // Drop the colliders that are gone
+        for (auto it = m_treeProxies.begin(); it != m_treeProxies.end();)
+        {
+            if (it->second.frame != m_frame)
+            {
+                m_tree.DestroyProxy(it->second.node);
+                it = m_treeProxies.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        // Every pair is found from its lower index, or from its awake collider if the other sleeps; sleeping colliders do not query.
+        // The tree skips subtrees without a colliding layer
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const AABB2D& aabb = proxies[i].aabb;
+            uint32_t mask = layers.GetCollisionMask(proxies[i].layer);
+            if (mask == 0 || proxies[i].sleeping)
+                continue;
+
+            m_tree.Query(aabb, mask, [&](int32_t node)
+                {
+                    uint32_t j = m_tree.GetUserData(node);
+                    if ((j > i || proxies[j].sleeping) && proxies[j].aabb.Overlaps(aabb))
+                        pairs.push_back({ std::min(i, j), std::max(i, j) });
+                });
+        }
+    }
+
+    void Broadphase2D::FindPairsSweep(const std::vector<BroadphaseProxy2D>& proxies, const CollisionLayer& layers, std::vector<BroadphasePair2D>& pairs)
+    {
+        uint32_t count = static_cast<uint32_t>(proxies.size());
+        if (count == 0)
+        {
+            m_sweepOrder.clear();
+            return;
+        }
+
+        // Sweep along the axis the colliders are spread out the most, so fewer of them overlap on it
+        glm::vec2 sum(0.0f), sumSq(0.0f);
+        for (const BroadphaseProxy2D& proxy : proxies)
+        {
+            glm::vec2 center = (proxy.aabb.min + proxy.aabb.max) * 0.5f;
+            sum += center;
+            sumSq += center * center;
+        }
+        glm::vec2 variance = sumSq / static_cast<float>(count) - (sum * sum) / static_cast<float>(count * count);
+        int axis = variance.y > variance.x ? 1 : 0;
+
+        auto lower = [&proxies, axis](uint32_t index) { return proxies[index].aabb.min[axis]; };
+        if (m_sweepOrder.size() != count || axis != m_sweepAxis)
+        {
+            m_sweepAxis = axis;
+            m_sweepOrder.resize(count);
+            std::iota(m_sweepOrder.begin(), m_sweepOrder.end(), 0u);
+            std::sort(m_sweepOrder.begin(), m_sweepOrder.end(), [&](uint32_t lhs, uint32_t rhs) { return lower(lhs) < lower(rhs); });
+        }
+        else
+        {
+            // Colliders move little between frames, so last frame's order is nearly sorted and insertion sort is close to linear.
+            // Fall back to a full sort if too much changed.
+            size_t shifts = 0;
+            size_t shiftBudget = static_cast<size_t>(count) * 8;
+            for (uint32_t a = 1; a < count && shifts <= shiftBudget; ++a)
+            {
+                uint32_t index = m_sweepOrder[a];
+                float key = lower(index);
+                uint32_t b = a;
+                while (b > 0 && lower(m_sweepOrder[b - 1]) > key)
+                {
+                    m_sweepOrder[b] = m_sweepOrder[b - 1];
+                    --b;
+                }
+                m_sweepOrder[b] = index;
+                shifts += a - b;
+            }
+            if (shifts > shiftBudget)
+                std::sort(m_sweepOrder.begin(), m_sweepOrder.end(), [&](uint32_t lhs, uint32_t rhs) { return lower(lhs) < lower(rhs); });
+        }
+
+        // Each collider is tested against the ones starting before it ends on the sweep axis
+        for (uint32_t a = 0; a < count; ++a)
+        {
+            uint32_t i = m_sweepOrder[a];
+            const AABB2D& aabb = proxies[i].aabb;
+            uint32_t mask = layers.GetCollisionMask(proxies[i].layer);
+            if (mask == 0)
+                continue;
+
+            float upper = aabb.max[axis];
+            for (uint32_t b = a + 1; b < count && lower(m_sweepOrder[b]) <= upper; ++b)
+            {
+                uint32_t j = m_sweepOrder[b];
+                if (proxies[i].sleeping && proxies[j].sleeping)
+                    continue;
+                if ((mask & CollisionLayer::GetLayerBit(proxies[j].layer)) != 0 && proxies[j].aabb.Overlaps(aabb))
+                    pairs.push_back({ std::min(i, j), std::max(i, j) });
+            }
+        }
+    }
+}
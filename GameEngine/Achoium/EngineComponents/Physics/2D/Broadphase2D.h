@@ -0,0 +1,117 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "AABB2D.h"
+#include "DynamicAABBTree2D.h"
+
+namespace ac
+{
+    class CollisionLayer;
+
+    /**
+     * @brief Algorithms Broadphase2D can find candidate pairs with.
+     */
+    enum class BroadphaseMethod2D
+    {
+        BruteForce,   ///< Tests the bounds of every pair, O(n^2); kept as a reference
+        AABBTree,     ///< Queries a DynamicAABBTree2D of fat AABBs kept between frames
+        SweepAndPrune ///< Sorts the bounds along one axis and sweeps; the order is kept between frames
+    };
+
+    /**
+     * @brief A collider as seen by the broadphase.
+     */
+    struct BroadphaseProxy2D
+    {
+        uint64_t key = 0;   ///< Identifies the collider across frames, unique within a frame
+        AABB2D aabb;        ///< World bounds of the collider this frame
+        uint32_t layer = 0; ///< Collision layer of the collider
+        bool sleeping = false; ///< If true, the collider's body sleeps: it is not refit and never paired with another sleeping one
+    };
+
+    /**
+     * @brief Two proxies whose bounds overlap and whose layers collide.
+     */
+    struct BroadphasePair2D
+    {
+        uint32_t a = 0; ///< Index of the first proxy
+        uint32_t b = 0; ///< Index of the second proxy, always greater than a
+    };
+
+    /**
+     * @brief Resource finding the collider pairs Collision2DSystem runs the narrowphase on.
+     *
+     * The method can be switched at runtime, e.g. to compare them in a
+     * benchmark; all methods report the same pairs in the same order.
+     */
+    class Broadphase2D
+    {
+    public:
+        /**
+         * @brief Fraction of a collider's larger side its fat AABB extends on every side in the AABB tree.
+         *
+         * Larger margins reinsert moving colliders less often but report more candidate pairs to test.
+         */
+        float aabbMargin = 0.1f;
+
+        /**
+         * @brief Constructor with the method to use.
+         *
+         * @param method The broadphase algorithm
+         */
+        explicit Broadphase2D(BroadphaseMethod2D method = BroadphaseMethod2D::AABBTree);
+
+        /**
+         * @brief Switches the algorithm; the state kept for the previous one is dropped.
+         *
+         * @param method The broadphase algorithm
+         */
+        void SetMethod(BroadphaseMethod2D method);
+
+        /**
+         * @brief Gets the algorithm in use.
+         */
+        BroadphaseMethod2D GetMethod() const { return m_method; }
+
+        /**
+         * @brief Finds the pairs of this frame's colliders that may touch.
+         *
+         * A pair is reported if the bounds of both proxies overlap,
+         * CollisionLayer::ShouldCollide holds for their layers and at least
+         * one of them is awake. Colliders whose key was not passed again
+         * since the last call are forgotten.
+         *
+         * @param proxies Every collider of this frame.
+         * @param layers The collision matrix.
+         * @param pairs Output, cleared first; sorted by a, then b.
+         */
+        void FindPairs(const std::vector<BroadphaseProxy2D>& proxies, const CollisionLayer& layers, std::vector<BroadphasePair2D>& pairs);
+
+        /**
+         * @brief Gets the AABB tree, filled while the method is AABBTree.
+         */
+        const DynamicAABBTree2D& GetTree() const { return m_tree; }
+
+    private:
+        void FindPairsBruteForce(const std::vector<BroadphaseProxy2D>& proxies, const CollisionLayer& layers, std::vector<BroadphasePair2D>& pairs);
+        void FindPairsTree(const std::vector<BroadphaseProxy2D>& proxies, const CollisionLayer& layers, std::vector<BroadphasePair2D>& pairs);
+        void FindPairsSweep(const std::vector<BroadphaseProxy2D>& proxies, const CollisionLayer& layers, std::vector<BroadphasePair2D>& pairs);
+
+        struct TreeProxy
+        {
+            int32_t node = DynamicAABBTree2D::NullNode;
+            uint32_t layer = 0;
+            uint32_t frame = 0; ///< Last call the collider was passed in
+        };
+
+        BroadphaseMethod2D m_method;
+
+        DynamicAABBTree2D m_tree;
+        std::unordered_map<uint64_t, TreeProxy> m_treeProxies;
+        uint32_t m_frame = 0;
+
+        std::vector<uint32_t> m_sweepOrder; ///< Proxy indices sorted by their lower bound on the sweep axis
+        int m_sweepAxis = 0;
+    };
+}
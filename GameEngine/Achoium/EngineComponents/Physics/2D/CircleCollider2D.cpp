@@ -10,70 +10,36 @@
 namespace ac
 {
     CircleCollider2D::CircleCollider2D()
-        : Collider2D()
+        : Collider2D(ColliderType2D::Circle)
         , radius(0.5f)
     {
     }
     
     CircleCollider2D::CircleCollider2D(float _radius)
-        : Collider2D()
+        : Collider2D(ColliderType2D::Circle)
         , radius(_radius)
     {
     }
     
     CircleCollider2D::CircleCollider2D(float _radius, const glm::vec2& _offset, uint32_t _layer, bool _isTrigger)
-        : Collider2D(_layer)
+        : Collider2D(ColliderType2D::Circle, _layer)
         , radius(_radius)
     {
         offset = _offset;
         isTrigger = _isTrigger;
     }
     
-    bool CircleCollider2D::CheckCollision(
-        const Collider2D* other,
-        const Transform& myTransform,
-        const Transform& otherTransform,
-        std::vector<CollisionPoint2D>& collisionPoints,
-        glm::vec2& collisionNormal,
-        float& penetrationDepth
-    ) const
+    AABB2D CircleCollider2D::GetWorldAABB(const Transform& transform) const
     {
-        // Check what type of collider we're colliding with and delegate to specific function
-        if (const CircleCollider2D* otherCircle = dynamic_cast<const CircleCollider2D*>(other))
-        {
-            return CircleVsCircle(otherCircle, myTransform, otherTransform, 
-                collisionPoints, collisionNormal, penetrationDepth);
-        }
-        else if (const RectCollider2D* otherRect = dynamic_cast<const RectCollider2D*>(other))
-        {
-            bool res =  otherRect->RectVsCircle(this, otherTransform, myTransform,
-                collisionPoints, collisionNormal, penetrationDepth);
-            for (auto& t : collisionPoints)
-                std::swap(t.rbA, t.rbB);
-            collisionNormal = -collisionNormal;
-            return res;
-        }
-        else if (const PolygonCollider2D* otherPolygon = dynamic_cast<const PolygonCollider2D*>(other))
-        {
-            bool res = otherPolygon->PolygonVsCircle(this, otherTransform, myTransform,
-                collisionPoints, collisionNormal, penetrationDepth);
-            for (auto& t : collisionPoints)
-                std::swap(t.rbA, t.rbB);
-            collisionNormal = -collisionNormal;
-            return res;
-        }
-        
-        // Unsupported collider type
-        return false;
+        glm::vec2 center = GetWorldPosition(transform);
+        return { center - glm::vec2(radius), center + glm::vec2(radius) };
     }
     
     bool CircleCollider2D::CircleVsCircle(
         const CircleCollider2D* other,
         const Transform& myTransform,
         const Transform& otherTransform,
-        std::vector<CollisionPoint2D>& collisionPoints,
-        glm::vec2& collisionNormal,
-        float& penetrationDepth
+        Manifold2D& manifold
     ) const
     {
         glm::vec myPos = GetWorldPosition(myTransform);
@@ -106,22 +72,22 @@ namespace ac
         // Handle the case where the circles are at exactly the same position
         if (dist < 0.0001f)
         {
-            collisionNormal = glm::vec3(0.0f, 1.0f, 0.0f); // Default to up direction
-            penetrationDepth = sumRadii;
-            collisionPoints.push_back({ myPos, otherPos });
+            manifold.normal = glm::vec3(0.0f, 1.0f, 0.0f); // Default to up direction
+            manifold.penetrationDepth = sumRadii;
+            manifold.AddPoint({ myPos, otherPos });
         }
         else
         {
             // Calculate collision normal
             glm::vec2 normalDir = distance / dist;
-            collisionNormal = glm::vec3(normalDir.x, normalDir.y, 0.0f);
+            manifold.normal = glm::vec3(normalDir.x, normalDir.y, 0.0f);
             
             // Calculate penetration depth
-            penetrationDepth = sumRadii - dist;
+            manifold.penetrationDepth = sumRadii - dist;
             
             // Calculate collision point
             glm::vec2 collisionPoint2D = myPos2D + normalDir * radius;
-            collisionPoints.push_back({ myPos2D + normalDir * radius, otherPos2D + -normalDir * other->radius });
+            manifold.AddPoint({ myPos2D + normalDir * radius, otherPos2D + -normalDir * other->radius });
         }
         
         return true;
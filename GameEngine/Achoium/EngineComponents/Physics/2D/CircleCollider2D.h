@@ -42,18 +42,12 @@ namespace ac
         CircleCollider2D(float _radius, const glm::vec2& _offset, uint32_t _layer = 0, bool _isTrigger = false);
 
         /**
-         * @brief Implements collision detection for this circle collider.
+         * @brief Computes the world-space bounds of the collider.
          * 
-         * Checks for collision with another collider and outputs collision data.
+         * @param transform The entity's transform component
+         * @return Box containing the collider
          */
-        virtual bool CheckCollision(
-            const Collider2D* other,
-            const Transform& myTransform,
-            const Transform& otherTransform,
-            std::vector<CollisionPoint2D>& collisionPoints,
-            glm::vec2& collisionNormal,
-            float& penetrationDepth
-        ) const override;
+        virtual AABB2D GetWorldAABB(const Transform& transform) const override;
 
         
         /**
@@ -63,9 +57,7 @@ namespace ac
             const CircleCollider2D* other,
             const Transform& myTransform,
             const Transform& otherTransform,
-            std::vector<CollisionPoint2D>& collisionPoints,
-            glm::vec2& collisionNormal,
-            float& penetrationDepth
+            Manifold2D& manifold
         ) const;
 
     };
@@ -1,26 +1,148 @@
 #include "acpch.h"
 #include "Collider2D.h"
+#include "CircleCollider2D.h"
+#include "RectCollider2D.h"
+#include "PolygonCollider2D.h"
 #include "Math/Transform.h"
 
 namespace ac
 {
-    Collider2D::Collider2D()
+    namespace
+    {
+        using CollisionFunction2D = bool(*)(
+            const Collider2D* a,
+            const Collider2D* b,
+            const Transform& transformA,
+            const Transform& transformB,
+            Manifold2D& manifold);
+
+        bool CircleVsCircle(const Collider2D* a, const Collider2D* b, const Transform& transformA, const Transform& transformB,
+            Manifold2D& manifold)
+        {
+            return static_cast<const CircleCollider2D*>(a)->CircleVsCircle(static_cast<const CircleCollider2D*>(b),
+                transformA, transformB, manifold);
+        }
+
+        bool RectVsCircle(const Collider2D* a, const Collider2D* b, const Transform& transformA, const Transform& transformB,
+            Manifold2D& manifold)
+        {
+            return static_cast<const RectCollider2D*>(a)->RectVsCircle(static_cast<const CircleCollider2D*>(b),
+                transformA, transformB, manifold);
+        }
+
+        bool RectVsRect(const Collider2D* a, const Collider2D* b, const Transform& transformA, const Transform& transformB,
+            Manifold2D& manifold)
+        {
+            return static_cast<const RectCollider2D*>(a)->RectVsRect(static_cast<const RectCollider2D*>(b),
+                transformA, transformB, manifold);
+        }
+
+        bool RectVsPolygon(const Collider2D* a, const Collider2D* b, const Transform& transformA, const Transform& transformB,
+            Manifold2D& manifold)
+        {
+            return static_cast<const RectCollider2D*>(a)->RectVsPolygon(static_cast<const PolygonCollider2D*>(b),
+                transformA, transformB, manifold);
+        }
+
+        bool PolygonVsCircle(const Collider2D* a, const Collider2D* b, const Transform& transformA, const Transform& transformB,
+            Manifold2D& manifold)
+        {
+            return static_cast<const PolygonCollider2D*>(a)->PolygonVsCircle(static_cast<const CircleCollider2D*>(b),
+                transformA, transformB, manifold);
+        }
+
+        bool PolygonVsPolygon(const Collider2D* a, const Collider2D* b, const Transform& transformA, const Transform& transformB,
+            Manifold2D& manifold)
+        {
+            return static_cast<const PolygonCollider2D*>(a)->PolygonVsPolygon(static_cast<const PolygonCollider2D*>(b),
+                transformA, transformB, manifold);
+        }
+
+        // Runs a pair function with the colliders swapped, then swaps its results back
+        template <CollisionFunction2D Function>
+        bool Swapped(const Collider2D* a, const Collider2D* b, const Transform& transformA, const Transform& transformB,
+            Manifold2D& manifold)
+        {
+            if (!Function(b, a, transformB, transformA, manifold))
+                return false;
+            for (uint32_t i = 0; i < manifold.pointCount; ++i)
+                std::swap(manifold.points[i].rbA, manifold.points[i].rbB);
+            manifold.normal = -manifold.normal;
+            return true;
+        }
+
+        constexpr size_t ShapeCount = static_cast<size_t>(ColliderType2D::Count);
+
+        struct CollisionTable2D
+        {
+            CollisionFunction2D functions[ShapeCount][ShapeCount] = {};
+
+            // Registers the function for (A, B) and its swapped version for (B, A)
+            template <ColliderType2D A, ColliderType2D B, CollisionFunction2D Function>
+            constexpr void Register()
+            {
+                functions[static_cast<size_t>(A)][static_cast<size_t>(B)] = Function;
+                if constexpr (A != B)
+                    functions[static_cast<size_t>(B)][static_cast<size_t>(A)] = &Swapped<Function>;
+            }
+
+            constexpr bool IsComplete() const
+            {
+                for (size_t a = 0; a < ShapeCount; ++a)
+                    for (size_t b = 0; b < ShapeCount; ++b)
+                        if (functions[a][b] == nullptr)
+                            return false;
+                return true;
+            }
+        };
+
+        constexpr CollisionTable2D BuildCollisionTable()
+        {
+            CollisionTable2D table;
+            table.Register<ColliderType2D::Circle, ColliderType2D::Circle, &CircleVsCircle>();
+            table.Register<ColliderType2D::Rect, ColliderType2D::Circle, &RectVsCircle>();
+            table.Register<ColliderType2D::Rect, ColliderType2D::Rect, &RectVsRect>();
+            table.Register<ColliderType2D::Rect, ColliderType2D::Polygon, &RectVsPolygon>();
+            table.Register<ColliderType2D::Polygon, ColliderType2D::Circle, &PolygonVsCircle>();
+            table.Register<ColliderType2D::Polygon, ColliderType2D::Polygon, &PolygonVsPolygon>();
+            return table;
+        }
+
+        constexpr CollisionTable2D s_collisionTable = BuildCollisionTable();
+        static_assert(s_collisionTable.IsComplete(), "Every pair of 2D collider shapes needs a collision function");
+    }
+
+    Collider2D::Collider2D(ColliderType2D _type)
         : offset(0.0f)
         , isTrigger(false)
         , layer(0)
+        , m_type(_type)
     {
     }
-    
-    Collider2D::Collider2D(uint32_t _layer)
+
+    Collider2D::Collider2D(ColliderType2D _type, uint32_t _layer)
         : offset(0.0f)
         , isTrigger(false)
         , layer(_layer)
+        , m_type(_type)
     {
     }
-    
+
     glm::vec2 Collider2D::GetWorldPosition(const Transform& transform) const
     {
         // Apply entity's transform to the collider's local offset
         return transform.position + transform.rotation * glm::vec3(offset, 0);
     }
+
+    bool Collider2D::CheckCollision(
+        const Collider2D* other,
+        const Transform& myTransform,
+        const Transform& otherTransform,
+        Manifold2D& manifold
+    ) const
+    {
+        manifold.pointCount = 0;
+        CollisionFunction2D function = s_collisionTable.functions[static_cast<size_t>(m_type)][static_cast<size_t>(other->m_type)];
+        return function(this, other, myTransform, otherTransform, manifold);
+    }
 }
\ No newline at end of file
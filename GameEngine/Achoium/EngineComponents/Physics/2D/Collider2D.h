@@ -2,6 +2,7 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/glm.hpp>
 #include <cstdint>
+#include "AABB2D.h"
 
 namespace ac
 {
@@ -11,8 +12,41 @@ namespace ac
         glm::vec2 rbB{ 0,0 }; ///< Point on rigidbody B
     };
 
+    /**
+     * @brief Contact between two colliders, stored inline so the narrowphase never allocates.
+     */
+    struct Manifold2D
+    {
+        static constexpr uint32_t MaxPoints = 2;
+
+        CollisionPoint2D points[MaxPoints]; ///< Contact points, the first pointCount are valid
+        uint32_t pointCount = 0;            ///< Number of valid contact points
+        glm::vec2 normal{ 0,0 };            ///< Collision normal, from the first collider to the second
+        float penetrationDepth = 0.0f;      ///< Overlap along the normal
+
+        /**
+         * @brief Appends a contact point; points beyond MaxPoints are dropped.
+         */
+        void AddPoint(const CollisionPoint2D& point)
+        {
+            if (pointCount < MaxPoints)
+                points[pointCount++] = point;
+        }
+    };
+
     // Forward declaration of Transform
     class Transform;
+
+    /**
+     * @brief Shape of a 2D collider, used to pick the pair function in the collision table.
+     */
+    enum class ColliderType2D : uint8_t
+    {
+        Circle,
+        Rect,
+        Polygon,
+        Count
+    };
     
     /**
      * @brief Base class for all collision shapes.
@@ -28,16 +62,19 @@ namespace ac
         uint32_t layer;   ///< Collision layer this collider belongs to
         
         /**
-         * @brief Default constructor.
+         * @brief Constructor with the shape type.
+         * 
+         * @param _type Shape of the derived collider
          */
-        Collider2D();
+        explicit Collider2D(ColliderType2D _type);
         
         /**
-         * @brief Constructor with layer.
+         * @brief Constructor with shape type and layer.
          * 
+         * @param _type Shape of the derived collider
          * @param _layer The collision layer this collider belongs to
          */
-        explicit Collider2D(uint32_t _layer);
+        Collider2D(ColliderType2D _type, uint32_t _layer);
         
         /**
          * @brief Virtual destructor for proper cleanup of derived classes.
@@ -51,25 +88,52 @@ namespace ac
          * @return World position of the collider
          */
         glm::vec2 GetWorldPosition(const Transform& transform) const;
+
+        /**
+         * @brief Gets the shape of the collider.
+         */
+        ColliderType2D GetType() const { return m_type; }
+
+        /**
+         * @brief Caches the world-space data CheckCollision reads, such as polygon vertices.
+         * 
+         * Must be called whenever the transform changes before testing the
+         * collider again; Collision2DSystem does so for every collider each frame.
+         * 
+         * @param transform The entity's transform component
+         */
+        virtual void UpdateWorldVertices(const Transform& /*transform*/) {}
         
         /**
-         * @brief Abstract method for collision detection against another collider.
+         * @brief Collision detection against another collider.
+         * 
+         * Looks up the pair function for the shapes of both colliders in the
+         * collision table, so any two shapes can be tested without RTTI.
+         * Both colliders must have their world vertices cached for the given
+         * transforms by UpdateWorldVertices.
          * 
          * @param other The other collider to check collision against
          * @param myTransform This collider's entity transform
          * @param otherTransform The other collider's entity transform
-         * @param collisionPoint Output parameter for the point of collision if detected
-         * @param collisionNormal Output parameter for the collision normal if detected
-         * @param penetrationDepth Output parameter for the penetration depth if detected
+         * @param manifold Output contact, with the normal pointing from this collider to the other one
          * @return True if the colliders are intersecting
          */
-        virtual bool CheckCollision(
+        bool CheckCollision(
             const Collider2D* other,
             const Transform& myTransform,
             const Transform& otherTransform,
-            std::vector<CollisionPoint2D>& collisionPoints,
-            glm::vec2& collisionNormal,
-            float& penetrationDepth
-        ) const = 0;
+            Manifold2D& manifold
+        ) const;
+
+        /**
+         * @brief Abstract method computing the world-space bounds of the collider.
+         * 
+         * @param transform The entity's transform component
+         * @return Box containing the collider, used by the broadphase
+         */
+        virtual AABB2D GetWorldAABB(const Transform& transform) const = 0;
+
+    private:
+        ColliderType2D m_type; ///< Shape of the derived collider
     };
 }
\ No newline at end of file
@@ -0,0 +1,381 @@
+#include "acpch.h"
+#include "ContactSolver2D.h"
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/norm.hpp>
+
+namespace ac
+{
+    namespace
+    {
+        // 2D cross products: vector x vector is a scalar, scalar x vector a vector
+        float Cross(const glm::vec2& a, const glm::vec2& b)
+        {
+            return a.x * b.y - a.y * b.x;
+        }
+
+        glm::vec2 Cross(float w, const glm::vec2& r)
+        {
+            return glm::vec2(-w * r.y, w * r.x);
+        }
+
+        // Fixed bodies may touch islands solved on other threads, so they are read but never written
+        bool IsFixed(const SolverBody2D& body)
+        {
+            return body.inverseMass == 0.0f && body.inverseInertia == 0.0f;
+        }
+
+        void ApplyImpulse(SolverBody2D& body, const glm::vec2& r, const glm::vec2& impulse)
+        {
+            if (IsFixed(body))
+                return;
+            body.velocity += body.inverseMass * impulse;
+            body.angularVelocity += body.inverseInertia * Cross(r, impulse);
+        }
+
+        // A few dozen islands per job; small islands of a single contact are the common case
+        constexpr size_t IslandGrainSize = 64;
+    }
+
+    void ContactSolver2D::BeginStep()
+    {
+        ++m_step;
+        m_bodies.clear();
+        m_bodyIndices.clear();
+        m_contacts.clear();
+    }
+
+    uint32_t ContactSolver2D::AddBody(uint64_t id, const SolverBody2D& body)
+    {
+        auto [it, inserted] = m_bodyIndices.try_emplace(id, static_cast<uint32_t>(m_bodies.size()));
+        if (inserted)
+            m_bodies.push_back(body);
+        return it->second;
+    }
+
+    void ContactSolver2D::AddContact(const ContactKey2D& key, uint32_t bodyA, uint32_t bodyB, const glm::vec2& centerA, const glm::vec2& centerB,
+        const Manifold2D& manifold, float friction, float restitution)
+    {
+        Contact& contact = m_contacts.emplace_back();
+        contact.bodyA = bodyA;
+        contact.bodyB = bodyB;
+        contact.normal = manifold.normal;
+        contact.friction = friction;
+        contact.restitution = restitution;
+        contact.penetrationDepth = manifold.penetrationDepth;
+        contact.pointCount = manifold.pointCount;
+        contact.cache = &m_cache[key];
+
+        // Points close to one of last step's inherit its impulses as the starting guess
+        const CachedContact& cache = *contact.cache;
+        float matchDistanceSq = contactMatchDistance * contactMatchDistance;
+        for (uint32_t i = 0; i < manifold.pointCount; ++i)
+        {
+            ContactPoint& point = contact.points[i];
+            glm::vec2 position = (manifold.points[i].rbA + manifold.points[i].rbB) * 0.5f;
+            point.rA = position - centerA;
+            point.rB = position - centerB;
+
+            float bestDistanceSq = matchDistanceSq;
+            for (uint32_t j = 0; j < cache.pointCount; ++j)
+            {
+                float distanceSq = glm::length2(cache.points[j].rA - point.rA);
+                if (distanceSq < bestDistanceSq)
+                {
+                    bestDistanceSq = distanceSq;
+                    point.normalImpulse = cache.points[j].normalImpulse;
+                    point.tangentImpulse = cache.points[j].tangentImpulse;
+                }
+            }
+        }
+        contact.cache->step = m_step;
+    }
+
+    void ContactSolver2D::Solve()
+    {
+        BuildIslands();
+        for (uint32_t island = 0; island < m_islands.GetIslandCount(); ++island)
+            SolveIsland(island);
+        StoreImpulses();
+    }
+
+    void ContactSolver2D::Solve(JobSystem& jobs)
+    {
+        BuildIslands();
+        jobs.ParallelFor(m_islands.GetIslandCount(), IslandGrainSize, [this](size_t begin, size_t end)
+            {
+                for (size_t island = begin; island < end; ++island)
+                    SolveIsland(static_cast<uint32_t>(island));
+            }, maxThreads);
+        StoreImpulses();
+    }
+
+    void ContactSolver2D::BuildIslands()
+    {
+        m_islands.Reset(static_cast<uint32_t>(m_bodies.size()));
+        for (const Contact& contact : m_contacts)
+        {
+            if (!IsFixed(m_bodies[contact.bodyA]) && !IsFixed(m_bodies[contact.bodyB]))
+                m_islands.Link(contact.bodyA, contact.bodyB);
+        }
+        m_islands.Build();
+
+        // Counting sort of the contacts by the island of their moving body, keeping the order they were added in
+        auto islandOf = [this](const Contact& contact)
+            {
+                return m_islands.GetIsland(IsFixed(m_bodies[contact.bodyA]) ? contact.bodyB : contact.bodyA);
+            };
+        m_islandContactStarts.assign(m_islands.GetIslandCount() + 1, 0);
+        for (const Contact& contact : m_contacts)
+            ++m_islandContactStarts[islandOf(contact) + 1];
+        for (size_t island = 1; island < m_islandContactStarts.size(); ++island)
+            m_islandContactStarts[island] += m_islandContactStarts[island - 1];
+
+        m_unsortedContacts.swap(m_contacts);
+        m_contacts.resize(m_unsortedContacts.size());
+        std::vector<uint32_t> next(m_islandContactStarts.begin(), m_islandContactStarts.end() - 1);
+        for (const Contact& contact : m_unsortedContacts)
+            m_contacts[next[islandOf(contact)]++] = contact;
+    }
+
+    void ContactSolver2D::SolveIsland(uint32_t island)
+    {
+        size_t begin = m_islandContactStarts[island];
+        size_t end = m_islandContactStarts[island + 1];
+        if (begin == end)
+            return;
+
+        PrepareContacts(begin, end);
+        WarmStart(begin, end);
+        for (uint32_t i = 0; i < velocityIterations; ++i)
+            SolveVelocities(begin, end);
+        for (uint32_t i = 0; i < positionIterations; ++i)
+            SolvePositions(begin, end);
+    }
+
+    void ContactSolver2D::PrepareContacts(size_t begin, size_t end)
+    {
+        for (size_t c = begin; c < end; ++c)
+        {
+            Contact& contact = m_contacts[c];
+            const SolverBody2D& a = m_bodies[contact.bodyA];
+            const SolverBody2D& b = m_bodies[contact.bodyB];
+            glm::vec2 tangent(-contact.normal.y, contact.normal.x);
+
+            for (uint32_t i = 0; i < contact.pointCount; ++i)
+            {
+                ContactPoint& point = contact.points[i];
+
+                float rnA = Cross(point.rA, contact.normal);
+                float rnB = Cross(point.rB, contact.normal);
+                float normalMass = a.inverseMass + b.inverseMass + a.inverseInertia * rnA * rnA + b.inverseInertia * rnB * rnB;
+                point.normalMass = normalMass > 0.0f ? 1.0f / normalMass : 0.0f;
+
+                float rtA = Cross(point.rA, tangent);
+                float rtB = Cross(point.rB, tangent);
+                float tangentMass = a.inverseMass + b.inverseMass + a.inverseInertia * rtA * rtA + b.inverseInertia * rtB * rtB;
+                point.tangentMass = tangentMass > 0.0f ? 1.0f / tangentMass : 0.0f;
+
+                // Bounce only off fast impacts, so resting contacts do not keep hopping
+                glm::vec2 relativeVelocity = b.velocity + Cross(b.angularVelocity, point.rB) - a.velocity - Cross(a.angularVelocity, point.rA);
+                float velocityAlongNormal = glm::dot(relativeVelocity, contact.normal);
+                point.velocityBias = velocityAlongNormal < -restitutionThreshold ? -contact.restitution * velocityAlongNormal : 0.0f;
+            }
+
+            // Solve two points together unless they are so close that K is nearly singular
+            contact.blockSolve = false;
+            if (contact.pointCount == 2)
+            {
+                const ContactPoint& p1 = contact.points[0];
+                const ContactPoint& p2 = contact.points[1];
+                float rn1A = Cross(p1.rA, contact.normal);
+                float rn1B = Cross(p1.rB, contact.normal);
+                float rn2A = Cross(p2.rA, contact.normal);
+                float rn2B = Cross(p2.rB, contact.normal);
+                float inverseMassSum = a.inverseMass + b.inverseMass;
+                contact.k11 = inverseMassSum + a.inverseInertia * rn1A * rn1A + b.inverseInertia * rn1B * rn1B;
+                contact.k22 = inverseMassSum + a.inverseInertia * rn2A * rn2A + b.inverseInertia * rn2B * rn2B;
+                contact.k12 = inverseMassSum + a.inverseInertia * rn1A * rn2A + b.inverseInertia * rn1B * rn2B;
+
+                const float maxConditionNumber = 1000.0f;
+                float determinant = contact.k11 * contact.k22 - contact.k12 * contact.k12;
+                if (contact.k11 * contact.k11 < maxConditionNumber * determinant)
+                    contact.blockSolve = true;
+            }
+        }
+    }
+
+    void ContactSolver2D::WarmStart(size_t begin, size_t end)
+    {
+        for (size_t c = begin; c < end; ++c)
+        {
+            const Contact& contact = m_contacts[c];
+            SolverBody2D& a = m_bodies[contact.bodyA];
+            SolverBody2D& b = m_bodies[contact.bodyB];
+            glm::vec2 tangent(-contact.normal.y, contact.normal.x);
+
+            for (uint32_t i = 0; i < contact.pointCount; ++i)
+            {
+                const ContactPoint& point = contact.points[i];
+                glm::vec2 impulse = point.normalImpulse * contact.normal + point.tangentImpulse * tangent;
+                ApplyImpulse(a, point.rA, -impulse);
+                ApplyImpulse(b, point.rB, impulse);
+            }
+        }
+    }
+
+    void ContactSolver2D::SolveVelocities(size_t begin, size_t end)
+    {
+        for (size_t c = begin; c < end; ++c)
+        {
+            Contact& contact = m_contacts[c];
+            SolverBody2D& a = m_bodies[contact.bodyA];
+            SolverBody2D& b = m_bodies[contact.bodyB];
+            glm::vec2 tangent(-contact.normal.y, contact.normal.x);
+
+            auto applyImpulse = [&a, &b](const ContactPoint& point, const glm::vec2& impulse)
+                {
+                    ApplyImpulse(a, point.rA, -impulse);
+                    ApplyImpulse(b, point.rB, impulse);
+                };
+
+            // Friction first: it is bounded by the normal impulse, which the normal pass then gets the last word on
+            for (uint32_t i = 0; i < contact.pointCount; ++i)
+            {
+                ContactPoint& point = contact.points[i];
+                glm::vec2 relativeVelocity = b.velocity + Cross(b.angularVelocity, point.rB) - a.velocity - Cross(a.angularVelocity, point.rA);
+                float lambda = -point.tangentMass * glm::dot(relativeVelocity, tangent);
+
+                float maxFriction = contact.friction * point.normalImpulse;
+                float newImpulse = glm::clamp(point.tangentImpulse + lambda, -maxFriction, maxFriction);
+                lambda = newImpulse - point.tangentImpulse;
+                point.tangentImpulse = newImpulse;
+                applyImpulse(point, lambda * tangent);
+            }
+
+            if (contact.blockSolve)
+            {
+                SolveNormalBlock(contact);
+                continue;
+            }
+
+            // Normal impulses may pull back what earlier passes pushed, as long as the total stays non-negative
+            for (uint32_t i = 0; i < contact.pointCount; ++i)
+            {
+                ContactPoint& point = contact.points[i];
+                glm::vec2 relativeVelocity = b.velocity + Cross(b.angularVelocity, point.rB) - a.velocity - Cross(a.angularVelocity, point.rA);
+                float lambda = -point.normalMass * (glm::dot(relativeVelocity, contact.normal) - point.velocityBias);
+
+                float newImpulse = std::max(point.normalImpulse + lambda, 0.0f);
+                lambda = newImpulse - point.normalImpulse;
+                point.normalImpulse = newImpulse;
+                applyImpulse(point, lambda * contact.normal);
+            }
+        }
+    }
+
+    void ContactSolver2D::SolveNormalBlock(Contact& contact)
+    {
+        SolverBody2D& a = m_bodies[contact.bodyA];
+        SolverBody2D& b = m_bodies[contact.bodyB];
+        ContactPoint& p1 = contact.points[0];
+        ContactPoint& p2 = contact.points[1];
+
+        // Find the total impulses x >= 0 with K x + b >= 0 and x_i (K x + b)_i = 0 by trying which points stay active
+        glm::vec2 oldImpulse(p1.normalImpulse, p2.normalImpulse);
+        glm::vec2 dv1 = b.velocity + Cross(b.angularVelocity, p1.rB) - a.velocity - Cross(a.angularVelocity, p1.rA);
+        glm::vec2 dv2 = b.velocity + Cross(b.angularVelocity, p2.rB) - a.velocity - Cross(a.angularVelocity, p2.rA);
+        glm::vec2 rhs(glm::dot(dv1, contact.normal) - p1.velocityBias, glm::dot(dv2, contact.normal) - p2.velocityBias);
+        rhs.x -= contact.k11 * oldImpulse.x + contact.k12 * oldImpulse.y;
+        rhs.y -= contact.k12 * oldImpulse.x + contact.k22 * oldImpulse.y;
+
+        glm::vec2 newImpulse;
+        float determinant = contact.k11 * contact.k22 - contact.k12 * contact.k12;
+        for (;;)
+        {
+            // Both points pushing
+            newImpulse.x = -(contact.k22 * rhs.x - contact.k12 * rhs.y) / determinant;
+            newImpulse.y = -(contact.k11 * rhs.y - contact.k12 * rhs.x) / determinant;
+            if (newImpulse.x >= 0.0f && newImpulse.y >= 0.0f)
+                break;
+
+            // Only the first point pushing, the second separating
+            newImpulse = glm::vec2(-rhs.x / contact.k11, 0.0f);
+            if (newImpulse.x >= 0.0f && contact.k12 * newImpulse.x + rhs.y >= 0.0f)
+                break;
+
+            // Only the second point pushing
+            newImpulse = glm::vec2(0.0f, -rhs.y / contact.k22);
+            if (newImpulse.y >= 0.0f && contact.k12 * newImpulse.y + rhs.x >= 0.0f)
+                break;
+
+            // Both separating
+            newImpulse = glm::vec2(0.0f);
+            if (rhs.x >= 0.0f && rhs.y >= 0.0f)
+                break;
+
+            // No case holds, which only happens through round-off; keep last pass's impulses
+            return;
+        }
+
+        glm::vec2 delta = newImpulse - oldImpulse;
+        glm::vec2 impulse1 = delta.x * contact.normal;
+        glm::vec2 impulse2 = delta.y * contact.normal;
+        if (!IsFixed(a))
+        {
+            a.velocity -= a.inverseMass * (impulse1 + impulse2);
+            a.angularVelocity -= a.inverseInertia * (Cross(p1.rA, impulse1) + Cross(p2.rA, impulse2));
+        }
+        if (!IsFixed(b))
+        {
+            b.velocity += b.inverseMass * (impulse1 + impulse2);
+            b.angularVelocity += b.inverseInertia * (Cross(p1.rB, impulse1) + Cross(p2.rB, impulse2));
+        }
+        p1.normalImpulse = newImpulse.x;
+        p2.normalImpulse = newImpulse.y;
+    }
+
+    void ContactSolver2D::SolvePositions(size_t begin, size_t end)
+    {
+        // Translation only, like the correction this pass replaces; the overlap left is re-measured after every push
+        for (size_t c = begin; c < end; ++c)
+        {
+            const Contact& contact = m_contacts[c];
+            SolverBody2D& a = m_bodies[contact.bodyA];
+            SolverBody2D& b = m_bodies[contact.bodyB];
+            float inverseMassSum = a.inverseMass + b.inverseMass;
+            if (inverseMassSum <= 0.0f)
+                continue;
+
+            float separation = glm::dot(b.positionCorrection - a.positionCorrection, contact.normal) - contact.penetrationDepth;
+            float correction = glm::clamp(baumgarte * (separation + linearSlop), -maxCorrection, 0.0f);
+            if (correction >= 0.0f)
+                continue;
+
+            glm::vec2 impulse = (-correction / inverseMassSum) * contact.normal;
+            if (!IsFixed(a))
+                a.positionCorrection -= a.inverseMass * impulse;
+            if (!IsFixed(b))
+                b.positionCorrection += b.inverseMass * impulse;
+        }
+    }
+
+    void ContactSolver2D::StoreImpulses()
+    {
+        for (const Contact& contact : m_contacts)
+        {
+            CachedContact& cache = *contact.cache;
+            cache.pointCount = contact.pointCount;
+            for (uint32_t i = 0; i < contact.pointCount; ++i)
+                cache.points[i] = { contact.points[i].rA, contact.points[i].normalImpulse, contact.points[i].tangentImpulse };
+        }
+
+        // Pairs that stopped touching start from zero if they touch again
+        for (auto it = m_cache.begin(); it != m_cache.end();)
+        {
+            if (it->second.step != m_step)
+                it = m_cache.erase(it);
+            else
+                ++it;
+        }
+    }
+}
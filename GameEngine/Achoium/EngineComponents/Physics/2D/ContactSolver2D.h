@@ -0,0 +1,207 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include "Collider2D.h"
+#include "EngineComponents/Physics/Islands.h"
+#include "Core/JobSystem.hpp"
+
+namespace ac
+{
+    /**
+     * @brief Velocity state of a rigid body while the contacts are solved.
+     *
+     * Filled from the RigidBody2D before the solve and written back after it.
+     */
+    struct SolverBody2D
+    {
+        glm::vec2 velocity{ 0, 0 };            ///< Linear velocity
+        float angularVelocity = 0.0f;          ///< Angular velocity about z
+        float inverseMass = 0.0f;              ///< 0 for kinematic bodies
+        float inverseInertia = 0.0f;           ///< 0 for kinematic bodies and frozen rotation
+        glm::vec2 positionCorrection{ 0, 0 };  ///< Translation found by the position pass
+    };
+
+    /**
+     * @brief Identifies a pair of colliders across frames.
+     */
+    struct ContactKey2D
+    {
+        uint64_t a = 0; ///< Key of the first collider
+        uint64_t b = 0; ///< Key of the second collider
+        uint64_t generations = 0; ///< Generations of the two entities, so a recycled entity index does not inherit the pair
+
+        bool operator==(const ContactKey2D& other) const { return a == other.a && b == other.b && generations == other.generations; }
+    };
+
+    struct ContactKeyHash2D
+    {
+        size_t operator()(const ContactKey2D& key) const
+        {
+            return std::hash<uint64_t>()((key.a * 0x9E3779B97F4A7C15ull ^ key.b) * 0x9E3779B97F4A7C15ull ^ key.generations);
+        }
+    };
+
+    /**
+     * @brief Resource resolving the contacts found by Collision2DSystem with sequential impulses.
+     *
+     * Every step the contacts are collected with AddContact and solved
+     * together by Solve: the accumulated impulses of the previous step are
+     * applied first (warm starting), then velocityIterations passes apply
+     * normal and friction impulses, each clamped in total rather than per
+     * pass, and positionIterations passes push overlapping bodies apart.
+     *
+     * The accumulated impulses are kept per collider pair between steps, so
+     * resting contacts start close to their solution and stacks settle
+     * instead of jittering. Pairs not reported in a step are forgotten.
+     *
+     * Contacts are solved island by island: bodies that touch, directly or
+     * through other moving bodies, form an island, and islands share no
+     * moving body, so they can be solved on different threads. Fixed bodies
+     * (zero inverse mass and inertia) may touch several islands and are
+     * only ever read.
+     */
+    class ContactSolver2D
+    {
+    public:
+        uint32_t velocityIterations = 8;  ///< Passes over the contacts solving velocities
+        uint32_t positionIterations = 6;  ///< Passes over the contacts removing overlap
+        float baumgarte = 0.4f;           ///< Fraction of the overlap removed per position pass
+        float linearSlop = 0.05f;         ///< Overlap allowed to remain, keeps resting contacts touching
+        float maxCorrection = 2.0f;       ///< Largest translation per contact and position pass
+        float restitutionThreshold = 10.0f; ///< Closing speed below which contacts do not bounce
+        float contactMatchDistance = 1.0f;  ///< Distance within which a contact point inherits the impulses of last step's
+        uint32_t maxThreads = 0;            ///< Most threads Collision2DSystem tests pairs and solves islands on, 0 for every thread of the job system
+
+        /**
+         * @brief Drops the bodies and contacts of the previous step; the impulse cache is kept.
+         */
+        void BeginStep();
+
+        /**
+         * @brief Adds a body taking part in this step's contacts.
+         *
+         * @param id Identifies the body; adding the same id again returns the first index.
+         * @param body Velocity state and inverse mass of the body.
+         * @return Index of the body in GetBodies().
+         */
+        uint32_t AddBody(uint64_t id, const SolverBody2D& body);
+
+        /**
+         * @brief Adds the contact between two bodies found by the narrowphase.
+         *
+         * @param key Identifies the collider pair across steps.
+         * @param bodyA Index of the body of the first collider.
+         * @param bodyB Index of the body of the second collider.
+         * @param centerA Center of mass of the first body in world space.
+         * @param centerB Center of mass of the second body in world space.
+         * @param manifold Contact points and normal, pointing from the first collider to the second.
+         * @param friction Friction coefficient of the pair.
+         * @param restitution Restitution of the pair.
+         */
+        void AddContact(const ContactKey2D& key, uint32_t bodyA, uint32_t bodyB, const glm::vec2& centerA, const glm::vec2& centerB,
+            const Manifold2D& manifold, float friction, float restitution);
+
+        /**
+         * @brief Solves this step's contacts and stores their impulses for the next step.
+         *
+         * Groups the bodies into islands first; see GetIslands.
+         */
+        void Solve();
+
+        /**
+         * @brief Like Solve, with the islands spread over the threads of a job system.
+         *
+         * Every island's contacts are solved in the order they were added,
+         * whichever thread runs it, so the result is the same for any
+         * number of threads, and the same as Solve's.
+         *
+         * @param jobs Runs the islands; at most maxThreads threads take part.
+         */
+        void Solve(JobSystem& jobs);
+
+        /**
+         * @brief Gets the islands found by the last Solve; body numbers are indices in GetBodies().
+         *
+         * Bodies with a zero inverse mass and inertia, like kinematic ones, do
+         * not link the bodies touching them, so everything resting on the same
+         * ground does not become a single island.
+         */
+        const IslandBuilder& GetIslands() const { return m_islands; }
+
+        /**
+         * @brief Gets the bodies of this step, holding the solved velocities after Solve.
+         */
+        std::vector<SolverBody2D>& GetBodies() { return m_bodies; }
+
+        /**
+         * @brief Number of collider pairs whose impulses are kept for the next step.
+         */
+        size_t GetCachedContactCount() const { return m_cache.size(); }
+
+    private:
+        struct CachedPoint
+        {
+            glm::vec2 rA{ 0, 0 };        ///< Contact point relative to the first body
+            float normalImpulse = 0.0f;
+            float tangentImpulse = 0.0f;
+        };
+
+        struct CachedContact
+        {
+            CachedPoint points[Manifold2D::MaxPoints];
+            uint32_t pointCount = 0;
+            uint32_t step = 0; ///< Last step the pair was reported in
+        };
+
+        struct ContactPoint
+        {
+            glm::vec2 rA{ 0, 0 };        ///< Contact point relative to the first body
+            glm::vec2 rB{ 0, 0 };        ///< Contact point relative to the second body
+            float normalImpulse = 0.0f;  ///< Accumulated over the passes, never negative
+            float tangentImpulse = 0.0f; ///< Accumulated over the passes, within the friction cone
+            float normalMass = 0.0f;
+            float tangentMass = 0.0f;
+            float velocityBias = 0.0f;   ///< Separating speed restitution asks for
+        };
+
+        struct Contact
+        {
+            uint32_t bodyA = 0;
+            uint32_t bodyB = 0;
+            glm::vec2 normal{ 0, 0 };
+            float friction = 0.0f;
+            float restitution = 0.0f;
+            float penetrationDepth = 0.0f;
+            ContactPoint points[Manifold2D::MaxPoints];
+            uint32_t pointCount = 0;
+            CachedContact* cache = nullptr;
+
+            // Two points solved as one 2x2 system, K = [k11 k12; k12 k22], so neither end of a resting face is favoured
+            bool blockSolve = false;
+            float k11 = 0.0f;
+            float k12 = 0.0f;
+            float k22 = 0.0f;
+        };
+
+        void BuildIslands();
+        void SolveIsland(uint32_t island);
+        void PrepareContacts(size_t begin, size_t end);
+        void WarmStart(size_t begin, size_t end);
+        void SolveVelocities(size_t begin, size_t end);
+        void SolveNormalBlock(Contact& contact);
+        void SolvePositions(size_t begin, size_t end);
+        void StoreImpulses();
+
+        std::vector<SolverBody2D> m_bodies;
+        std::unordered_map<uint64_t, uint32_t> m_bodyIndices; ///< Body id to its index in m_bodies
+        std::vector<Contact> m_contacts;                ///< Sorted by island by BuildIslands
+        std::vector<Contact> m_unsortedContacts;        ///< Scratch for the sort
+        std::vector<uint32_t> m_islandContactStarts;    ///< Start of every island's contacts in m_contacts, then m_contacts.size()
+        std::unordered_map<ContactKey2D, CachedContact, ContactKeyHash2D> m_cache;
+        IslandBuilder m_islands;
+        uint32_t m_step = 0;
+    };
+}
@@ -0,0 +1,279 @@
+#include "acpch.h"
+#include "DynamicAABBTree2D.h"
+
+namespace ac
+{
+    DynamicAABBTree2D::DynamicAABBTree2D()
+        : m_root(NullNode)
+        , m_freeList(NullNode)
+        , m_proxyCount(0)
+    {
+    }
+
+    int32_t DynamicAABBTree2D::CreateProxy(const AABB2D& aabb, float margin, uint32_t layerBits, uint32_t userData)
+    {
+        int32_t proxy = AllocateNode();
+        Node& node = m_nodes[proxy];
+        node.aabb = aabb.Expanded(margin);
+        node.layerBits = layerBits;
+        node.userData = userData;
+        node.height = 0;
+        InsertLeaf(proxy);
+        ++m_proxyCount;
+        return proxy;
+    }
+
+    void DynamicAABBTree2D::DestroyProxy(int32_t proxy)
+    {
+        RemoveLeaf(proxy);
+        FreeNode(proxy);
+        --m_proxyCount;
+    }
+
+    bool DynamicAABBTree2D::MoveProxy(int32_t proxy, const AABB2D& aabb, float margin)
+    {
+        // Keep the proxy while the fat AABB still contains the box and has not grown far too big for it
+        const AABB2D& fat = m_nodes[proxy].aabb;
+        if (fat.Contains(aabb) && aabb.Expanded(4.0f * margin).Contains(fat))
+            return false;
+
+        RemoveLeaf(proxy);
+        m_nodes[proxy].aabb = aabb.Expanded(margin);
+        InsertLeaf(proxy);
+        return true;
+    }
+
+    void DynamicAABBTree2D::Clear()
+    {
+        m_nodes.clear();
+        m_root = NullNode;
+        m_freeList = NullNode;
+        m_proxyCount = 0;
+    }
+
+    int32_t DynamicAABBTree2D::AllocateNode()
+    {
+        if (m_freeList == NullNode)
+        {
+            m_nodes.emplace_back();
+            return static_cast<int32_t>(m_nodes.size() - 1);
+        }
+
+        int32_t node = m_freeList;
+        m_freeList = m_nodes[node].parent;
+        m_nodes[node] = Node();
+        return node;
+    }
+
+    void DynamicAABBTree2D::FreeNode(int32_t node)
+    {
+        m_nodes[node].parent = m_freeList;
+        m_nodes[node].height = -1;
+        m_freeList = node;
+    }
+
+    void DynamicAABBTree2D::InsertLeaf(int32_t leaf)
+    {
+        if (m_root == NullNode)
+        {
+            m_root = leaf;
+            m_nodes[leaf].parent = NullNode;
+            return;
+        }
+
+        // Walk down to the sibling that grows the total perimeter of the tree the least
+        AABB2D leafAABB = m_nodes[leaf].aabb;
+        int32_t index = m_root;
+        while (!m_nodes[index].IsLeaf())
+        {
+            const Node& node = m_nodes[index];
+            float perimeter = node.aabb.Perimeter();
+            float combinedPerimeter = AABB2D::Union(node.aabb, leafAABB).Perimeter();
+
+            // Cost of making a new parent for this node and the leaf
+            float cost = 2.0f * combinedPerimeter;
+            // Minimum cost of pushing the leaf further down, every ancestor grows by it
+            float inheritanceCost = 2.0f * (combinedPerimeter - perimeter);
+
+            auto descendCost = [&](int32_t child)
+                {
+                    const Node& c = m_nodes[child];
+                    float grown = AABB2D::Union(leafAABB, c.aabb).Perimeter();
+                    return (c.IsLeaf() ? grown : grown - c.aabb.Perimeter()) + inheritanceCost;
+                };
+            float cost1 = descendCost(node.child1);
+            float cost2 = descendCost(node.child2);
+
+            if (cost < cost1 && cost < cost2)
+                break;
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        // Replace the sibling with a new parent of the sibling and the leaf
+        int32_t sibling = index;
+        int32_t newParent = AllocateNode();
+        int32_t oldParent = m_nodes[sibling].parent;
+        Node& parent = m_nodes[newParent];
+        parent.parent = oldParent;
+        parent.aabb = AABB2D::Union(leafAABB, m_nodes[sibling].aabb);
+        parent.layerBits = m_nodes[leaf].layerBits | m_nodes[sibling].layerBits;
+        parent.height = m_nodes[sibling].height + 1;
+        parent.child1 = sibling;
+        parent.child2 = leaf;
+
+        if (oldParent != NullNode)
+        {
+            if (m_nodes[oldParent].child1 == sibling)
+                m_nodes[oldParent].child1 = newParent;
+            else
+                m_nodes[oldParent].child2 = newParent;
+        }
+        else
+        {
+            m_root = newParent;
+        }
+        m_nodes[sibling].parent = newParent;
+        m_nodes[leaf].parent = newParent;
+
+        Refit(m_nodes[leaf].parent);
+    }
+
+    void DynamicAABBTree2D::RemoveLeaf(int32_t leaf)
+    {
+        if (leaf == m_root)
+        {
+            m_root = NullNode;
+            return;
+        }
+
+        // The sibling takes the place of the parent
+        int32_t parent = m_nodes[leaf].parent;
+        int32_t grandParent = m_nodes[parent].parent;
+        int32_t sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+        if (grandParent != NullNode)
+        {
+            if (m_nodes[grandParent].child1 == parent)
+                m_nodes[grandParent].child1 = sibling;
+            else
+                m_nodes[grandParent].child2 = sibling;
+            m_nodes[sibling].parent = grandParent;
+            FreeNode(parent);
+            Refit(grandParent);
+        }
+        else
+        {
+            m_root = sibling;
+            m_nodes[sibling].parent = NullNode;
+            FreeNode(parent);
+        }
+    }
+
+    void DynamicAABBTree2D::Refit(int32_t index)
+    {
+        // Rebalance and recompute the bounds, heights and layer bits of every ancestor
+        while (index != NullNode)
+        {
+            index = Balance(index);
+
+            Node& node = m_nodes[index];
+            const Node& child1 = m_nodes[node.child1];
+            const Node& child2 = m_nodes[node.child2];
+            node.height = 1 + std::max(child1.height, child2.height);
+            node.aabb = AABB2D::Union(child1.aabb, child2.aabb);
+            node.layerBits = child1.layerBits | child2.layerBits;
+
+            index = node.parent;
+        }
+    }
+
+    int32_t DynamicAABBTree2D::Balance(int32_t iA)
+    {
+        Node& A = m_nodes[iA];
+        if (A.IsLeaf() || A.height < 2)
+            return iA;
+
+        int32_t iB = A.child1;
+        int32_t iC = A.child2;
+        Node& B = m_nodes[iB];
+        Node& C = m_nodes[iC];
+        int32_t balance = C.height - B.height;
+
+        // Makes iUp the parent of A in A's place
+        auto replaceInParent = [this, iA](Node& up, int32_t iUp)
+            {
+                up.parent = m_nodes[iA].parent;
+                m_nodes[iA].parent = iUp;
+                if (up.parent != NullNode)
+                {
+                    if (m_nodes[up.parent].child1 == iA)
+                        m_nodes[up.parent].child1 = iUp;
+                    else
+                        m_nodes[up.parent].child2 = iUp;
+                }
+                else
+                {
+                    m_root = iUp;
+                }
+            };
+
+        // Rotate C up
+        if (balance > 1)
+        {
+            int32_t iF = C.child1;
+            int32_t iG = C.child2;
+            Node& F = m_nodes[iF];
+            Node& G = m_nodes[iG];
+
+            C.child1 = iA;
+            replaceInParent(C, iC);
+
+            // The taller grandchild stays under C, the other one moves under A
+            Node& keep = F.height > G.height ? F : G;
+            Node& move = F.height > G.height ? G : F;
+            int32_t iKeep = F.height > G.height ? iF : iG;
+            int32_t iMove = F.height > G.height ? iG : iF;
+            C.child2 = iKeep;
+            A.child2 = iMove;
+            move.parent = iA;
+
+            A.aabb = AABB2D::Union(B.aabb, move.aabb);
+            A.layerBits = B.layerBits | move.layerBits;
+            A.height = 1 + std::max(B.height, move.height);
+            C.aabb = AABB2D::Union(A.aabb, keep.aabb);
+            C.layerBits = A.layerBits | keep.layerBits;
+            C.height = 1 + std::max(A.height, keep.height);
+            return iC;
+        }
+
+        // Rotate B up
+        if (balance < -1)
+        {
+            int32_t iD = B.child1;
+            int32_t iE = B.child2;
+            Node& D = m_nodes[iD];
+            Node& E = m_nodes[iE];
+
+            B.child1 = iA;
+            replaceInParent(B, iB);
+
+            Node& keep = D.height > E.height ? D : E;
+            Node& move = D.height > E.height ? E : D;
+            int32_t iKeep = D.height > E.height ? iD : iE;
+            int32_t iMove = D.height > E.height ? iE : iD;
+            B.child2 = iKeep;
+            A.child1 = iMove;
+            move.parent = iA;
+
+            A.aabb = AABB2D::Union(C.aabb, move.aabb);
+            A.layerBits = C.layerBits | move.layerBits;
+            A.height = 1 + std::max(C.height, move.height);
+            B.aabb = AABB2D::Union(A.aabb, keep.aabb);
+            B.layerBits = A.layerBits | keep.layerBits;
+            B.height = 1 + std::max(A.height, keep.height);
+            return iB;
+        }
+
+        return iA;
+    }
+}
@@ -0,0 +1,143 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "AABB2D.h"
+
+namespace ac
+{
+    /**
+     * @brief Bounding volume hierarchy over moving 2D boxes.
+     *
+     * Every proxy is a leaf holding a fat AABB, the box it was inserted with
+     * grown by a margin. Moving a proxy only touches the tree once its box
+     * leaves the fat AABB, so slow bodies are not reinserted every frame.
+     * Inner nodes hold the union of their children and are kept balanced by
+     * rotations, giving O(log n) inserts, removals and box queries.
+     *
+     * Each leaf also carries a layer bit, and inner nodes the OR of the bits
+     * below them, so queries skip whole subtrees no collider of the wanted
+     * layers lives in.
+     */
+    class DynamicAABBTree2D
+    {
+    public:
+        static constexpr int32_t NullNode = -1;
+
+        DynamicAABBTree2D();
+
+        /**
+         * @brief Inserts a proxy for a box.
+         *
+         * @param aabb The tight box of the proxy; it is stored grown by margin.
+         * @param margin How far the box may move before the proxy is reinserted.
+         * @param layerBits Layer bits of the proxy, matched against query masks.
+         * @param userData Value handed back by queries.
+         * @return Id of the proxy.
+         */
+        int32_t CreateProxy(const AABB2D& aabb, float margin, uint32_t layerBits, uint32_t userData);
+
+        /**
+         * @brief Removes a proxy; its id may be handed out again.
+         */
+        void DestroyProxy(int32_t proxy);
+
+        /**
+         * @brief Updates the box of a proxy.
+         *
+         * @param proxy Id returned by CreateProxy.
+         * @param aabb The new tight box.
+         * @param margin Margin of the fat AABB if the proxy has to be reinserted.
+         * @return True if the box left the fat AABB and the proxy was reinserted.
+         */
+        bool MoveProxy(int32_t proxy, const AABB2D& aabb, float margin);
+
+        /**
+         * @brief Returns the fat AABB of a proxy.
+         */
+        const AABB2D& GetFatAABB(int32_t proxy) const { return m_nodes[proxy].aabb; }
+
+        /**
+         * @brief Returns the value passed to CreateProxy or SetUserData.
+         */
+        uint32_t GetUserData(int32_t proxy) const { return m_nodes[proxy].userData; }
+
+        /**
+         * @brief Replaces the value queries hand back for a proxy.
+         */
+        void SetUserData(int32_t proxy, uint32_t userData) { m_nodes[proxy].userData = userData; }
+
+        /**
+         * @brief Calls callback(proxy) for every proxy whose fat AABB overlaps aabb and whose layer bits intersect layerMask.
+         *
+         * Thread-safe as long as the tree is not modified at the same time.
+         */
+        template <class Func>
+        void Query(const AABB2D& aabb, uint32_t layerMask, Func&& callback) const
+        {
+            if (m_root == NullNode)
+                return;
+
+            // A balanced tree of 2^32 leaves is less than 64 levels deep, and at most one sibling per level waits on the stack
+            int32_t stack[128];
+            int32_t count = 0;
+            stack[count++] = m_root;
+            while (count > 0)
+            {
+                const Node& node = m_nodes[stack[--count]];
+                if ((node.layerBits & layerMask) == 0 || !node.aabb.Overlaps(aabb))
+                    continue;
+
+                if (node.IsLeaf())
+                {
+                    callback(static_cast<int32_t>(&node - m_nodes.data()));
+                }
+                else
+                {
+                    stack[count++] = node.child1;
+                    stack[count++] = node.child2;
+                }
+            }
+        }
+
+        /**
+         * @brief Removes every proxy.
+         */
+        void Clear();
+
+        /**
+         * @brief Number of proxies in the tree.
+         */
+        size_t GetProxyCount() const { return m_proxyCount; }
+
+        /**
+         * @brief Height of the root, 0 for a single leaf and -1 for an empty tree.
+         */
+        int32_t GetHeight() const { return m_root == NullNode ? -1 : m_nodes[m_root].height; }
+
+    private:
+        struct Node
+        {
+            AABB2D aabb;
+            uint32_t layerBits = 0;
+            uint32_t userData = 0;
+            int32_t parent = NullNode; ///< Parent node, or the next free node while on the free list
+            int32_t child1 = NullNode;
+            int32_t child2 = NullNode;
+            int32_t height = 0;        ///< 0 for leaves, -1 for free nodes
+
+            bool IsLeaf() const { return child1 == NullNode; }
+        };
+
+        int32_t AllocateNode();
+        void FreeNode(int32_t node);
+        void InsertLeaf(int32_t leaf);
+        void RemoveLeaf(int32_t leaf);
+        int32_t Balance(int32_t node);
+        void Refit(int32_t node);
+
+        std::vector<Node> m_nodes;
+        int32_t m_root;
+        int32_t m_freeList;
+        size_t m_proxyCount;
+    };
+}
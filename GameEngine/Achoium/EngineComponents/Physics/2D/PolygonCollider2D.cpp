@@ -1,6 +1,7 @@
 #include "acpch.h"
 #include "PolygonCollider2D.h"
 #include "CircleCollider2D.h"
+#include "RectCollider2D.h"
 #include "Math/Transform.h"
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/norm.hpp>
@@ -10,7 +11,7 @@
 namespace ac
 {
     PolygonCollider2D::PolygonCollider2D()
-        : Collider2D()
+        : Collider2D(ColliderType2D::Polygon)
     {
         // Create a default triangle
         m_vertices.push_back(glm::vec2(-0.5f, -0.5f));
@@ -19,7 +20,7 @@ namespace ac
     }
     
     PolygonCollider2D::PolygonCollider2D(const std::vector<glm::vec2>& _vertices)
-        : Collider2D()
+        : Collider2D(ColliderType2D::Polygon)
         , m_vertices(_vertices)
     {
         // Ensure we have at least 3 vertices for a valid polygon
@@ -34,7 +35,7 @@ namespace ac
     }
     
     PolygonCollider2D::PolygonCollider2D(const std::vector<glm::vec2>& _vertices, const glm::vec2& _offset, uint32_t _layer, bool _isTrigger)
-        : Collider2D(_layer)
+        : Collider2D(ColliderType2D::Polygon, _layer)
         , m_vertices(_vertices)
     {
         offset = _offset;
@@ -67,6 +68,20 @@ namespace ac
         return worldVertices;
     }
     
+    void PolygonCollider2D::UpdateWorldVertices(const Transform& transform)
+    {
+        // Only grows the cache when the vertex count changes, so steady frames do not allocate
+        if (m_worldVertices.size() != m_vertices.size())
+            m_worldVertices.resize(m_vertices.size());
+        
+        glm::mat4 modelMatrix = transform.asMat4();
+        for (size_t i = 0; i < m_vertices.size(); ++i)
+        {
+            glm::vec4 worldPos = modelMatrix * glm::vec4(m_vertices[i].x, m_vertices[i].y, 0.0f, 1.0f);
+            m_worldVertices[i] = glm::vec2(worldPos.x, worldPos.y);
+        }
+    }
+    
     std::vector<glm::vec2> PolygonCollider2D::GetEdges() const
     {
         std::vector<glm::vec2> edges(m_vertices.size());
@@ -80,29 +95,23 @@ namespace ac
         return edges;
     }
     
-    bool PolygonCollider2D::CheckCollision(
-        const Collider2D* other,
-        const Transform& myTransform,
-        const Transform& otherTransform,
-        std::vector<CollisionPoint2D>& collisionPoints,
-        glm::vec2& collisionNormal,
-        float& penetrationDepth
-    ) const
+    AABB2D PolygonCollider2D::GetWorldAABB(const Transform& transform) const
     {
-        // Check what type of collider we're colliding with and delegate to specific function
-        if (const PolygonCollider2D* otherPolygon = dynamic_cast<const PolygonCollider2D*>(other))
+        if (m_vertices.empty())
         {
-            return PolygonVsPolygon(otherPolygon, myTransform, otherTransform, 
-                collisionPoints, collisionNormal, penetrationDepth);
+            glm::vec2 position(transform.position.x, transform.position.y);
+            return { position, position };
         }
-        else if (const CircleCollider2D* otherCircle = dynamic_cast<const CircleCollider2D*>(other))
+
+        glm::mat4 modelMatrix = transform.asMat4();
+        AABB2D bounds{ glm::vec2(std::numeric_limits<float>::max()), glm::vec2(std::numeric_limits<float>::lowest()) };
+        for (const glm::vec2& vertex : m_vertices)
         {
-            return PolygonVsCircle(otherCircle, myTransform, otherTransform, 
-                collisionPoints, collisionNormal, penetrationDepth);
+            glm::vec4 worldPos = modelMatrix * glm::vec4(vertex.x, vertex.y, 0.0f, 1.0f);
+            bounds.min = glm::min(bounds.min, glm::vec2(worldPos.x, worldPos.y));
+            bounds.max = glm::max(bounds.max, glm::vec2(worldPos.x, worldPos.y));
         }
-        
-        // Unsupported collider type
-        return false;
+        return bounds;
     }
     
     glm::vec2 PolygonCollider2D::FindClosestPoint(const glm::vec2& point) const
@@ -265,97 +274,92 @@ namespace ac
     
     bool PolygonCollider2D::PolygonVsPolygon(
         const PolygonCollider2D* other,
-        const Transform& myTransform,
+        const Transform& /*myTransform*/,
+        const Transform& /*otherTransform*/,
+        Manifold2D& manifold
+    ) const
+    {
+        return RectCollider2D::ConvexVsConvex(m_worldVertices.data(), m_worldVertices.size(),
+            other->m_worldVertices.data(), other->m_worldVertices.size(), manifold);
+    }
+    
+    bool PolygonCollider2D::PolygonVsCircle(
+        const CircleCollider2D* circle,
+        const Transform& /*myTransform*/,
         const Transform& otherTransform,
-        std::vector<CollisionPoint2D>& collisionPoints,
-        glm::vec2& collisionNormal,
-        float& penetrationDepth
+        Manifold2D& manifold
     ) const
     {
-        // Get vertices and edges in world space
-        std::vector<glm::vec2> myVerticesWorld = GetWorldVertices(myTransform);
-        std::vector<glm::vec2> otherVerticesWorld = other->GetWorldVertices(otherTransform);
+        const std::vector<glm::vec2>& vertices = m_worldVertices;
+        glm::vec2 center = circle->GetWorldPosition(otherTransform);
+        size_t count = vertices.size();
         
-        // Calculate edges
-        std::vector<glm::vec2> myEdges(myVerticesWorld.size());
-        std::vector<glm::vec2> otherEdges(otherVerticesWorld.size());
-        
-        // Generate edges for my shape
-        for (size_t i = 0; i < myVerticesWorld.size(); ++i)
+        // Outward edge normals are on the right of counterclockwise edges; a mirroring transform flips the winding
+        float area = 0.0f;
+        for (size_t i = 0; i < count; ++i)
         {
-            size_t j = (i + 1) % myVerticesWorld.size();
-            myEdges[i] = myVerticesWorld[j] - myVerticesWorld[i];
+            const glm::vec2& v1 = vertices[i];
+            const glm::vec2& v2 = vertices[(i + 1) % count];
+            area += v1.x * v2.y - v2.x * v1.y;
         }
+        float winding = area < 0.0f ? -1.0f : 1.0f;
         
-        // Generate edges for other shape
-        for (size_t i = 0; i < otherVerticesWorld.size(); ++i)
+        // Find the edge the circle center is furthest outside of
+        float separation = -std::numeric_limits<float>::max();
+        size_t bestEdge = 0;
+        glm::vec2 bestNormal(0.0f, 1.0f);
+        for (size_t i = 0; i < count; ++i)
         {
-            size_t j = (i + 1) % otherVerticesWorld.size();
-            otherEdges[i] = otherVerticesWorld[j] - otherVerticesWorld[i];
+            glm::vec2 edge = vertices[(i + 1) % count] - vertices[i];
+            float length = glm::length(edge);
+            if (length < 0.0001f) continue; // Skip degenerate edges
+            
+            glm::vec2 normal = glm::vec2(edge.y, -edge.x) * (winding / length);
+            float distance = glm::dot(normal, center - vertices[i]);
+            if (distance > circle->radius)
+                return false; // Separating axis found
+            
+            if (distance > separation)
+            {
+                separation = distance;
+                bestEdge = i;
+                bestNormal = normal;
+            }
         }
         
-        // Check my axes
-        glm::vec2 axisA;
-        float depthA;
-        bool collideA = FindMinimumPenetration(
-            myEdges, myVerticesWorld, otherEdges, otherVerticesWorld, 
-            axisA, depthA
-        );
-        
-        if (!collideA)
-            return false;
+        glm::vec2 v1 = vertices[bestEdge];
+        glm::vec2 v2 = vertices[(bestEdge + 1) % count];
+        glm::vec2 closestPoint;
         
-        // Check other's axes
-        glm::vec2 axisB;
-        float depthB;
-        bool collideB = FindMinimumPenetration(
-            otherEdges, otherVerticesWorld, myEdges, myVerticesWorld, 
-            axisB, depthB
-        );
-        
-        if (!collideB)
-            return false;
-        
-        // Use the smaller penetration for the result
-        if (depthA < depthB)
+        if (separation < 0.0001f)
         {
-            collisionNormal = glm::vec3(axisA.x, axisA.y, 0.0f);
-            penetrationDepth = depthA;
+            // Circle center is inside the polygon, push it out through the closest edge
+            manifold.normal = bestNormal;
+            manifold.penetrationDepth = circle->radius - separation;
+            closestPoint = center - bestNormal * separation;
+        }
+        else if (glm::dot(center - v1, v2 - v1) <= 0.0f || glm::dot(center - v2, v1 - v2) <= 0.0f)
+        {
+            // Circle center is beyond the end of the edge, so the closest feature is a vertex
+            closestPoint = glm::dot(center - v1, v2 - v1) <= 0.0f ? v1 : v2;
+            glm::vec2 difference = center - closestPoint;
+            float distanceSq = glm::length2(difference);
+            if (distanceSq > circle->radius * circle->radius)
+                return false;
+            
+            float distance = glm::sqrt(distanceSq);
+            manifold.normal = distance > 0.0001f ? difference / distance : bestNormal;
+            manifold.penetrationDepth = circle->radius - distance;
         }
         else
         {
-            collisionNormal = glm::vec3(-axisB.x, -axisB.y, 0.0f);
-            penetrationDepth = depthB;
+            // Circle center faces the edge
+            manifold.normal = bestNormal;
+            manifold.penetrationDepth = circle->radius - separation;
+            closestPoint = center - bestNormal * separation;
         }
         
-        // Calculate contact point (approximate with centroid of intersection)
-        glm::vec2 center1 = std::accumulate(myVerticesWorld.begin(), myVerticesWorld.end(), glm::vec2(0.0f)) 
-                            / static_cast<float>(myVerticesWorld.size());
-        glm::vec2 center2 = std::accumulate(otherVerticesWorld.begin(), otherVerticesWorld.end(), glm::vec2(0.0f)) 
-                            / static_cast<float>(otherVerticesWorld.size());
-        
-        
+        manifold.AddPoint({ closestPoint, center - manifold.normal * circle->radius });
         return true;
     }
-    
-    bool PolygonCollider2D::PolygonVsCircle(
-        const CircleCollider2D* circle,
-        const Transform& myTransform,
-        const Transform& otherTransform,
-        std::vector<CollisionPoint2D>& collisionPoints,
-        glm::vec2& collisionNormal,
-        float& penetrationDepth
-    ) const
-    {
-        // Delegate to the circle's implementation but flip the normal
-        //bool result = circle->CircleVsPolygon(this, otherTransform, myTransform,
-                                            //collisionPoints, collisionNormal, penetrationDepth);
-        
-        //if (result)
-        //{
-        //    collisionNormal = -collisionNormal;
-        //}
-        
-        return false;
-    }
 }
\ No newline at end of file
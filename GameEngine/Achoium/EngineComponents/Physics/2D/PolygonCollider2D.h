@@ -57,6 +57,20 @@ namespace ac
          * @return The vertices in counterclockwise order
          */
         std::vector<glm::vec2> GetWorldVertices(const Transform& transform) const;
+
+        /**
+         * @brief Caches the world-space vertices used by the narrowphase.
+         * 
+         * @param transform The entity's transform component
+         */
+        virtual void UpdateWorldVertices(const Transform& transform) override;
+
+        /**
+         * @brief Gets the world-space vertices cached by the last UpdateWorldVertices call.
+         * 
+         * @return The vertices in counterclockwise order
+         */
+        const std::vector<glm::vec2>& GetCachedWorldVertices() const { return m_worldVertices; }
         
         /**
          * @brief Gets the local-space edges of the polygon.
@@ -66,18 +80,12 @@ namespace ac
         std::vector<glm::vec2> GetEdges() const;
 
         /**
-         * @brief Implements collision detection for this polygon collider.
+         * @brief Computes the world-space bounds of the collider.
          * 
-         * Checks for collision with another collider and outputs collision data.
+         * @param transform The entity's transform component
+         * @return Box containing the collider
          */
-        virtual bool CheckCollision(
-            const Collider2D* other,
-            const Transform& myTransform,
-            const Transform& otherTransform,
-            std::vector<CollisionPoint2D>& collisionPoints,
-            glm::vec2& collisionNormal,
-            float& penetrationDepth
-        ) const override;
+        virtual AABB2D GetWorldAABB(const Transform& transform) const override;
         
         /**
          * @brief Finds the closest point on the polygon to the given point.
@@ -123,12 +131,11 @@ namespace ac
             const PolygonCollider2D* other,
             const Transform& myTransform,
             const Transform& otherTransform,
-            std::vector<CollisionPoint2D>& collisionPoints,
-            glm::vec2& collisionNormal,
-            float& penetrationDepth
+            Manifold2D& manifold
         ) const;
 
         std::vector<glm::vec2> m_vertices; ///< Local-space vertices of the polygon
+        std::vector<glm::vec2> m_worldVertices; ///< World-space vertices from the last UpdateWorldVertices call
         
         /**
          * @brief Circle vs Polygon collision detection.
@@ -137,9 +144,7 @@ namespace ac
             const class CircleCollider2D* circle,
             const Transform& myTransform,
             const Transform& otherTransform,
-            std::vector<CollisionPoint2D>& collisionPoints,
-            glm::vec2& collisionNormal,
-            float& penetrationDepth
+            Manifold2D& manifold
         ) const;
     };
 }
\ No newline at end of file
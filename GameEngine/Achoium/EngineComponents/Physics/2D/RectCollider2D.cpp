@@ -10,19 +10,19 @@
 namespace ac
 {
     RectCollider2D::RectCollider2D()
-        : Collider2D()
+        : Collider2D(ColliderType2D::Rect)
         , halfSize(0.5f, 0.5f)
     {
     }
     
     RectCollider2D::RectCollider2D(float width, float height)
-        : Collider2D()
+        : Collider2D(ColliderType2D::Rect)
         , halfSize(width * 0.5f, height * 0.5f)
     {
     }
     
     RectCollider2D::RectCollider2D(float width, float height, const glm::vec2& _offset, uint32_t _layer, bool _isTrigger)
-        : Collider2D(_layer)
+        : Collider2D(ColliderType2D::Rect, _layer)
         , halfSize(width * 0.5f, height * 0.5f)
     {
         offset = _offset;
@@ -65,137 +65,125 @@ namespace ac
         return worldVertices;
     }
     
-    bool RectCollider2D::CheckCollision(
-        const Collider2D* other,
-        const Transform& myTransform,
-        const Transform& otherTransform,
-        std::vector<CollisionPoint2D>& collisionPoints,
-        glm::vec2& collisionNormal,
-        float& penetrationDepth
-    ) const
+    AABB2D RectCollider2D::GetWorldAABB(const Transform& transform) const
     {
-        // Check what type of collider we're colliding with and delegate to specific function
-        if (const RectCollider2D* otherRect = dynamic_cast<const RectCollider2D*>(other))
-        {
-            return RectVsRect(otherRect, myTransform, otherTransform, 
-                collisionPoints, collisionNormal, penetrationDepth);
+        // Same model matrix as GetWorldVertices; the extents are the projections of the rotated half axes
+        glm::mat4 modelMatrix = transform.asMat4();
+        if (glm::length2(offset) > 0.0001f) {
+            modelMatrix = glm::translate(modelMatrix, glm::vec3(offset, 0));
         }
-        else if (const CircleCollider2D* otherCircle = dynamic_cast<const CircleCollider2D*>(other))
-        {
-            return RectVsCircle(otherCircle, myTransform, otherTransform, 
-                collisionPoints, collisionNormal, penetrationDepth);
+        glm::vec2 center(modelMatrix[3].x, modelMatrix[3].y);
+        glm::vec2 axisX = glm::vec2(modelMatrix[0].x, modelMatrix[0].y) * halfSize.x;
+        glm::vec2 axisY = glm::vec2(modelMatrix[1].x, modelMatrix[1].y) * halfSize.y;
+        glm::vec2 extents = glm::abs(axisX) + glm::abs(axisY);
+        return { center - extents, center + extents };
+    }
+    
+    void RectCollider2D::UpdateWorldVertices(const Transform& transform)
+    {
+        // Same model matrix as GetWorldVertices, written into the cache instead of a new vector
+        glm::mat4 modelMatrix = transform.asMat4();
+        if (glm::length2(offset) > 0.0001f) {
+            modelMatrix = glm::translate(modelMatrix, glm::vec3(offset, 0));
         }
-        else if (const PolygonCollider2D* otherPolygon = dynamic_cast<const PolygonCollider2D*>(other))
+        
+        const glm::vec2 localVertices[4] = {
+            glm::vec2(-halfSize.x, -halfSize.y),
+            glm::vec2(halfSize.x, -halfSize.y),
+            glm::vec2(halfSize.x, halfSize.y),
+            glm::vec2(-halfSize.x, halfSize.y)
+        };
+        for (size_t i = 0; i < 4; ++i)
         {
-            return RectVsPolygon(otherPolygon, myTransform, otherTransform, 
-                collisionPoints, collisionNormal, penetrationDepth);
+            glm::vec4 worldPos = modelMatrix * glm::vec4(localVertices[i].x, localVertices[i].y, 0.0f, 1.0f);
+            m_worldVertices[i] = glm::vec2(worldPos.x, worldPos.y);
         }
-        
-        // Unsupported collider type
-        return false;
     }
     
     bool RectCollider2D::RectVsRect(
         const RectCollider2D* other,
-        const Transform& myTransform,
-        const Transform& otherTransform,
-        std::vector<CollisionPoint2D>& collisionPoints,
-        glm::vec2& collisionNormal,
-        float& penetrationDepth
+        const Transform& /*myTransform*/,
+        const Transform& /*otherTransform*/,
+        Manifold2D& manifold
     ) const
     {
-        // Get vertices in world space
-        std::vector<glm::vec2> myVertices = GetWorldVertices(myTransform);
-        std::vector<glm::vec2> otherVertices = other->GetWorldVertices(otherTransform);
-        
+        return ConvexVsConvex(m_worldVertices, 4, other->m_worldVertices, 4, manifold);
+    }
+    
+    bool RectCollider2D::ConvexVsConvex(
+        const glm::vec2* myVertices,
+        size_t myCount,
+        const glm::vec2* otherVertices,
+        size_t otherCount,
+        Manifold2D& manifold
+    )
+    {
         // Implement SAT for collision detection
         float minPenetration = std::numeric_limits<float>::max();
         glm::vec2 bestAxis;
-        bool hasCollision = true;
-        std::vector<glm::vec2> axes;
         
-        // Get all potential axes to test (edges from both rectangles)
-        // Collect axes from my edges
-        for (size_t i = 0; i < myVertices.size(); ++i)
-        {
-            size_t j = (i + 1) % myVertices.size();
-            glm::vec2 edge = myVertices[j] - myVertices[i];
-            glm::vec2 axis(-edge.y, edge.x);
-            float length = glm::length(axis);
-            if (length < 0.0001f) continue;
-            
-            axes.push_back(axis / length); // Normalize
-        }
-        
-        // Collect axes from other's edges
-        for (size_t i = 0; i < otherVertices.size(); ++i)
-        {
-            size_t j = (i + 1) % otherVertices.size();
-            glm::vec2 edge = otherVertices[j] - otherVertices[i];
-            glm::vec2 axis(-edge.y, edge.x);
-            float length = glm::length(axis);
-            if (length < 0.0001f) continue;
-            
-            axes.push_back(axis / length); // Normalize
-        }
-        
-        // Test all axes
-        for (const auto& axis : axes)
-        {
-            // Project both shapes onto the axis
-            float minA = std::numeric_limits<float>::max();
-            float maxA = -std::numeric_limits<float>::max();
-            float minB = std::numeric_limits<float>::max();
-            float maxB = -std::numeric_limits<float>::max();
-            
-            // Project vertices of rectangle A
-            for (const auto& vertex : myVertices)
-            {
-                float projection = glm::dot(axis, vertex);
-                minA = std::min(minA, projection);
-                maxA = std::max(maxA, projection);
-            }
-            
-            // Project vertices of rectangle B
-            for (const auto& vertex : otherVertices)
-            {
-                float projection = glm::dot(axis, vertex);
-                minB = std::min(minB, projection);
-                maxB = std::max(maxB, projection);
-            }
-            
-            // Check for separation
-            if (minA > maxB || minB > maxA)
+        // Test the edge normals of one shape as potential axes; returns false on a separating axis
+        auto testAxes = [&](const glm::vec2* vertices, size_t count)
             {
-                // Separating axis found, no collision
-                hasCollision = false;
-                break;
-            }
-            
-            // Calculate penetration depth
-            float overlap = std::min(maxA - minB, maxB - minA);
-            
-            // Track minimum penetration for collision response
-            if (overlap < minPenetration)
-            {
-                minPenetration = overlap;
-                bestAxis = axis;
-                
-                // Ensure the normal points from A to B
-                float centerA = (minA + maxA) * 0.5f;
-                float centerB = (minB + maxB) * 0.5f;
-                if (centerA > centerB)
+                for (size_t i = 0; i < count; ++i)
                 {
-                    bestAxis = -bestAxis;
+                    size_t j = (i + 1) % count;
+                    glm::vec2 edge = vertices[j] - vertices[i];
+                    glm::vec2 axis(-edge.y, edge.x);
+                    float length = glm::length(axis);
+                    if (length < 0.0001f) continue;
+                    axis /= length; // Normalize
+                    
+                    // Project both shapes onto the axis
+                    float minA = std::numeric_limits<float>::max();
+                    float maxA = -std::numeric_limits<float>::max();
+                    float minB = std::numeric_limits<float>::max();
+                    float maxB = -std::numeric_limits<float>::max();
+                    
+                    for (size_t k = 0; k < myCount; ++k)
+                    {
+                        float projection = glm::dot(axis, myVertices[k]);
+                        minA = std::min(minA, projection);
+                        maxA = std::max(maxA, projection);
+                    }
+                    
+                    for (size_t k = 0; k < otherCount; ++k)
+                    {
+                        float projection = glm::dot(axis, otherVertices[k]);
+                        minB = std::min(minB, projection);
+                        maxB = std::max(maxB, projection);
+                    }
+                    
+                    // Separating axis found, no collision
+                    if (minA > maxB || minB > maxA)
+                        return false;
+                    
+                    // Track minimum penetration for collision response
+                    float overlap = std::min(maxA - minB, maxB - minA);
+                    if (overlap < minPenetration)
+                    {
+                        minPenetration = overlap;
+                        bestAxis = axis;
+                        
+                        // Ensure the normal points from A to B
+                        float centerA = (minA + maxA) * 0.5f;
+                        float centerB = (minB + maxB) * 0.5f;
+                        if (centerA > centerB)
+                        {
+                            bestAxis = -bestAxis;
+                        }
+                    }
                 }
-            }
-        }
+                return true;
+            };
         
-        if (!hasCollision) return false;
+        // Axes from my edges, then from the other's edges
+        if (!testAxes(myVertices, myCount) || !testAxes(otherVertices, otherCount))
+            return false;
         
         // Set collision normal and penetration depth
-        collisionNormal = glm::vec3(bestAxis.x, bestAxis.y, 0.0f);
-        penetrationDepth = minPenetration;
+        manifold.normal = bestAxis;
+        manifold.penetrationDepth = minPenetration;
         
         // Find the contact points - this is what needs improvement
         
@@ -207,7 +195,7 @@ namespace ac
             float dot;
         };
         
-		glm::vec2 collisionNormal2D = glm::vec2(collisionNormal.x, collisionNormal.y);
+		glm::vec2 collisionNormal2D = manifold.normal;
 
         Face referenceFace{};
         Face incidentFace{};
@@ -219,8 +207,8 @@ namespace ac
 		float mnProjectionOnNormal = std::numeric_limits<float>::max();
         
         // Check my faces
-        for (size_t i = 0; i < myVertices.size(); i++) {
-            size_t j = (i + 1) % myVertices.size();
+        for (size_t i = 0; i < myCount; i++) {
+            size_t j = (i + 1) % myCount;
             glm::vec2 edge = myVertices[j] - myVertices[i];
             glm::vec2 normal(-edge.y, edge.x);
 			float myMxProjectionOnNormal = std::max(glm::dot(collisionNormal2D, myVertices[j]), glm::dot(collisionNormal2D, myVertices[i]));
@@ -250,8 +238,8 @@ namespace ac
         }
         mnDot = std::numeric_limits<float>::max();
         // Check other faces
-        for (size_t i = 0; i < otherVertices.size(); i++) {
-            size_t j = (i + 1) % otherVertices.size();
+        for (size_t i = 0; i < otherCount; i++) {
+            size_t j = (i + 1) % otherCount;
             glm::vec2 edge = otherVertices[j] - otherVertices[i];
             glm::vec2 normal(-edge.y, edge.x);
             normal = glm::normalize(normal);
@@ -308,45 +296,39 @@ namespace ac
         
         // Clip incident face to reference face side planes
         // Side 1
-        std::vector<glm::vec2> clippedPoints;
-        ClipSegmentToLine(incidentFace.startPoint, incidentFace.endPoint, refFaceNormal, offset1, clippedPoints);
-        if (clippedPoints.size() > 1)
+        glm::vec2 clippedPoints[2];
+        size_t clippedCount = ClipSegmentToLine(incidentFace.startPoint, incidentFace.endPoint, refFaceNormal, offset1, clippedPoints);
+        if (clippedCount > 1)
         {
-            glm::vec2 v1 = clippedPoints[0], v2 = clippedPoints[1];
-            clippedPoints.clear();
-            ClipSegmentToLine(v1, v2, refEdge, offset2, clippedPoints);
+            clippedCount = ClipSegmentToLine(clippedPoints[0], clippedPoints[1], refEdge, offset2, clippedPoints);
         }
-        if (clippedPoints.size() > 1)
+        if (clippedCount > 1)
         {
-            glm::vec2 v1 = clippedPoints[0], v2 = clippedPoints[1];
-            clippedPoints.clear();
-            ClipSegmentToLine(v1, v2, -refEdge, offset3, clippedPoints);
+            clippedCount = ClipSegmentToLine(clippedPoints[0], clippedPoints[1], -refEdge, offset3, clippedPoints);
         }
 
         
-        if (clippedPoints.empty()) {
+        if (clippedCount == 0) {
             // Use approximate method as above
             glm::vec3 myCenter(0.0f);
-            for (const auto& vertex : myVertices) {
-                myCenter += glm::vec3(vertex.x, vertex.y, 0.0f);
+            for (size_t i = 0; i < myCount; ++i) {
+                myCenter += glm::vec3(myVertices[i].x, myVertices[i].y, 0.0f);
             }
-            myCenter /= static_cast<float>(myVertices.size());
+            myCenter /= static_cast<float>(myCount);
             
             glm::vec3 otherCenter(0.0f);
-            for (const auto& vertex : otherVertices) {
-                otherCenter += glm::vec3(vertex.x, vertex.y, 0.0f);
+            for (size_t i = 0; i < otherCount; ++i) {
+                otherCenter += glm::vec3(otherVertices[i].x, otherVertices[i].y, 0.0f);
             }
-            otherCenter /= static_cast<float>(otherVertices.size());
+            otherCenter /= static_cast<float>(otherCount);
             
             glm::vec2 p = (myCenter + otherCenter) * 0.5f;
-            collisionPoints.push_back({ p,p });
+            manifold.AddPoint({ p,p });
         } else {
-			glm::vec2 averagePoint(0.0f);
-            for(const auto& point : clippedPoints) {
-				averagePoint += point;
-			}
-			averagePoint /= static_cast<float>(clippedPoints.size());
-			collisionPoints.push_back({ averagePoint, averagePoint });
+            // Both ends of the clipped edge, so a resting face is held at two points and cannot pivot
+            for (size_t i = 0; i < clippedCount; ++i) {
+                manifold.AddPoint({ clippedPoints[i], clippedPoints[i] });
+            }
         }
         
         return true;
@@ -356,9 +338,7 @@ namespace ac
         const CircleCollider2D* circle,
         const Transform& myTransform,
         const Transform& circleTransform,
-        std::vector<CollisionPoint2D>& collisionPoints,
-        glm::vec2& collisionNormal,
-        float& penetrationDepth
+        Manifold2D& manifold
     ) const
     {
         // Get world positions
@@ -431,26 +411,26 @@ namespace ac
             
             // Transform the normal from local to world space
             glm::vec4 worldNormal = glm::transpose(rectWorldToLocal) * glm::vec4(localNormal, 0.0f);
-            collisionNormal = glm::normalize(glm::vec3(worldNormal));
+            manifold.normal = glm::normalize(glm::vec3(worldNormal));
             
             // Calculate the penetration depth (include circle radius)
-            penetrationDepth = minPenetration + circle->radius;
+            manifold.penetrationDepth = minPenetration + circle->radius;
             
             // Set collision point at circle center
-            collisionPoints.push_back({ closestPointWorld, circleCenter });
+            manifold.AddPoint({ closestPointWorld, circleCenter });
         }
         else
         {
             // Normal conversion from local to world
             glm::vec3 localNormal = glm::normalize(difference);
             glm::vec4 worldNormal = glm::transpose(rectWorldToLocal) * glm::vec4(localNormal, 0.0f);
-            collisionNormal = glm::normalize(glm::vec3(worldNormal));
+            manifold.normal = glm::normalize(glm::vec3(worldNormal));
             
             // Set collision point at the closest point on the rectangle
-            collisionPoints.push_back({ closestPointWorld, circleCenter + -collisionNormal * circle->radius });
+            manifold.AddPoint({ closestPointWorld, circleCenter + -manifold.normal * circle->radius });
             
             // Calculate penetration depth
-            penetrationDepth = circle->radius - distance;
+            manifold.penetrationDepth = circle->radius - distance;
         }
         
         return true;
@@ -458,214 +438,52 @@ namespace ac
     
     bool RectCollider2D::RectVsPolygon(
         const PolygonCollider2D* polygon,
-        const Transform& myTransform,
-        const Transform& polygonTransform,
-        std::vector<CollisionPoint2D>& collisionPoints,
-        glm::vec2& collisionNormal,
-        float& penetrationDepth
+        const Transform& /*myTransform*/,
+        const Transform& /*polygonTransform*/,
+        Manifold2D& manifold
     ) const
     {
-        // Convert rectangle to polygon and use polygon-polygon collision
-        std::vector<glm::vec2> myVertices = GetWorldVertices(myTransform);
-        std::vector<glm::vec2> polyVertices = polygon->GetWorldVertices(polygonTransform);
-        
-        // Generate edges for rectangle
-        std::vector<glm::vec2> myEdges(myVertices.size());
-        for (size_t i = 0; i < myVertices.size(); ++i)
-        {
-            size_t j = (i + 1) % myVertices.size();
-            myEdges[i] = myVertices[j] - myVertices[i];
-        }
-        
-        // Generate edges for polygon
-        std::vector<glm::vec2> polyEdges(polyVertices.size());
-        for (size_t i = 0; i < polyVertices.size(); ++i)
-        {
-            size_t j = (i + 1) % polyVertices.size();
-            polyEdges[i] = polyVertices[j] - polyVertices[i];
-        }
-        
-        // Implement the SAT for collision detection
-        float minPenetration = std::numeric_limits<float>::max();
-        glm::vec2 bestAxis;
-        bool hasCollision = true;
-        
-        // Check rectangle's axes
-        for (const auto& edge : myEdges)
-        {
-            // Calculate the perpendicular axis for projection
-            glm::vec2 axis(-edge.y, edge.x);
-            float length = glm::length(axis);
-            if (length < 0.0001f) continue; // Skip degenerate edges
-            
-            axis = axis / length; // Normalize
-            
-            // Project both shapes onto the axis
-            float minA = std::numeric_limits<float>::max();
-            float maxA = -std::numeric_limits<float>::max();
-            float minB = std::numeric_limits<float>::max();
-            float maxB = -std::numeric_limits<float>::max();
-            
-            // Project rectangle vertices
-            for (const auto& vertex : myVertices)
-            {
-                float projection = glm::dot(axis, vertex);
-                minA = std::min(minA, projection);
-                maxA = std::max(maxA, projection);
-            }
-            
-            // Project polygon vertices
-            for (const auto& vertex : polyVertices)
-            {
-                float projection = glm::dot(axis, vertex);
-                minB = std::min(minB, projection);
-                maxB = std::max(maxB, projection);
-            }
-            
-            // Check for separation
-            if (minA > maxB || minB > maxA)
-            {
-                // Separating axis found, no collision
-                hasCollision = false;
-                break;
-            }
-            
-            // Calculate penetration depth
-            float overlap = std::min(maxA - minB, maxB - minA);
-            
-            // Track minimum penetration for collision response
-            if (overlap < minPenetration)
-            {
-                minPenetration = overlap;
-                bestAxis = axis;
-                
-                // Ensure the normal points from rectangle to polygon
-                float centerA = (minA + maxA) * 0.5f;
-                float centerB = (minB + maxB) * 0.5f;
-                if (centerA > centerB)
-                {
-                    bestAxis = -bestAxis;
-                }
-            }
-        }
-        
-        if (!hasCollision) return false;
-        
-        // Check polygon's axes
-        for (const auto& edge : polyEdges)
-        {
-            // Calculate the perpendicular axis for projection
-            glm::vec2 axis(-edge.y, edge.x);
-            float length = glm::length(axis);
-            if (length < 0.0001f) continue; // Skip degenerate edges
-            
-            axis = axis / length; // Normalize
-            
-            // Project both shapes onto the axis
-            float minA = std::numeric_limits<float>::max();
-            float maxA = -std::numeric_limits<float>::max();
-            float minB = std::numeric_limits<float>::max();
-            float maxB = -std::numeric_limits<float>::max();
-            
-            // Project rectangle vertices
-            for (const auto& vertex : myVertices)
-            {
-                float projection = glm::dot(axis, vertex);
-                minA = std::min(minA, projection);
-                maxA = std::max(maxA, projection);
-            }
-            
-            // Project polygon vertices
-            for (const auto& vertex : polyVertices)
-            {
-                float projection = glm::dot(axis, vertex);
-                minB = std::min(minB, projection);
-                maxB = std::max(maxB, projection);
-            }
-            
-            // Check for separation
-            if (minA > maxB || minB > maxA)
-            {
-                // Separating axis found, no collision
-                hasCollision = false;
-                break;
-            }
-            
-            // Calculate penetration depth
-            float overlap = std::min(maxA - minB, maxB - minA);
-            
-            // Track minimum penetration for collision response
-            if (overlap < minPenetration)
-            {
-                minPenetration = overlap;
-                bestAxis = axis;
-                
-                // Ensure the normal points from rectangle to polygon
-                float centerA = (minA + maxA) * 0.5f;
-                float centerB = (minB + maxB) * 0.5f;
-                if (centerA > centerB)
-                {
-                    bestAxis = -bestAxis;
-                }
-            }
-        }
-        
-        if (!hasCollision) return false;
-        
-        // If we get here, there is a collision
-        collisionNormal = glm::vec3(bestAxis.x, bestAxis.y, 0.0f);
-        penetrationDepth = minPenetration;
-        
-        // Calculate contact points
-        // Use the centroid of the overlap region as an approximation
-        glm::vec2 rectCenter = std::accumulate(myVertices.begin(), myVertices.end(), glm::vec2(0.0f)) / 
-                               static_cast<float>(myVertices.size());
-        glm::vec2 polyCenter = std::accumulate(polyVertices.begin(), polyVertices.end(), glm::vec2(0.0f)) / 
-                               static_cast<float>(polyVertices.size());
-        
-        //collisionPoint = glm::vec3((rectCenter + polyCenter) * 0.5f, 0.0f);
-        
-        return true;
+        // A rectangle is a convex polygon, so the rectangle routine handles both
+        const std::vector<glm::vec2>& polygonVertices = polygon->GetCachedWorldVertices();
+        return ConvexVsConvex(m_worldVertices, 4, polygonVertices.data(), polygonVertices.size(), manifold);
     }
     
-    void RectCollider2D::ClipSegmentToLine(
-        const glm::vec2& v1,
-        const glm::vec2& v2,
+    size_t RectCollider2D::ClipSegmentToLine(
+        glm::vec2 v1,
+        glm::vec2 v2,
         const glm::vec2& normal,
         float offset,
-        std::vector<glm::vec2>& outPoints
-    ) const
+        glm::vec2 (&outPoints)[2]
+    )
     {
-        outPoints.clear();
-        
         // Distance of vertices from the clipping line
         float distance1 = glm::dot(normal, v1) - offset;
         float distance2 = glm::dot(normal, v2) - offset;
         
         // If both points are behind the line, keep both
         if (distance1 >= 0.0f && distance2 >= 0.0f) {
-            outPoints.push_back(v1);
-            outPoints.push_back(v2);
-            return;
+            outPoints[0] = v1;
+            outPoints[1] = v2;
+            return 2;
         }
         
         // If only first point is behind the line, keep first and compute intersection
         if (distance1 >= 0.0f && distance2 < 0.0f) {
-            outPoints.push_back(v1);
             float t = distance1 / (distance1 - distance2);
-            outPoints.push_back(v1 + t * (v2 - v1));
-            return;
+            outPoints[0] = v1;
+            outPoints[1] = v1 + t * (v2 - v1);
+            return 2;
         }
         
         // If only second point is behind the line, keep second and compute intersection
         if (distance1 < 0.0f && distance2 >= 0.0f) {
             float t = distance1 / (distance1 - distance2);
-            outPoints.push_back(v2);
-            outPoints.push_back(v1 + t * (v2 - v1));
-            return;
+            outPoints[0] = v2;
+            outPoints[1] = v1 + t * (v2 - v1);
+            return 2;
         }
         
         // Both points are in front of the line, keep none
-        return;
+        return 0;
     }
 }
\ No newline at end of file
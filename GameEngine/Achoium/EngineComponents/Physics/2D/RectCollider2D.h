@@ -44,18 +44,12 @@ namespace ac
         RectCollider2D(float width, float height, const glm::vec2& _offset, uint32_t _layer = 0, bool _isTrigger = false);
 
         /**
-         * @brief Implements collision detection for this rectangle collider.
+         * @brief Computes the world-space bounds of the collider.
          * 
-         * Checks for collision with another collider and outputs collision data.
+         * @param transform The entity's transform component
+         * @return Box containing the collider
          */
-        virtual bool CheckCollision(
-            const Collider2D* other,
-            const Transform& myTransform,
-            const Transform& otherTransform,
-            std::vector<CollisionPoint2D>& collisionPoints,
-            glm::vec2& collisionNormal,
-            float& penetrationDepth
-        ) const override;
+        virtual AABB2D GetWorldAABB(const Transform& transform) const override;
         
         /**
          * @brief Gets the vertices of the rectangle in local space.
@@ -72,6 +66,20 @@ namespace ac
          */
         std::vector<glm::vec2> GetWorldVertices(const Transform& transform) const;
 
+        /**
+         * @brief Caches the world-space vertices used by the narrowphase.
+         * 
+         * @param transform The entity's transform component
+         */
+        virtual void UpdateWorldVertices(const Transform& transform) override;
+
+        /**
+         * @brief Gets the world-space vertices cached by the last UpdateWorldVertices call.
+         * 
+         * @return The four vertices of the rectangle in counterclockwise order
+         */
+        const glm::vec2* GetCachedWorldVertices() const { return m_worldVertices; }
+
         /**
          * @brief Rectangle vs Rectangle collision detection using SAT.
          */
@@ -79,9 +87,7 @@ namespace ac
             const RectCollider2D* other,
             const Transform& myTransform,
             const Transform& otherTransform,
-            std::vector<CollisionPoint2D>& collisionPoints,
-            glm::vec2& collisionNormal,
-            float& penetrationDepth
+            Manifold2D& manifold
         ) const;
 
         /**
@@ -91,9 +97,7 @@ namespace ac
             const class CircleCollider2D* circle,
             const Transform& myTransform,
             const Transform& otherTransform,
-            std::vector<CollisionPoint2D>& collisionPoints,
-            glm::vec2& collisionNormal,
-            float& penetrationDepth
+            Manifold2D& manifold
         ) const;
         
         /**
@@ -103,11 +107,29 @@ namespace ac
             const class PolygonCollider2D* polygon,
             const Transform& myTransform,
             const Transform& otherTransform,
-            std::vector<CollisionPoint2D>& collisionPoints,
-            glm::vec2& collisionNormal,
-            float& penetrationDepth
+            Manifold2D& manifold
         ) const;
 
+        /**
+         * @brief Convex polygon vs convex polygon collision detection using SAT.
+         * 
+         * The contact points are the two ends of the incident edge clipped
+         * against the reference edge, the same way for rectangles and polygons.
+         * 
+         * @param myVertices World-space vertices of the first shape in counterclockwise order
+         * @param myCount Number of vertices of the first shape
+         * @param otherVertices World-space vertices of the second shape in counterclockwise order
+         * @param otherCount Number of vertices of the second shape
+         * @param manifold Output contact, normal pointing from the first shape to the second
+         */
+        static bool ConvexVsConvex(
+            const glm::vec2* myVertices,
+            size_t myCount,
+            const glm::vec2* otherVertices,
+            size_t otherCount,
+            Manifold2D& manifold
+        );
+
     private:
         /**
          * @brief Helper method for clipping a segment to a line.
@@ -116,14 +138,17 @@ namespace ac
          * @param v2 Second vertex of the segment
          * @param normal Normal vector of the line
          * @param offset Offset of the line
-         * @param outPoints Output vector to store clipped points
+         * @param outPoints Output for the clipped points, may alias v1 and v2
+         * @return Number of points written to outPoints, 0 or 2
          */
-        void ClipSegmentToLine(
-            const glm::vec2& v1,
-            const glm::vec2& v2,
+        static size_t ClipSegmentToLine(
+            glm::vec2 v1,
+            glm::vec2 v2,
             const glm::vec2& normal,
             float offset,
-            std::vector<glm::vec2>& outPoints
-        ) const;
+            glm::vec2 (&outPoints)[2]
+        );
+
+        glm::vec2 m_worldVertices[4]; ///< World-space vertices from the last UpdateWorldVertices call
     };
 }
\ No newline at end of file
@@ -16,6 +16,10 @@ namespace ac
         , isKinematic(false)
         , freezeRotation(false)
         , inertiaTensor(1.0f)
+        , isSleeping(false)
+        , restFrames(0)
+        , bullet(false)
+        , sweep(0.0f)
     {
         if(isKinematic)
 			inverseMass = 0.0f; // Kinematic bodies have no mass for physics
@@ -35,6 +39,10 @@ namespace ac
         , isKinematic(_isKinematic)
         , freezeRotation(_freezeRotation)
         , inertiaTensor(1.0f)
+        , isSleeping(false)
+        , restFrames(0)
+        , bullet(false)
+        , sweep(0.0f)
     {
         if (isKinematic)
             inverseMass = 0.0f; // Kinematic bodies have no mass for physics
@@ -54,61 +62,81 @@ namespace ac
         , isKinematic(false)
         , freezeRotation(false)
         , inertiaTensor(1.0f)
+        , isSleeping(false)
+        , restFrames(0)
+        , bullet(false)
+        , sweep(0.0f)
     {
         if (isKinematic)
             inverseMass = 0.0f; // Kinematic bodies have no mass for physics
 
     }
     
-    void RigidBody2D::ApplyForce(const glm::vec2& _force)
+    // Shared by RigidBody2D and RigidBody2DRef, whose fields are references into SoA columns
+    template <class Body>
+    static void WakeUpBody(Body& body)
+    {
+        body.isSleeping = false;
+        body.restFrames = 0;
+    }
+
+    template <class Body>
+    static void ApplyForceTo(Body& body, const glm::vec2& _force)
     {
         // Only apply force if not kinematic
-        if (isKinematic)
+        if (body.isKinematic)
             return;
             
-        force += _force;
+        WakeUpBody(body);
+        body.force += _force;
     }
     
-    void RigidBody2D::ApplyForceAtPosition(const glm::vec2& _force, const glm::vec2& _position)
+    template <class Body>
+    static void ApplyForceAtPositionTo(Body& body, const glm::vec2& _force, const glm::vec2& _position)
     {
         // Only apply force if not kinematic
-        if (isKinematic)
+        if (body.isKinematic)
             return;
             
         // Apply the force
-        force += _force;
+        WakeUpBody(body);
+        body.force += _force;
         
         // Calculate torque if rotation isn't frozen
-        if (!freezeRotation)
+        if (!body.freezeRotation)
         {
             // Cross product in 2D is a scalar: (a.x * b.y - a.y * b.x)
             float torqueAmount = _position.x * _force.y - _position.y * _force.x;
-            torque += torqueAmount;
+            body.torque += torqueAmount;
         }
     }
     
-    void RigidBody2D::ApplyImpulse(const glm::vec2& _impulse)
+    template <class Body>
+    static void ApplyImpulseTo(Body& body, const glm::vec2& _impulse)
     {
         // Only apply impulse if not kinematic
-        if (isKinematic)
+        if (body.isKinematic)
             return;
             
         // Impulse = change in momentum = mass * change in velocity
         // So, change in velocity = impulse / mass
-        velocity += _impulse * inverseMass;
+        WakeUpBody(body);
+        body.velocity += _impulse * body.inverseMass;
     }
     
-    void RigidBody2D::ApplyImpulseAtPosition(const glm::vec2& impulse, const glm::vec2& position)
+    template <class Body>
+    static void ApplyImpulseAtPositionTo(Body& body, const glm::vec2& impulse, const glm::vec2& position)
     {
         // Only apply impulse if not kinematic
-        if (isKinematic)
+        if (body.isKinematic)
             return;
         
         // Apply linear impulse (change in velocity)
-        velocity += impulse * inverseMass;
+        WakeUpBody(body);
+        body.velocity += impulse * body.inverseMass;
         
         // Calculate angular impulse if rotation isn't frozen
-        if (!freezeRotation)
+        if (!body.freezeRotation)
         {
             // Calculate torque using 2D cross product (r × F)
             // position is relative to center of mass
@@ -118,7 +146,57 @@ namespace ac
             // For simplicity, using a moment of inertia approximation
             // Actual moment of inertia would depend on the shape
             
-            angularVelocity += angularImpulse / inertiaTensor;
+            body.angularVelocity += angularImpulse / body.inertiaTensor;
         }
     }
+
+    void RigidBody2D::ApplyForce(const glm::vec2& _force)
+    {
+        ApplyForceTo(*this, _force);
+    }
+
+    void RigidBody2D::ApplyForceAtPosition(const glm::vec2& _force, const glm::vec2& _position)
+    {
+        ApplyForceAtPositionTo(*this, _force, _position);
+    }
+
+    void RigidBody2D::ApplyImpulse(const glm::vec2& _impulse)
+    {
+        ApplyImpulseTo(*this, _impulse);
+    }
+
+    void RigidBody2D::ApplyImpulseAtPosition(const glm::vec2& impulse, const glm::vec2& position)
+    {
+        ApplyImpulseAtPositionTo(*this, impulse, position);
+    }
+
+    void RigidBody2D::WakeUp()
+    {
+        WakeUpBody(*this);
+    }
+
+    void RigidBody2DRef::ApplyForce(const glm::vec2& _force) const
+    {
+        ApplyForceTo(*this, _force);
+    }
+
+    void RigidBody2DRef::ApplyForceAtPosition(const glm::vec2& _force, const glm::vec2& _position) const
+    {
+        ApplyForceAtPositionTo(*this, _force, _position);
+    }
+
+    void RigidBody2DRef::ApplyImpulse(const glm::vec2& _impulse) const
+    {
+        ApplyImpulseTo(*this, _impulse);
+    }
+
+    void RigidBody2DRef::ApplyImpulseAtPosition(const glm::vec2& impulse, const glm::vec2& position) const
+    {
+        ApplyImpulseAtPositionTo(*this, impulse, position);
+    }
+
+    void RigidBody2DRef::WakeUp() const
+    {
+        WakeUpBody(*this);
+    }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/glm.hpp>
+#include "Core/SoA.hpp"
 
 namespace ac
 {
@@ -9,6 +10,10 @@ namespace ac
      * 
      * RigidBody2D provides 2D physics simulation properties including mass,
      * velocity, forces, and physical material properties.
+     *
+     * Worlds store it field by field (see SoALayout<RigidBody2D>), so views
+     * and World::Get hand out RigidBody2DRef / RigidBody2DConstRef instead
+     * of RigidBody2D& / const RigidBody2D&.
      */
     class RigidBody2D
     {
@@ -25,6 +30,10 @@ namespace ac
         bool isKinematic; ///< If true, not affected by forces but affects others
         bool freezeRotation; ///< If true, rotation is not simulated
         float inertiaTensor;
+        bool isSleeping; ///< If true, the body's island came to rest and is not simulated until something wakes it
+        uint32_t restFrames; ///< Consecutive fixed steps the body moved slower than the sleep thresholds
+        bool bullet; ///< If true, Collision2DSystem sweeps the body's colliders along their motion so they cannot pass through thin ones
+        glm::vec2 sweep; ///< Translation of the last integration step, kept for bullets until Collision2DSystem sweeps it
         
         /**
          * @brief Default constructor with standard physics values.
@@ -72,5 +81,91 @@ namespace ac
          * @param position World position to apply the impulse at (relative to center)
          */
         void ApplyImpulseAtPosition(const glm::vec2& impulse, const glm::vec2& position);
+
+        /**
+         * @brief Wakes the body up if it is sleeping and restarts its rest count.
+         *
+         * The forces and impulses above wake the body themselves; the rest of
+         * its island wakes at the next collision step.
+         */
+        void WakeUp();
+    };
+
+    /**
+     * @brief Reference to a RigidBody2D stored in the SoA columns of a World.
+     *
+     * Take it by value; its members refer to the stored fields.
+     */
+    struct RigidBody2DRef
+    {
+        float& mass;
+        float& inverseMass;
+        glm::vec2& velocity;
+        float& angularVelocity;
+        glm::vec2& force;
+        float& torque;
+        float& restitution;
+        float& friction;
+        bool& useGravity;
+        bool& isKinematic;
+        bool& freezeRotation;
+        float& inertiaTensor;
+        bool& isSleeping;
+        uint32_t& restFrames;
+        bool& bullet;
+        glm::vec2& sweep;
+
+        /** @copydoc RigidBody2D::ApplyForce */
+        void ApplyForce(const glm::vec2& _force) const;
+
+        /** @copydoc RigidBody2D::ApplyForceAtPosition */
+        void ApplyForceAtPosition(const glm::vec2& _force, const glm::vec2& _position) const;
+
+        /** @copydoc RigidBody2D::ApplyImpulse */
+        void ApplyImpulse(const glm::vec2& _impulse) const;
+
+        /** @copydoc RigidBody2D::ApplyImpulseAtPosition */
+        void ApplyImpulseAtPosition(const glm::vec2& impulse, const glm::vec2& position) const;
+
+        /** @copydoc RigidBody2D::WakeUp */
+        void WakeUp() const;
+    };
+
+    /**
+     * @brief Read-only reference to a RigidBody2D stored in the SoA columns of a World.
+     */
+    struct RigidBody2DConstRef
+    {
+        const float& mass;
+        const float& inverseMass;
+        const glm::vec2& velocity;
+        const float& angularVelocity;
+        const glm::vec2& force;
+        const float& torque;
+        const float& restitution;
+        const float& friction;
+        const bool& useGravity;
+        const bool& isKinematic;
+        const bool& freezeRotation;
+        const float& inertiaTensor;
+        const bool& isSleeping;
+        const uint32_t& restFrames;
+        const bool& bullet;
+        const glm::vec2& sweep;
+    };
+
+    /**
+     * @brief Stores each RigidBody2D field in its own column so the integration loop only streams the fields it uses.
+     */
+    template <>
+    struct SoALayout<RigidBody2D>
+    {
+        using Fields = SoAFields<&RigidBody2D::mass, &RigidBody2D::inverseMass, &RigidBody2D::velocity,
+            &RigidBody2D::angularVelocity, &RigidBody2D::force, &RigidBody2D::torque, &RigidBody2D::restitution,
+            &RigidBody2D::friction, &RigidBody2D::useGravity, &RigidBody2D::isKinematic, &RigidBody2D::freezeRotation,
+            &RigidBody2D::inertiaTensor, &RigidBody2D::isSleeping, &RigidBody2D::restFrames,
+            &RigidBody2D::bullet, &RigidBody2D::sweep>;
+        using Ref = RigidBody2DRef;
+        using ConstRef = RigidBody2DConstRef;
     };
 }
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "acpch.h"
+#include "TimeOfImpact2D.h"
+#include "CircleCollider2D.h"
+#include "RectCollider2D.h"
+#include "PolygonCollider2D.h"
+#include "Math/Transform.h"
+
+namespace ac
+{
+    namespace
+    {
+        // Advancement steps before giving up short of the contact, which is still a safe place to stop
+        constexpr int MaxAdvancementSteps = 32;
+
+        /**
+         * @brief A convex polygon or, with a single vertex, a point, grown by a radius.
+         */
+        struct ConvexShape2D
+        {
+            const glm::vec2* vertices = nullptr;
+            size_t count = 0;
+            float radius = 0.0f;
+            glm::vec2 center{ 0, 0 }; ///< The vertex of a circle
+        };
+
+        void MakeShape(const Collider2D& collider, const Transform& transform, ConvexShape2D& shape)
+        {
+            switch (collider.GetType())
+            {
+            case ColliderType2D::Circle:
+                shape.center = collider.GetWorldPosition(transform);
+                shape.radius = static_cast<const CircleCollider2D&>(collider).radius;
+                shape.vertices = &shape.center;
+                shape.count = 1;
+                break;
+            case ColliderType2D::Rect:
+                shape.vertices = static_cast<const RectCollider2D&>(collider).GetCachedWorldVertices();
+                shape.count = 4;
+                break;
+            default:
+            {
+                const std::vector<glm::vec2>& vertices = static_cast<const PolygonCollider2D&>(collider).GetCachedWorldVertices();
+                shape.vertices = vertices.data();
+                shape.count = vertices.size();
+                break;
+            }
+            }
+        }
+
+        // Whether an edge normal of either polygon separates the cores of the shapes, a moved by shift
+        bool Separated(const ConvexShape2D& a, const glm::vec2& shift, const ConvexShape2D& b)
+        {
+            // Two points only touch where they coincide, which Distance finds
+            if (a.count < 3 && b.count < 3)
+                return true;
+
+            auto separatedOn = [&a, &b, &shift](const glm::vec2& axis)
+                {
+                    float minA = FLT_MAX, maxA = -FLT_MAX, minB = FLT_MAX, maxB = -FLT_MAX;
+                    for (size_t i = 0; i < a.count; ++i)
+                    {
+                        float projection = glm::dot(a.vertices[i] + shift, axis);
+                        minA = std::min(minA, projection);
+                        maxA = std::max(maxA, projection);
+                    }
+                    for (size_t i = 0; i < b.count; ++i)
+                    {
+                        float projection = glm::dot(b.vertices[i], axis);
+                        minB = std::min(minB, projection);
+                        maxB = std::max(maxB, projection);
+                    }
+                    return maxA < minB || maxB < minA;
+                };
+
+            for (const ConvexShape2D* shape : { &a, &b })
+            {
+                if (shape->count < 3)
+                    continue;
+                for (size_t i = 0; i < shape->count; ++i)
+                {
+                    glm::vec2 edge = shape->vertices[(i + 1) % shape->count] - shape->vertices[i];
+                    if (separatedOn(glm::vec2(-edge.y, edge.x)))
+                        return true;
+                }
+            }
+            return false;
+        }
+
+        float PointToSegmentDistanceSq(const glm::vec2& point, const glm::vec2& start, const glm::vec2& end)
+        {
+            glm::vec2 segment = end - start;
+            float lengthSq = glm::dot(segment, segment);
+            float t = lengthSq > 0.0f ? glm::clamp(glm::dot(point - start, segment) / lengthSq, 0.0f, 1.0f) : 0.0f;
+            glm::vec2 offset = point - (start + t * segment);
+            return glm::dot(offset, offset);
+        }
+
+        float PointToBoundaryDistanceSq(const glm::vec2& point, const ConvexShape2D& shape)
+        {
+            if (shape.count == 1)
+                return PointToSegmentDistanceSq(point, shape.vertices[0], shape.vertices[0]);
+
+            float distanceSq = FLT_MAX;
+            for (size_t i = 0; i < shape.count; ++i)
+                distanceSq = std::min(distanceSq, PointToSegmentDistanceSq(point, shape.vertices[i], shape.vertices[(i + 1) % shape.count]));
+            return distanceSq;
+        }
+
+        // Distance between the shapes with a moved by shift, 0 if they overlap
+        float Distance(const ConvexShape2D& a, const glm::vec2& shift, const ConvexShape2D& b)
+        {
+            if (!Separated(a, shift, b))
+                return 0.0f;
+
+            // Disjoint convex polygons are closest between a vertex of one and an edge of the other
+            float distanceSq = FLT_MAX;
+            for (size_t i = 0; i < a.count; ++i)
+                distanceSq = std::min(distanceSq, PointToBoundaryDistanceSq(a.vertices[i] + shift, b));
+            for (size_t i = 0; i < b.count; ++i)
+                distanceSq = std::min(distanceSq, PointToBoundaryDistanceSq(b.vertices[i] - shift, a));
+            return std::max(std::sqrt(distanceSq) - a.radius - b.radius, 0.0f);
+        }
+    }
+
+    bool TimeOfImpact2D(
+        const Collider2D& moving,
+        const Transform& movingTransform,
+        const glm::vec2& translation,
+        const Collider2D& other,
+        const Transform& otherTransform,
+        float tolerance,
+        float& toi
+    )
+    {
+        float lengthSq = glm::dot(translation, translation);
+        if (lengthSq <= 0.0f)
+            return false;
+
+        ConvexShape2D a, b;
+        MakeShape(moving, movingTransform, a);
+        MakeShape(other, otherTransform, b);
+
+        // Swept circles: first root of |start + t * translation| = radius, relative to the other center
+        if (moving.GetType() == ColliderType2D::Circle && other.GetType() == ColliderType2D::Circle)
+        {
+            glm::vec2 start = a.center - translation - b.center;
+            float radius = a.radius + b.radius;
+            float c = glm::dot(start, start) - radius * radius;
+            float halfB = glm::dot(start, translation);
+            if (c <= 0.0f || halfB >= 0.0f)
+                return false; // Touching at the start, or moving apart
+            float discriminant = halfB * halfB - lengthSq * c;
+            if (discriminant < 0.0f)
+                return false;
+            float t = (-halfB - std::sqrt(discriminant)) / lengthSq;
+            if (t > 1.0f)
+                return false;
+            toi = t;
+            return true;
+        }
+
+        // Conservative advancement: no point of the moving shape travels further than the translation,
+        // so advancing it by the distance between the shapes cannot carry it through a contact
+        float length = std::sqrt(lengthSq);
+        float t = 0.0f;
+        for (int step = 0; step < MaxAdvancementSteps; ++step)
+        {
+            float distance = Distance(a, (t - 1.0f) * translation, b);
+            if (distance <= tolerance)
+            {
+                if (step == 0)
+                    return false;
+                toi = t;
+                return true;
+            }
+            t += distance / length;
+            if (t >= 1.0f)
+                return false;
+        }
+        toi = t;
+        return true;
+    }
+}
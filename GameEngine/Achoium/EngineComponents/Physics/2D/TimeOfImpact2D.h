@@ -0,0 +1,38 @@
+#pragma once
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include "Collider2D.h"
+
+namespace ac
+{
+    /**
+     * @brief Finds when a collider moving in a straight line first touches another collider that holds still.
+     *
+     * The moving collider keeps the orientation it has at the end of the
+     * motion. Two circles are swept exactly. Every other pair uses
+     * conservative advancement: the moving collider is advanced by the
+     * distance between the shapes, which cannot carry it past a contact,
+     * until the distance drops below tolerance.
+     *
+     * Both colliders must have their world vertices cached for the given
+     * transforms by UpdateWorldVertices.
+     *
+     * @param moving The collider that moved
+     * @param movingTransform Its entity transform at the end of the motion
+     * @param translation How far it moved; the motion started at the end position minus translation
+     * @param other The collider holding still
+     * @param otherTransform Its entity transform
+     * @param tolerance Distance at which the colliders count as touching
+     * @param toi Output, fraction of the motion in [0, 1] at which they first touch
+     * @return True if the colliders touch during the motion; colliders touching at its start are left to the narrowphase
+     */
+    bool TimeOfImpact2D(
+        const Collider2D& moving,
+        const Transform& movingTransform,
+        const glm::vec2& translation,
+        const Collider2D& other,
+        const Transform& otherTransform,
+        float tolerance,
+        float& toi
+    );
+}
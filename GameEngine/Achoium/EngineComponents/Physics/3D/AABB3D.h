@@ -0,0 +1,25 @@
+#pragma once
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+
+namespace ac
+{
+    /**
+     * @brief Axis-aligned bounding box in world space.
+     */
+    struct AABB3D
+    {
+        glm::vec3 min{ 0, 0, 0 }; ///< Corner with the smallest coordinates
+        glm::vec3 max{ 0, 0, 0 }; ///< Corner with the largest coordinates
+
+        /**
+         * @brief Checks if this box and another one intersect or touch.
+         */
+        bool Overlaps(const AABB3D& other) const
+        {
+            return min.x <= other.max.x && other.min.x <= max.x &&
+                   min.y <= other.max.y && other.min.y <= max.y &&
+                   min.z <= other.max.z && other.min.z <= max.z;
+        }
+    };
+}
@@ -1,6 +1,5 @@
 #include "acpch.h"
 #include "BoxCollider.h"
-#include "SphereCollider.h"
 #include "Math/Transform.h"
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/matrix_decompose.hpp>
@@ -8,41 +7,31 @@
 
 namespace ac
 {
-    BoxCollider::BoxCollider() : halfSize(0.5f, 0.5f, 0.5f)
+    BoxCollider::BoxCollider()
+        : Collider(ColliderType::Box)
+        , halfSize(0.5f, 0.5f, 0.5f)
     {
     }
 
     BoxCollider::BoxCollider(float width, float height, float depth)
-        : halfSize(width * 0.5f, height * 0.5f, depth * 0.5f)
+        : Collider(ColliderType::Box)
+        , halfSize(width * 0.5f, height * 0.5f, depth * 0.5f)
     {
     }
 
     BoxCollider::BoxCollider(const glm::vec3& size, const glm::vec3& _offset)
-        : halfSize(size.x * 0.5f, size.y * 0.5f, size.z * 0.5f)
+        : Collider(ColliderType::Box)
+        , halfSize(size.x * 0.5f, size.y * 0.5f, size.z * 0.5f)
     {
         offset = _offset;
     }
 
-    bool BoxCollider::CheckCollision(
-        const Collider* other,
-        const Transform& myTransform,
-        const Transform& otherTransform,
-        glm::vec3& collisionPoint,
-        glm::vec3& collisionNormal,
-        float& penetrationDepth
-    ) const
+    AABB3D BoxCollider::GetWorldAABB(const Transform& transform) const
     {
-        // Check the type of the other collider and dispatch to the appropriate collision function
-        if (const BoxCollider* box = dynamic_cast<const BoxCollider*>(other))
-        {
-            return BoxVsBox(box, myTransform, otherTransform, collisionPoint, collisionNormal, penetrationDepth);
-        }
-        else if (const SphereCollider* sphere = dynamic_cast<const SphereCollider*>(other))
-        {
-            return BoxVsSphere(sphere, myTransform, otherTransform, collisionPoint, collisionNormal, penetrationDepth);
-        }
-
-        return false;
+        // The narrowphase treats boxes as axis aligned, scaled but not rotated
+        glm::vec3 center = GetWorldPosition(transform);
+        glm::vec3 extents = halfSize * glm::abs(transform.scale);
+        return { center - extents, center + extents };
     }
 
     bool BoxCollider::BoxVsBox(
@@ -115,31 +104,4 @@ namespace ac
 
         return true;
     }
-
-    bool BoxCollider::BoxVsSphere(
-        const SphereCollider* sphere,
-        const Transform& myTransform,
-        const Transform& sphereTransform,
-        glm::vec3& collisionPoint,
-        glm::vec3& collisionNormal,
-        float& penetrationDepth
-    ) const
-    {
-        // Let the SphereCollider handle this collision check
-        // Reverse the parameters so the normal is correct
-        bool result = sphere->CheckCollision(
-            this, 
-            sphereTransform, 
-            myTransform, 
-            collisionPoint, 
-            collisionNormal, 
-            penetrationDepth
-        );
-        
-        // Reverse the normal since we flipped the parameters
-        if (result)
-            collisionNormal = -collisionNormal;
-            
-        return result;
-    }
 }
\ No newline at end of file
@@ -37,20 +37,13 @@ namespace ac
         BoxCollider(const glm::vec3& size, const glm::vec3& _offset = glm::vec3(0.0f));
 
         /**
-         * @brief Implements collision detection for this box collider.
+         * @brief Computes the world-space bounds of the collider.
          * 
-         * Checks for collision with another collider and outputs collision data.
+         * @param transform The entity's transform component
+         * @return Box containing the collider
          */
-        bool CheckCollision(
-            const Collider* other,
-            const Transform& myTransform,
-            const Transform& otherTransform,
-            glm::vec3& collisionPoint,
-            glm::vec3& collisionNormal,
-            float& penetrationDepth
-        ) const override;
+        AABB3D GetWorldAABB(const Transform& transform) const override;
 
-    private:
         /**
          * @brief Box vs Box collision detection.
          */
@@ -62,17 +55,5 @@ namespace ac
             glm::vec3& collisionNormal,
             float& penetrationDepth
         ) const;
-
-        /**
-         * @brief Box vs Sphere collision detection.
-         */
-        bool BoxVsSphere(
-            const class SphereCollider* sphere,
-            const Transform& myTransform,
-            const Transform& sphereTransform,
-            glm::vec3& collisionPoint,
-            glm::vec3& collisionNormal,
-            float& penetrationDepth
-        ) const;
     };
 }
\ No newline at end of file
@@ -0,0 +1,229 @@
+#include "acpch.h"
+#include "SpatialHashGrid3D.h"
+#include "EngineComponents/Physics/CollisionLayer.h"
+
+namespace ac
+{
+    // Cell coordinates are clamped so that far away colliders cannot overflow the cell counts
+    constexpr float MaxCellCoordinate = 1 << 30;
+
+    SpatialHashGrid3D::SpatialHashGrid3D(float cellSize)
+        : m_cellSize(0.0f)
+        , m_inverseCellSize(0.0f)
+    {
+        SetCellSize(cellSize);
+    }
+
+    void SpatialHashGrid3D::SetCellSize(float cellSize)
+    {
+        m_cellSize = cellSize > 0.0f ? cellSize : 0.0f;
+        m_inverseCellSize = m_cellSize > 0.0f ? 1.0f / m_cellSize : 0.0f;
+        m_slots.clear();
+        m_proxies.clear();
+        m_freeSlots.clear();
+        m_cells.clear();
+        m_largeProxies.clear();
+    }
+
+    uint64_t SpatialHashGrid3D::CellKey(int32_t x, int32_t y, int32_t z)
+    {
+        // 21 bits per axis; cells 2^21 apart share a key, which only costs extra bounds tests
+        return (static_cast<uint64_t>(x & 0x1FFFFF) << 42) | (static_cast<uint64_t>(y & 0x1FFFFF) << 21) | static_cast<uint64_t>(z & 0x1FFFFF);
+    }
+
+    SpatialHashGrid3D::CellRange SpatialHashGrid3D::ComputeRange(const AABB3D& aabb) const
+    {
+        auto cell = [this](const glm::vec3& point)
+            {
+                glm::vec3 scaled = glm::clamp(glm::floor(point * m_inverseCellSize), glm::vec3(-MaxCellCoordinate), glm::vec3(MaxCellCoordinate));
+                return glm::ivec3(scaled);
+            };
+        return { cell(aabb.min), cell(aabb.max) };
+    }
+
+    void SpatialHashGrid3D::Insert(uint32_t slot)
+    {
+        Proxy& proxy = m_proxies[slot];
+        // Stops as soon as the proxy is large, as the ranges of three clamped axes would overflow the product
+        int64_t cellCount = 1;
+        for (int axis = 0; axis < 3 && cellCount <= MaxCellsPerProxy; ++axis)
+            cellCount *= static_cast<int64_t>(proxy.range.max[axis]) - proxy.range.min[axis] + 1;
+        proxy.isLarge = cellCount > MaxCellsPerProxy;
+        if (proxy.isLarge)
+        {
+            m_largeProxies.push_back(slot);
+            return;
+        }
+
+        for (int32_t x = proxy.range.min.x; x <= proxy.range.max.x; ++x)
+            for (int32_t y = proxy.range.min.y; y <= proxy.range.max.y; ++y)
+                for (int32_t z = proxy.range.min.z; z <= proxy.range.max.z; ++z)
+                {
+                    Cell& cell = m_cells[CellKey(x, y, z)];
+                    (proxy.isStatic ? cell.statics : cell.dynamics).push_back(slot);
+                }
+    }
+
+    void SpatialHashGrid3D::Remove(uint32_t slot)
+    {
+        const Proxy& proxy = m_proxies[slot];
+        if (proxy.isLarge)
+        {
+            m_largeProxies.erase(std::find(m_largeProxies.begin(), m_largeProxies.end(), slot));
+            return;
+        }
+
+        for (int32_t x = proxy.range.min.x; x <= proxy.range.max.x; ++x)
+            for (int32_t y = proxy.range.min.y; y <= proxy.range.max.y; ++y)
+                for (int32_t z = proxy.range.min.z; z <= proxy.range.max.z; ++z)
+                {
+                    auto it = m_cells.find(CellKey(x, y, z));
+                    std::vector<uint32_t>& members = proxy.isStatic ? it->second.statics : it->second.dynamics;
+                    *std::find(members.begin(), members.end(), slot) = members.back();
+                    members.pop_back();
+                    if (it->second.statics.empty() && it->second.dynamics.empty())
+                        m_cells.erase(it);
+                }
+    }
+
+    void SpatialHashGrid3D::FindPairs(const std::vector<BroadphaseProxy3D>& proxies, const CollisionLayer& layers, std::vector<BroadphasePair3D>& pairs)
+    {
+        pairs.clear();
+        ++m_frame;
+        uint32_t count = static_cast<uint32_t>(proxies.size());
+
+        // Pick a cell about twice the size of an average collider
+        if (m_cellSize == 0.0f && count > 0)
+        {
+            float sum = 0.0f;
+            for (const BroadphaseProxy3D& proxy : proxies)
+            {
+                glm::vec3 size = proxy.aabb.max - proxy.aabb.min;
+                sum += std::max(size.x, std::max(size.y, size.z));
+            }
+            float cellSize = 2.0f * sum / static_cast<float>(count);
+            m_cellSize = cellSize > 0.0f ? cellSize : 1.0f;
+            m_inverseCellSize = 1.0f / m_cellSize;
+        }
+
+        // Move the colliders whose cell range changed
+        m_slotOfIndex.resize(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const BroadphaseProxy3D& input = proxies[i];
+            CellRange range = ComputeRange(input.aabb);
+
+            auto [it, inserted] = m_slots.try_emplace(input.key);
+            uint32_t slot;
+            if (inserted)
+            {
+                if (m_freeSlots.empty())
+                {
+                    slot = static_cast<uint32_t>(m_proxies.size());
+                    m_proxies.emplace_back();
+                }
+                else
+                {
+                    slot = m_freeSlots.back();
+                    m_freeSlots.pop_back();
+                }
+                it->second = slot;
+                m_proxies[slot].range = range;
+                m_proxies[slot].isStatic = input.isStatic;
+                Insert(slot);
+            }
+            else
+            {
+                slot = it->second;
+                Proxy& proxy = m_proxies[slot];
+                if (!(proxy.range == range) || proxy.isStatic != input.isStatic)
+                {
+                    Remove(slot);
+                    proxy.range = range;
+                    proxy.isStatic = input.isStatic;
+                    Insert(slot);
+                }
+            }
+
+            Proxy& proxy = m_proxies[slot];
+            proxy.index = i;
+            proxy.layer = input.layer;
+            proxy.frame = m_frame;
+            m_slotOfIndex[i] = slot;
+        }
+
+        // Drop the colliders that are gone
+        for (auto it = m_slots.begin(); it != m_slots.end();)
+        {
+            if (m_proxies[it->second].frame != m_frame)
+            {
+                Remove(it->second);
+                m_freeSlots.push_back(it->second);
+                it = m_slots.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        auto tryPair = [&](const Proxy& proxy, uint32_t mask, const Proxy& other)
+            {
+                if ((mask & CollisionLayer::GetLayerBit(other.layer)) != 0 && proxies[proxy.index].aabb.Overlaps(proxies[other.index].aabb))
+                    pairs.push_back({ std::min(proxy.index, other.index), std::max(proxy.index, other.index) });
+            };
+
+        // Look for pairs from every dynamic collider in the cells; a pair sharing several cells is only
+        // reported in the first cell both ranges have in common
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const Proxy& proxy = m_proxies[m_slotOfIndex[i]];
+            uint32_t mask = layers.GetCollisionMask(proxy.layer);
+            if (proxy.isStatic || proxy.isLarge || mask == 0)
+                continue;
+
+            for (int32_t x = proxy.range.min.x; x <= proxy.range.max.x; ++x)
+                for (int32_t y = proxy.range.min.y; y <= proxy.range.max.y; ++y)
+                    for (int32_t z = proxy.range.min.z; z <= proxy.range.max.z; ++z)
+                    {
+                        const Cell& cell = m_cells.find(CellKey(x, y, z))->second;
+                        glm::ivec3 here(x, y, z);
+                        for (uint32_t otherSlot : cell.dynamics)
+                        {
+                            const Proxy& other = m_proxies[otherSlot];
+                            if (other.index > i && glm::max(proxy.range.min, other.range.min) == here)
+                                tryPair(proxy, mask, other);
+                        }
+                        for (uint32_t otherSlot : cell.statics)
+                        {
+                            const Proxy& other = m_proxies[otherSlot];
+                            if (glm::max(proxy.range.min, other.range.min) == here)
+                                tryPair(proxy, mask, other);
+                        }
+                    }
+        }
+
+        // Colliders too large for the cells are tested against every collider
+        for (uint32_t largeSlot : m_largeProxies)
+        {
+            const Proxy& large = m_proxies[largeSlot];
+            uint32_t mask = layers.GetCollisionMask(large.layer);
+            if (mask == 0)
+                continue;
+
+            for (uint32_t j = 0; j < count; ++j)
+            {
+                const Proxy& other = m_proxies[m_slotOfIndex[j]];
+                // Pairs of two large colliders are found from the one with the lower index
+                if (j == large.index || (large.isStatic && other.isStatic) || (other.isLarge && j < large.index))
+                    continue;
+                tryPair(large, mask, other);
+            }
+        }
+
+        std::sort(pairs.begin(), pairs.end(), [](const BroadphasePair3D& lhs, const BroadphasePair3D& rhs)
+            {
+                return lhs.a != rhs.a ? lhs.a < rhs.a : lhs.b < rhs.b;
+            });
+    }
+}
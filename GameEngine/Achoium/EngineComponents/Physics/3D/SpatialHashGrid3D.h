@@ -0,0 +1,135 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include "AABB3D.h"
+
+namespace ac
+{
+    class CollisionLayer;
+
+    /**
+     * @brief A collider as seen by the 3D broadphase.
+     */
+    struct BroadphaseProxy3D
+    {
+        uint64_t key = 0;      ///< Identifies the collider across frames, unique within a frame
+        AABB3D aabb;           ///< World bounds of the collider this frame
+        uint32_t layer = 0;    ///< Collision layer of the collider
+        bool isStatic = false; ///< Static colliders are never paired with each other
+    };
+
+    /**
+     * @brief Two proxies whose bounds overlap and whose layers collide.
+     */
+    struct BroadphasePair3D
+    {
+        uint32_t a = 0; ///< Index of the first proxy
+        uint32_t b = 0; ///< Index of the second proxy, always greater than a
+    };
+
+    /**
+     * @brief Resource finding the collider pairs CollisionSystem runs the narrowphase on.
+     *
+     * Space is divided into cubic cells of cellSize, and every collider is
+     * listed in the cells its bounds touch. The lists are kept between frames:
+     * a collider only moves between cells when the range of cells it touches
+     * changes. Static and dynamic colliders are listed separately and pairs
+     * are only looked for from the dynamic side, so static colliders are
+     * never tested against each other.
+     *
+     * Colliders touching more than MaxCellsPerProxy cells, such as a floor,
+     * are kept out of the cells and tested against every other collider.
+     */
+    class SpatialHashGrid3D
+    {
+    public:
+        static constexpr uint32_t MaxCellsPerProxy = 64;
+
+        /**
+         * @brief Constructor with the cell size.
+         *
+         * @param cellSize Edge length of a cell; 0 picks twice the average collider size on the first call to FindPairs.
+         */
+        explicit SpatialHashGrid3D(float cellSize = 0.0f);
+
+        /**
+         * @brief Changes the cell size; every collider is hashed again on the next call to FindPairs.
+         *
+         * @param cellSize Edge length of a cell, or 0 to pick it from the colliders.
+         */
+        void SetCellSize(float cellSize);
+
+        /**
+         * @brief Gets the edge length of a cell, 0 until picked automatically.
+         */
+        float GetCellSize() const { return m_cellSize; }
+
+        /**
+         * @brief Finds the pairs of this frame's colliders that may touch.
+         *
+         * A pair is reported if at least one collider is not static, the
+         * bounds of both overlap and CollisionLayer::ShouldCollide holds for
+         * their layers. Colliders whose key was not passed again since the
+         * last call are removed from the grid.
+         *
+         * @param proxies Every collider of this frame.
+         * @param layers The collision matrix.
+         * @param pairs Output, cleared first; sorted by a, then b.
+         */
+        void FindPairs(const std::vector<BroadphaseProxy3D>& proxies, const CollisionLayer& layers, std::vector<BroadphasePair3D>& pairs);
+
+        /**
+         * @brief Number of cells holding at least one collider.
+         */
+        size_t GetCellCount() const { return m_cells.size(); }
+
+        /**
+         * @brief Number of colliders in the grid, including those too large for the cells.
+         */
+        size_t GetProxyCount() const { return m_slots.size(); }
+
+    private:
+        struct CellRange
+        {
+            glm::ivec3 min{ 0 };
+            glm::ivec3 max{ -1 };
+
+            bool operator==(const CellRange& other) const { return min == other.min && max == other.max; }
+        };
+
+        struct Proxy
+        {
+            CellRange range;
+            uint32_t index = 0;    ///< Index of the collider in this frame's proxies
+            uint32_t layer = 0;
+            uint32_t frame = 0;    ///< Last call the collider was passed in
+            bool isStatic = false;
+            bool isLarge = false;  ///< Kept in m_largeProxies instead of the cells
+        };
+
+        struct Cell
+        {
+            std::vector<uint32_t> dynamics;
+            std::vector<uint32_t> statics;
+        };
+
+        CellRange ComputeRange(const AABB3D& aabb) const;
+        void Insert(uint32_t slot);
+        void Remove(uint32_t slot);
+        static uint64_t CellKey(int32_t x, int32_t y, int32_t z);
+
+        float m_cellSize;
+        float m_inverseCellSize;
+
+        std::unordered_map<uint64_t, uint32_t> m_slots; ///< Collider key to its slot in m_proxies
+        std::vector<Proxy> m_proxies;
+        std::vector<uint32_t> m_freeSlots;
+        std::vector<uint32_t> m_slotOfIndex;            ///< Slot of every collider of this frame
+        std::unordered_map<uint64_t, Cell> m_cells;
+        std::vector<uint32_t> m_largeProxies;
+        uint32_t m_frame = 0;
+    };
+}
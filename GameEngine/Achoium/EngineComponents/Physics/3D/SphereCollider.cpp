@@ -5,39 +5,31 @@
 
 namespace ac
 {
-    SphereCollider::SphereCollider() : radius(0.5f)
+    SphereCollider::SphereCollider()
+        : Collider(ColliderType::Sphere)
+        , radius(0.5f)
     {
     }
 
-    SphereCollider::SphereCollider(float _radius) : radius(_radius)
+    SphereCollider::SphereCollider(float _radius)
+        : Collider(ColliderType::Sphere)
+        , radius(_radius)
     {
     }
 
-    SphereCollider::SphereCollider(float _radius, const glm::vec3& _offset) : radius(_radius)
+    SphereCollider::SphereCollider(float _radius, const glm::vec3& _offset)
+        : Collider(ColliderType::Sphere)
+        , radius(_radius)
     {
         offset = _offset;
     }
 
-    bool SphereCollider::CheckCollision(
-        const Collider* other,
-        const Transform& myTransform,
-        const Transform& otherTransform,
-        glm::vec3& collisionPoint,
-        glm::vec3& collisionNormal,
-        float& penetrationDepth
-    ) const
+    AABB3D SphereCollider::GetWorldAABB(const Transform& transform) const
     {
-        // Check the type of the other collider and dispatch to the appropriate collision function
-        if (const SphereCollider* sphere = dynamic_cast<const SphereCollider*>(other))
-        {
-            return SphereVsSphere(sphere, myTransform, otherTransform, collisionPoint, collisionNormal, penetrationDepth);
-        }
-        else if (const BoxCollider* box = dynamic_cast<const BoxCollider*>(other))
-        {
-            return SphereVsBox(box, myTransform, otherTransform, collisionPoint, collisionNormal, penetrationDepth);
-        }
-
-        return false;
+        glm::vec3 center = GetWorldPosition(transform);
+        float scaledRadius = radius * glm::max(transform.scale.x, glm::max(transform.scale.y, transform.scale.z));
+        glm::vec3 extents(std::abs(scaledRadius));
+        return { center - extents, center + extents };
     }
 
     bool SphereCollider::SphereVsSphere(
@@ -34,20 +34,13 @@ namespace ac
         SphereCollider(float _radius, const glm::vec3& _offset);
 
         /**
-         * @brief Implements collision detection for this sphere collider.
+         * @brief Computes the world-space bounds of the collider.
          * 
-         * Checks for collision with another collider and outputs collision data.
+         * @param transform The entity's transform component
+         * @return Box containing the collider
          */
-        bool CheckCollision(
-            const Collider* other,
-            const Transform& myTransform,
-            const Transform& otherTransform,
-            glm::vec3& collisionPoint,
-            glm::vec3& collisionNormal,
-            float& penetrationDepth
-        ) const override;
+        AABB3D GetWorldAABB(const Transform& transform) const override;
 
-    private:
         /**
          * @brief Sphere vs Sphere collision detection.
          */
@@ -0,0 +1,96 @@
+#include "acpch.h"
+#include "TimeOfImpact3D.h"
+#include "Math/Transform.h"
+
+namespace ac
+{
+    namespace
+    {
+        // Advancement steps before giving up short of the contact, which is still a safe place to stop
+        constexpr int MaxAdvancementSteps = 32;
+
+        /**
+         * @brief A box or, with min == max, a point, grown by a radius.
+         */
+        struct RoundedBox3D
+        {
+            AABB3D box;
+            float radius = 0.0f;
+        };
+
+        RoundedBox3D MakeShape(const Collider& collider, const Transform& transform)
+        {
+            // A sphere's bounds are its center grown by its scaled radius
+            AABB3D bounds = collider.GetWorldAABB(transform);
+            if (collider.GetType() != ColliderType::Sphere)
+                return { bounds, 0.0f };
+            glm::vec3 center = (bounds.min + bounds.max) * 0.5f;
+            return { { center, center }, (bounds.max.x - bounds.min.x) * 0.5f };
+        }
+
+        // Distance between the shapes with a moved by shift, 0 if they overlap
+        float Distance(const RoundedBox3D& a, const glm::vec3& shift, const RoundedBox3D& b)
+        {
+            glm::vec3 gap = glm::max(glm::max(a.box.min + shift - b.box.max, b.box.min - a.box.max - shift), glm::vec3(0.0f));
+            return std::max(glm::length(gap) - a.radius - b.radius, 0.0f);
+        }
+    }
+
+    bool TimeOfImpact3D(
+        const Collider& moving,
+        const Transform& movingTransform,
+        const glm::vec3& translation,
+        const Collider& other,
+        const Transform& otherTransform,
+        float tolerance,
+        float& toi
+    )
+    {
+        float lengthSq = glm::dot(translation, translation);
+        if (lengthSq <= 0.0f)
+            return false;
+
+        RoundedBox3D a = MakeShape(moving, movingTransform);
+        RoundedBox3D b = MakeShape(other, otherTransform);
+
+        // Swept spheres: first root of |start + t * translation| = radius, relative to the other center
+        if (moving.GetType() == ColliderType::Sphere && other.GetType() == ColliderType::Sphere)
+        {
+            glm::vec3 start = a.box.min - translation - b.box.min;
+            float radius = a.radius + b.radius;
+            float c = glm::dot(start, start) - radius * radius;
+            float halfB = glm::dot(start, translation);
+            if (c <= 0.0f || halfB >= 0.0f)
+                return false; // Touching at the start, or moving apart
+            float discriminant = halfB * halfB - lengthSq * c;
+            if (discriminant < 0.0f)
+                return false;
+            float t = (-halfB - std::sqrt(discriminant)) / lengthSq;
+            if (t > 1.0f)
+                return false;
+            toi = t;
+            return true;
+        }
+
+        // Conservative advancement: no point of the moving shape travels further than the translation,
+        // so advancing it by the distance between the shapes cannot carry it through a contact
+        float length = std::sqrt(lengthSq);
+        float t = 0.0f;
+        for (int step = 0; step < MaxAdvancementSteps; ++step)
+        {
+            float distance = Distance(a, (t - 1.0f) * translation, b);
+            if (distance <= tolerance)
+            {
+                if (step == 0)
+                    return false;
+                toi = t;
+                return true;
+            }
+            t += distance / length;
+            if (t >= 1.0f)
+                return false;
+        }
+        toi = t;
+        return true;
+    }
+}
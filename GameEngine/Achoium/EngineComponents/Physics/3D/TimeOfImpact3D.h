@@ -0,0 +1,34 @@
+#pragma once
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include "../Collider.h"
+
+namespace ac
+{
+    /**
+     * @brief Finds when a collider moving in a straight line first touches another collider that holds still.
+     *
+     * Boxes are axis aligned, as in the narrowphase, so the distance between
+     * any two shapes is exact. Two spheres are swept exactly; every other
+     * pair uses conservative advancement, advancing the moving collider by
+     * the distance between the shapes until it drops below tolerance.
+     *
+     * @param moving The collider that moved
+     * @param movingTransform Its entity transform at the end of the motion
+     * @param translation How far it moved; the motion started at the end position minus translation
+     * @param other The collider holding still
+     * @param otherTransform Its entity transform
+     * @param tolerance Distance at which the colliders count as touching
+     * @param toi Output, fraction of the motion in [0, 1] at which they first touch
+     * @return True if the colliders touch during the motion; colliders touching at its start are left to the narrowphase
+     */
+    bool TimeOfImpact3D(
+        const Collider& moving,
+        const Transform& movingTransform,
+        const glm::vec3& translation,
+        const Collider& other,
+        const Transform& otherTransform,
+        float tolerance,
+        float& toi
+    );
+}
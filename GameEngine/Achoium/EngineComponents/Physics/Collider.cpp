@@ -1,20 +1,105 @@
 #include "acpch.h"
 #include "Collider.h"
+#include "3D/BoxCollider.h"
+#include "3D/SphereCollider.h"
 #include "Math/Transform.h"
 
 namespace ac
 {
-    Collider::Collider()
+    namespace
+    {
+        using CollisionFunction = bool(*)(
+            const Collider* a,
+            const Collider* b,
+            const Transform& transformA,
+            const Transform& transformB,
+            glm::vec3& collisionPoint,
+            glm::vec3& collisionNormal,
+            float& penetrationDepth);
+
+        bool BoxVsBox(const Collider* a, const Collider* b, const Transform& transformA, const Transform& transformB,
+            glm::vec3& collisionPoint, glm::vec3& collisionNormal, float& penetrationDepth)
+        {
+            return static_cast<const BoxCollider*>(a)->BoxVsBox(static_cast<const BoxCollider*>(b),
+                transformA, transformB, collisionPoint, collisionNormal, penetrationDepth);
+        }
+
+        bool SphereVsSphere(const Collider* a, const Collider* b, const Transform& transformA, const Transform& transformB,
+            glm::vec3& collisionPoint, glm::vec3& collisionNormal, float& penetrationDepth)
+        {
+            return static_cast<const SphereCollider*>(a)->SphereVsSphere(static_cast<const SphereCollider*>(b),
+                transformA, transformB, collisionPoint, collisionNormal, penetrationDepth);
+        }
+
+        bool SphereVsBox(const Collider* a, const Collider* b, const Transform& transformA, const Transform& transformB,
+            glm::vec3& collisionPoint, glm::vec3& collisionNormal, float& penetrationDepth)
+        {
+            return static_cast<const SphereCollider*>(a)->SphereVsBox(static_cast<const BoxCollider*>(b),
+                transformA, transformB, collisionPoint, collisionNormal, penetrationDepth);
+        }
+
+        // Runs a pair function with the colliders swapped, then flips the normal back
+        template <CollisionFunction Function>
+        bool Swapped(const Collider* a, const Collider* b, const Transform& transformA, const Transform& transformB,
+            glm::vec3& collisionPoint, glm::vec3& collisionNormal, float& penetrationDepth)
+        {
+            if (!Function(b, a, transformB, transformA, collisionPoint, collisionNormal, penetrationDepth))
+                return false;
+            collisionNormal = -collisionNormal;
+            return true;
+        }
+
+        constexpr size_t ShapeCount = static_cast<size_t>(ColliderType::Count);
+
+        struct CollisionTable
+        {
+            CollisionFunction functions[ShapeCount][ShapeCount] = {};
+
+            // Registers the function for (A, B) and its swapped version for (B, A)
+            template <ColliderType A, ColliderType B, CollisionFunction Function>
+            constexpr void Register()
+            {
+                functions[static_cast<size_t>(A)][static_cast<size_t>(B)] = Function;
+                if constexpr (A != B)
+                    functions[static_cast<size_t>(B)][static_cast<size_t>(A)] = &Swapped<Function>;
+            }
+
+            constexpr bool IsComplete() const
+            {
+                for (size_t a = 0; a < ShapeCount; ++a)
+                    for (size_t b = 0; b < ShapeCount; ++b)
+                        if (functions[a][b] == nullptr)
+                            return false;
+                return true;
+            }
+        };
+
+        constexpr CollisionTable BuildCollisionTable()
+        {
+            CollisionTable table;
+            table.Register<ColliderType::Box, ColliderType::Box, &BoxVsBox>();
+            table.Register<ColliderType::Sphere, ColliderType::Sphere, &SphereVsSphere>();
+            table.Register<ColliderType::Sphere, ColliderType::Box, &SphereVsBox>();
+            return table;
+        }
+
+        constexpr CollisionTable s_collisionTable = BuildCollisionTable();
+        static_assert(s_collisionTable.IsComplete(), "Every pair of 3D collider shapes needs a collision function");
+    }
+
+    Collider::Collider(ColliderType _type)
         : offset(0.0f)
         , isTrigger(false)
         , layer(0)
+        , m_type(_type)
     {
     }
     
-    Collider::Collider(uint32_t _layer)
+    Collider::Collider(ColliderType _type, uint32_t _layer)
         : offset(0.0f)
         , isTrigger(false)
         , layer(_layer)
+        , m_type(_type)
     {
     }
     
@@ -23,4 +108,17 @@ namespace ac
         // Apply entity's transform to the collider's local offset
         return transform.position + transform.rotation * offset;
     }
+
+    bool Collider::CheckCollision(
+        const Collider* other,
+        const Transform& myTransform,
+        const Transform& otherTransform,
+        glm::vec3& collisionPoint,
+        glm::vec3& collisionNormal,
+        float& penetrationDepth
+    ) const
+    {
+        CollisionFunction function = s_collisionTable.functions[static_cast<size_t>(m_type)][static_cast<size_t>(other->m_type)];
+        return function(this, other, myTransform, otherTransform, collisionPoint, collisionNormal, penetrationDepth);
+    }
 }
\ No newline at end of file
@@ -2,11 +2,22 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/glm.hpp>
 #include <cstdint>
+#include "3D/AABB3D.h"
 
 namespace ac
 {
     // Forward declaration of Transform
     class Transform;
+
+    /**
+     * @brief Shape of a 3D collider, used to pick the pair function in the collision table.
+     */
+    enum class ColliderType : uint8_t
+    {
+        Box,
+        Sphere,
+        Count
+    };
     
     /**
      * @brief Base class for all collision shapes.
@@ -22,16 +33,19 @@ namespace ac
         uint32_t layer;   ///< Collision layer this collider belongs to
         
         /**
-         * @brief Default constructor.
+         * @brief Constructor with the shape type.
+         * 
+         * @param _type Shape of the derived collider
          */
-        Collider();
+        explicit Collider(ColliderType _type);
         
         /**
-         * @brief Constructor with layer.
+         * @brief Constructor with shape type and layer.
          * 
+         * @param _type Shape of the derived collider
          * @param _layer The collision layer this collider belongs to
          */
-        explicit Collider(uint32_t _layer);
+        Collider(ColliderType _type, uint32_t _layer);
         
         /**
          * @brief Virtual destructor for proper cleanup of derived classes.
@@ -45,9 +59,17 @@ namespace ac
          * @return World position of the collider
          */
         glm::vec3 GetWorldPosition(const Transform& transform) const;
+
+        /**
+         * @brief Gets the shape of the collider.
+         */
+        ColliderType GetType() const { return m_type; }
         
         /**
-         * @brief Abstract method for collision detection against another collider.
+         * @brief Collision detection against another collider.
+         * 
+         * Looks up the pair function for the shapes of both colliders in the
+         * collision table, so any two shapes can be tested without RTTI.
          * 
          * @param other The other collider to check collision against
          * @param myTransform This collider's entity transform
@@ -57,13 +79,24 @@ namespace ac
          * @param penetrationDepth Output parameter for the penetration depth if detected
          * @return True if the colliders are intersecting
          */
-        virtual bool CheckCollision(
+        bool CheckCollision(
             const Collider* other,
             const Transform& myTransform,
             const Transform& otherTransform,
             glm::vec3& collisionPoint,
             glm::vec3& collisionNormal,
             float& penetrationDepth
-        ) const = 0;
+        ) const;
+
+        /**
+         * @brief Abstract method computing the world-space bounds of the collider.
+         * 
+         * @param transform The entity's transform component
+         * @return Box containing the collider, used by the broadphase
+         */
+        virtual AABB3D GetWorldAABB(const Transform& transform) const = 0;
+
+    private:
+        ColliderType m_type; ///< Shape of the derived collider
     };
 }
\ No newline at end of file
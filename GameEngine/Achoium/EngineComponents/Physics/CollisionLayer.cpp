@@ -8,10 +8,7 @@ namespace ac
         // Initialize all layers to collide with each other
         for (uint32_t i = 0; i < MAX_COLLISION_LAYERS; ++i)
         {
-            for (uint32_t j = 0; j < MAX_COLLISION_LAYERS; ++j)
-            {
-                m_collisionMatrix[i][j] = true;
-            }
+            m_collisionMasks[i] = ~0u;
             
             // Set default layer names
             m_layerNames[i] = "Layer " + std::to_string(i);
@@ -31,8 +28,16 @@ namespace ac
     {
         if (layer1 < MAX_COLLISION_LAYERS && layer2 < MAX_COLLISION_LAYERS)
         {
-            m_collisionMatrix[layer1][layer2] = shouldCollide;
-            m_collisionMatrix[layer2][layer1] = shouldCollide;
+            if (shouldCollide)
+            {
+                m_collisionMasks[layer1] |= GetLayerBit(layer2);
+                m_collisionMasks[layer2] |= GetLayerBit(layer1);
+            }
+            else
+            {
+                m_collisionMasks[layer1] &= ~GetLayerBit(layer2);
+                m_collisionMasks[layer2] &= ~GetLayerBit(layer1);
+            }
         }
     }
     
@@ -40,10 +45,24 @@ namespace ac
     {
         if (layer1 < MAX_COLLISION_LAYERS && layer2 < MAX_COLLISION_LAYERS)
         {
-            return m_collisionMatrix[layer1][layer2];
+            return (m_collisionMasks[layer1] & GetLayerBit(layer2)) != 0;
         }
         return false;
     }
+
+    uint32_t CollisionLayer::GetCollisionMask(uint32_t layer) const
+    {
+        if (layer < MAX_COLLISION_LAYERS)
+        {
+            return m_collisionMasks[layer];
+        }
+        return 0;
+    }
+
+    uint32_t CollisionLayer::GetLayerBit(uint32_t layer)
+    {
+        return layer < MAX_COLLISION_LAYERS ? 1u << layer : 0u;
+    }
     
     const std::string& CollisionLayer::GetLayerName(uint32_t index) const
     {
@@ -39,6 +39,25 @@ namespace ac
          * @return True if the layers should collide
          */
         bool ShouldCollide(uint32_t layer1, uint32_t layer2) const;
+
+        /**
+         * @brief Gets the layers a layer collides with as a bitmask.
+         * 
+         * Bit i is set if the layer collides with layer i, so a pair filter is
+         * GetCollisionMask(layer1) & GetLayerBit(layer2).
+         * 
+         * @param layer The layer
+         * @return Mask of the colliding layers, 0 for an invalid layer
+         */
+        uint32_t GetCollisionMask(uint32_t layer) const;
+
+        /**
+         * @brief Gets the bit of a layer in collision masks.
+         * 
+         * @param layer The layer
+         * @return 1 << layer, 0 for an invalid layer
+         */
+        static uint32_t GetLayerBit(uint32_t layer);
         
         /**
          * @brief Gets a named layer by index.
@@ -57,8 +76,8 @@ namespace ac
         void SetLayerName(uint32_t index, const std::string& name);
         
     private:
-        // Collision matrix stored as a 32x32 array of booleans
-        std::array<std::array<bool, MAX_COLLISION_LAYERS>, MAX_COLLISION_LAYERS> m_collisionMatrix;
+        // Collision matrix stored as one 32 bit row per layer
+        std::array<uint32_t, MAX_COLLISION_LAYERS> m_collisionMasks;
         
         // Names for each layer
         std::array<std::string, MAX_COLLISION_LAYERS> m_layerNames;
@@ -0,0 +1,128 @@
+#include "acpch.h"
+#include "Islands.h"
+
+namespace ac
+{
+    void IslandBuilder::Reset(uint32_t bodyCount)
+    {
+        m_parent.resize(bodyCount);
+        m_size.assign(bodyCount, 1);
+        for (uint32_t body = 0; body < bodyCount; ++body)
+            m_parent[body] = body;
+        m_islandOfBody.clear();
+        m_bodies.clear();
+        m_islandStarts.assign(1, 0);
+    }
+
+    void IslandBuilder::Link(uint32_t a, uint32_t b)
+    {
+        a = Find(a);
+        b = Find(b);
+        if (a == b)
+            return;
+
+        // Hang the smaller tree below the larger one so paths stay short
+        if (m_size[a] < m_size[b])
+            std::swap(a, b);
+        m_parent[b] = a;
+        m_size[a] += m_size[b];
+    }
+
+    uint32_t IslandBuilder::Find(uint32_t body)
+    {
+        // Path halving: every visited body skips to its grandparent
+        while (m_parent[body] != body)
+        {
+            m_parent[body] = m_parent[m_parent[body]];
+            body = m_parent[body];
+        }
+        return body;
+    }
+
+    void IslandBuilder::Build()
+    {
+        uint32_t bodyCount = static_cast<uint32_t>(m_parent.size());
+
+        // Number the islands by their lowest body and count their members
+        std::vector<uint32_t> islandOfRoot(bodyCount, UINT32_MAX);
+        m_islandOfBody.resize(bodyCount);
+        m_islandStarts.assign(1, 0);
+        for (uint32_t body = 0; body < bodyCount; ++body)
+        {
+            uint32_t root = Find(body);
+            if (islandOfRoot[root] == UINT32_MAX)
+            {
+                islandOfRoot[root] = static_cast<uint32_t>(m_islandStarts.size()) - 1;
+                m_islandStarts.push_back(0);
+            }
+            m_islandOfBody[body] = islandOfRoot[root];
+            ++m_islandStarts[m_islandOfBody[body] + 1];
+        }
+
+        // Counting sort of the bodies by island keeps them in increasing order within each
+        for (size_t island = 1; island < m_islandStarts.size(); ++island)
+            m_islandStarts[island] += m_islandStarts[island - 1];
+        std::vector<uint32_t> next(m_islandStarts.begin(), m_islandStarts.end() - 1);
+        m_bodies.resize(bodyCount);
+        for (uint32_t body = 0; body < bodyCount; ++body)
+            m_bodies[next[m_islandOfBody[body]]++] = body;
+    }
+
+    void SleepingIslands::Add(const std::vector<Entity>& bodies)
+    {
+        uint32_t island;
+        if (!m_freeIslands.empty())
+        {
+            island = m_freeIslands.back();
+            m_freeIslands.pop_back();
+            m_islands[island] = bodies;
+        }
+        else
+        {
+            island = static_cast<uint32_t>(m_islands.size());
+            m_islands.push_back(bodies);
+        }
+
+        for (Entity body : bodies)
+            m_islandOf[body] = island;
+    }
+
+    void SleepingIslands::Take(Entity body, std::vector<Entity>& woken)
+    {
+        auto it = m_islandOf.find(body);
+        if (it != m_islandOf.end())
+            TakeIsland(it->second, woken);
+    }
+
+    void SleepingIslands::Break(Entity body)
+    {
+        if (m_islandOf.find(body) != m_islandOf.end())
+            m_broken.push_back(body);
+    }
+
+    void SleepingIslands::TakeBroken(std::vector<Entity>& woken)
+    {
+        // Bodies of an island taken earlier in the loop are no longer found
+        for (Entity body : m_broken)
+            Take(body, woken);
+        m_broken.clear();
+    }
+
+    void SleepingIslands::Clear()
+    {
+        m_islands.clear();
+        m_freeIslands.clear();
+        m_islandOf.clear();
+        m_broken.clear();
+    }
+
+    void SleepingIslands::TakeIsland(uint32_t island, std::vector<Entity>& woken)
+    {
+        std::vector<Entity>& bodies = m_islands[island];
+        for (Entity body : bodies)
+            m_islandOf.erase(body);
+        woken.insert(woken.end(), bodies.begin(), bodies.end());
+        bodies.clear();
+        m_freeIslands.push_back(island);
+    }
+}
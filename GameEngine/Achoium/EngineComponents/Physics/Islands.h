@@ -0,0 +1,161 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Core/sparseset.hpp"
+
+namespace ac
+{
+    /**
+     * @brief Groups bodies linked by contacts into islands with union-find.
+     *
+     * Bodies are numbered 0..n-1 by the caller. Link merges the islands of two
+     * bodies; after Build, the bodies of every island are listed next to each
+     * other, islands in the order of their lowest body and bodies in
+     * increasing order, so the grouping does not depend on the order the
+     * links were made in.
+     */
+    class IslandBuilder
+    {
+    public:
+        /**
+         * @brief Starts over with bodyCount bodies, each its own island.
+         *
+         * @param bodyCount Number of bodies
+         */
+        void Reset(uint32_t bodyCount);
+
+        /**
+         * @brief Puts two bodies in the same island.
+         *
+         * @param a First body
+         * @param b Second body
+         */
+        void Link(uint32_t a, uint32_t b);
+
+        /**
+         * @brief Gets the body standing for the island of a body.
+         *
+         * @param body The body
+         * @return The same body for every member of an island
+         */
+        uint32_t Find(uint32_t body);
+
+        /**
+         * @brief Lists the bodies of every island; call after the last Link.
+         */
+        void Build();
+
+        /**
+         * @brief Number of islands found by Build, including single bodies.
+         */
+        uint32_t GetIslandCount() const { return static_cast<uint32_t>(m_islandStarts.size()) - 1; }
+
+        /**
+         * @brief Gets the bodies of an island found by Build.
+         *
+         * @param island Index of the island, below GetIslandCount()
+         * @param count Output, number of bodies in the island
+         * @return The bodies of the island in increasing order
+         */
+        const uint32_t* GetIslandBodies(uint32_t island, uint32_t& count) const
+        {
+            count = m_islandStarts[island + 1] - m_islandStarts[island];
+            return m_bodies.data() + m_islandStarts[island];
+        }
+
+        /**
+         * @brief Gets the island Build put a body in.
+         *
+         * @param body The body
+         * @return Index of the island, below GetIslandCount()
+         */
+        uint32_t GetIsland(uint32_t body) const { return m_islandOfBody[body]; }
+
+    private:
+        std::vector<uint32_t> m_parent;
+        std::vector<uint32_t> m_size;
+        std::vector<uint32_t> m_islandOfBody; ///< Island of every body, filled by Build
+        std::vector<uint32_t> m_bodies;       ///< Bodies grouped by island
+        std::vector<uint32_t> m_islandStarts{ 0 }; ///< Start of every island in m_bodies, then m_bodies.size()
+    };
+
+    /**
+     * @brief The islands that fell asleep, kept so touching one sleeping body wakes its whole island.
+     */
+    class SleepingIslands
+    {
+    public:
+        /**
+         * @brief Records the bodies of an island that fell asleep.
+         *
+         * @param bodies Entities of the island
+         */
+        void Add(const std::vector<Entity>& bodies);
+
+        /**
+         * @brief Forgets the island of a body and appends its bodies to woken.
+         *
+         * @param body A sleeping entity; nothing happens if it is in no island
+         * @param woken Output the entities of the island are appended to
+         */
+        void Take(Entity body, std::vector<Entity>& woken);
+
+        /**
+         * @brief Queues the island of a body to be woken by the next TakeBroken.
+         *
+         * Called when a body of a sleeping island is destroyed, loses its
+         * rigid body or a collider, or was woken by a force or an impulse:
+         * the rest of the island may have lost what held it up. Nothing
+         * happens if the body is in no island.
+         *
+         * @param body The entity
+         */
+        void Break(Entity body);
+
+        /**
+         * @brief Forgets the islands queued by Break and appends their bodies to woken.
+         *
+         * @param woken Output the entities of the islands are appended to
+         */
+        void TakeBroken(std::vector<Entity>& woken);
+
+        /**
+         * @brief Number of islands sleeping.
+         */
+        size_t GetIslandCount() const { return m_islands.size() - m_freeIslands.size(); }
+
+        /**
+         * @brief Forgets every island.
+         */
+        void Clear();
+
+    private:
+        void TakeIsland(uint32_t island, std::vector<Entity>& woken);
+
+        std::vector<std::vector<Entity>> m_islands;       ///< Bodies of every island, empty for free slots
+        std::vector<uint32_t> m_freeIslands;              ///< Free slots of m_islands
+        std::unordered_map<Entity, uint32_t> m_islandOf;  ///< Island of every sleeping body
+        std::vector<Entity> m_broken;                     ///< Bodies passed to Break since the last TakeBroken
+    };
+
+    /**
+     * @brief World resource deciding when rigid bodies fall asleep and keeping the sleeping islands.
+     *
+     * After every collision step, each island of touching dynamic bodies
+     * whose members all moved slower than the thresholds for stepsToSleep
+     * fixed steps is put to sleep: its bodies are not integrated, not refit
+     * in the broadphase and not solved until a contact with a moving body,
+     * a force or an impulse wakes them.
+     */
+    struct PhysicsSleep
+    {
+        bool enabled = true;               ///< If false, no island falls asleep; sleeping ones still wake up
+        float linearSleepVelocity = 1.0f;  ///< Speed below which a body counts as resting
+        float angularSleepVelocity = 0.05f; ///< Angular speed below which a body counts as resting (rad/s)
+        uint32_t stepsToSleep = 30;        ///< Fixed steps every body of an island must rest before it sleeps
+
+        SleepingIslands bodies2D; ///< Islands of RigidBody2D entities
+        SleepingIslands bodies3D; ///< Islands of RigidBody entities
+    };
+}
@@ -15,5 +15,11 @@
 
 // Include collision system resources
 #include "CollisionLayer.h"
+#include "Islands.h"
+#include "2D/Broadphase2D.h"
+#include "2D/ContactSolver2D.h"
+#include "3D/SpatialHashGrid3D.h"
+#include "2D/TimeOfImpact2D.h"
+#include "3D/TimeOfImpact3D.h"
 
 #include "2D/Collider2D.h"
\ No newline at end of file
@@ -14,7 +14,11 @@ namespace ac
         friction(0.5f),
         useGravity(true),
         isKinematic(false),
-        freezeRotation(false)
+        freezeRotation(false),
+        isSleeping(false),
+        restFrames(0),
+        bullet(false),
+        sweep(0.0f)
     {
     }
 
@@ -29,7 +33,11 @@ namespace ac
         friction(friction),
         useGravity(useGravity),
         isKinematic(isKnematic),
-        freezeRotation(freezeRotation)
+        freezeRotation(freezeRotation),
+        isSleeping(false),
+        restFrames(0),
+        bullet(false),
+        sweep(0.0f)
     {
     }
 
@@ -42,34 +50,96 @@ namespace ac
         friction(0.5f),
         useGravity(true),
         isKinematic(false),
-        freezeRotation(false)
+        freezeRotation(false),
+        isSleeping(false),
+        restFrames(0),
+        bullet(false),
+        sweep(0.0f)
     {
         mass = _mass;
         inverseMass = _mass > 0.0f ? 1.0f / _mass : 0.0f;
     }
 
-    void RigidBody::ApplyForce(const glm::vec3& _force)
+    // Shared by RigidBody and RigidBodyRef, whose fields are references into SoA columns
+    template <class Body>
+    static void WakeUpBody(Body& body)
     {
-        if (!isKinematic)
-            force += _force;
+        body.isSleeping = false;
+        body.restFrames = 0;
     }
 
-    void RigidBody::ApplyForceAtPosition(const glm::vec3& _force, const glm::vec3& _position)
+    template <class Body>
+    static void ApplyForceTo(Body& body, const glm::vec3& _force)
     {
-        if (!isKinematic)
+        if (!body.isKinematic)
+        {
+            WakeUpBody(body);
+            body.force += _force;
+        }
+    }
+
+    template <class Body>
+    static void ApplyForceAtPositionTo(Body& body, const glm::vec3& _force, const glm::vec3& _position)
+    {
+        if (!body.isKinematic)
         {
             // Add linear force
-            force += _force;
+            WakeUpBody(body);
+            body.force += _force;
 
             // Compute torque = r × F
-            if (!freezeRotation)
-                torque += glm::cross(_position, _force);
+            if (!body.freezeRotation)
+                body.torque += glm::cross(_position, _force);
+        }
+    }
+
+    template <class Body>
+    static void ApplyImpulseTo(Body& body, const glm::vec3& _impulse)
+    {
+        if (!body.isKinematic)
+        {
+            WakeUpBody(body);
+            body.velocity += _impulse * body.inverseMass;
         }
     }
 
+    void RigidBody::ApplyForce(const glm::vec3& _force)
+    {
+        ApplyForceTo(*this, _force);
+    }
+
+    void RigidBody::ApplyForceAtPosition(const glm::vec3& _force, const glm::vec3& _position)
+    {
+        ApplyForceAtPositionTo(*this, _force, _position);
+    }
+
     void RigidBody::ApplyImpulse(const glm::vec3& _impulse)
     {
-        if (!isKinematic)
-            velocity += _impulse * inverseMass;
+        ApplyImpulseTo(*this, _impulse);
+    }
+
+    void RigidBody::WakeUp()
+    {
+        WakeUpBody(*this);
+    }
+
+    void RigidBodyRef::ApplyForce(const glm::vec3& _force) const
+    {
+        ApplyForceTo(*this, _force);
+    }
+
+    void RigidBodyRef::ApplyForceAtPosition(const glm::vec3& _force, const glm::vec3& _position) const
+    {
+        ApplyForceAtPositionTo(*this, _force, _position);
+    }
+
+    void RigidBodyRef::ApplyImpulse(const glm::vec3& _impulse) const
+    {
+        ApplyImpulseTo(*this, _impulse);
+    }
+
+    void RigidBodyRef::WakeUp() const
+    {
+        WakeUpBody(*this);
     }
 }
\ No newline at end of file
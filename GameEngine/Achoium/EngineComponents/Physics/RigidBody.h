@@ -1,6 +1,7 @@
 #pragma once
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/glm.hpp>
+#include "Core/SoA.hpp"
 
 namespace ac
 {
@@ -9,6 +10,10 @@ namespace ac
      * 
      * RigidBody provides physics simulation properties including mass,
      * velocity, forces, and physical material properties.
+     *
+     * Worlds store it field by field (see SoALayout<RigidBody>), so views
+     * and World::Get hand out RigidBodyRef / RigidBodyConstRef instead
+     * of RigidBody& / const RigidBody&.
      */
     class RigidBody
     {
@@ -24,6 +29,10 @@ namespace ac
         bool useGravity; ///< Whether gravity affects this object
         bool isKinematic; ///< If true, not affected by forces but affects others
         bool freezeRotation; ///< If true, rotation is not simulated
+        bool isSleeping; ///< If true, the body's island came to rest and is not simulated until something wakes it
+        uint32_t restFrames; ///< Consecutive fixed steps the body moved slower than the sleep thresholds
+        bool bullet; ///< If true, CollisionSystem sweeps the body's colliders along their motion so they cannot pass through thin ones
+        glm::vec3 sweep; ///< Translation of the last integration step, kept for bullets until CollisionSystem sweeps it
         
         /**
          * @brief Default constructor with standard physics values.
@@ -60,5 +69,84 @@ namespace ac
          * @param _impulse Impulse vector to apply
          */
         void ApplyImpulse(const glm::vec3& _impulse);
+
+        /**
+         * @brief Wakes the body up if it is sleeping and restarts its rest count.
+         *
+         * The forces and impulses above wake the body themselves; the rest of
+         * its island wakes at the next collision step.
+         */
+        void WakeUp();
+    };
+
+    /**
+     * @brief Mutable reference to a RigidBody stored in the SoA columns of a World.
+     */
+    struct RigidBodyRef
+    {
+        float& mass;
+        float& inverseMass;
+        glm::vec3& velocity;
+        glm::vec3& angularVelocity;
+        glm::vec3& force;
+        glm::vec3& torque;
+        float& restitution;
+        float& friction;
+        bool& useGravity;
+        bool& isKinematic;
+        bool& freezeRotation;
+        bool& isSleeping;
+        uint32_t& restFrames;
+        bool& bullet;
+        glm::vec3& sweep;
+
+        /** @copydoc RigidBody::ApplyForce */
+        void ApplyForce(const glm::vec3& _force) const;
+
+        /** @copydoc RigidBody::ApplyForceAtPosition */
+        void ApplyForceAtPosition(const glm::vec3& _force, const glm::vec3& _position) const;
+
+        /** @copydoc RigidBody::ApplyImpulse */
+        void ApplyImpulse(const glm::vec3& _impulse) const;
+
+        /** @copydoc RigidBody::WakeUp */
+        void WakeUp() const;
+    };
+
+    /**
+     * @brief Read-only reference to a RigidBody stored in the SoA columns of a World.
+     */
+    struct RigidBodyConstRef
+    {
+        const float& mass;
+        const float& inverseMass;
+        const glm::vec3& velocity;
+        const glm::vec3& angularVelocity;
+        const glm::vec3& force;
+        const glm::vec3& torque;
+        const float& restitution;
+        const float& friction;
+        const bool& useGravity;
+        const bool& isKinematic;
+        const bool& freezeRotation;
+        const bool& isSleeping;
+        const uint32_t& restFrames;
+        const bool& bullet;
+        const glm::vec3& sweep;
+    };
+
+    /**
+     * @brief Stores each RigidBody field in its own column so the integration kernels can stream them.
+     */
+    template <>
+    struct SoALayout<RigidBody>
+    {
+        using Fields = SoAFields<&RigidBody::mass, &RigidBody::inverseMass, &RigidBody::velocity,
+            &RigidBody::angularVelocity, &RigidBody::force, &RigidBody::torque, &RigidBody::restitution,
+            &RigidBody::friction, &RigidBody::useGravity, &RigidBody::isKinematic, &RigidBody::freezeRotation,
+            &RigidBody::isSleeping, &RigidBody::restFrames,
+            &RigidBody::bullet, &RigidBody::sweep>;
+        using Ref = RigidBodyRef;
+        using ConstRef = RigidBodyConstRef;
     };
 }
\ No newline at end of file
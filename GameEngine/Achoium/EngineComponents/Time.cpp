@@ -1,5 +1,6 @@
 #include "acpch.h"
 #include "Time.h"
+#include "Debug.h"
 namespace ac
 {
     Time::Time()
@@ -10,23 +11,61 @@ namespace ac
         realDelta = 0;
         totTime = 0;
         realTotTime = 0;
-        
+        fixedDelta = 1.0f / 60.0f;
+        maxFixedSteps = 4;
+        fixedStepCount = 0;
+        fixedAccumulator = 0;
+        fixedTime = 0;
     }
     void Time::Update()
     {
         auto now = std::chrono::high_resolution_clock::now();
 
         // Calculate delta time (in seconds)
-        realDelta = std::chrono::duration<float>(now - preTime).count();
+        float frameTime = std::chrono::duration<float>(now - preTime).count();
         preTime = now;
 
+        Advance(frameTime);
+        preTime = std::chrono::high_resolution_clock::now();
+    }
+    void Time::Advance(float frameTime)
+    {
+        realDelta = frameTime;
+
         // Apply time scaling (e.g., 1.0 = normal, 0.5 = slow-mo)
         delta = realDelta * timeScale;
 
         // Update total time (unscaled and scaled)
         totTime += delta;
         realTotTime += realDelta;
-        preTime = std::chrono::high_resolution_clock::now();
+
+        // Split the scaled time into fixed steps, keeping the remainder for the next frame
+        fixedAccumulator += delta;
+        fixedStepCount = static_cast<uint32_t>(fixedAccumulator / fixedDelta);
+        if (fixedStepCount > maxFixedSteps)
+        {
+            fixedStepCount = maxFixedSteps;
+            fixedAccumulator = std::fmod(fixedAccumulator, fixedDelta);
+        }
+        else
+        {
+            fixedAccumulator -= fixedStepCount * fixedDelta;
+        }
+        // Round-off can leave the remainder a hair outside [0, fixedDelta)
+        fixedAccumulator = std::clamp(fixedAccumulator, 0.0f, std::nextafter(fixedDelta, 0.0f));
+        fixedTime += static_cast<double>(fixedStepCount) * fixedDelta;
+    }
+    void Time::SetFixedDelta(float seconds)
+    {
+        ACASSERT(seconds > 0.0f, "Fixed time step must be greater than 0");
+        // Keep the same fraction of a step pending so interpolation does not jump
+        fixedAccumulator = InterpolationAlpha() * seconds;
+        fixedDelta = seconds;
+    }
+    void Time::SetMaxFixedSteps(uint32_t steps)
+    {
+        ACASSERT(steps > 0, "At least one fixed step per frame is needed");
+        maxFixedSteps = steps;
     }
     float Time::Delta() const
     {
@@ -1,5 +1,6 @@
 #pragma once
 #include <chrono>
+#include <cstdint>
 namespace ac
 {
 	class Time
@@ -13,6 +14,61 @@ namespace ac
 		float CurTime() const;
 		float RealCurTime() const;
 		float GetFrameRate() const;
+
+		/**
+		 * @brief Advances the clocks by a measured frame time; Update calls it with the time since the last Update.
+		 *
+		 * The scaled time is added to the fixed-step accumulator, which is
+		 * then split into whole fixed steps, at most MaxFixedSteps. Time past
+		 * that limit is dropped, so a long frame slows the simulation down
+		 * instead of making the next frames even longer.
+		 *
+		 * @param frameTime Unscaled seconds since the previous frame.
+		 */
+		void Advance(float frameTime);
+
+		/**
+		 * @brief Gets the simulated seconds per fixed step.
+		 */
+		float FixedDelta() const { return fixedDelta; }
+
+		/**
+		 * @brief Sets the simulated seconds per fixed step, e.g. 1/30 or 1/60 s.
+		 *
+		 * @param seconds Length of a step, greater than 0.
+		 */
+		void SetFixedDelta(float seconds);
+
+		/**
+		 * @brief Gets the most fixed steps run in one frame.
+		 */
+		uint32_t MaxFixedSteps() const { return maxFixedSteps; }
+
+		/**
+		 * @brief Sets the most fixed steps run in one frame.
+		 *
+		 * @param steps Limit on the steps per frame, at least 1.
+		 */
+		void SetMaxFixedSteps(uint32_t steps);
+
+		/**
+		 * @brief Gets the number of fixed steps due in the current frame.
+		 */
+		uint32_t FixedStepCount() const { return fixedStepCount; }
+
+		/**
+		 * @brief Gets how far the current frame lies between the last fixed step and the next, in [0, 1).
+		 *
+		 * Rendering blends the state before the last fixed step with the state
+		 * after it by this factor, so motion stays smooth when the frame rate
+		 * and the fixed step rate differ.
+		 */
+		float InterpolationAlpha() const { return fixedAccumulator / fixedDelta; }
+
+		/**
+		 * @brief Gets the simulated seconds covered by all fixed steps so far.
+		 */
+		double FixedTime() const { return fixedTime; }
 	private:
 		float timeScale;
 		std::chrono::time_point<std::chrono::high_resolution_clock> preTime;
@@ -20,6 +76,11 @@ namespace ac
 		float realDelta;
 		float totTime;
 		float realTotTime;
+		float fixedDelta;
+		uint32_t maxFixedSteps;
+		uint32_t fixedStepCount;
+		float fixedAccumulator;
+		double fixedTime;
 		
 
 	};
@@ -16,7 +16,7 @@ namespace ac
 
         // һԾƵͨӵһ
         Entity activeListenerEntity = NULL_ENTITY;
-        auto listenerView = world.View<AudioListener>();
+        auto listenerView = world.View<const AudioListener>();
         for (auto [entity, listener] : listenerView.GetPacked())
         {
             if (std::get<0>(listener).active)
@@ -27,7 +27,9 @@ namespace ac
         }
 
         // ƵԴ
-        world.View<AudioSource>().ForEach([&audioManager,&world, activeListenerEntity](Entity entity, AudioSource& audioSource)
+        const Transform* listenerTransform = activeListenerEntity != NULL_ENTITY ?
+            world.GetPtr<const Transform>(activeListenerEntity) : nullptr;
+        world.View<const AudioSource>(Optional<const Transform>{}).ForEach([&audioManager, &world, listenerTransform](Entity entity, const AudioSource& audioSource, const Transform* sourceTransform)
             {
                 // ЧƵID
                 if (audioSource.audioID == INVALID_AUDIO_ID) return;
@@ -37,15 +39,10 @@ namespace ac
                 if (!clip) return;
 
                 // ھ˥лԾļͱ任
-                if (activeListenerEntity != NULL_ENTITY &&
-                    world.Has<Transform>(entity) &&
-                    world.Has<Transform>(activeListenerEntity))
+                if (sourceTransform != nullptr && listenerTransform != nullptr)
                 {
-                    const auto& sourceTransform = world.Get<Transform>(entity);
-                    const auto& listenerTransform = world.Get<Transform>(activeListenerEntity);
-
                     // Դ֮ľ
-                    float distance = glm::distance(sourceTransform.position, listenerTransform.position);
+                    float distance = glm::distance(sourceTransform->position, listenerTransform->position);
 
                     // ݾ򵥵˥
                     const float maxDistance = 20.0f; // 
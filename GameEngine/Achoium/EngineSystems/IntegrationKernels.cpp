@@ -0,0 +1,456 @@
+#include "acpch.h"
+#include "IntegrationKernels.h"
+#include <cstring>
+namespace ac
+{
+    static_assert(sizeof(bool) == 1, "The kernels read bool flags as bytes");
+    static_assert(sizeof(glm::vec2) == 2 * sizeof(float) && sizeof(glm::vec3) == 3 * sizeof(float),
+        "The kernels read vector columns as packed floats");
+
+    // Bodies spinning slower than this (rad/s) are not rotated
+    constexpr float RotationThreshold = 0.0001f;
+
+    // Cephes single precision sine and cosine: |x| is reduced to [-pi/4, pi/4] by subtracting
+    // the nearest even multiple of pi/4 (split in three parts to keep precision), then one of
+    // two minimax polynomials is evaluated depending on the octant.
+    constexpr float FourOverPi = 1.27323954473516f;
+    constexpr float PiOver4Part1 = -0.78515625f;
+    constexpr float PiOver4Part2 = -2.4187564849853515625e-4f;
+    constexpr float PiOver4Part3 = -3.77489497744594108e-8f;
+    constexpr float CosCoef0 = 2.443315711809948e-5f;
+    constexpr float CosCoef1 = -1.388731625493765e-3f;
+    constexpr float CosCoef2 = 4.166664568298827e-2f;
+    constexpr float SinCoef0 = -1.9515295891e-4f;
+    constexpr float SinCoef1 = 8.3321608736e-3f;
+    constexpr float SinCoef2 = -1.6666654611e-1f;
+
+    static void Integrate2DScalar(const BodyBatch2D& b, size_t begin, size_t end, glm::vec2 gravity, float dt)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            bool dynamic = b.active[i] != 0 && !b.isKinematic[i] && !b.isSleeping[i];
+            bool spin = dynamic && !b.freezeRotation[i];
+
+            glm::vec2 force = b.useGravity[i] ? b.force[i] + gravity * b.mass[i] : b.force[i];
+            glm::vec2 velocity = dynamic ? b.velocity[i] + force * b.inverseMass[i] * dt : b.velocity[i];
+            float angularVelocity = spin ? b.angularVelocity[i] + b.torque[i] * b.inverseMass[i] * dt : b.angularVelocity[i];
+            bool rotate = spin && std::abs(angularVelocity) > RotationThreshold;
+
+            b.velocity[i] = velocity;
+            b.angularVelocity[i] = angularVelocity;
+            b.displacement[i] = dynamic ? velocity * dt : glm::vec2(0.0f);
+            b.rotationW[i] = 1.0f;
+            b.rotationZ[i] = 0.0f;
+            if (rotate)
+            {
+                float halfAngle = angularVelocity * dt * 0.5f;
+                b.rotationW[i] = std::cos(halfAngle);
+                b.rotationZ[i] = std::sin(halfAngle);
+            }
+            b.force[i] = dynamic ? glm::vec2(0.0f) : b.force[i];
+            b.torque[i] = dynamic ? 0.0f : b.torque[i];
+        }
+    }
+
+    static void Integrate3DScalar(const BodyBatch3D& b, size_t begin, size_t end, glm::vec3 gravity, float dt)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            bool dynamic = b.active[i] != 0 && !b.isKinematic[i] && !b.isSleeping[i];
+            bool spin = dynamic && !b.freezeRotation[i];
+
+            glm::vec3 force = b.useGravity[i] ? b.force[i] + gravity * b.mass[i] : b.force[i];
+            glm::vec3 velocity = dynamic ? b.velocity[i] + force * b.inverseMass[i] * dt : b.velocity[i];
+            glm::vec3 angularVelocity = spin ? b.angularVelocity[i] + b.torque[i] * b.inverseMass[i] * dt : b.angularVelocity[i];
+            float speed = std::sqrt(angularVelocity.x * angularVelocity.x + angularVelocity.y * angularVelocity.y + angularVelocity.z * angularVelocity.z);
+            bool rotate = spin && speed > RotationThreshold;
+
+            b.velocity[i] = velocity;
+            b.angularVelocity[i] = angularVelocity;
+            b.displacement[i] = dynamic ? velocity * dt : glm::vec3(0.0f);
+            glm::vec3 axisSin(0.0f);
+            b.rotationW[i] = 1.0f;
+            if (rotate)
+            {
+                // sin(halfAngle) * axis, with axis = angularVelocity / speed
+                float halfAngle = speed * dt * 0.5f;
+                axisSin = angularVelocity * (std::sin(halfAngle) / speed);
+                b.rotationW[i] = std::cos(halfAngle);
+            }
+            b.rotationX[i] = axisSin.x;
+            b.rotationY[i] = axisSin.y;
+            b.rotationZ[i] = axisSin.z;
+            b.force[i] = dynamic ? glm::vec3(0.0f) : b.force[i];
+            b.torque[i] = dynamic ? glm::vec3(0.0f) : b.torque[i];
+        }
+    }
+
+#if defined(AC_SIMD_X86)
+    // ---- SSE2: 4 bodies per iteration ----
+
+    /** Per lane mask ? a : b. */
+    static inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    /** Turns 4 flag bytes into lane masks, all bits set for non-zero bytes. */
+    static inline __m128 LoadMask4(const void* flags)
+    {
+        int32_t bytes;
+        std::memcpy(&bytes, flags, sizeof(bytes));
+        __m128i zero = _mm_setzero_si128();
+        __m128i lanes = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero), zero);
+        return _mm_castsi128_ps(_mm_cmpgt_epi32(lanes, zero));
+    }
+
+    static inline void SinCos4(__m128 x, __m128& sinOut, __m128& cosOut)
+    {
+        const __m128 signBit = _mm_castsi128_ps(_mm_set1_epi32(INT32_MIN));
+        __m128 sinSign = _mm_and_ps(x, signBit);
+        x = _mm_andnot_ps(signBit, x);
+
+        __m128i octant = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(FourOverPi)));
+        octant = _mm_and_si128(_mm_add_epi32(octant, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+        __m128 y = _mm_cvtepi32_ps(octant);
+        sinSign = _mm_xor_ps(sinSign, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(octant, _mm_set1_epi32(4)), 29)));
+        __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(octant, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+        __m128 sinPolyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(octant, _mm_set1_epi32(2)), _mm_setzero_si128()));
+
+        x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(PiOver4Part1)));
+        x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(PiOver4Part2)));
+        x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(PiOver4Part3)));
+        __m128 z = _mm_mul_ps(x, x);
+
+        __m128 cosPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(CosCoef0), z), _mm_set1_ps(CosCoef1));
+        cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(CosCoef2));
+        cosPoly = _mm_mul_ps(_mm_mul_ps(cosPoly, z), z);
+        cosPoly = _mm_add_ps(_mm_sub_ps(cosPoly, _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+        __m128 sinPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SinCoef0), z), _mm_set1_ps(SinCoef1));
+        sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(SinCoef2));
+        sinPoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinPoly, z), x), x);
+
+        sinOut = _mm_xor_ps(Select(sinPolyMask, sinPoly, cosPoly), sinSign);
+        cosOut = _mm_xor_ps(Select(sinPolyMask, cosPoly, sinPoly), cosSign);
+    }
+
+    /**
+     * @brief Linear part of the step for 4 packed floats of a vector column.
+     *
+     * The per-body scalars and masks are already spread to match the floats.
+     */
+    static inline void IntegrateLinear4(float* velocity, float* force, float* displacement, __m128 gravity,
+        __m128 mass, __m128 inverseMass, __m128 dynamic, __m128 gravityOn, __m128 dt)
+    {
+        __m128 f = _mm_loadu_ps(force);
+        __m128 v = _mm_loadu_ps(velocity);
+        __m128 accumulated = Select(gravityOn, _mm_add_ps(f, _mm_mul_ps(gravity, mass)), f);
+        v = Select(dynamic, _mm_add_ps(v, _mm_mul_ps(_mm_mul_ps(accumulated, inverseMass), dt)), v);
+        _mm_storeu_ps(velocity, v);
+        _mm_storeu_ps(displacement, _mm_and_ps(dynamic, _mm_mul_ps(v, dt)));
+        _mm_storeu_ps(force, _mm_andnot_ps(dynamic, f));
+    }
+
+    static void Integrate2DSSE2(const BodyBatch2D& b, size_t begin, size_t end, glm::vec2 gravity, float dt)
+    {
+        const __m128 dtv = _mm_set1_ps(dt);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 threshold = _mm_set1_ps(RotationThreshold);
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(INT32_MAX));
+        const __m128 gravityPair = _mm_setr_ps(gravity.x, gravity.y, gravity.x, gravity.y);
+
+        size_t i = begin;
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 mass = _mm_loadu_ps(b.mass + i);
+            __m128 inverseMass = _mm_loadu_ps(b.inverseMass + i);
+            __m128 dynamic = _mm_andnot_ps(_mm_or_ps(LoadMask4(b.isKinematic + i), LoadMask4(b.isSleeping + i)), LoadMask4(b.active + i));
+            __m128 spin = _mm_andnot_ps(LoadMask4(b.freezeRotation + i), dynamic);
+            __m128 gravityOn = LoadMask4(b.useGravity + i);
+
+            // Vector columns hold x, y pairs: lanes of bodies 0-1, then 2-3
+            IntegrateLinear4(&b.velocity[i].x, &b.force[i].x, &b.displacement[i].x, gravityPair,
+                _mm_unpacklo_ps(mass, mass), _mm_unpacklo_ps(inverseMass, inverseMass),
+                _mm_unpacklo_ps(dynamic, dynamic), _mm_unpacklo_ps(gravityOn, gravityOn), dtv);
+            IntegrateLinear4(&b.velocity[i + 2].x, &b.force[i + 2].x, &b.displacement[i + 2].x, gravityPair,
+                _mm_unpackhi_ps(mass, mass), _mm_unpackhi_ps(inverseMass, inverseMass),
+                _mm_unpackhi_ps(dynamic, dynamic), _mm_unpackhi_ps(gravityOn, gravityOn), dtv);
+
+            __m128 torque = _mm_loadu_ps(b.torque + i);
+            __m128 w = _mm_loadu_ps(b.angularVelocity + i);
+            w = Select(spin, _mm_add_ps(w, _mm_mul_ps(_mm_mul_ps(torque, inverseMass), dtv)), w);
+            _mm_storeu_ps(b.angularVelocity + i, w);
+            _mm_storeu_ps(b.torque + i, _mm_andnot_ps(dynamic, torque));
+
+            __m128 rotate = _mm_and_ps(spin, _mm_cmpgt_ps(_mm_and_ps(w, absMask), threshold));
+            __m128 s = _mm_setzero_ps(), c = one;
+            if (_mm_movemask_ps(rotate) != 0)
+                SinCos4(_mm_mul_ps(_mm_mul_ps(w, dtv), half), s, c);
+            _mm_storeu_ps(b.rotationW + i, Select(rotate, c, one));
+            _mm_storeu_ps(b.rotationZ + i, _mm_and_ps(rotate, s));
+        }
+        Integrate2DScalar(b, i, end, gravity, dt);
+    }
+
+    static void Integrate3DSSE2(const BodyBatch3D& b, size_t begin, size_t end, glm::vec3 gravity, float dt)
+    {
+        const __m128 dtv = _mm_set1_ps(dt);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 threshold = _mm_set1_ps(RotationThreshold);
+        // 4 bodies fill 3 registers of x, y, z triples; float k of register r belongs to body (4r + k) / 3
+        const __m128 gravityTriples[3] = {
+            _mm_setr_ps(gravity.x, gravity.y, gravity.z, gravity.x),
+            _mm_setr_ps(gravity.y, gravity.z, gravity.x, gravity.y),
+            _mm_setr_ps(gravity.z, gravity.x, gravity.y, gravity.z) };
+        auto spread = [](__m128 x, int r)
+            {
+                if (r == 0)
+                    return _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 0, 0, 0));
+                if (r == 1)
+                    return _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 2, 1, 1));
+                return _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 2));
+            };
+
+        size_t i = begin;
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 mass = _mm_loadu_ps(b.mass + i);
+            __m128 inverseMass = _mm_loadu_ps(b.inverseMass + i);
+            __m128 dynamic = _mm_andnot_ps(_mm_or_ps(LoadMask4(b.isKinematic + i), LoadMask4(b.isSleeping + i)), LoadMask4(b.active + i));
+            __m128 spin = _mm_andnot_ps(LoadMask4(b.freezeRotation + i), dynamic);
+            __m128 gravityOn = LoadMask4(b.useGravity + i);
+
+            float* angularVelocity = &b.angularVelocity[i].x;
+            float* torque = &b.torque[i].x;
+            for (int r = 0; r < 3; ++r)
+            {
+                __m128 spreadInverseMass = spread(inverseMass, r);
+                __m128 spreadDynamic = spread(dynamic, r);
+                IntegrateLinear4(&b.velocity[i].x + 4 * r, &b.force[i].x + 4 * r, &b.displacement[i].x + 4 * r, gravityTriples[r],
+                    spread(mass, r), spreadInverseMass, spreadDynamic, spread(gravityOn, r), dtv);
+
+                __m128 t = _mm_loadu_ps(torque + 4 * r);
+                __m128 w = _mm_loadu_ps(angularVelocity + 4 * r);
+                w = Select(spread(spin, r), _mm_add_ps(w, _mm_mul_ps(_mm_mul_ps(t, spreadInverseMass), dtv)), w);
+                _mm_storeu_ps(angularVelocity + 4 * r, w);
+                _mm_storeu_ps(torque + 4 * r, _mm_andnot_ps(spreadDynamic, t));
+            }
+
+            const float* w = angularVelocity;
+            __m128 wx = _mm_setr_ps(w[0], w[3], w[6], w[9]);
+            __m128 wy = _mm_setr_ps(w[1], w[4], w[7], w[10]);
+            __m128 wz = _mm_setr_ps(w[2], w[5], w[8], w[11]);
+            __m128 speed = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(wx, wx), _mm_mul_ps(wy, wy)), _mm_mul_ps(wz, wz)));
+            __m128 rotate = _mm_and_ps(spin, _mm_cmpgt_ps(speed, threshold));
+            __m128 s = _mm_setzero_ps(), c = one;
+            if (_mm_movemask_ps(rotate) != 0)
+                SinCos4(_mm_mul_ps(_mm_mul_ps(speed, dtv), half), s, c);
+            __m128 scale = _mm_and_ps(rotate, _mm_div_ps(s, Select(rotate, speed, one)));
+            _mm_storeu_ps(b.rotationX + i, _mm_mul_ps(wx, scale));
+            _mm_storeu_ps(b.rotationY + i, _mm_mul_ps(wy, scale));
+            _mm_storeu_ps(b.rotationZ + i, _mm_mul_ps(wz, scale));
+            _mm_storeu_ps(b.rotationW + i, Select(rotate, c, one));
+        }
+        Integrate3DScalar(b, i, end, gravity, dt);
+    }
+
+    // ---- AVX2: 8 bodies per iteration ----
+
+    static inline AC_TARGET_AVX2 __m256 Select(__m256 mask, __m256 a, __m256 b)
+    {
+        return _mm256_blendv_ps(b, a, mask);
+    }
+
+    /** Turns 8 flag bytes into lane masks, all bits set for non-zero bytes. */
+    static inline AC_TARGET_AVX2 __m256 LoadMask8(const void* flags)
+    {
+        __m256i lanes = _mm256_cvtepu8_epi32(_mm_loadl_epi64(static_cast<const __m128i*>(flags)));
+        return _mm256_castsi256_ps(_mm256_cmpgt_epi32(lanes, _mm256_setzero_si256()));
+    }
+
+    static inline AC_TARGET_AVX2 void SinCos8(__m256 x, __m256& sinOut, __m256& cosOut)
+    {
+        const __m256 signBit = _mm256_castsi256_ps(_mm256_set1_epi32(INT32_MIN));
+        __m256 sinSign = _mm256_and_ps(x, signBit);
+        x = _mm256_andnot_ps(signBit, x);
+
+        __m256i octant = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(FourOverPi)));
+        octant = _mm256_and_si256(_mm256_add_epi32(octant, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+        __m256 y = _mm256_cvtepi32_ps(octant);
+        sinSign = _mm256_xor_ps(sinSign, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(octant, _mm256_set1_epi32(4)), 29)));
+        __m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_andnot_si256(_mm256_sub_epi32(octant, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29));
+        __m256 sinPolyMask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(octant, _mm256_set1_epi32(2)), _mm256_setzero_si256()));
+
+        x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(PiOver4Part1)));
+        x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(PiOver4Part2)));
+        x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(PiOver4Part3)));
+        __m256 z = _mm256_mul_ps(x, x);
+
+        __m256 cosPoly = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(CosCoef0), z), _mm256_set1_ps(CosCoef1));
+        cosPoly = _mm256_add_ps(_mm256_mul_ps(cosPoly, z), _mm256_set1_ps(CosCoef2));
+        cosPoly = _mm256_mul_ps(_mm256_mul_ps(cosPoly, z), z);
+        cosPoly = _mm256_add_ps(_mm256_sub_ps(cosPoly, _mm256_mul_ps(z, _mm256_set1_ps(0.5f))), _mm256_set1_ps(1.0f));
+
+        __m256 sinPoly = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(SinCoef0), z), _mm256_set1_ps(SinCoef1));
+        sinPoly = _mm256_add_ps(_mm256_mul_ps(sinPoly, z), _mm256_set1_ps(SinCoef2));
+        sinPoly = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(sinPoly, z), x), x);
+
+        sinOut = _mm256_xor_ps(Select(sinPolyMask, sinPoly, cosPoly), sinSign);
+        cosOut = _mm256_xor_ps(Select(sinPolyMask, cosPoly, sinPoly), cosSign);
+    }
+
+    /** @copydoc IntegrateLinear4 */
+    static inline AC_TARGET_AVX2 void IntegrateLinear8(float* velocity, float* force, float* displacement, __m256 gravity,
+        __m256 mass, __m256 inverseMass, __m256 dynamic, __m256 gravityOn, __m256 dt)
+    {
+        __m256 f = _mm256_loadu_ps(force);
+        __m256 v = _mm256_loadu_ps(velocity);
+        __m256 accumulated = Select(gravityOn, _mm256_add_ps(f, _mm256_mul_ps(gravity, mass)), f);
+        v = Select(dynamic, _mm256_add_ps(v, _mm256_mul_ps(_mm256_mul_ps(accumulated, inverseMass), dt)), v);
+        _mm256_storeu_ps(velocity, v);
+        _mm256_storeu_ps(displacement, _mm256_and_ps(dynamic, _mm256_mul_ps(v, dt)));
+        _mm256_storeu_ps(force, _mm256_andnot_ps(dynamic, f));
+    }
+
+    static AC_TARGET_AVX2 void Integrate2DAVX2(const BodyBatch2D& b, size_t begin, size_t end, glm::vec2 gravity, float dt)
+    {
+        const __m256 dtv = _mm256_set1_ps(dt);
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 threshold = _mm256_set1_ps(RotationThreshold);
+        const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(INT32_MAX));
+        const __m256 gravityPairs = _mm256_setr_ps(gravity.x, gravity.y, gravity.x, gravity.y, gravity.x, gravity.y, gravity.x, gravity.y);
+        // Vector columns hold x, y pairs: lanes of bodies 0-3, then 4-7
+        const __m256i pairsLow = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+        const __m256i pairsHigh = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+
+        size_t i = begin;
+        for (; i + 8 <= end; i += 8)
+        {
+            __m256 mass = _mm256_loadu_ps(b.mass + i);
+            __m256 inverseMass = _mm256_loadu_ps(b.inverseMass + i);
+            __m256 dynamic = _mm256_andnot_ps(_mm256_or_ps(LoadMask8(b.isKinematic + i), LoadMask8(b.isSleeping + i)), LoadMask8(b.active + i));
+            __m256 spin = _mm256_andnot_ps(LoadMask8(b.freezeRotation + i), dynamic);
+            __m256 gravityOn = LoadMask8(b.useGravity + i);
+
+            IntegrateLinear8(&b.velocity[i].x, &b.force[i].x, &b.displacement[i].x, gravityPairs,
+                _mm256_permutevar8x32_ps(mass, pairsLow), _mm256_permutevar8x32_ps(inverseMass, pairsLow),
+                _mm256_permutevar8x32_ps(dynamic, pairsLow), _mm256_permutevar8x32_ps(gravityOn, pairsLow), dtv);
+            IntegrateLinear8(&b.velocity[i + 4].x, &b.force[i + 4].x, &b.displacement[i + 4].x, gravityPairs,
+                _mm256_permutevar8x32_ps(mass, pairsHigh), _mm256_permutevar8x32_ps(inverseMass, pairsHigh),
+                _mm256_permutevar8x32_ps(dynamic, pairsHigh), _mm256_permutevar8x32_ps(gravityOn, pairsHigh), dtv);
+
+            __m256 torque = _mm256_loadu_ps(b.torque + i);
+            __m256 w = _mm256_loadu_ps(b.angularVelocity + i);
+            w = Select(spin, _mm256_add_ps(w, _mm256_mul_ps(_mm256_mul_ps(torque, inverseMass), dtv)), w);
+            _mm256_storeu_ps(b.angularVelocity + i, w);
+            _mm256_storeu_ps(b.torque + i, _mm256_andnot_ps(dynamic, torque));
+
+            __m256 rotate = _mm256_and_ps(spin, _mm256_cmp_ps(_mm256_and_ps(w, absMask), threshold, _CMP_GT_OQ));
+            __m256 s = _mm256_setzero_ps(), c = one;
+            if (_mm256_movemask_ps(rotate) != 0)
+                SinCos8(_mm256_mul_ps(_mm256_mul_ps(w, dtv), half), s, c);
+            _mm256_storeu_ps(b.rotationW + i, Select(rotate, c, one));
+            _mm256_storeu_ps(b.rotationZ + i, _mm256_and_ps(rotate, s));
+        }
+        Integrate2DScalar(b, i, end, gravity, dt);
+    }
+
+    static AC_TARGET_AVX2 void Integrate3DAVX2(const BodyBatch3D& b, size_t begin, size_t end, glm::vec3 gravity, float dt)
+    {
+        const __m256 dtv = _mm256_set1_ps(dt);
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 threshold = _mm256_set1_ps(RotationThreshold);
+        // 8 bodies fill 3 registers of x, y, z triples; float k of register r belongs to body (8r + k) / 3
+        const __m256i triples[3] = {
+            _mm256_setr_epi32(0, 0, 0, 1, 1, 1, 2, 2),
+            _mm256_setr_epi32(2, 3, 3, 3, 4, 4, 4, 5),
+            _mm256_setr_epi32(5, 5, 6, 6, 6, 7, 7, 7) };
+        const __m256 gravityTriples[3] = {
+            _mm256_setr_ps(gravity.x, gravity.y, gravity.z, gravity.x, gravity.y, gravity.z, gravity.x, gravity.y),
+            _mm256_setr_ps(gravity.z, gravity.x, gravity.y, gravity.z, gravity.x, gravity.y, gravity.z, gravity.x),
+            _mm256_setr_ps(gravity.y, gravity.z, gravity.x, gravity.y, gravity.z, gravity.x, gravity.y, gravity.z) };
+        const __m256i componentOffsets = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+
+        size_t i = begin;
+        for (; i + 8 <= end; i += 8)
+        {
+            __m256 mass = _mm256_loadu_ps(b.mass + i);
+            __m256 inverseMass = _mm256_loadu_ps(b.inverseMass + i);
+            __m256 dynamic = _mm256_andnot_ps(_mm256_or_ps(LoadMask8(b.isKinematic + i), LoadMask8(b.isSleeping + i)), LoadMask8(b.active + i));
+            __m256 spin = _mm256_andnot_ps(LoadMask8(b.freezeRotation + i), dynamic);
+            __m256 gravityOn = LoadMask8(b.useGravity + i);
+
+            float* angularVelocity = &b.angularVelocity[i].x;
+            float* torque = &b.torque[i].x;
+            for (int r = 0; r < 3; ++r)
+            {
+                __m256 spreadInverseMass = _mm256_permutevar8x32_ps(inverseMass, triples[r]);
+                __m256 spreadDynamic = _mm256_permutevar8x32_ps(dynamic, triples[r]);
+                IntegrateLinear8(&b.velocity[i].x + 8 * r, &b.force[i].x + 8 * r, &b.displacement[i].x + 8 * r, gravityTriples[r],
+                    _mm256_permutevar8x32_ps(mass, triples[r]), spreadInverseMass, spreadDynamic,
+                    _mm256_permutevar8x32_ps(gravityOn, triples[r]), dtv);
+
+                __m256 t = _mm256_loadu_ps(torque + 8 * r);
+                __m256 w = _mm256_loadu_ps(angularVelocity + 8 * r);
+                w = Select(_mm256_permutevar8x32_ps(spin, triples[r]), _mm256_add_ps(w, _mm256_mul_ps(_mm256_mul_ps(t, spreadInverseMass), dtv)), w);
+                _mm256_storeu_ps(angularVelocity + 8 * r, w);
+                _mm256_storeu_ps(torque + 8 * r, _mm256_andnot_ps(spreadDynamic, t));
+            }
+
+            __m256 wx = _mm256_i32gather_ps(angularVelocity, componentOffsets, 4);
+            __m256 wy = _mm256_i32gather_ps(angularVelocity + 1, componentOffsets, 4);
+            __m256 wz = _mm256_i32gather_ps(angularVelocity + 2, componentOffsets, 4);
+            __m256 speed = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(wx, wx), _mm256_mul_ps(wy, wy)), _mm256_mul_ps(wz, wz)));
+            __m256 rotate = _mm256_and_ps(spin, _mm256_cmp_ps(speed, threshold, _CMP_GT_OQ));
+            __m256 s = _mm256_setzero_ps(), c = one;
+            if (_mm256_movemask_ps(rotate) != 0)
+                SinCos8(_mm256_mul_ps(_mm256_mul_ps(speed, dtv), half), s, c);
+            __m256 scale = _mm256_and_ps(rotate, _mm256_div_ps(s, Select(rotate, speed, one)));
+            _mm256_storeu_ps(b.rotationX + i, _mm256_mul_ps(wx, scale));
+            _mm256_storeu_ps(b.rotationY + i, _mm256_mul_ps(wy, scale));
+            _mm256_storeu_ps(b.rotationZ + i, _mm256_mul_ps(wz, scale));
+            _mm256_storeu_ps(b.rotationW + i, Select(rotate, c, one));
+        }
+        Integrate3DScalar(b, i, end, gravity, dt);
+    }
+#endif
+
+    void IntegrateBodies2D(const BodyBatch2D& batch, size_t begin, size_t end, glm::vec2 gravity, float dt, SimdLevel level)
+    {
+        switch (level)
+        {
+#if defined(AC_SIMD_X86)
+        case SimdLevel::AVX2:
+            Integrate2DAVX2(batch, begin, end, gravity, dt);
+            return;
+        case SimdLevel::SSE2:
+            Integrate2DSSE2(batch, begin, end, gravity, dt);
+            return;
+#endif
+        default:
+            Integrate2DScalar(batch, begin, end, gravity, dt);
+        }
+    }
+
+    void IntegrateBodies3D(const BodyBatch3D& batch, size_t begin, size_t end, glm::vec3 gravity, float dt, SimdLevel level)
+    {
+        switch (level)
+        {
+#if defined(AC_SIMD_X86)
+        case SimdLevel::AVX2:
+            Integrate3DAVX2(batch, begin, end, gravity, dt);
+            return;
+        case SimdLevel::SSE2:
+            Integrate3DSSE2(batch, begin, end, gravity, dt);
+            return;
+#endif
+        default:
+            Integrate3DScalar(batch, begin, end, gravity, dt);
+        }
+    }
+}
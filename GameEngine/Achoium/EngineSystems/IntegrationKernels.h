@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include "Math/Simd.h"
+namespace ac
+{
+    /**
+     * @brief Row-aligned arrays of 2D rigid bodies integrated by IntegrateBodies2D.
+     *
+     * The body arrays are the SoA columns of the RigidBody2D pool. A body is
+     * dynamic if active[i] is set and neither isKinematic[i] nor isSleeping[i]; every other row is
+     * left untouched and gets a zero displacement and an identity rotation.
+     */
+    struct BodyBatch2D
+    {
+        const float* mass = nullptr;
+        const float* inverseMass = nullptr;
+        glm::vec2* velocity = nullptr;
+        float* angularVelocity = nullptr;
+        glm::vec2* force = nullptr;   ///< Cleared for dynamic bodies
+        float* torque = nullptr;      ///< Cleared for dynamic bodies
+        const bool* useGravity = nullptr;
+        const bool* isKinematic = nullptr;
+        const bool* isSleeping = nullptr;
+        const bool* freezeRotation = nullptr;
+        const uint8_t* active = nullptr; ///< Non-zero for rows whose entity has a Transform
+
+        glm::vec2* displacement = nullptr; ///< Output: position change of the step
+        float* rotationW = nullptr;        ///< Output: w of the quaternion rotating the body about z this step
+        float* rotationZ = nullptr;        ///< Output: z of the quaternion rotating the body about z this step
+    };
+
+    /**
+     * @brief Row-aligned arrays of 3D rigid bodies integrated by IntegrateBodies3D.
+     *
+     * Same conventions as BodyBatch2D; the rotation of a step is written as a
+     * quaternion split over four arrays.
+     */
+    struct BodyBatch3D
+    {
+        const float* mass = nullptr;
+        const float* inverseMass = nullptr;
+        glm::vec3* velocity = nullptr;
+        glm::vec3* angularVelocity = nullptr;
+        glm::vec3* force = nullptr;   ///< Cleared for dynamic bodies
+        glm::vec3* torque = nullptr;  ///< Cleared for dynamic bodies
+        const bool* useGravity = nullptr;
+        const bool* isKinematic = nullptr;
+        const bool* isSleeping = nullptr;
+        const bool* freezeRotation = nullptr;
+        const uint8_t* active = nullptr; ///< Non-zero for rows whose entity has a Transform
+
+        glm::vec3* displacement = nullptr; ///< Output: position change of the step
+        float* rotationX = nullptr;        ///< Output: quaternion of the rotation of the step
+        float* rotationY = nullptr;
+        float* rotationZ = nullptr;
+        float* rotationW = nullptr;
+    };
+
+    /**
+     * @brief Integrates rows [begin, end) of a batch of 2D bodies over one step.
+     *
+     * For dynamic bodies: adds gravity * mass to the force if useGravity is set,
+     * adds force * inverseMass * dt to the velocity and, unless freezeRotation
+     * is set, torque * inverseMass * dt to the angular velocity. Outputs
+     * velocity * dt as the displacement and the rotation by angularVelocity * dt,
+     * then clears force and torque. The flags are turned into lane masks, so
+     * the vector kernels do not branch per body.
+     *
+     * @param batch The bodies and the output arrays.
+     * @param begin First row.
+     * @param end One past the last row.
+     * @param gravity Gravitational acceleration.
+     * @param dt Step length in seconds.
+     * @param level Instruction set to use; must not exceed GetSimdLevel().
+     */
+    void IntegrateBodies2D(const BodyBatch2D& batch, size_t begin, size_t end, glm::vec2 gravity, float dt, SimdLevel level = GetSimdLevel());
+
+    /**
+     * @brief Integrates rows [begin, end) of a batch of 3D bodies over one step; see IntegrateBodies2D.
+     */
+    void IntegrateBodies3D(const BodyBatch3D& batch, size_t begin, size_t end, glm::vec3 gravity, float dt, SimdLevel level = GetSimdLevel());
+}
@@ -4,487 +4,928 @@
 #include "Math/Transform.h"
 #include "Event/Event.hpp"
 #include "EngineComponents/Time.h"
+#include "EngineComponents/Hierarchy.h"
 #include "Debug.h"
+#include "IntegrationKernels.h"
 namespace ac
 {
     constexpr glm::vec3 gravity(0.0f, -98.1, 0.0f);
     
-    void PhysicsSystem::PhysicsStep(World& world)
+    // Bodies per job of the integration pass, a multiple of the SIMD widths
+    constexpr size_t IntegrationGrainSize = 4096;
+
+    // Bodies per kernel call; their displacements and rotations stay in L1 until the transforms are moved
+    constexpr size_t IntegrationBlockSize = 256;
+
+    // Collider pairs per job of the 2D narrowphase
+    constexpr size_t NarrowphaseGrainSize = 64;
+
+    // Depth a 3D bullet is left inside what it hit, enough for the narrowphase to report the contact
+    constexpr float BulletOverlap3D = 0.05f;
+
+    /**
+     * @brief Looks up the Transform of every body row again if the body or Transform pool changed its layout since the last step.
+     */
+    template <class Body>
+    static void SyncIntegrationRows(World& world, SparseSet<Body>& bodies, IntegrationRows& rows)
     {
-        Time& time = world.GetResourse<Time>();
+        uint64_t bodyLayout = bodies.LayoutVersion();
+        uint64_t transformLayout = world.GetLayoutVersion<Transform>();
+        if (rows.bodyLayout == bodyLayout && rows.transformLayout == transformLayout)
+            return;
+
+        rows.bodyLayout = bodyLayout;
+        rows.transformLayout = transformLayout;
+        const std::vector<Entity>& entities = bodies.Entities();
+        rows.active.assign(entities.size(), 0);
+        rows.transforms.assign(entities.size(), nullptr);
+        rows.transformTicks.assign(entities.size(), nullptr);
+        for (size_t row = 0; row < entities.size(); ++row)
+        {
+            rows.transforms[row] = world.GetUntrackedPtr<Transform>(entities[row], rows.transformTicks[row]);
+            rows.active[row] = rows.transforms[row] != nullptr;
+        }
+    }
 
-        // Update physics for all rigidbodies
-        world.View<RigidBody, Transform>().ForEach([&time](Entity entity, RigidBody& rb, Transform& transform)
+    static float SpeedSquared(float angularVelocity) { return angularVelocity * angularVelocity; }
+    static float SpeedSquared(const glm::vec2& velocity) { return glm::dot(velocity, velocity); }
+    static float SpeedSquared(const glm::vec3& velocity) { return glm::dot(velocity, velocity); }
+
+    /**
+     * @brief Whether a RigidBody2D / RigidBody moved slower than the sleep thresholds.
+     */
+    template <class BodyRef>
+    static bool IsResting(const BodyRef& rb, const PhysicsSleep& sleep)
+    {
+        return SpeedSquared(rb.velocity) <= sleep.linearSleepVelocity * sleep.linearSleepVelocity
+            && SpeedSquared(rb.angularVelocity) <= sleep.angularSleepVelocity * sleep.angularSleepVelocity;
+    }
+
+    template <class Body>
+    static void WakeBodies(World& world, const std::vector<Entity>& bodies)
+    {
+        for (Entity body : bodies)
         {
-            // Skip kinematic bodies for force calculations
-            if (rb.isKinematic)
-                return;
+            if (ComponentPtr<Body> rb = world.GetPtr<Body>(body); rb != nullptr)
+                rb->WakeUp();
+        }
+    }
 
-            // Apply gravity
-            if (rb.useGravity)
-                rb.force += gravity * rb.mass;
+    /**
+     * @brief Wakes a sleeping body together with the rest of its island.
+     */
+    template <class Body>
+    static void WakeIsland(World& world, SleepingIslands& islands, Entity body)
+    {
+        std::vector<Entity> woken{ body };
+        islands.Take(body, woken);
+        WakeBodies<Body>(world, woken);
+    }
 
-            // Update velocity with forces (F = ma, so a = F/m)
-            rb.velocity += rb.force * rb.inverseMass * time.Delta();
-            
-            // Update angular velocity with torques
-            if (!rb.freezeRotation)
-                rb.angularVelocity += rb.torque * rb.inverseMass * time.Delta();
+    /**
+     * @brief Wakes the sleeping islands queued with SleepingIslands::Break since the last call.
+     *
+     * Removals queue them through the listeners of AddSleepListeners, and the
+     * collision systems queue the islands of bodies a force or an impulse
+     * woke; sleeping bodies are never visited to find them.
+     */
+    template <class Body>
+    static void WakeBrokenIslands(World& world, SleepingIslands& islands)
+    {
+        std::vector<Entity> woken;
+        islands.TakeBroken(woken);
+        WakeBodies<Body>(world, woken);
+    }
 
-            // Apply linear velocity to position
-            transform.position += rb.velocity * time.Delta();
-            
-            // Apply angular velocity to rotation
-            if (!rb.freezeRotation && glm::length(rb.angularVelocity) > 0.0001f)
-            {
-                float angle = glm::length(rb.angularVelocity) * time.Delta();
-                glm::vec3 axis = glm::normalize(rb.angularVelocity);
-                transform.RotateAxis(axis, glm::degrees(angle));
-            }
+    /**
+     * @brief Queues the island of an entity whose body or collider is being removed.
+     */
+    template <class Component, SleepingIslands PhysicsSleep::* Islands>
+    static bool BreakIslandOnDeleted(const OnDeleted<Component>& event)
+    {
+        World& world = event.world;
+        (world.GetResourse<PhysicsSleep>().*Islands).Break(event.ID);
+        return true;
+    }
 
-            // Reset forces and torques for the next frame
-            rb.force = glm::vec3(0.0f);
-            rb.torque = glm::vec3(0.0f);
-        });
+    template <class Component, SleepingIslands PhysicsSleep::* Islands>
+    static bool BreakIslandsOnDeletedBatch(const OnDeletedBatch<Component>& event)
+    {
+        World& world = event.world;
+        SleepingIslands& islands = world.GetResourse<PhysicsSleep>().*Islands;
+        for (Entity entity : event.IDs)
+            islands.Break(entity);
+        return true;
     }
-    
-    void PhysicsSystem::Physics2DStep(World& world)
+
+    template <class Component, SleepingIslands PhysicsSleep::* Islands>
+    static void AddSleepListener(EventManager& eventManager)
     {
-        Time& time = world.GetResourse<Time>();
+        eventManager.AddListener<OnDeleted<Component>>(BreakIslandOnDeleted<Component, Islands>);
+        eventManager.AddListener<OnDeletedBatch<Component>>(BreakIslandsOnDeletedBatch<Component, Islands>);
+    }
 
-        // Update physics for all 2D rigidbodies
-        world.View<RigidBody2D, Transform>().ForEach([&time](Entity entity, RigidBody2D& rb, Transform& transform)
+    /**
+     * @brief Counts the steps each body of the islands rested and puts the islands whose bodies all rested long enough to sleep.
+     *
+     * @param islands Islands of the bodies, linked by the contacts of this step.
+     * @param bodies Indexed by body number; each has an entity and canSleep,
+     *               set for bodies that were awake and dynamic when the step started.
+     * @return True if an island fell asleep.
+     */
+    template <class Body, class IslandBodies>
+    static bool SleepRestingIslands(World& world, const IslandBuilder& islands, const IslandBodies& bodies, const PhysicsSleep& sleep, SleepingIslands& sleeping)
+    {
+        bool slept = false;
+        std::vector<Entity> members;
+        for (uint32_t island = 0; island < islands.GetIslandCount(); ++island)
         {
-            // Skip kinematic bodies for force calculations
-            if (rb.isKinematic)
-                return;
+            uint32_t count;
+            const uint32_t* islandBodies = islands.GetIslandBodies(island, count);
 
-            // Apply gravity (in 2D, gravity is typically just in y direction)
-            if (rb.useGravity)
-            {
-                rb.force += glm::vec2(gravity.x, gravity.y) * rb.mass; // Standard gravity
-            }
+            // Bodies that cannot sleep do not link islands, so they are alone in theirs
+            if (!bodies[islandBodies[0]].canSleep)
+                continue;
 
-            // Update velocity with forces (F = ma, so a = F/m)
-            rb.velocity += rb.force * rb.inverseMass * time.Delta();
-            
-            // Update angular velocity with torques
-            if (!rb.freezeRotation)
+            uint32_t restFrames = UINT32_MAX;
+            for (uint32_t k = 0; k < count; ++k)
             {
-                rb.angularVelocity += rb.torque * rb.inverseMass * time.Delta();
+                auto rb = *world.GetPtr<Body>(bodies[islandBodies[k]].entity);
+                if (!IsResting(rb, sleep))
+                    rb.restFrames = 0;
+                else if (rb.restFrames < UINT32_MAX)
+                    ++rb.restFrames;
+                restFrames = std::min(restFrames, rb.restFrames);
             }
+            if (restFrames < sleep.stepsToSleep)
+                continue;
 
-            // Apply linear velocity to position (only in XY plane)
-            transform.position.x += rb.velocity.x * time.Delta();
-            transform.position.y += rb.velocity.y * time.Delta();
-            
-            // Apply angular velocity to rotation (rotate around Z axis for 2D)
-            if (!rb.freezeRotation && std::abs(rb.angularVelocity) > 0.0001f)
+            members.clear();
+            for (uint32_t k = 0; k < count; ++k)
             {
-                float angle = rb.angularVelocity * time.Delta();
-                transform.RotateZ(glm::degrees(angle));
+                auto rb = *world.GetPtr<Body>(bodies[islandBodies[k]].entity);
+                rb.isSleeping = true;
+                rb.velocity *= 0.0f;
+                rb.angularVelocity *= 0.0f;
+                members.push_back(bodies[islandBodies[k]].entity);
             }
+            sleeping.Add(members);
+            slept = true;
+        }
+        return slept;
+    }
 
-            // Reset forces and torques for the next frame
-            rb.force = glm::vec2(0.0f);
-            rb.torque = 0.0f;
-        });
+    static void MoveBack(Transform& transform, const glm::vec2& translation)
+    {
+        transform.position.x -= translation.x;
+        transform.position.y -= translation.y;
     }
 
-    void PhysicsSystem::CollisionSystem(World& world)
+    static void MoveBack(Transform& transform, const glm::vec3& translation) { transform.position -= translation; }
+
+    /**
+     * @brief Moves every bullet back to just past the first rigid body its sweep touches, so it cannot pass through it within a step.
+     *
+     * The bullet is left overlapping what it hit by up to overlap along its
+     * motion, so the narrowphase reports the contact and the solver stops
+     * it. Triggers do not stop bullets; other bullets count as holding still
+     * where their step ended. The sweeps are cleared afterwards.
+     *
+     * @tparam Body RigidBody2D or RigidBody.
+     * @param colliders Collider entries with an entity, collider, transform, rigidBody and sweep, zero for non-bullets.
+     * @param pairs Broadphase pairs, found with the bounds of the bullets grown over their sweep.
+     * @param overlap Depth past the first contact the bullets are left at.
+     * @param timeOfImpact TimeOfImpact2D or TimeOfImpact3D.
+     */
+    template <class Body, class Entries, class Pairs, class Shape, class Vector>
+    static void SweepBullets(World& world, const Entries& colliders, const Pairs& pairs, float overlap,
+        bool (*timeOfImpact)(const Shape&, const Transform&, const Vector&, const Shape&, const Transform&, float, float&))
     {
-        EventManager& eventManager = world.GetResourse<EventManager>();
-        
-        // Create collections for the different collider types
-        auto boxColliders = world.View<BoxCollider, Transform>().GetPacked();
-        auto sphereColliders = world.View<SphereCollider, Transform>().GetPacked();
-        
-        // Combined list of all colliders
-        std::vector<std::pair<Entity, Collider*>> allColliders;
-        
-        // Add box colliders to the combined list
-        for (auto& item : boxColliders) {
-            Entity entity = item.id;
-            BoxCollider& boxCollider = world.Get<BoxCollider>(entity);
-            allColliders.push_back({entity, static_cast<Collider*>(&boxCollider)});
-        }
-        
-        // Add sphere colliders to the combined list
-        for (auto& item : sphereColliders) {
-            Entity entity = item.id;
-            SphereCollider& sphereCollider = world.Get<SphereCollider>(entity);
-            allColliders.push_back({entity, static_cast<Collider*>(&sphereCollider)});
-        }
-        
-        // Check each collider pair for collisions
-        for (size_t i = 0; i < allColliders.size(); i++)
+        struct Hit
         {
-            Entity entityA = allColliders[i].first;
-            Collider* colliderA = allColliders[i].second;
-            Transform& transformA = world.Get<Transform>(entityA);
-            
-            for (size_t j = i + 1; j < allColliders.size(); j++)
+            float toi;
+            Vector sweep;
+        };
+        std::unordered_map<Entity, Hit> hits; // Earliest contact of every bullet that hit something
+        for (const auto& pair : pairs)
+        {
+            for (int side = 0; side < 2; ++side)
             {
-                Entity entityB = allColliders[j].first;
-                Collider* colliderB = allColliders[j].second;
-                Transform& transformB = world.Get<Transform>(entityB);
-                
-                glm::vec3 collisionPoint, collisionNormal;
-                float penetrationDepth;
-                
-                // Check for collision
-                if (!colliderA->CheckCollision(colliderB, transformA, transformB,
-                    collisionPoint, collisionNormal, penetrationDepth))
+                const auto& bullet = colliders[side == 0 ? pair.a : pair.b];
+                const auto& other = colliders[side == 0 ? pair.b : pair.a];
+                if (bullet.sweep == Vector(0.0f) || bullet.collider->isTrigger || other.collider->isTrigger
+                    || other.rigidBody == nullptr || other.entity == bullet.entity)
                     continue;
 
-                // Create collision data
-                CollisionData2D collisionData;
-                collisionData.entityA = entityA;
-                collisionData.entityB = entityB;
-                //collisionData.collisionPoint = collisionPoint;
-                collisionData.collisionNormal = collisionNormal;
-                collisionData.penetrationDepth = penetrationDepth;
-
-                // If either collider is a trigger, send trigger event
-                if (colliderA->isTrigger || colliderB->isTrigger)
-                {
-                    OnTriggerEnter triggerEvent{ collisionData, world };
-                    eventManager.Invoke(triggerEvent, AllowToken<OnTriggerEnter>());
-                }
-                else
-                {
-                    // Send collision event
-                    OnCollision collisionEvent{ collisionData, world };
-                    eventManager.Invoke(collisionEvent, AllowToken<OnCollision>());
-
-                    // Collision resolution for RigidBody components
-                    bool hasRbA = world.Has<RigidBody>(entityA);
-                    bool hasRbB = world.Has<RigidBody>(entityB);
-
-                    if ((!hasRbA || !hasRbB))
-						continue; // Skip if either entity does not have a RigidBody
+                float toi;
+                if (!timeOfImpact(*bullet.collider, *bullet.transform, bullet.sweep, *other.collider, *other.transform, 0.25f * overlap, toi))
+                    continue;
+                auto [it, inserted] = hits.try_emplace(bullet.entity, Hit{ toi, bullet.sweep });
+                if (!inserted)
+                    it->second.toi = std::min(it->second.toi, toi);
+            }
+        }
 
-                    RigidBody& rbA = world.Get<RigidBody>(entityA);
-                    RigidBody& rbB = world.Get<RigidBody>(entityB);
+        for (auto& [entity, hit] : hits)
+        {
+            float t = std::min(hit.toi + overlap / glm::length(hit.sweep), 1.0f);
+            MoveBack(*world.GetPtr<Transform>(entity), (1.0f - t) * hit.sweep);
+        }
 
-                    // Skip if both are kinematic
-                    if (rbA.isKinematic && rbB.isKinematic)
-                        continue;
+        for (const auto& entry : colliders)
+        {
+            if (entry.sweep == Vector(0.0f))
+                continue;
+            if constexpr (std::is_same_v<Shape, Collider2D>)
+            {
+                if (hits.count(entry.entity) != 0)
+                    entry.collider->UpdateWorldVertices(*entry.transform);
+            }
+            auto rb = *world.GetPtr<Body>(entry.entity);
+            rb.sweep = Vector(0.0f);
+        }
+    }
 
-                    // Calculate impulse for collision response
-                    float invMassSum = rbA.inverseMass + rbB.inverseMass;
-                    if (invMassSum <= 0)
-						continue; // Avoid division by zero
+    void PhysicsSystem::PhysicsStep(World& world)
+    {
+        Time& time = world.GetResourse<Time>();
+        Integrate3D(world, time.FixedDelta(), GetSimdLevel());
+    }
 
-                    // Position correction (avoid sinking)
-                    const float percent = 0.2f; // penetration correction factor
-                    glm::vec3 correction = (penetrationDepth / invMassSum) * percent * collisionNormal;
+    void PhysicsSystem::Physics2DStep(World& world)
+    {
+        Time& time = world.GetResourse<Time>();
+        Integrate2D(world, time.FixedDelta(), GetSimdLevel());
+    }
 
-                    if (!rbA.isKinematic)
-                        transformA.position -= correction * rbA.inverseMass;
+    void PhysicsSystem::SaveInterpolationState(World& world)
+    {
+        // Bodies created since the last step start out drawn where they are
+        std::vector<Entity> missing;
+        world.Query<const RigidBody2D, const Transform>(Exclude<InterpolatedTransform>{}).ForEach(
+            [&missing](Entity entity, RigidBody2DConstRef, const Transform&) { missing.push_back(entity); });
+        world.Query<const RigidBody, const Transform>(Exclude<InterpolatedTransform>{}).ForEach(
+            [&missing](Entity entity, RigidBodyConstRef, const Transform&) { missing.push_back(entity); });
+        if (!missing.empty())
+        {
+            // An entity with both kinds of body is listed twice
+            std::sort(missing.begin(), missing.end());
+            missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+            world.AddBatch<InterpolatedTransform>(missing, std::vector<InterpolatedTransform>(missing.size()));
+        }
 
-                    if (!rbB.isKinematic)
-                        transformB.position += correction * rbB.inverseMass;
+        world.Query<const Transform, InterpolatedTransform>().ParallelForEach(
+            [](const Transform& transform, InterpolatedTransform& interpolated)
+            {
+                interpolated.previousPosition = transform.position;
+                interpolated.previousRotation = transform.rotation;
+                interpolated.previousScale = transform.scale;
+                interpolated.saved = true;
+            });
+    }
 
-                    // Velocity correction (bounce effect)
-                    glm::vec3 relativeVelocity = rbB.velocity - rbA.velocity;
-                    float velocityAlongNormal = glm::dot(relativeVelocity, collisionNormal);
-                    // If objects are moving away from each other along the collision normal,
-// we need to flip the normal
-                    if (velocityAlongNormal > 0)
+    void PhysicsSystem::Integrate3D(World& world, float dt, SimdLevel level)
+    {
+        SparseSet<RigidBody>& bodies = world.GetSoAPool<RigidBody>();
+        IntegrationRows& rows = world.GetResourse<PhysicsIntegrationCache>().bodies3D;
+        SyncIntegrationRows(world, bodies, rows);
+
+        auto& columns = bodies.Columns();
+        float* mass = columns.Column<&RigidBody::mass>().data();
+        float* inverseMass = columns.Column<&RigidBody::inverseMass>().data();
+        glm::vec3* velocity = columns.Column<&RigidBody::velocity>().data();
+        glm::vec3* angularVelocity = columns.Column<&RigidBody::angularVelocity>().data();
+        glm::vec3* force = columns.Column<&RigidBody::force>().data();
+        glm::vec3* torque = columns.Column<&RigidBody::torque>().data();
+        bool* useGravity = columns.Column<&RigidBody::useGravity>().data();
+        bool* isKinematic = columns.Column<&RigidBody::isKinematic>().data();
+        bool* isSleeping = columns.Column<&RigidBody::isSleeping>().data();
+        bool* freezeRotation = columns.Column<&RigidBody::freezeRotation>().data();
+        bool* bullet = columns.Column<&RigidBody::bullet>().data();
+        glm::vec3* sweep = columns.Column<&RigidBody::sweep>().data();
+        std::vector<ComponentTicks>& bodyTicks = bodies.Ticks();
+        uint32_t tick = world.GetChangeTick();
+
+        // Bodies are independent, so integrate them in parallel chunks
+        world.GetJobSystem().ParallelFor(bodies.Size(), IntegrationGrainSize, [&, dt, level, tick](size_t begin, size_t end)
+            {
+                glm::vec3 displacement[IntegrationBlockSize];
+                float rotationX[IntegrationBlockSize], rotationY[IntegrationBlockSize], rotationZ[IntegrationBlockSize], rotationW[IntegrationBlockSize];
+                for (size_t first = begin; first < end; first += IntegrationBlockSize)
+                {
+                    size_t count = std::min(IntegrationBlockSize, end - first);
+                    BodyBatch3D batch;
+                    batch.mass = mass + first;
+                    batch.inverseMass = inverseMass + first;
+                    batch.velocity = velocity + first;
+                    batch.angularVelocity = angularVelocity + first;
+                    batch.force = force + first;
+                    batch.torque = torque + first;
+                    batch.useGravity = useGravity + first;
+                    batch.isKinematic = isKinematic + first;
+                    batch.isSleeping = isSleeping + first;
+                    batch.freezeRotation = freezeRotation + first;
+                    batch.active = rows.active.data() + first;
+                    batch.displacement = displacement;
+                    batch.rotationX = rotationX;
+                    batch.rotationY = rotationY;
+                    batch.rotationZ = rotationZ;
+                    batch.rotationW = rotationW;
+                    IntegrateBodies3D(batch, 0, count, gravity, dt, level);
+
+                    // Kinematic bodies got a zero displacement and an identity rotation; sleeping ones are not marked changed
+                    for (size_t i = 0; i < count; ++i)
                     {
-                        collisionNormal = -collisionNormal;
-                        velocityAlongNormal = -velocityAlongNormal;
+                        Transform* transform = rows.transforms[first + i];
+                        if (transform == nullptr || isSleeping[first + i])
+                            continue;
+                        transform->position += displacement[i];
+                        transform->rotation = glm::quat(rotationW[i], rotationX[i], rotationY[i], rotationZ[i]) * transform->rotation;
+                        if (bullet[first + i])
+                            sweep[first + i] = displacement[i];
+                        rows.transformTicks[first + i]->changed = tick;
+                        bodyTicks[first + i].changed = tick;
                     }
-                    // Only resolve if objects are moving toward each other
-                    if (velocityAlongNormal < 0)
-                    {
-                        // Calculate coefficient of restitution (bounciness)
-                        float e = std::min(rbA.restitution, rbB.restitution);
-
-                        // Calculate impulse scalar
-                        float j = -(1.0f + e) * velocityAlongNormal / invMassSum;
-
-                        // Apply impulse
-                        glm::vec3 impulse = j * collisionNormal;
-
-                        if (!rbA.isKinematic)
-                            rbA.velocity -= impulse * rbA.inverseMass;
-
-                        if (!rbB.isKinematic)
-                            rbB.velocity += impulse * rbB.inverseMass;
-
-                        // Apply friction
-                        float friction = (rbA.friction + rbB.friction) * 0.5f;
-
-                        if (friction > 0)
-                        {
-                            // Recalculate relative velocity after normal impulse
-                            relativeVelocity = rbB.velocity - rbA.velocity;
-
-                            // Calculate tangent vector (perpendicular to normal)
-                            glm::vec3 tangent = relativeVelocity - (glm::dot(relativeVelocity, collisionNormal) * collisionNormal);
-                            float tangentLength = glm::length(tangent);
-
-                            if (tangentLength > 0.0001f)
-                            {
-                                tangent = tangent / tangentLength;
-
-                                // Calculate friction impulse
-                                float jt = -glm::dot(relativeVelocity, tangent) / invMassSum;
-
-                                // Clamp friction
-                                jt = glm::clamp(jt, -j * friction, j * friction);
-
-                                // Apply friction impulse
-                                glm::vec3 frictionImpulse = jt * tangent;
-
-                                if (!rbA.isKinematic)
-                                    rbA.velocity -= frictionImpulse * rbA.inverseMass;
+                }
+            });
+    }
 
-                                if (!rbB.isKinematic)
-                                    rbB.velocity += frictionImpulse * rbB.inverseMass;
-                            }
-                        }
+    void PhysicsSystem::Integrate2D(World& world, float dt, SimdLevel level)
+    {
+        SparseSet<RigidBody2D>& bodies = world.GetSoAPool<RigidBody2D>();
+        IntegrationRows& rows = world.GetResourse<PhysicsIntegrationCache>().bodies2D;
+        SyncIntegrationRows(world, bodies, rows);
+
+        auto& columns = bodies.Columns();
+        float* mass = columns.Column<&RigidBody2D::mass>().data();
+        float* inverseMass = columns.Column<&RigidBody2D::inverseMass>().data();
+        glm::vec2* velocity = columns.Column<&RigidBody2D::velocity>().data();
+        float* angularVelocity = columns.Column<&RigidBody2D::angularVelocity>().data();
+        glm::vec2* force = columns.Column<&RigidBody2D::force>().data();
+        float* torque = columns.Column<&RigidBody2D::torque>().data();
+        bool* useGravity = columns.Column<&RigidBody2D::useGravity>().data();
+        bool* isKinematic = columns.Column<&RigidBody2D::isKinematic>().data();
+        bool* isSleeping = columns.Column<&RigidBody2D::isSleeping>().data();
+        bool* freezeRotation = columns.Column<&RigidBody2D::freezeRotation>().data();
+        bool* bullet = columns.Column<&RigidBody2D::bullet>().data();
+        glm::vec2* sweep = columns.Column<&RigidBody2D::sweep>().data();
+        std::vector<ComponentTicks>& bodyTicks = bodies.Ticks();
+        uint32_t tick = world.GetChangeTick();
+
+        // Bodies are independent, so integrate them in parallel chunks (gravity is typically just in y direction)
+        world.GetJobSystem().ParallelFor(bodies.Size(), IntegrationGrainSize, [&, dt, level, tick](size_t begin, size_t end)
+            {
+                glm::vec2 displacement[IntegrationBlockSize];
+                float rotationW[IntegrationBlockSize], rotationZ[IntegrationBlockSize];
+                for (size_t first = begin; first < end; first += IntegrationBlockSize)
+                {
+                    size_t count = std::min(IntegrationBlockSize, end - first);
+                    BodyBatch2D batch;
+                    batch.mass = mass + first;
+                    batch.inverseMass = inverseMass + first;
+                    batch.velocity = velocity + first;
+                    batch.angularVelocity = angularVelocity + first;
+                    batch.force = force + first;
+                    batch.torque = torque + first;
+                    batch.useGravity = useGravity + first;
+                    batch.isKinematic = isKinematic + first;
+                    batch.isSleeping = isSleeping + first;
+                    batch.freezeRotation = freezeRotation + first;
+                    batch.active = rows.active.data() + first;
+                    batch.displacement = displacement;
+                    batch.rotationW = rotationW;
+                    batch.rotationZ = rotationZ;
+                    IntegrateBodies2D(batch, 0, count, glm::vec2(gravity.x, gravity.y), dt, level);
+
+                    // Move in the XY plane and rotate around the Z axis: (w, 0, 0, z) * rotation, expanded; sleeping bodies are not marked changed
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        Transform* transform = rows.transforms[first + i];
+                        if (transform == nullptr || isSleeping[first + i])
+                            continue;
+                        transform->position.x += displacement[i].x;
+                        transform->position.y += displacement[i].y;
+                        if (bullet[first + i])
+                            sweep[first + i] = displacement[i];
+                        glm::quat r = transform->rotation;
+                        float w = rotationW[i], z = rotationZ[i];
+                        transform->rotation = glm::quat(w * r.w - z * r.z, w * r.x - z * r.y, w * r.y + z * r.x, w * r.z + z * r.w);
+                        rows.transformTicks[first + i]->changed = tick;
+                        bodyTicks[first + i].changed = tick;
                     }
                 }
-            }
-        }
+            });
     }
 
-    void Solve(RigidBody2D& rbA, RigidBody2D& rbB, Transform& transformA, Transform& transformB, 
-        float penetrationDepth, glm::vec2 collisionNormal, glm::vec2 collisionPoint2D, bool applyPositionCorrection)
+    void PhysicsSystem::AddSleepListeners(World& world)
     {
-        // Get 2D vectors for calculations
-        glm::vec2 normal2D(collisionNormal.x, collisionNormal.y);
-
-        // Calculate relative positions of collision point
-        glm::vec2 rA = collisionPoint2D - glm::vec2(transformA.position.x, transformA.position.y);
-        glm::vec2 rB = collisionPoint2D - glm::vec2(transformB.position.x, transformB.position.y);
-
-        // Calculate relative velocity at contact point
-        glm::vec2 relativeVelocity = rbB.velocity + glm::vec2(-rbB.angularVelocity * rB.y, rbB.angularVelocity * rB.x) -
-            rbA.velocity - glm::vec2(-rbA.angularVelocity * rA.y, rbA.angularVelocity * rA.x);
+        EventManager& eventManager = world.GetResourse<EventManager>();
+        AddSleepListener<RigidBody, &PhysicsSleep::bodies3D>(eventManager);
+        AddSleepListener<BoxCollider, &PhysicsSleep::bodies3D>(eventManager);
+        AddSleepListener<SphereCollider, &PhysicsSleep::bodies3D>(eventManager);
+        AddSleepListener<RigidBody2D, &PhysicsSleep::bodies2D>(eventManager);
+        AddSleepListener<CircleCollider2D, &PhysicsSleep::bodies2D>(eventManager);
+        AddSleepListener<RectCollider2D, &PhysicsSleep::bodies2D>(eventManager);
+        AddSleepListener<PolygonCollider2D, &PhysicsSleep::bodies2D>(eventManager);
+    }
 
-        // Calculate velocity along normal
-        float velocityAlongNormal = glm::dot(relativeVelocity, normal2D);
-		if (velocityAlongNormal < 0)
+    void PhysicsSystem::CollisionSystem(World& world)
+    {
+        EventManager& eventManager = world.GetResourse<EventManager>();
+        CollisionLayer& collisionLayers = world.GetResourse<CollisionLayer>();
+        SpatialHashGrid3D& broadphase = world.GetResourse<SpatialHashGrid3D>();
+        PhysicsSleep& sleep = world.GetResourse<PhysicsSleep>();
+        // Islands that lost a body or a collider since the last step move again from this one
+        WakeBrokenIslands<RigidBody>(world, sleep.bodies3D);
+        
+        // Gather every collider with its transform, its bounds and, if present, its rigid body in one pass
+        struct ColliderEntry
         {
-            // Calculate coefficient of restitution (bounciness)
-            float e = std::min(rbA.restitution, rbB.restitution);
-
-            // Calculate angular contribution to constraint
-            // 2D cross product for rA.cross(normal) is (rA.x * normal.y - rA.y * normal.x)
-            float rACrossN = rA.x * normal2D.y - rA.y * normal2D.x;
-            float rBCrossN = rB.x * normal2D.y - rB.y * normal2D.x;
+            Entity entity;
+            const Collider* collider;
+            const Transform* transform;
+            ComponentPtr<const RigidBody> rigidBody;
+            uint32_t row;       ///< Row of the body in the RigidBody pool, numbering it in the islands
+            bool sleeping;      ///< The body slept when the step started
+            bool wakesSleepers; ///< Touching the collider wakes a sleeping body: awake dynamic bodies and moving kinematic ones
+            glm::vec3 sweep;    ///< Translation of a bullet this step, zero for other colliders
+        };
+        std::vector<ColliderEntry> allColliders;
+        std::vector<BroadphaseProxy3D> proxies;
+        size_t bulletCount = 0;
+
+        // Islands are built over the rows of the RigidBody pool; only awake dynamic bodies with a collider can fall asleep
+        struct IslandBody
+        {
+            Entity entity = 0;
+            bool canSleep = false; ///< Awake and dynamic when the step started
+        };
+        size_t bodyCount = world.GetSoAPool<RigidBody>().Size();
+        std::vector<IslandBody> islandBodies(bodyCount);
+        IslandBuilder islands;
+        islands.Reset(static_cast<uint32_t>(bodyCount));
+
+        auto gather = [&allColliders, &proxies, &bulletCount, &sleep, &islandBodies](uint64_t shape)
+            {
+                return [&allColliders, &proxies, &bulletCount, &sleep, &islandBodies, shape](Entity entity, const Collider& collider, const Transform& transform, ComponentPtr<const RigidBody> rigidBody)
+                    {
+                        bool sleeping = rigidBody != nullptr && rigidBody->isSleeping;
+                        // An awake body still listed in a sleeping island was woken by a force or an impulse
+                        if (rigidBody != nullptr && !sleeping)
+                            sleep.bodies3D.Break(entity);
+                        bool wakesSleepers = rigidBody != nullptr && !sleeping && (!rigidBody->isKinematic || !IsResting(*rigidBody, sleep));
+                        glm::vec3 sweep = rigidBody != nullptr && rigidBody->bullet && !sleeping ? rigidBody->sweep : glm::vec3(0.0f);
+                        uint32_t row = rigidBody != nullptr ? static_cast<uint32_t>(rigidBody.Row()) : UINT32_MAX;
+                        if (rigidBody != nullptr && !sleeping && !rigidBody->isKinematic)
+                            islandBodies[row] = { entity, true };
+                        allColliders.push_back({ entity, &collider, &transform, rigidBody, row, sleeping, wakesSleepers, sweep });
+
+                        // A bullet's bounds cover its whole motion, so the broadphase reports what it may have passed through
+                        AABB3D bounds = collider.GetWorldAABB(transform);
+                        if (sweep != glm::vec3(0.0f))
+                        {
+                            bounds = { glm::min(bounds.min, bounds.min - sweep), glm::max(bounds.max, bounds.max - sweep) };
+                            ++bulletCount;
+                        }
+                        // Colliders without a RigidBody are level geometry and never tested against each other; sleeping bodies are treated the same
+                        proxies.push_back({ (static_cast<uint64_t>(EntityIndex(entity)) << 1) | shape, bounds, collider.layer, rigidBody == nullptr || sleeping });
+                    };
+            };
+        // Read-only, so colliders the step leaves alone are not marked changed; what it moves is written through GetPtr
+        world.Query<const BoxCollider, const Transform>(Optional<const RigidBody>{}).ForEach(gather(0));
+        world.Query<const SphereCollider, const Transform>(Optional<const RigidBody>{}).ForEach(gather(1));
+        // The rest of their islands hold still this step, like bodies woken by a contact
+        WakeBrokenIslands<RigidBody>(world, sleep.bodies3D);
+        
+        // Only pairs whose bounds overlap and whose layers collide reach the narrowphase
+        std::vector<BroadphasePair3D> pairs;
+        broadphase.FindPairs(proxies, collisionLayers, pairs);
+        if (bulletCount > 0)
+            SweepBullets<RigidBody>(world, allColliders, pairs, BulletOverlap3D, &TimeOfImpact3D);
+
+        // Handlers may destroy entities or add and remove components, so the events wait until the gathered pointers are no longer used
+        struct CollisionEvent
+        {
+            CollisionData2D data;
+            bool trigger; ///< Sent as OnTriggerEnter instead of OnCollision
+        };
+        std::vector<CollisionEvent> events;
 
-            // Calculate effective mass for constraint
-            float inverseMassSum = rbA.inverseMass + rbB.inverseMass;
+        for (const BroadphasePair3D& pair : pairs)
+        {
+            size_t i = pair.a;
+            size_t j = pair.b;
+            Entity entityA = allColliders[i].entity;
+            const Collider* colliderA = allColliders[i].collider;
+            const Transform& transformA = *allColliders[i].transform;
+            Entity entityB = allColliders[j].entity;
+            const Collider* colliderB = allColliders[j].collider;
+            const Transform& transformB = *allColliders[j].transform;
+
+            // A sleeping body is only tested against the colliders that can wake it
+            if ((allColliders[i].sleeping && !allColliders[j].wakesSleepers) || (allColliders[j].sleeping && !allColliders[i].wakesSleepers))
+                continue;
+                
+            glm::vec3 collisionPoint, collisionNormal;
+            float penetrationDepth;
+            
+            // Check for collision
+            if (!colliderA->CheckCollision(colliderB, transformA, transformB,
+                collisionPoint, collisionNormal, penetrationDepth))
+                continue;
+
+            // Create collision data
+            CollisionData2D collisionData;
+            collisionData.entityA = entityA;
+            collisionData.entityB = entityB;
+            //collisionData.collisionPoint = collisionPoint;
+            collisionData.collisionNormal = collisionNormal;
+            collisionData.penetrationDepth = penetrationDepth;
+
+            // If either collider is a trigger, queue a trigger event
+            if (colliderA->isTrigger || colliderB->isTrigger)
+            {
+                events.push_back({ collisionData, true });
+            }
+            else
+            {
+                // Queue a collision event
+                events.push_back({ collisionData, false });
+
+                // Collision resolution for RigidBody components
+                if (allColliders[i].rigidBody == nullptr || allColliders[j].rigidBody == nullptr)
+                    continue; // Skip if either entity does not have a RigidBody
+
+                // A sleeping body hit by a moving one wakes up with its island, and moves from the next step on
+                if (allColliders[i].sleeping)
+                    WakeIsland<RigidBody>(world, sleep.bodies3D, entityA);
+                if (allColliders[j].sleeping)
+                    WakeIsland<RigidBody>(world, sleep.bodies3D, entityB);
+
+                RigidBodyConstRef rbA = *allColliders[i].rigidBody;
+                RigidBodyConstRef rbB = *allColliders[j].rigidBody;
+                bool fixedA = rbA.isKinematic || allColliders[i].sleeping;
+                bool fixedB = rbB.isKinematic || allColliders[j].sleeping;
+
+                // Skip if neither body can move
+                if (fixedA && fixedB)
+                    continue;
 
+                // Only a body that can move takes the response, so only it is marked changed
+                ComponentPtr<RigidBody> movingA = fixedA ? nullptr : world.GetPtr<RigidBody>(entityA);
+                ComponentPtr<RigidBody> movingB = fixedB ? nullptr : world.GetPtr<RigidBody>(entityB);
 
+                // Bodies resting on each other share an island; kinematic and static ones link nothing
+                if (islandBodies[allColliders[i].row].canSleep && islandBodies[allColliders[j].row].canSleep)
+                    islands.Link(allColliders[i].row, allColliders[j].row);
 
-            // Include rotational contribution in effective mass
-            if (!rbA.freezeRotation)
-                inverseMassSum += rACrossN * rACrossN / rbA.inertiaTensor;
-            if (!rbB.freezeRotation)
-                inverseMassSum += rBCrossN * rBCrossN / rbB.inertiaTensor;
+                // Calculate impulse for collision response; a body that cannot move takes none of it
+                float invMassSum = (fixedA ? 0.0f : rbA.inverseMass) + (fixedB ? 0.0f : rbB.inverseMass);
+                if (invMassSum <= 0)
+						continue; // Avoid division by zero
 
-            if (inverseMassSum <= 0)
-                return; // Avoid division by zero
+                // Position correction (avoid sinking)
+                const float percent = 0.2f; // penetration correction factor
+                glm::vec3 correction = (penetrationDepth / invMassSum) * percent * collisionNormal;
 
-            // Calculate impulse scalar using constraint
-            float j = -(1.0f + e) * velocityAlongNormal / inverseMassSum;
-            ACMSG("Collided");
-            // Apply constraint impulse
-            glm::vec2 impulse = normal2D * j;
-            rbA.ApplyImpulseAtPosition(-impulse, collisionPoint2D - glm::vec2(transformA.position.x, transformA.position.y));
-            rbB.ApplyImpulseAtPosition(impulse, collisionPoint2D - glm::vec2(transformB.position.x, transformB.position.y));
+                if (!fixedA)
+                    world.GetPtr<Transform>(entityA)->position -= correction * rbA.inverseMass;
 
-            if (applyPositionCorrection)
-            {
-                // Apply position correction (avoid sinking)
-                const float percent = 0.2f; // penetration correction factor
-                glm::vec2 correction = normal2D * (penetrationDepth / inverseMassSum) * percent;
+                if (!fixedB)
+                    world.GetPtr<Transform>(entityB)->position += correction * rbB.inverseMass;
 
-                if (!rbA.isKinematic)
+                // Velocity correction (bounce effect)
+                glm::vec3 relativeVelocity = rbB.velocity - rbA.velocity;
+                float velocityAlongNormal = glm::dot(relativeVelocity, collisionNormal);
+                // If objects are moving away from each other along the collision normal,
+// we need to flip the normal
+                if (velocityAlongNormal > 0)
                 {
-                    transformA.position.x -= correction.x * rbA.inverseMass;
-                    transformA.position.y -= correction.y * rbA.inverseMass;
+                    collisionNormal = -collisionNormal;
+                    velocityAlongNormal = -velocityAlongNormal;
                 }
-
-                if (!rbB.isKinematic)
+                // Only resolve if objects are moving toward each other
+                if (velocityAlongNormal < 0)
                 {
-                    transformB.position.x += correction.x * rbB.inverseMass;
-                    transformB.position.y += correction.y * rbB.inverseMass;
-                }
-            }
-           
-        }
-    }
+                    // Calculate coefficient of restitution (bounciness)
+                    float e = std::min(rbA.restitution, rbB.restitution);
 
-    void SolveFriction(RigidBody2D& rbA, RigidBody2D& rbB, Transform& transformA, Transform& transformB,
-        float penetrationDepth, glm::vec2 collisionNormal, glm::vec2 collisionPoint2D)
-    {
-        float e = std::min(rbA.restitution, rbB.restitution);
-        float friction = (rbA.friction + rbB.friction) / 2.0;
+                    // Calculate impulse scalar
+                    float j = -(1.0f + e) * velocityAlongNormal / invMassSum;
 
-        glm::vec2 tangent(-collisionNormal.y, collisionNormal.x);
+                    // Apply impulse
+                    glm::vec3 impulse = j * collisionNormal;
 
-        // Calculate relative positions of collision point
-        glm::vec2 rA = collisionPoint2D - glm::vec2(transformA.position.x, transformA.position.y);
-        glm::vec2 rB = collisionPoint2D - glm::vec2(transformB.position.x, transformB.position.y);
+                    if (!fixedA)
+                        movingA->velocity -= impulse * rbA.inverseMass;
 
-        // Calculate relative velocity at contact point
-        glm::vec2 relativeVelocity = rbB.velocity + glm::vec2(-rbB.angularVelocity * rB.y, rbB.angularVelocity * rB.x) -
-            rbA.velocity - glm::vec2(-rbA.angularVelocity * rA.y, rbA.angularVelocity * rA.x);
+                    if (!fixedB)
+                        movingB->velocity += impulse * rbB.inverseMass;
 
-        float velocityAlongTangent = glm::dot(relativeVelocity, tangent);
+                    // Apply friction
+                    float friction = (rbA.friction + rbB.friction) * 0.5f;
 
-        float rACrossN = rA.x * tangent.y - rA.y * tangent.x;
-        float rBCrossN = rB.x * tangent.y - rB.y * tangent.x;
+                    if (friction > 0)
+                    {
+                        // Recalculate relative velocity after normal impulse
+                        relativeVelocity = rbB.velocity - rbA.velocity;
+
+                        // Calculate tangent vector (perpendicular to normal)
+                        glm::vec3 tangent = relativeVelocity - (glm::dot(relativeVelocity, collisionNormal) * collisionNormal);
+                        float tangentLength = glm::length(tangent);
 
-        // Calculate effective mass for constraint
-        float inverseMassSum = rbA.inverseMass + rbB.inverseMass;
+                        if (tangentLength > 0.0001f)
+                        {
+                            tangent = tangent / tangentLength;
 
+                            // Calculate friction impulse
+                            float jt = -glm::dot(relativeVelocity, tangent) / invMassSum;
 
-        // Include rotational contribution in effective mass
-        if (!rbA.freezeRotation)
-            inverseMassSum += rACrossN * rACrossN / rbA.inertiaTensor;
-        if (!rbB.freezeRotation)
-            inverseMassSum += rBCrossN * rBCrossN / rbB.inertiaTensor;
+                            // Clamp friction
+                            jt = glm::clamp(jt, -j * friction, j * friction);
 
-        if (inverseMassSum <= 0)
-            return; // Avoid division by zero
+                            // Apply friction impulse
+                            glm::vec3 frictionImpulse = jt * tangent;
 
-        float j = friction * -(1.0 + e) * velocityAlongTangent / inverseMassSum;
-        ACMSG("Collided");
-        // Apply constraint impulse
-        glm::vec2 impulse = tangent * j;
-        rbA.ApplyImpulseAtPosition(-impulse, collisionPoint2D - glm::vec2(transformA.position.x, transformA.position.y));
-        rbB.ApplyImpulseAtPosition(impulse, collisionPoint2D - glm::vec2(transformB.position.x, transformB.position.y));
+                            if (!fixedA)
+                                movingA->velocity -= frictionImpulse * rbA.inverseMass;
+
+                            if (!fixedB)
+                                movingB->velocity += frictionImpulse * rbB.inverseMass;
+                        }
+                    }
+                }
+            }
+        }
 
+        // Islands of bodies that all rested for long enough fall asleep
+        if (sleep.enabled)
+        {
+            islands.Build();
+            SleepRestingIslands<RigidBody>(world, islands, islandBodies, sleep, sleep.bodies3D);
+        }
+
+        // Handlers see the positions and velocities the step ended with
+        for (const CollisionEvent& event : events)
+        {
+            if (event.trigger)
+            {
+                OnTriggerEnter triggerEvent{ event.data, world };
+                eventManager.Invoke(triggerEvent, AllowToken<OnTriggerEnter>());
+            }
+            else
+            {
+                OnCollision collisionEvent{ event.data, world };
+                eventManager.Invoke(collisionEvent, AllowToken<OnCollision>());
+            }
+        }
     }
 
     void PhysicsSystem::Collision2DSystem(World& world)
     {
         EventManager& eventManager = world.GetResourse<EventManager>();
         CollisionLayer& collisionLayers = world.GetResourse<CollisionLayer>();
+        Broadphase2D& broadphase = world.GetResourse<Broadphase2D>();
+        ContactSolver2D& solver = world.GetResourse<ContactSolver2D>();
+        PhysicsSleep& sleep = world.GetResourse<PhysicsSleep>();
+        // Islands that lost a body or a collider since the last step move again from this one
+        WakeBrokenIslands<RigidBody2D>(world, sleep.bodies2D);
         
-        // Create collections for the different 2D collider types
-        auto circleColliders = world.View<CircleCollider2D, Transform>().GetPacked();
-        auto rectColliders = world.View<RectCollider2D, Transform>().GetPacked();
-        auto polygonColliders = world.View<PolygonCollider2D, Transform>().GetPacked();
-        
-        // Combined list of all colliders
-        std::vector<std::pair<Entity, Collider2D*>> allColliders;
-        
-        // Add circle colliders to the combined list
-        for (auto& item : circleColliders) {
-            Entity entity = item.id;
-            CircleCollider2D& circleCollider = world.Get<CircleCollider2D>(entity);
-            allColliders.push_back({entity, static_cast<Collider2D*>(&circleCollider)});
-        }
-        
-        // Add rect colliders to the combined list
-        for (auto& item : rectColliders) {
-            Entity entity = item.id;
-            RectCollider2D& rectCollider = world.Get<RectCollider2D>(entity);
-            allColliders.push_back({entity, static_cast<Collider2D*>(&rectCollider)});
-        }
-        
-        // Add polygon colliders to the combined list
-        for (auto& item : polygonColliders) {
-            Entity entity = item.id;
-            PolygonCollider2D& polygonCollider = world.Get<PolygonCollider2D>(entity);
-            allColliders.push_back({entity, static_cast<Collider2D*>(&polygonCollider)});
-        }
+        // Gather every collider with its transform, its bounds and, if present, its rigid body in one pass
+        struct ColliderEntry
+        {
+            Entity entity;
+            Collider2D* collider;
+            const Transform* transform;
+            ComponentPtr<const RigidBody2D> rigidBody;
+            bool sleeping;      ///< The body slept when the step started
+            bool wakesSleepers; ///< Touching the collider wakes a sleeping body: awake dynamic bodies and moving kinematic ones
+            glm::vec2 sweep;    ///< Translation of a bullet this step, zero for other colliders
+        };
+        std::vector<ColliderEntry> allColliders;
+        std::vector<BroadphaseProxy2D> proxies;
+        size_t bulletCount = 0;
+
+        // Rigid bodies are copied into the solver once, however many colliders they have
+        struct SolvedBody
+        {
+            Entity entity;
+            bool canSleep; ///< Awake and dynamic when the step started
+        };
+        std::vector<SolvedBody> solvedBodies;
+        solver.BeginStep();
+        auto addBody = [&solver, &solvedBodies](const ColliderEntry& entry)
+            {
+                RigidBody2DConstRef rb = *entry.rigidBody;
+                SolverBody2D body;
+                body.velocity = rb.velocity;
+                body.angularVelocity = rb.angularVelocity;
+                // A body that slept when the step started holds still until the next one, even if it was woken since
+                bool fixed = rb.isKinematic || entry.sleeping;
+                body.inverseMass = fixed ? 0.0f : rb.inverseMass;
+                body.inverseInertia = fixed || rb.freezeRotation || rb.inertiaTensor <= 0.0f ? 0.0f : 1.0f / rb.inertiaTensor;
+                uint32_t index = solver.AddBody(entry.entity, body);
+                if (index == solvedBodies.size())
+                    solvedBodies.push_back({ entry.entity, !fixed });
+                return index;
+            };
+
+        auto gather = [&allColliders, &proxies, &bulletCount, &sleep, &addBody](uint64_t shape)
+            {
+                return [&allColliders, &proxies, &bulletCount, &sleep, &addBody, shape](Entity entity, Collider2D& collider, const Transform& transform, ComponentPtr<const RigidBody2D> rigidBody)
+                    {
+                        bool sleeping = rigidBody != nullptr && rigidBody->isSleeping;
+                        // An awake body still listed in a sleeping island was woken by a force or an impulse
+                        if (rigidBody != nullptr && !sleeping)
+                            sleep.bodies2D.Break(entity);
+                        bool wakesSleepers = rigidBody != nullptr && !sleeping && (!rigidBody->isKinematic || !IsResting(*rigidBody, sleep));
+                        glm::vec2 sweep = rigidBody != nullptr && rigidBody->bullet && !sleeping ? rigidBody->sweep : glm::vec2(0.0f);
+                        // A sleeping body has not moved since its vertices were last cached
+                        if (!sleeping)
+                            collider.UpdateWorldVertices(transform);
+                        allColliders.push_back({ entity, &collider, &transform, rigidBody, sleeping, wakesSleepers, sweep });
+
+                        // A bullet's bounds cover its whole motion, so the broadphase reports what it may have passed through
+                        AABB2D bounds = collider.GetWorldAABB(transform);
+                        if (sweep != glm::vec2(0.0f))
+                        {
+                            bounds = AABB2D::Union(bounds, { bounds.min - sweep, bounds.max - sweep });
+                            ++bulletCount;
+                        }
+                        // An entity has at most one collider of each shape, so its index and the shape identify the collider across frames
+                        proxies.push_back({ (static_cast<uint64_t>(EntityIndex(entity)) << 2) | shape, bounds, collider.layer, sleeping });
+                        // Awake dynamic bodies touching nothing are islands of their own, so they enter the solver too
+                        if (rigidBody != nullptr && !sleeping && !rigidBody->isKinematic)
+                            addBody(allColliders.back());
+                    };
+            };
+        // Transforms and bodies are read-only, so what the step leaves alone is not marked changed; the solved bodies are written back through GetPtr
+        world.Query<CircleCollider2D, const Transform>(Optional<const RigidBody2D>{}).ForEach(gather(0));
+        world.Query<RectCollider2D, const Transform>(Optional<const RigidBody2D>{}).ForEach(gather(1));
+        world.Query<PolygonCollider2D, const Transform>(Optional<const RigidBody2D>{}).ForEach(gather(2));
+        // The rest of their islands hold still this step, like bodies woken by a contact
+        WakeBrokenIslands<RigidBody2D>(world, sleep.bodies2D);
         
-        // Check each collider pair for collisions
-        for (size_t i = 0; i < allColliders.size(); i++)
+        // Only pairs whose bounds overlap and whose layers collide reach the narrowphase; the broadphase drops pairs of sleeping colliders
+        std::vector<BroadphasePair2D> pairs;
+        broadphase.FindPairs(proxies, collisionLayers, pairs);
+        if (bulletCount > 0)
+            SweepBullets<RigidBody2D>(world, allColliders, pairs, solver.linearSlop, &TimeOfImpact2D);
+
+        // The narrowphase only reads the colliders, so the pairs are tested on every thread, each filling its own buffer
+        struct PairContact
         {
-            Entity entityA = allColliders[i].first;
-            Collider2D* colliderA = allColliders[i].second;
-            Transform& transformA = world.Get<Transform>(entityA);
-            
-            for (size_t j = i + 1; j < allColliders.size(); j++)
+            uint32_t pair; ///< Index in pairs
+            Manifold2D manifold;
+        };
+        JobSystem& jobs = world.GetJobSystem();
+        std::vector<std::vector<PairContact>> threadContacts(jobs.MaxWorkerIndex() + 1);
+        jobs.ParallelFor(pairs.size(), NarrowphaseGrainSize, [&jobs, &threadContacts, &pairs, &allColliders](size_t begin, size_t end)
             {
-                Entity entityB = allColliders[j].first;
-                Collider2D* colliderB = allColliders[j].second;
-                Transform& transformB = world.Get<Transform>(entityB);
-                
-                // Check if layers should collide
-                if (!collisionLayers.ShouldCollide(colliderA->layer, colliderB->layer))
-                    continue;
-                    
-                glm::vec2 collisionNormal;
-				std::vector<CollisionPoint2D> collisionPoint;
-                float penetrationDepth;
-                
-                // Check for collision
-                if (!colliderA->CheckCollision(colliderB, transformA, transformB,
-                    collisionPoint, collisionNormal, penetrationDepth))
-                    continue;
-
-                // Create collision data
-                CollisionData2D collisionData;
-                collisionData.entityA = entityA;
-                collisionData.entityB = entityB;
-                collisionData.collisionNormal = collisionNormal;
-                collisionData.penetrationDepth = penetrationDepth;
-                collisionData.collisionPointCnt = collisionPoint.size();
-                if (collisionData.collisionPointCnt > 0)
-                    collisionData.collisionPoint1 = collisionPoint[0];
-                if (collisionData.collisionPointCnt > 1)
-                    collisionData.collisionPoint2 = collisionPoint[1];
-
-                // If either collider is a trigger, send trigger event
-                if (colliderA->isTrigger || colliderB->isTrigger)
+                std::vector<PairContact>& contacts = threadContacts[jobs.WorkerIndex()];
+                for (size_t p = begin; p < end; ++p)
                 {
-                    OnTriggerEnter triggerEvent{ collisionData, world };
-                    eventManager.Invoke(triggerEvent, AllowToken<OnTriggerEnter>());
+                    const ColliderEntry& entryA = allColliders[pairs[p].a];
+                    const ColliderEntry& entryB = allColliders[pairs[p].b];
+
+                    // A sleeping body is only tested against the colliders that can wake it
+                    if ((entryA.sleeping && !entryB.wakesSleepers) || (entryB.sleeping && !entryA.wakesSleepers))
+                        continue;
+
+                    Manifold2D manifold;
+                    if (entryA.collider->CheckCollision(entryB.collider, *entryA.transform, *entryB.transform, manifold))
+                        contacts.push_back({ static_cast<uint32_t>(p), manifold });
                 }
-                else
-                {
-                    // Send collision event
-                    OnCollision collisionEvent{ collisionData, world };
-                    eventManager.Invoke(collisionEvent, AllowToken<OnCollision>());
+            }, solver.maxThreads);
 
-                    // Collision resolution for RigidBody2D components
-                    bool hasRbA = world.Has<RigidBody2D>(entityA);
-                    bool hasRbB = world.Has<RigidBody2D>(entityB);
+        // Back in pair order, events, wake-ups and contacts come out the same whichever thread found them
+        std::vector<PairContact> contacts;
+        for (const std::vector<PairContact>& threadContact : threadContacts)
+            contacts.insert(contacts.end(), threadContact.begin(), threadContact.end());
+        std::sort(contacts.begin(), contacts.end(), [](const PairContact& a, const PairContact& b) { return a.pair < b.pair; });
 
-                    if ((!hasRbA || !hasRbB))
-                        continue; // Skip if either entity does not have a RigidBody2D
+        // Handlers may destroy entities or add and remove components, so the events wait until the gathered pointers are no longer used
+        struct CollisionEvent
+        {
+            CollisionData2D data;
+            bool trigger; ///< Sent as OnTriggerEnter instead of OnCollision
+        };
+        std::vector<CollisionEvent> events;
+        events.reserve(contacts.size());
 
-                    RigidBody2D& rbA = world.Get<RigidBody2D>(entityA);
-                    RigidBody2D& rbB = world.Get<RigidBody2D>(entityB);
+        for (const PairContact& contact : contacts)
+        {
+            size_t i = pairs[contact.pair].a;
+            size_t j = pairs[contact.pair].b;
+            Entity entityA = allColliders[i].entity;
+            const Collider2D* colliderA = allColliders[i].collider;
+            const Transform& transformA = *allColliders[i].transform;
+            Entity entityB = allColliders[j].entity;
+            const Collider2D* colliderB = allColliders[j].collider;
+            const Transform& transformB = *allColliders[j].transform;
+            const Manifold2D& manifold = contact.manifold;
+
+            // Create collision data
+            CollisionData2D collisionData;
+            collisionData.entityA = entityA;
+            collisionData.entityB = entityB;
+            collisionData.collisionNormal = manifold.normal;
+            collisionData.penetrationDepth = manifold.penetrationDepth;
+            collisionData.collisionPointCnt = manifold.pointCount;
+            if (collisionData.collisionPointCnt > 0)
+                collisionData.collisionPoint1 = manifold.points[0];
+            if (collisionData.collisionPointCnt > 1)
+                collisionData.collisionPoint2 = manifold.points[1];
+
+            // Triggers only report the overlap
+            bool trigger = colliderA->isTrigger || colliderB->isTrigger;
+            events.push_back({ collisionData, trigger });
+            if (trigger)
+                continue;
+
+            // Collision resolution for RigidBody2D components
+            if (allColliders[i].rigidBody == nullptr || allColliders[j].rigidBody == nullptr)
+                continue; // Skip if either entity does not have a RigidBody2D
+
+            // A sleeping body hit by a moving one wakes up with its island, and moves from the next step on
+            if (allColliders[i].sleeping)
+                WakeIsland<RigidBody2D>(world, sleep.bodies2D, entityA);
+            if (allColliders[j].sleeping)
+                WakeIsland<RigidBody2D>(world, sleep.bodies2D, entityB);
+
+            RigidBody2DConstRef rbA = *allColliders[i].rigidBody;
+            RigidBody2DConstRef rbB = *allColliders[j].rigidBody;
+
+            // Skip if both are kinematic
+            if (rbA.isKinematic && rbB.isKinematic)
+                continue;
+
+            // The contact is resolved together with all others once every pair has been tested
+            float friction = (rbA.friction + rbB.friction) * 0.5f;
+            float restitution = std::min(rbA.restitution, rbB.restitution);
+            uint32_t bodyA = addBody(allColliders[i]);
+            uint32_t bodyB = addBody(allColliders[j]);
+            uint64_t generations = (static_cast<uint64_t>(EntityGeneration(entityA)) << 32) | EntityGeneration(entityB);
+            solver.AddContact({ proxies[i].key, proxies[j].key, generations }, bodyA, bodyB,
+                glm::vec2(transformA.position.x, transformA.position.y), glm::vec2(transformB.position.x, transformB.position.y),
+                manifold, friction, restitution);
+        }
 
-                    // Skip if both are kinematic
-                    if (rbA.isKinematic && rbB.isKinematic)
-                        continue;
-                    bool b = true;
-                        for (const auto& point : collisionPoint)
-                        {
-                            // Calculate impulse for collision response
-                            Solve(rbA, rbB, transformA, transformB, penetrationDepth, collisionNormal, point.rbA, b);
-                            SolveFriction(rbA, rbB, transformA, transformB, penetrationDepth, collisionNormal, point.rbA);
-                            b = false; // Only apply position correction once per collision
-                        }
-                    
+        // Warm start from last step's impulses, iterate the velocities, then push overlapping bodies apart, island by island on every thread
+        solver.Solve(jobs);
+        std::vector<SolverBody2D>& bodies = solver.GetBodies();
+        for (size_t k = 0; k < bodies.size(); ++k)
+        {
+            // Fixed bodies are only read by the solver, so only the moving ones are written back and marked changed
+            if (!solvedBodies[k].canSleep)
+                continue;
+            RigidBody2DRef rb = *world.GetPtr<RigidBody2D>(solvedBodies[k].entity);
+            rb.velocity = bodies[k].velocity;
+            rb.angularVelocity = bodies[k].angularVelocity;
+            Transform& transform = *world.GetPtr<Transform>(solvedBodies[k].entity);
+            transform.position.x += bodies[k].positionCorrection.x;
+            transform.position.y += bodies[k].positionCorrection.y;
+        }
+
+        // Islands of bodies that all rested for long enough fall asleep
+        if (sleep.enabled)
+        {
+            if (SleepRestingIslands<RigidBody2D>(world, solver.GetIslands(), solvedBodies, sleep, sleep.bodies2D))
+            {
+                // Cache their vertices where the position pass left them, as sleeping bodies skip the update
+                for (const ColliderEntry& entry : allColliders)
+                {
+                    if (entry.rigidBody != nullptr && !entry.sleeping && entry.rigidBody->isSleeping)
+                        entry.collider->UpdateWorldVertices(*entry.transform);
                 }
             }
         }
+
+        // Handlers see the positions and velocities the step ended with
+        for (const CollisionEvent& event : events)
+        {
+            if (event.trigger)
+            {
+                OnTriggerEnter triggerEvent{ event.data, world };
+                eventManager.Invoke(triggerEvent, AllowToken<OnTriggerEnter>());
+            }
+            else
+            {
+                OnCollision collisionEvent{ event.data, world };
+                eventManager.Invoke(collisionEvent, AllowToken<OnCollision>());
+            }
+        }
     }
     void PhysicsSystem::DebugPhysics(World& world)
     {
         float totMomentum = 0, totEnergy = 0;
-        world.View<RigidBody2D>().ForEach([&totMomentum, &totEnergy](Entity e, RigidBody2D& rb)
+        world.View<const RigidBody2D>().ForEach([&totMomentum, &totEnergy](Entity e, RigidBody2DConstRef rb)
             {
                 totMomentum += (rb.mass * glm::length(rb.velocity));
                 totMomentum += (abs(rb.angularVelocity) * rb.inertiaTensor);
                 
             });
-        ACMSG("TotMomentum: " << totMomentum);
+        AC_LOG_INFO(LogCategory::Physics, "TotMomentum: " << totMomentum);
         //ACMSG("TotEnergy: " << totEnergy);
     }
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/glm.hpp>
 #include "EngineComponents/Physics/Physics.h"
+#include "Math/Transform.h"
+#include "Math/Simd.h"
 namespace ac
 {
     /**
@@ -19,30 +21,110 @@ namespace ac
         float penetrationDepth = 0; ///< How far the objects are interpenetrating
     };
 
-    
+
+    /**
+     * @brief The Transform of every row of a rigid body pool.
+     *
+     * Rows match the rows of the RigidBody2D / RigidBody pool. The Transform
+     * addresses are looked up once and reused until either pool adds,
+     * removes or moves members.
+     */
+    struct IntegrationRows
+    {
+        uint64_t bodyLayout = UINT64_MAX;      ///< LayoutVersion of the body pool the rows were built for
+        uint64_t transformLayout = UINT64_MAX; ///< LayoutVersion of the Transform pool the rows were built for
+        std::vector<uint8_t> active;            ///< 1 if the entity of the row has a Transform
+        std::vector<Transform*> transforms;     ///< Transform of the entity of the row, or nullptr
+        std::vector<ComponentTicks*> transformTicks; ///< Change ticks of each entry of transforms
+    };
+
+    /**
+     * @brief World resource holding the state PhysicsStep and Physics2DStep keep between frames.
+     */
+    struct PhysicsIntegrationCache
+    {
+        IntegrationRows bodies2D;
+        IntegrationRows bodies3D;
+    };
+
     class PhysicsSystem
     {
     public:
         /**
          * @brief System that handles 3D physics simulation.
+         *
+         * Advances the bodies by Time::FixedDelta, so it belongs in the fixed-update phase.
          */
         static void PhysicsStep(World& world);
 
         /**
          * @brief System that handles 2D physics simulation.
+         *
+         * Advances the bodies by Time::FixedDelta, so it belongs in the fixed-update phase.
          */
         static void Physics2DStep(World& world);
 
+        /**
+         * @brief Records the Transform of every interpolated entity before a fixed step.
+         *
+         * Gives rigid bodies without an InterpolatedTransform one first, so
+         * InterpolateTransformsSystem can draw them between fixed steps. Adds
+         * components, so it must run exclusively, first in the fixed-update phase.
+         */
+        static void SaveInterpolationState(World& world);
+
+        /**
+         * @brief Integrates every RigidBody with a Transform over dt; the work of PhysicsStep.
+         *
+         * Runs the batch kernels over the SoA columns of the RigidBody pool in
+         * parallel chunks, then moves the Transforms. Needs a
+         * PhysicsIntegrationCache resource.
+         *
+         * @param world The world to update.
+         * @param dt Step length in seconds.
+         * @param level Instruction set of the kernels; PhysicsStep uses GetSimdLevel().
+         */
+        static void Integrate3D(World& world, float dt, SimdLevel level);
+
+        /**
+         * @brief Integrates every RigidBody2D with a Transform over dt; the work of Physics2DStep.
+         *
+         * Like Integrate3D over the RigidBody2D pool; bodies rotate about z.
+         *
+         * @param world The world to update.
+         * @param dt Step length in seconds.
+         * @param level Instruction set of the kernels; Physics2DStep uses GetSimdLevel().
+         */
+        static void Integrate2D(World& world, float dt, SimdLevel level);
+
         /**
          * @brief System that performs 3D collision detection and resolution.
+         *
+         * Like Collision2DSystem, sends OnCollision and OnTriggerEnter once
+         * the contacts are resolved.
          */
         static void CollisionSystem(World& world);
         
         /**
          * @brief System that performs 2D collision detection and resolution.
+         *
+         * OnCollision and OnTriggerEnter are sent once the contacts are
+         * resolved, so their handlers may destroy entities or add and remove
+         * components.
          */
         static void Collision2DSystem(World& world);
 
+        /**
+         * @brief Listens for removed rigid bodies and colliders so their sleeping islands wake up.
+         *
+         * Without it, removing a body from a sleeping island leaves the rest
+         * asleep in mid-air. InitEngine calls it; worlds set up by hand call
+         * it once after registering the physics types and resources.
+         *
+         * @param world The world with the PhysicsSleep resource.
+         */
+        static void AddSleepListeners(World& world);
+
         static void DebugPhysics(World& world);
     };
 
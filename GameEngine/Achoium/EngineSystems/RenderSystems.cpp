@@ -4,6 +4,7 @@
 #include "Math/Transform.h"
 #include "EngineComponents/Physics/Physics.h"
 #include "EngineComponents/Tilemap.h"
+#include "EngineComponents/Hierarchy.h"
 namespace ac
 {
 	bool OnSpriteAdded(const OnAdded<Sprite>& event)
@@ -31,14 +32,12 @@ namespace ac
 		OpenGLRenderer& renderer = world.GetResourse<OpenGLRenderer>();
 		TextureManager& textureManager = world.GetResourse<TextureManager>();
 		ModelManager& modelManager = world.GetResourse<ModelManager>();
-		world.View<Sprite, Transform>().ForEach([&modelManager, &textureManager, &renderer](Entity e, Sprite& sprite, Transform& trans)
+		world.Query<const Sprite, const WorldTransform>().ForEach([&modelManager, &textureManager, &renderer](Entity e, const Sprite& sprite, const WorldTransform& trans)
 			{
 				textureManager.GetTexture(sprite.textureID).Bind();
 				OpenGLVertexArray& vao = modelManager.GetModel(0);
-				Transform t = trans;
-				t.scale.x *= sprite.width;
-				t.scale.y *= sprite.height;
-				renderer.Submit(&(vao), t.asMat4(), sprite.color);
+				glm::mat4 m = glm::scale(trans.matrix, glm::vec3(sprite.width, sprite.height, 1));
+				renderer.Submit(&(vao), m, sprite.color);
 			});
 	}
 	void RenderCircle(World& world)
@@ -57,18 +56,15 @@ namespace ac
 		OpenGLRenderer& renderer = world.GetResourse<OpenGLRenderer>();
 		TextureManager& textureManager = world.GetResourse<TextureManager>();
 		ModelManager& modelManager = world.GetResourse<ModelManager>();
-		world.View<RectCollider2D, Transform>().ForEach([&modelManager, &textureManager, &renderer](Entity e, RectCollider2D& colli, Transform& trans)
+		world.View<const RectCollider2D, const WorldTransform>().ForEach([&modelManager, &textureManager, &renderer](Entity e, const RectCollider2D& colli, const WorldTransform& trans)
 			{
 				glm::vec2 tmp = (colli.offset - colli.halfSize) / colli.halfSize / 2.0f;
 				glm::vec3 offset = glm::vec3(tmp,0);
-				Transform t = trans;
-				t.scale.x *= colli.halfSize.x * 2;
-				t.scale.y *= colli.halfSize.y * 2;
-				glm::mat4 m = t.asMat4() * glm::translate(glm::mat4(1),offset);
+				glm::mat4 m = glm::scale(trans.matrix, glm::vec3(colli.halfSize * 2.0f, 1)) * glm::translate(glm::mat4(1),offset);
 				renderer.SubmitDebug(&modelManager.GetModel(0), m);
 			});
 
-		world.View<CircleCollider2D, Transform>().ForEach([&modelManager, &textureManager, &renderer](Entity e, CircleCollider2D& colli, Transform& trans)
+		world.View<const CircleCollider2D, const Transform>().ForEach([&modelManager, &textureManager, &renderer](Entity e, const CircleCollider2D& colli, const Transform& trans)
 			{
 				renderer.SubmitCircle(&modelManager.GetModel(0), colli.radius, trans);
 			});
@@ -78,26 +74,28 @@ namespace ac
 		OpenGLRenderer& renderer = world.GetResourse<OpenGLRenderer>();
 		TextureManager& textureManager = world.GetResourse<TextureManager>();
 		ModelManager& modelManager = world.GetResourse<ModelManager>();
-		world.View<TilemapElement, Sprite>().ForEach([&world, &modelManager, &textureManager, &renderer](Entity e, TilemapElement& tilemapElement, Sprite& sprite)
+		world.View<const TilemapElement, const Sprite>().ForEach([&world, &modelManager, &textureManager, &renderer](Entity e, const TilemapElement& tilemapElement, const Sprite& sprite)
 			{
 				textureManager.GetTexture(sprite.textureID).Bind();
 				OpenGLVertexArray& vao = modelManager.GetModel(0);
-				Tilemap& tilemap = world.Get<Tilemap>(tilemapElement.tilemap);
-				Transform t;
-				if (world.Has<Transform>(tilemapElement.tilemap))
-					Transform t = world.Get<Transform>(tilemapElement.tilemap);
-				t.position += glm::vec3(tilemap.gridWidth, tilemap.gridHeight, 0) * t.scale * glm::vec3(tilemapElement.x, tilemapElement.y,0);
-				t.position.z = world.Get<Transform > (tilemapElement.tilemap).position.z;
-				t.scale.x = sprite.width;
-				t.scale.y = sprite.height;
+				const Tilemap* tilemapPtr = world.GetPtr<const Tilemap>(tilemapElement.tilemap);
+				if (tilemapPtr == nullptr)
+					return;
+				const Tilemap& tilemap = *tilemapPtr;
+				// Tiles are laid out in the tilemap's space, whose world matrix is already cached
+				const WorldTransform* tilemapTransform = world.GetPtr<const WorldTransform>(tilemapElement.tilemap);
+				glm::mat4 m = tilemapTransform != nullptr ? tilemapTransform->matrix : glm::mat4(1.0f);
+				m = glm::translate(m, glm::vec3(tilemap.gridWidth * tilemapElement.x, tilemap.gridHeight * tilemapElement.y, 0));
+				m = glm::scale(m, glm::vec3(sprite.width, sprite.height, 1));
 
-				renderer.Submit(&(vao), t.asMat4(), sprite.color);
+				renderer.Submit(&(vao), m, sprite.color);
 			});
 	}
 	void SyncCamera(World& world)
 	{
 		OpenGLRenderer& renderer = world.GetResourse<OpenGLRenderer>();
-		world.View<Camera, Transform>().ForEach([&renderer](Entity e, Camera& camera, Transform& transform)
+		// The renderer keeps the last camera matrix, so only push it when the camera moved.
+		world.View<const Camera, const Transform>().Changed<Transform>().ForEach([&renderer](Entity e, const Camera& camera, const Transform& transform)
 			{
 				renderer.UpdateCamera(transform.asMat4(true));
 			});
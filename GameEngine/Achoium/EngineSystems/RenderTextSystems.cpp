@@ -10,10 +10,10 @@ void RenderTextSystem(World& world) {
     auto& renderer = world.GetResourse<OpenGLRenderer>();
     
     // ȡоTransformTextComponentʵ
-    auto view = world.View<Transform, Text>();
+    auto view = world.View<const Transform, const Text>();
     
     // Ⱦÿı
-    view.ForEach([&renderer](Entity entity, Transform& transform, Text& textComp) {
+    view.ForEach([&renderer](Entity entity, const Transform& transform, const Text& textComp) {
         if (!textComp.visible || textComp.text.empty())
             return;
             
@@ -5,6 +5,8 @@ namespace ac
 {
 	void UpdateTimeSystem(World& world)
 	{
-		world.GetResourse<Time>().Update();
+		Time& time = world.GetResourse<Time>();
+		time.Update();
+		world.SetFixedUpdateCount(time.FixedStepCount());
 	}
 }
@@ -3,5 +3,12 @@
 #include "EngineComponents/Time.h"
 namespace ac
 {
+	/**
+	 * @brief Advances the Time resource and tells the world how many fixed steps are due this frame.
+	 *
+	 * Must run in the pre-update phase, before the fixed-update phase it sizes.
+	 *
+	 * @param world The world to update.
+	 */
 	void UpdateTimeSystem(World& world);
 }
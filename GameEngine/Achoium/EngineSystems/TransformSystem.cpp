@@ -0,0 +1,135 @@
+#include "acpch.h"
+#include "TransformSystem.h"
+#include "Math/Transform.h"
+#include "EngineComponents/Time.h"
+namespace ac
+{
+	/**
+	 * @brief Recomputes the world matrices of all descendants of an entity.
+	 *
+	 * @param world The world the hierarchy lives in.
+	 * @param children The children of the entity.
+	 * @param parentMatrix The entity's world matrix.
+	 */
+	static void PropagateToChildren(World& world, const Children& children, const glm::mat4& parentMatrix)
+	{
+		for (Entity child : children.entities)
+		{
+			if (!world.IsAlive(child))
+				continue;
+			const Transform* transform = world.GetPtr<const Transform>(child);
+			WorldTransform* worldTransform = world.GetPtr<WorldTransform>(child);
+			if (transform == nullptr || worldTransform == nullptr)
+				continue; // Entities without a Transform end their branch
+
+			worldTransform->matrix = parentMatrix * transform->asMat4();
+			const Children* grandChildren = world.GetPtr<const Children>(child);
+			if (grandChildren != nullptr)
+				PropagateToChildren(world, *grandChildren, worldTransform->matrix);
+		}
+	}
+
+	/**
+	 * @brief Recomputes the world matrix of an entity from its clean parent's, then those of its descendants.
+	 *
+	 * @param world The world the hierarchy lives in.
+	 * @param entity The top of a dirty branch.
+	 */
+	static void UpdateBranch(World& world, Entity entity)
+	{
+		const Transform* transform = world.GetPtr<const Transform>(entity);
+		const Parent* parent = world.GetPtr<const Parent>(entity);
+		const WorldTransform* parentWorld = parent != nullptr ? world.GetPtr<const WorldTransform>(parent->entity) : nullptr;
+		if (transform == nullptr || (parent != nullptr && parentWorld == nullptr))
+			return; // Below a parent without a Transform, like PropagateToChildren
+
+		WorldTransform& worldTransform = world.Get<WorldTransform>(entity);
+		worldTransform.matrix = parentWorld != nullptr ? parentWorld->matrix * transform->asMat4() : transform->asMat4();
+		const Children* children = world.GetPtr<const Children>(entity);
+		if (children != nullptr)
+			PropagateToChildren(world, *children, worldTransform.matrix);
+	}
+
+	void TransformPropagationSystem(World& world)
+	{
+		// Children whose parent was deleted become roots
+		std::vector<Entity> orphans;
+		world.Query<const Parent>().ForEach([&world, &orphans](Entity entity, const Parent& parent)
+			{
+				if (!world.IsAlive(parent.entity))
+					orphans.push_back(entity);
+			});
+		for (Entity orphan : orphans)
+			RemoveParent(world, orphan);
+
+		// New WorldTransforms outside any hierarchy start out right; those in one are recomputed below
+		std::vector<Entity> dirty;
+		std::vector<Entity> missing;
+		std::vector<WorldTransform> initial;
+		world.Query<const Transform>(Exclude<WorldTransform>{}).ForEach([&world, &dirty, &missing, &initial](Entity entity, const Transform& transform)
+			{
+				missing.push_back(entity);
+				initial.push_back(WorldTransform{ transform.asMat4() });
+				if (world.Has<Parent>(entity) || world.Has<Children>(entity))
+					dirty.push_back(entity);
+			});
+		if (!missing.empty())
+			world.AddBatch<WorldTransform>(missing, initial);
+
+		// Entities outside any hierarchy
+		world.Query<const Transform, WorldTransform>(Exclude<Parent, Children>{}).Changed<Transform>().ParallelForEach(
+			[](const Transform& transform, WorldTransform& worldTransform)
+			{
+				worldTransform.matrix = transform.asMat4();
+			});
+
+		// Hierarchy entities that moved or were reparented; clean branches are never visited
+		auto collect = [&dirty](Entity entity, const Transform&, const Parent&) { dirty.push_back(entity); };
+		world.Query<const Transform, const Parent>().Changed<Transform>().ForEach(collect);
+		world.Query<const Transform, const Parent>().Changed<Parent>().ForEach(collect);
+		world.Query<const Transform, const Children>(Exclude<Parent>{}).Changed<Transform>().ForEach(
+			[&dirty](Entity root, const Transform&, const Children&)
+			{
+				dirty.push_back(root);
+			});
+		if (dirty.empty())
+			return;
+
+		// Only the topmost dirty entity of a branch is updated, and it updates everything below it
+		std::sort(dirty.begin(), dirty.end());
+		dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+		std::vector<Entity> tops;
+		for (Entity entity : dirty)
+		{
+			bool covered = false;
+			for (const Parent* parent = world.GetPtr<const Parent>(entity); parent != nullptr && !covered;
+				parent = world.GetPtr<const Parent>(parent->entity))
+				covered = std::binary_search(dirty.begin(), dirty.end(), parent->entity);
+			if (!covered)
+				tops.push_back(entity);
+		}
+
+		// No top is below another, so their branches are disjoint and each one can run on its own worker
+		world.GetJobSystem().ParallelFor(tops.size(), 8, [&world, &tops](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+					UpdateBranch(world, tops[i]);
+			});
+	}
+
+	void InterpolateTransformsSystem(World& world)
+	{
+		float alpha = world.GetResourse<Time>().InterpolationAlpha();
+		world.Query<const Transform, const InterpolatedTransform, WorldTransform>(Exclude<Parent, Children>{}).ParallelForEach(
+			[alpha](const Transform& transform, const InterpolatedTransform& interpolated, WorldTransform& worldTransform)
+			{
+				if (!interpolated.saved)
+					return;
+				Transform blended(
+					glm::mix(interpolated.previousPosition, transform.position, alpha),
+					glm::slerp(interpolated.previousRotation, transform.rotation, alpha),
+					glm::mix(interpolated.previousScale, transform.scale, alpha));
+				worldTransform.matrix = blended.asMat4();
+			});
+	}
+}
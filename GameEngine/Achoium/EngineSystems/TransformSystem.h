@@ -0,0 +1,34 @@
+#pragma once
+#include "Core/World.hpp"
+#include "EngineComponents/Hierarchy.h"
+namespace ac
+{
+	/**
+	 * @brief Computes the WorldTransform of every entity with a Transform.
+	 *
+	 * Entities outside any hierarchy are only recomputed when their Transform
+	 * changed. In hierarchies, the entities whose Transform or Parent changed
+	 * are found through the Changed filters; the topmost of each branch is
+	 * recomputed from its parent's WorldTransform together with everything
+	 * below it, one branch per job. Clean branches are not visited at all.
+	 * Entities that got a Transform
+	 * since the last run receive their WorldTransform here, so the system
+	 * must run exclusively, after the systems that move entities and before
+	 * the ones that render them.
+	 *
+	 * @param world The world to update.
+	 */
+	void TransformPropagationSystem(World& world);
+
+	/**
+	 * @brief Draws entities with an InterpolatedTransform between their last two fixed steps.
+	 *
+	 * Overwrites the WorldTransform of those entities outside any hierarchy
+	 * with their previous and current Transform blended by
+	 * Time::InterpolationAlpha, so it must run after TransformPropagationSystem
+	 * and before the systems that render.
+	 *
+	 * @param world The world to update.
+	 */
+	void InterpolateTransformsSystem(World& world);
+}
@@ -7,26 +7,22 @@
 #include <unordered_map>
 #include <memory>
 #include "AllowToken.h"
+#include "Core/TypeID.hpp"
+#include "Log/Log.h"
 
 
 #ifndef EVENT_ASSERT
 #define EVENT_ASSERT(condition, msg) \
 		if (!(condition)) { \
-			std::cerr << "[EVENT error]: " << msg << std::endl; \
-			::abort(); \
+			AC_LOG_FATAL(::ac::LogCategory::Event, msg); \
 		}
 #endif
-//#define EVENT_INFO_ENABLED
+// Per-invocation trace, compiled out unless AC_LOG_LEVEL is AC_LOG_LEVEL_TRACE.
 #ifndef EVENT_INFO
-#ifdef EVENT_INFO_ENABLED
-#define EVENT_INFO(msg) std::cout << "[EVENT info]: " << msg << "\n";
-#else
-#define EVENT_INFO(msg);
-#endif
-
+#define EVENT_INFO(msg) AC_LOG_TRACE(::ac::LogCategory::Event, msg)
 #endif
 #ifndef EVENT_MSG
-#define EVENT_MSG(msg) std::cout << "[ECS]: " << msg << "\n";
+#define EVENT_MSG(msg) AC_LOG_WARNING(::ac::LogCategory::Event, msg)
 #endif
 
 namespace ac
@@ -79,6 +75,14 @@ namespace ac
 			eventListeners.erase(func.target_type().hash_code());
 		}
 
+		/**
+		 * @brief Returns the number of registered listeners.
+		 */
+		size_t ListenerCount() const
+		{
+			return eventListeners.size();
+		}
+
 		/**
 		 * @brief Triggers the event, calling all registered listeners.
 		 * 
@@ -114,16 +118,18 @@ namespace ac
 		template <class T>
 		EventManager& RegisterEvent()
 		{
-			EVENT_ASSERT(eventPools.size() < MAX_EVENT, "Event amount exceed max event count");
-			auto it = eventID.find(typeid(T));
-			if (it != eventID.end())
+			EVENT_ASSERT(eventCount < MAX_EVENT, "Event amount exceed max event count");
+			size_t typeID = TypeID<EventFamily>::Get<T>();
+			if (typeID >= eventPools.size())
+				eventPools.resize(typeID + 1);
+			if (eventPools[typeID] != nullptr)
 			{
 				EVENT_MSG("WARNING try to register event already registered " << typeid(T).name());
 				return *this;
 			}
 
-			eventID[typeid(T)] = eventPools.size();
-			eventPools.push_back(std::make_unique<EventPool<T>>());
+			eventPools[typeID] = std::make_unique<EventPool<T>>();
+			++eventCount;
 			EVENT_INFO("Registerd event: " << typeid(T).name());
 			return *this;
 		}
@@ -138,8 +144,7 @@ namespace ac
 		template <class T>
 		EventManager& AddListener(std::function<bool(const T&)> func)
 		{
-			auto it = eventID.find(typeid(T));
-			if (it == eventID.end())
+			if (!Contain<T>())
 				RegisterEvent<T>();
 			EventPool<T>* pool = GetPool<T>();
 			pool->AddListener(func);
@@ -157,8 +162,7 @@ namespace ac
 		template<class T>
 		EventManager& Invoke(const T& event, AllowToken<T> t)
 		{
-			auto it = eventID.find(typeid(T));
-			if(it == eventID.end())
+			if (!Contain<T>())
 				RegisterEvent<T>();
 			EventPool<T>* pool = GetPool<T>();
 			pool->Invoke(event);
@@ -166,6 +170,20 @@ namespace ac
 			return *this;
 		}
 
+		/**
+		 * @brief Checks if an event type has any listener.
+		 * 
+		 * Lets senders skip building events nobody receives.
+		 * 
+		 * @tparam T The event type to check
+		 * @return true If at least one listener is registered for T
+		 */
+		template <class T>
+		bool HasListeners()
+		{
+			return Contain<T>() && GetPool<T>()->ListenerCount() != 0;
+		}
+
 		/**
 		 * @brief Checks if an event type is registered in the system.
 		 * 
@@ -176,8 +194,8 @@ namespace ac
 		template <class T>
 		bool Contain()
 		{
-			auto it = eventID.find(typeid(T));
-			return it != eventID.end();
+			size_t typeID = TypeID<EventFamily>::Get<T>();
+			return typeID < eventPools.size() && eventPools[typeID] != nullptr;
 		}
 	private:
 		/**
@@ -189,15 +207,13 @@ namespace ac
 		template <class T>
 		EventPool<T>* GetPool()
 		{
-			auto it = eventID.find(typeid(T));
-			EVENT_ASSERT(it != eventID.end(), "Try to use an unregisterd event");
-			size_t ind = it->second;
-			return static_cast<EventPool<T>*>(eventPools[ind].get());
+			EVENT_ASSERT(Contain<T>(), "Try to use an unregisterd event");
+			return static_cast<EventPool<T>*>(eventPools[TypeID<EventFamily>::Get<T>()].get());
 		}
 		const size_t MAX_EVENT = UINT64_MAX; ///< Maximum number of event types that can be registered
 
-		std::unordered_map<std::type_index, size_t> eventID; ///< Maps event types to their pool index
-		std::vector<std::unique_ptr<IEventPool>> eventPools; ///< Stores all event pools
+		size_t eventCount = 0; ///< Number of registered event types
+		std::vector<std::unique_ptr<IEventPool>> eventPools; ///< Stores all event pools, indexed by TypeID<EventFamily>; nullptr if not registered
 	};
 }
 
@@ -17,7 +17,9 @@
 #include "EngineSystems/AudioSystem.h"
 #include "EngineComponents/Physics/Physics.h"
 #include "EngineComponents/Tilemap.h"
+#include "EngineComponents/Hierarchy.h"
 #include "EngineSystems/TimeSystem.h"
+#include "EngineSystems/TransformSystem.h"
 #include "EngineSystems/RenderTextSystems.h"
 #include "EngineComponents/TextComponent.h"
 #include "Global.h"
@@ -33,6 +35,10 @@ namespace ac
 		CURPATH = filesystem::current_path().string();
 		world.RegisterType<Sprite>();
 		world.RegisterType<Transform>();
+		world.RegisterType<Parent>();
+		world.RegisterType<Children>();
+		world.RegisterType<WorldTransform>();
+		world.RegisterType<InterpolatedTransform>();
 		world.RegisterType<Collider>();
 		world.RegisterType<RigidBody>();
 		world.RegisterType<SphereCollider>();
@@ -56,6 +62,11 @@ namespace ac
 		world.AddResource<TextureManager>(new TextureManager());
 		world.AddResource<ModelManager>(new ModelManager());
 		world.AddResource<CollisionLayer>(new CollisionLayer());
+		world.AddResource<Broadphase2D>(new Broadphase2D());
+		world.AddResource<ContactSolver2D>(new ContactSolver2D());
+		world.AddResource<SpatialHashGrid3D>(new SpatialHashGrid3D());
+		world.AddResource<PhysicsSleep>(new PhysicsSleep());
+		world.AddResource<PhysicsIntegrationCache>(new PhysicsIntegrationCache());
 		world.AddResource<InputManager>(new InputManager());
 		// ƵԴ
 		world.AddResource<AudioManager>(new AudioManager());
@@ -71,22 +82,35 @@ namespace ac
 			.AddListener<OnDeleted<Sprite>>(OnSpriteDelete)
 			.AddListener<OnAdded<AudioSource>>(OnAudioSourceAdded)
 			.AddListener<OnDeleted<AudioSource>>(OnAudioSourceDeleted);
+		PhysicsSystem::AddSleepListeners(world);
 
 		world.AddPreUpdateSystem(UpdateTimeSystem, 0);
 		world.AddPreUpdateSystem(InputManagerSystem::UpdateInput, 1); // Update input before other systems
 
 		// Register physics systems
-		world.AddUpdateSystem(PhysicsSystem::PhysicsStep, 1); // Run physics step early in update
-		world.AddUpdateSystem(PhysicsSystem::CollisionSystem, 2); // Run collision detection after physics update
+		// Physics advances by Time::FixedDelta, as many steps per frame as UpdateTimeSystem found due
+		world.AddFixedUpdateSystem(PhysicsSystem::SaveInterpolationState, 0); // Adds missing InterpolatedTransforms, so it runs exclusively
+		world.AddFixedUpdateSystem(PhysicsSystem::PhysicsStep, 1,
+			SystemAccess().Write<RigidBody, Transform>().ReadResource<Time>().WriteResource<PhysicsIntegrationCache>());
+		world.AddFixedUpdateSystem(PhysicsSystem::CollisionSystem, 2); // Run collision detection after physics update
+		world.AddFixedUpdateSystem(PhysicsSystem::Physics2DStep, 1,
+			SystemAccess().Write<RigidBody2D, Transform>().ReadResource<Time>().WriteResource<PhysicsIntegrationCache>());
+		world.AddFixedUpdateSystem(PhysicsSystem::Collision2DSystem, 2); // Run collision detection after physics update
 		// עƵϵͳ
-		world.AddPostUpdateSystem(AudioSystem::UpdateAudio, 0); // ϵͳ֮Ƶ
-		world.AddPostUpdateSystem(SyncCamera, 0); // Sync camera after audio update
+		world.AddPostUpdateSystem(AudioSystem::UpdateAudio, 0,
+			SystemAccess().Write<AudioSource>().Read<AudioListener, Transform>().WriteResource<AudioManager>()); // ϵͳ֮Ƶ
+		world.AddPostUpdateSystem(SyncCamera, 0,
+			SystemAccess().Read<Camera, Transform>().WriteResource<OpenGLRenderer>().MainThread()); // Sync camera after audio update
 		
-		world.AddPostUpdateSystem(PhysicsSystem::Physics2DStep, 1);
-		world.AddPostUpdateSystem(PhysicsSystem::Collision2DSystem, 2); // Run collision detection after physics update
-		world.AddPostUpdateSystem(RenderSprite, 9);
-		world.AddPostUpdateSystem(RenderTilemap, 9);
-		world.AddPostUpdateSystem(RenderTextSystem, 9);
+		world.AddPostUpdateSystem(TransformPropagationSystem, 8); // Adds missing WorldTransforms, so it runs exclusively before rendering
+		world.AddPostUpdateSystem(InterpolateTransformsSystem, 8,
+			SystemAccess().Read<Transform, InterpolatedTransform>().Write<WorldTransform>().ReadResource<Time>()); // Draws bodies between fixed steps
+		world.AddPostUpdateSystem(RenderSprite, 9,
+			SystemAccess().Read<Sprite, WorldTransform>().WriteResource<OpenGLRenderer, TextureManager, ModelManager>().MainThread());
+		world.AddPostUpdateSystem(RenderTilemap, 9,
+			SystemAccess().Read<TilemapElement, Tilemap, Sprite, WorldTransform>().WriteResource<OpenGLRenderer, TextureManager, ModelManager>().MainThread());
+		world.AddPostUpdateSystem(RenderTextSystem, 9,
+			SystemAccess().Read<Transform, Text>().WriteResource<OpenGLRenderer>().MainThread());
 		
 
 		
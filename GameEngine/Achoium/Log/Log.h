@@ -0,0 +1,430 @@
+#ifndef LOG_H
+#define LOG_H
+#include <atomic>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+/*
+ * Compile-time log level. Messages below it are removed by the preprocessor,
+ * including the evaluation of their arguments. Define AC_LOG_LEVEL in the
+ * project settings to change it, e.g. AC_LOG_LEVEL=0 for a diagnostic build
+ * that keeps the per-entity ECS trace.
+ */
+#define AC_LOG_LEVEL_TRACE 0
+#define AC_LOG_LEVEL_INFO 1
+#define AC_LOG_LEVEL_WARNING 2
+#define AC_LOG_LEVEL_ERROR 3
+#define AC_LOG_LEVEL_NONE 4
+
+#ifndef AC_LOG_LEVEL
+#define AC_LOG_LEVEL AC_LOG_LEVEL_INFO
+#endif
+
+namespace ac
+{
+	/**
+	 * @brief Severity of a log message, matching the AC_LOG_LEVEL_* values.
+	 */
+	enum class LogLevel : uint8_t
+	{
+		Trace = AC_LOG_LEVEL_TRACE,
+		Info = AC_LOG_LEVEL_INFO,
+		Warning = AC_LOG_LEVEL_WARNING,
+		Error = AC_LOG_LEVEL_ERROR,
+	};
+
+	/**
+	 * @brief Subsystem a log message belongs to; each can be switched on and off at runtime.
+	 */
+	enum class LogCategory : uint8_t
+	{
+		General,
+		ECS,
+		Event,
+		Physics,
+		Render,
+		Audio,
+		Count
+	};
+
+	/**
+	 * @brief Bounded lock-free multi-producer multi-consumer queue.
+	 *
+	 * Every cell carries a sequence number telling producers and consumers
+	 * whose turn it is, so neither side ever takes a lock. Pushing into a
+	 * full queue fails instead of blocking.
+	 *
+	 * @tparam T Element type, copied in and out.
+	 * @tparam Capacity Number of cells, must be a power of two.
+	 */
+	template <class T, size_t Capacity>
+	class LogRingBuffer
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "LogRingBuffer capacity must be a power of two");
+	public:
+		LogRingBuffer()
+		{
+			for (size_t i = 0; i < Capacity; ++i)
+				cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Claims a cell and fills it with writer(T&).
+		 *
+		 * @return False if the queue is full.
+		 */
+		template <class Writer>
+		bool TryPush(Writer&& writer)
+		{
+			size_t pos = enqueuePos.load(std::memory_order_relaxed);
+			Cell* cell;
+			while (true)
+			{
+				cell = &cells[pos & (Capacity - 1)];
+				size_t sequence = cell->sequence.load(std::memory_order_acquire);
+				intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+				if (diff == 0)
+				{
+					if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (diff < 0)
+					return false;
+				else
+					pos = enqueuePos.load(std::memory_order_relaxed);
+			}
+			writer(cell->value);
+			cell->sequence.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief Takes the oldest element.
+		 *
+		 * @return False if the queue is empty.
+		 */
+		bool TryPop(T& out)
+		{
+			size_t pos = dequeuePos.load(std::memory_order_relaxed);
+			Cell* cell;
+			while (true)
+			{
+				cell = &cells[pos & (Capacity - 1)];
+				size_t sequence = cell->sequence.load(std::memory_order_acquire);
+				intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+				if (diff == 0)
+				{
+					if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (diff < 0)
+					return false;
+				else
+					pos = dequeuePos.load(std::memory_order_relaxed);
+			}
+			out = cell->value;
+			cell->sequence.store(pos + Capacity, std::memory_order_release);
+			return true;
+		}
+
+	private:
+		struct Cell
+		{
+			std::atomic<size_t> sequence;
+			T value;
+		};
+
+		std::array<Cell, Capacity> cells;
+		alignas(64) std::atomic<size_t> enqueuePos{ 0 };
+		alignas(64) std::atomic<size_t> dequeuePos{ 0 };
+	};
+
+	/**
+	 * @brief Process-wide asynchronous logger.
+	 *
+	 * Producers format the message on their own thread and copy it into a
+	 * lock-free ring buffer; a background thread writes the buffer to stdout.
+	 * Logging therefore never flushes or locks on the calling thread. When the
+	 * buffer is full, messages are dropped and counted rather than stalling the
+	 * caller. Fatal messages bypass the buffer and are written synchronously
+	 * after everything queued before them.
+	 *
+	 * Use the AC_LOG_* macros rather than calling the logger directly so that
+	 * disabled levels are compiled out.
+	 *
+	 * Usage example:
+	 *   AC_LOG_TRACE(LogCategory::Physics, "Contact " << a << " " << b);
+	 *   Logger::Get().SetCategoryEnabled(LogCategory::Physics, false);
+	 */
+	class Logger
+	{
+	public:
+		/** Longest message kept, longer ones are truncated. */
+		static constexpr size_t MaxMessageLength = 240;
+
+		/**
+		 * @brief Returns the logger, starting its writer thread on first use.
+		 *
+		 * The instance is intentionally never destroyed so that code running
+		 * during static destruction can still log; queued messages are written
+		 * by an atexit handler.
+		 */
+		static Logger& Get()
+		{
+			static Logger* instance = new Logger();
+			return *instance;
+		}
+
+		/**
+		 * @brief Checks the runtime filters for a message.
+		 */
+		bool ShouldLog(LogLevel level, LogCategory category) const
+		{
+			return level >= minLevel.load(std::memory_order_relaxed) &&
+				(enabledCategories.load(std::memory_order_relaxed) & CategoryBit(category)) != 0;
+		}
+
+		/**
+		 * @brief Sets the lowest level written at runtime; levels removed at compile time stay removed.
+		 */
+		void SetLevel(LogLevel level)
+		{
+			minLevel.store(level, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Enables or disables all messages of a category.
+		 */
+		void SetCategoryEnabled(LogCategory category, bool enabled)
+		{
+			if (enabled)
+				enabledCategories.fetch_or(CategoryBit(category), std::memory_order_relaxed);
+			else
+				enabledCategories.fetch_and(~CategoryBit(category), std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Returns a cleared per-thread stream to format a message into.
+		 */
+		static std::ostringstream& Stream()
+		{
+			thread_local std::ostringstream stream;
+			stream.str(std::string());
+			stream.clear();
+			return stream;
+		}
+
+		/**
+		 * @brief Queues a formatted message for the writer thread.
+		 *
+		 * @param level The message level.
+		 * @param category The message category.
+		 * @param message The formatted text.
+		 */
+		void Submit(LogLevel level, LogCategory category, std::string_view message)
+		{
+			bool pushed = queue.TryPush([&](Entry& entry)
+				{
+					entry.level = level;
+					entry.category = category;
+					entry.length = static_cast<uint16_t>(std::min(message.size(), MaxMessageLength));
+					std::memcpy(entry.text, message.data(), entry.length);
+				});
+			if (!pushed)
+				droppedCount.fetch_add(1, std::memory_order_relaxed);
+			// Nobody drains the buffer once the writer has stopped at exit.
+			if (stopping.load(std::memory_order_acquire))
+				Flush();
+		}
+
+		/**
+		 * @brief Writes a message synchronously after everything queued so far, e.g. right before abort().
+		 */
+		void WriteFatal(LogCategory category, std::string_view message)
+		{
+			Flush();
+			std::lock_guard<std::mutex> lock(writeMutex);
+			WritePrefix(std::cout, LogLevel::Error, category);
+			std::cout << message << std::endl;
+		}
+
+		/**
+		 * @brief Writes every queued message on the calling thread.
+		 */
+		void Flush()
+		{
+			std::lock_guard<std::mutex> lock(writeMutex);
+			Drain();
+			std::cout.flush();
+		}
+
+		/**
+		 * @brief Returns the number of messages dropped because the buffer was full.
+		 */
+		size_t DroppedCount() const
+		{
+			return droppedCount.load(std::memory_order_relaxed);
+		}
+
+	private:
+		struct Entry
+		{
+			LogLevel level;
+			LogCategory category;
+			uint16_t length;
+			char text[MaxMessageLength];
+		};
+
+		Logger()
+		{
+			writer = std::thread([this]() { WriterLoop(); });
+			std::atexit([]() { Get().Stop(); });
+		}
+
+		static uint32_t CategoryBit(LogCategory category)
+		{
+			return 1u << static_cast<uint32_t>(category);
+		}
+
+		static void WritePrefix(std::ostream& out, LogLevel level, LogCategory category)
+		{
+			static constexpr const char* categoryNames[] = { "AC", "ECS", "EVENT", "Physics", "Render", "Audio" };
+			static constexpr const char* levelNames[] = { "trace", "msg", "Warning", "ERROR!!!" };
+			out << '[' << categoryNames[static_cast<size_t>(category)] << ' ' << levelNames[static_cast<size_t>(level)] << "]: ";
+		}
+
+		/**
+		 * @brief Writes queued messages; the caller holds writeMutex.
+		 *
+		 * @return True if anything was written.
+		 */
+		bool Drain()
+		{
+			bool wrote = false;
+			while (queue.TryPop(scratch))
+			{
+				WritePrefix(std::cout, scratch.level, scratch.category);
+				std::cout.write(scratch.text, scratch.length);
+				std::cout.put('\n');
+				wrote = true;
+			}
+			size_t dropped = droppedCount.exchange(0, std::memory_order_relaxed);
+			if (dropped != 0)
+			{
+				WritePrefix(std::cout, LogLevel::Warning, LogCategory::General);
+				std::cout << dropped << " log messages dropped, log buffer full\n";
+			}
+			return wrote;
+		}
+
+		void WriterLoop()
+		{
+			while (true)
+			{
+				bool wrote;
+				{
+					std::lock_guard<std::mutex> lock(writeMutex);
+					wrote = Drain();
+					if (wrote)
+						std::cout.flush();
+				}
+				if (wrote)
+					continue;
+				// Producers never notify, so poll at a short interval while idle.
+				std::unique_lock<std::mutex> lock(stopMutex);
+				if (stopCondition.wait_for(lock, std::chrono::milliseconds(2), [this]() { return stopping.load(); }))
+					return;
+			}
+		}
+
+		/**
+		 * @brief Stops the writer thread and writes what is left; runs at exit.
+		 */
+		void Stop()
+		{
+			{
+				std::lock_guard<std::mutex> lock(stopMutex);
+				stopping = true;
+			}
+			stopCondition.notify_all();
+			if (writer.joinable())
+				writer.join();
+			Flush();
+		}
+
+		LogRingBuffer<Entry, 4096> queue;
+		std::atomic<size_t> droppedCount{ 0 };
+		std::atomic<LogLevel> minLevel{ LogLevel::Trace };
+		std::atomic<uint32_t> enabledCategories{ UINT32_MAX };
+
+		/** Serializes writers of std::cout: the background thread, Flush and WriteFatal. */
+		std::mutex writeMutex;
+
+		/** Entry popped by Drain, kept as a member to stay off the writer's stack. */
+		Entry scratch;
+
+		std::thread writer;
+		std::mutex stopMutex;
+		std::condition_variable stopCondition;
+		std::atomic<bool> stopping{ false };
+	};
+}
+
+/**
+ * @brief Logs a message built with operator<<, if it passes the runtime filters.
+ */
+#define AC_LOG(level, category, msg) \
+	do { \
+		if (::ac::Logger::Get().ShouldLog(level, category)) { \
+			std::ostringstream& acLogStream = ::ac::Logger::Stream(); \
+			acLogStream << msg; \
+			::ac::Logger::Get().Submit(level, category, acLogStream.view()); \
+		} \
+	} while (0)
+
+#if AC_LOG_LEVEL <= AC_LOG_LEVEL_TRACE
+#define AC_LOG_TRACE(category, msg) AC_LOG(::ac::LogLevel::Trace, category, msg)
+#else
+#define AC_LOG_TRACE(category, msg) ((void)0)
+#endif
+
+#if AC_LOG_LEVEL <= AC_LOG_LEVEL_INFO
+#define AC_LOG_INFO(category, msg) AC_LOG(::ac::LogLevel::Info, category, msg)
+#else
+#define AC_LOG_INFO(category, msg) ((void)0)
+#endif
+
+#if AC_LOG_LEVEL <= AC_LOG_LEVEL_WARNING
+#define AC_LOG_WARNING(category, msg) AC_LOG(::ac::LogLevel::Warning, category, msg)
+#else
+#define AC_LOG_WARNING(category, msg) ((void)0)
+#endif
+
+#if AC_LOG_LEVEL <= AC_LOG_LEVEL_ERROR
+#define AC_LOG_ERROR(category, msg) AC_LOG(::ac::LogLevel::Error, category, msg)
+#else
+#define AC_LOG_ERROR(category, msg) ((void)0)
+#endif
+
+/**
+ * @brief Writes a message synchronously regardless of level and filters, then aborts.
+ */
+#define AC_LOG_FATAL(category, msg) \
+	do { \
+		std::ostringstream& acLogStream = ::ac::Logger::Stream(); \
+		acLogStream << msg; \
+		::ac::Logger::Get().WriteFatal(category, acLogStream.view()); \
+		::abort(); \
+	} while (0)
+
+#endif // !LOG_H
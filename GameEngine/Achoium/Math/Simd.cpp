@@ -0,0 +1,50 @@
+#include "acpch.h"
+#include "Simd.h"
+#if defined(AC_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+namespace ac
+{
+	SimdLevel DetectSimdLevel()
+	{
+#if defined(AC_SIMD_X86) && defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		int maxLeaf = info[0];
+		__cpuid(info, 1);
+		bool osSavesAvx = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+		if (maxLeaf >= 7 && osSavesAvx && avx && (_xgetbv(0) & 0x6) == 0x6)
+		{
+			__cpuidex(info, 7, 0);
+			if (info[1] & (1 << 5))
+				return SimdLevel::AVX2;
+		}
+		return SimdLevel::SSE2;
+#elif defined(AC_SIMD_X86)
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#else
+		return SimdLevel::Scalar;
+#endif
+	}
+
+	SimdLevel GetSimdLevel()
+	{
+		static const SimdLevel level = DetectSimdLevel();
+		return level;
+	}
+
+	const char* ToString(SimdLevel level)
+	{
+		switch (level)
+		{
+		case SimdLevel::AVX2:
+			return "AVX2";
+		case SimdLevel::SSE2:
+			return "SSE2";
+		default:
+			return "Scalar";
+		}
+	}
+}
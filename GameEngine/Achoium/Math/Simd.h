@@ -0,0 +1,44 @@
+#pragma once
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define AC_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// Functions using AVX2 intrinsics are marked with AC_TARGET_AVX2 and only called after
+// GetSimdLevel() reported AVX2. MSVC accepts the intrinsics anywhere; GCC and Clang need
+// the target attribute since the rest of the engine is built for the baseline instruction set.
+#if defined(AC_SIMD_X86) && !defined(_MSC_VER)
+#define AC_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define AC_TARGET_AVX2
+#endif
+
+namespace ac
+{
+	/**
+	 * @brief Instruction sets the batch math kernels can use, from slowest to fastest.
+	 */
+	enum class SimdLevel
+	{
+		Scalar, ///< Plain C++, available everywhere
+		SSE2,   ///< 4 floats per instruction, always available on x64
+		AVX2    ///< 8 floats per instruction
+	};
+
+	/**
+	 * @brief Queries the CPU for the best instruction set the kernels support.
+	 *
+	 * @return AVX2 if the CPU and OS support it, SSE2 on other x86 CPUs, Scalar elsewhere.
+	 */
+	SimdLevel DetectSimdLevel();
+
+	/**
+	 * @brief Returns the result of DetectSimdLevel, detected once on first use.
+	 */
+	SimdLevel GetSimdLevel();
+
+	/**
+	 * @brief Returns a printable name of an instruction set.
+	 */
+	const char* ToString(SimdLevel level);
+}
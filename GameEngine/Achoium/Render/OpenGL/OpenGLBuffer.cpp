@@ -35,7 +35,7 @@ namespace ac
    /// Deletes the vertex buffer and releases its resources.  
    OpenGLVertexBuffer::~OpenGLVertexBuffer()  
    {  
-       ACMSG("VBO: " << m_RendererID << " Deleted");  
+       AC_LOG_TRACE(LogCategory::Render, "VBO: " << m_RendererID << " Deleted");  
        glDeleteBuffers(1, &m_RendererID);  
        delete vertices.release();  
    }  
@@ -57,11 +57,11 @@ namespace ac
    {  
        if (m_RendererID != 0)  
        {  
-           ACMSG("VBO: " << m_RendererID << " Already Uploaded");  
+           AC_LOG_TRACE(LogCategory::Render, "VBO: " << m_RendererID << " Already Uploaded");  
            return;  
 	   }
        glGenBuffers(1, &m_RendererID);  
-       ACMSG("VBO: " << m_RendererID << " Created");  
+       AC_LOG_TRACE(LogCategory::Render, "VBO: " << m_RendererID << " Created");  
        glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);  
        glBufferData(GL_ARRAY_BUFFER, size, vertices.get(), GL_STATIC_DRAW);  
    }  
@@ -121,11 +121,11 @@ namespace ac
    {  
        if (m_RendererID != 0)  
        {  
-           ACMSG("EBO: " << m_RendererID << " Already Uploaded");  
+           AC_LOG_TRACE(LogCategory::Render, "EBO: " << m_RendererID << " Already Uploaded");  
            return;  
 	   }
        glCreateBuffers(1, &m_RendererID);  
-       ACMSG("EBO: " << m_RendererID << " Created");  
+       AC_LOG_TRACE(LogCategory::Render, "EBO: " << m_RendererID << " Created");  
        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);  
        glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_Count * sizeof(uint32_t), indicies.get(), GL_STATIC_DRAW);  
    }  
@@ -157,7 +157,7 @@ namespace ac
    /// Deletes the index buffer and releases its resources.  
    OpenGLIndexBuffer::~OpenGLIndexBuffer()  
    {  
-       ACMSG("EBO: " << m_RendererID << " Deleted");  
+       AC_LOG_TRACE(LogCategory::Render, "EBO: " << m_RendererID << " Deleted");  
        glDeleteBuffers(1, &m_RendererID);  
        delete indicies.release();  
    }  
@@ -65,7 +65,7 @@ namespace ac
 	ac::OpenGLTexture2D::~OpenGLTexture2D()
 	{
 
-		ACMSG("OpenGLTexture2D Delete with id: " << m_RenderID);
+		AC_LOG_TRACE(LogCategory::Render, "OpenGLTexture2D Delete with id: " << m_RenderID);
 		stbi_image_free(data);
 		glDeleteTextures(1, &m_RenderID);
 	}
@@ -74,7 +74,7 @@ namespace ac
 	{
 		if (m_RenderID != 0)
 		{
-			ACMSG("Texture: " << m_RenderID << " is already uploaded");
+			AC_LOG_TRACE(LogCategory::Render, "Texture: " << m_RenderID << " is already uploaded");
 			return;
 		}
 		glGenTextures(1, & m_RenderID);
@@ -117,7 +117,7 @@ namespace ac
 	void ac::OpenGLTexture2D::Bind(uint32_t slot) const
 	{
 		if(m_RenderID == 0)
-			ACMSG("Trying to bind a texture that is not uploaded!!!");
+			AC_LOG_WARNING(LogCategory::Render, "Trying to bind a texture that is not uploaded!!!");
 		glBindTextureUnit(slot, m_RenderID);
 	}
 }
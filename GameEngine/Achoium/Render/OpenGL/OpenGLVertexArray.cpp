@@ -41,7 +41,7 @@ namespace ac
    {  
        if (isUploaded)
        {
-		   ACMSG("VertexArray: " << m_RendererID << "already uploaded, skipping upload.");
+		   AC_LOG_TRACE(LogCategory::Render, "VertexArray: " << m_RendererID << "already uploaded, skipping upload.");
            return;
        }
        Bind();  
@@ -1,4 +1,9 @@
 #pragma once
 
 void BenchmarkEventSystem(int);
+void BenchmarkViewIteration(int);
+void BenchmarkEntitySpawn(int);
+void BenchmarkIntegration(int);
+void BenchmarkBroadphase(int);
+void BenchmarkParallelCollision2D(int);
 
@@ -0,0 +1,98 @@
+#include "acpch.h"
+#include "Benchmark.h"
+#include "Achoium.h"
+using namespace ac;
+
+template <class Func>
+static double MeasureMsPerFrame(int frames, Func&& func)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < frames; ++i)
+        func(i);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> duration = end - start;
+    return duration.count() / frames;
+}
+
+void BenchmarkBroadphase(int n) {
+    const BroadphaseMethod2D methods[] = { BroadphaseMethod2D::BruteForce, BroadphaseMethod2D::AABBTree, BroadphaseMethod2D::SweepAndPrune };
+    const char* names[] = { "BruteForce", "AABBTree", "SweepAndPrune" };
+    const int frames = 60;
+
+    for (int m = 0; m < 3; ++m) {
+        ac::World world;
+        world.RegisterType<Transform>();
+        world.RegisterType<CircleCollider2D>();
+        world.RegisterType<RectCollider2D>();
+        world.RegisterType<PolygonCollider2D>();
+        world.RegisterType<RigidBody2D>();
+        world.AddResource<CollisionLayer>(new CollisionLayer());
+        world.AddResource<Broadphase2D>(new Broadphase2D(methods[m]));
+        world.AddResource<ContactSolver2D>(new ContactSolver2D());
+        world.AddResource<PhysicsSleep>(new PhysicsSleep());
+
+        // Circles and boxes of 20 units spread so that each touches about one other
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> coordinate(0.0f, std::sqrt(static_cast<float>(n)) * 40.0f);
+        std::vector<Entity> entities;
+        for (int i = 0; i < n; ++i) {
+            Entity e = world.CreateEntity();
+            world.Add<Transform>(e, Transform(glm::vec3(coordinate(rng), coordinate(rng), 0.0f)));
+            if (i % 2 == 0)
+                world.Add<CircleCollider2D>(e, CircleCollider2D(10.0f));
+            else
+                world.Add<RectCollider2D>(e, RectCollider2D(20.0f, 20.0f));
+            entities.push_back(e);
+        }
+
+        // Drift every collider a little each frame, so proxies leave their fat AABBs now and then
+        double ms = MeasureMsPerFrame(frames, [&](int frame) {
+            for (size_t i = 0; i < entities.size(); ++i) {
+                float phase = static_cast<float>(i) + frame * 0.1f;
+                world.Get<Transform>(entities[i]).position += glm::vec3(std::cos(phase), std::sin(phase), 0.0f);
+            }
+            PhysicsSystem::Collision2DSystem(world);
+        });
+        ACMSG("Collision2DSystem " << names[m] << " (" << n << " colliders): " << ms << " ms/frame");
+    }
+
+    // The 3D spatial hash with the cell size picked from the colliders and with fixed ones
+    const float cellSizes[] = { 0.0f, 10.0f, 40.0f, 160.0f };
+    for (float cellSize : cellSizes) {
+        ac::World world;
+        world.RegisterType<Transform>();
+        world.RegisterType<BoxCollider>();
+        world.RegisterType<SphereCollider>();
+        world.RegisterType<RigidBody>();
+        world.AddResource<CollisionLayer>(new CollisionLayer());
+        world.AddResource<SpatialHashGrid3D>(new SpatialHashGrid3D(cellSize));
+        world.AddResource<PhysicsSleep>(new PhysicsSleep());
+        world.GetResourse<PhysicsSleep>().enabled = false; // The bodies are moved by hand and never gain speed
+
+        // Spheres and boxes of 20 units, a quarter of them static level geometry without a RigidBody
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> coordinate(0.0f, std::cbrt(static_cast<float>(n)) * 40.0f);
+        std::vector<Entity> entities;
+        for (int i = 0; i < n; ++i) {
+            Entity e = world.CreateEntity();
+            world.Add<Transform>(e, Transform(glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng))));
+            if (i % 2 == 0)
+                world.Add<SphereCollider>(e, SphereCollider(10.0f));
+            else
+                world.Add<BoxCollider>(e, BoxCollider(20.0f, 20.0f, 20.0f));
+            if (i % 4 != 0) {
+                world.Add<RigidBody>(e, RigidBody(1.0f));
+                entities.push_back(e);
+            }
+        }
+
+        double ms = MeasureMsPerFrame(frames, [&](int frame) {
+            for (size_t i = 0; i < entities.size(); ++i) {
+                float phase = static_cast<float>(i) + frame * 0.1f;
+                world.Get<Transform>(entities[i]).position += glm::vec3(std::cos(phase), std::sin(phase), std::cos(phase * 0.5f));
+            }
+            PhysicsSystem::CollisionSystem(world);
+        });
+        ACMSG("CollisionSystem cell size " << world.GetResourse<SpatialHashGrid3D>().GetCellSize() << " (" << n << " colliders): " << ms << " ms/frame");
+    }
+}
@@ -0,0 +1,68 @@
+#include "acpch.h"
+#include "Benchmark.h"
+#include "Achoium.h"
+#include "PhysicsTestWorld.h"
+using namespace ac;
+
+namespace
+{
+    const float BoxSize = 20.0f;
+    const int ColumnHeight = 4;
+
+    // Columns of boxes on one kinematic ground; every column is an island of its own
+    struct ColumnScene : PhysicsTestWorld
+    {
+        std::vector<Entity> boxes;
+
+        explicit ColumnScene(int n) : PhysicsTestWorld(BroadphaseMethod2D::SweepAndPrune)
+        {
+            world.GetResourse<PhysicsSleep>().enabled = false; // Keep every island awake for the whole run
+
+            int columns = (n + ColumnHeight - 1) / ColumnHeight;
+            float width = static_cast<float>(columns) * 2.0f * BoxSize;
+            AddStaticRect2D(glm::vec2(width * 0.5f, -BoxSize * 0.5f), width + BoxSize, BoxSize, 0.6f);
+
+            // Dropped from a little above their resting height, so the contacts have work to do
+            for (int i = 0; i < n; ++i) {
+                int column = i / ColumnHeight;
+                int level = i % ColumnHeight;
+                boxes.push_back(AddBox2D(glm::vec2(column * 2.0f * BoxSize + BoxSize, BoxSize * (level + 0.6f)), BoxSize, 0.5f));
+            }
+        }
+    };
+}
+
+void BenchmarkParallelCollision2D(int n) {
+    const int frames = 60;
+    const float dt = 1.0f / 60.0f;
+    // Set from the first scene's job system: its workers, plus the calling thread that helps them
+    size_t threadCount = 1;
+
+    // Same scene and steps on 1..all threads; the positions must not depend on the thread count
+    std::vector<glm::vec3> serialPositions;
+    double serialMs = 0.0;
+    for (size_t threads = 1; threads <= threadCount; ++threads) {
+        ColumnScene scene(n);
+        if (threads == 1)
+            threadCount = scene.world.GetJobSystem().MaxWorkerIndex() + 1;
+        scene.world.GetResourse<ContactSolver2D>().maxThreads = static_cast<uint32_t>(threads);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < frames; ++frame)
+            scene.Step2D(dt, GetSimdLevel());
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> duration = end - start;
+        double ms = duration.count() / frames;
+
+        std::vector<glm::vec3> positions;
+        for (Entity box : scene.boxes)
+            positions.push_back(scene.world.Get<Transform>(box).position);
+        if (threads == 1) {
+            serialPositions = positions;
+            serialMs = ms;
+        }
+        ACASSERT(positions == serialPositions, "BenchmarkParallelCollision2D: positions on " << threads << " threads differ from 1 thread");
+
+        ACMSG("Collision2DSystem on " << threads << " thread(s) (" << n << " boxes): " << ms << " ms/frame, x" << serialMs / ms);
+    }
+}
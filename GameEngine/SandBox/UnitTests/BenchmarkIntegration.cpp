@@ -0,0 +1,89 @@
+#include "acpch.h"
+#include "Benchmark.h"
+#include "Achoium.h"
+using namespace ac;
+
+template <class Func>
+static double MeasureNsPerEntity(int n, int iterations, Func&& func)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        func();
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::nano> duration = end - start;
+    return duration.count() / (static_cast<double>(n) * iterations);
+}
+
+void BenchmarkIntegration(int n) {
+    ac::World world;
+    world.RegisterType<Transform>();
+    world.RegisterType<RigidBody>();
+    world.RegisterType<RigidBody2D>();
+    world.AddResource<PhysicsIntegrationCache>(new PhysicsIntegrationCache());
+    // Dynamic bodies falling under gravity and tumbling at different rates
+    for (int i = 0; i < n; ++i) {
+        Entity e = world.CreateEntity();
+        world.Add<Transform>(e, Transform(glm::vec3(static_cast<float>(i), 0, 0)));
+        RigidBody2D body2D(1.0f + i % 3);
+        body2D.isKinematic = false;
+        body2D.angularVelocity = 0.5f + (i % 7) * 0.25f;
+        world.Add<RigidBody2D>(e, std::move(body2D));
+        RigidBody body(1.0f + i % 3);
+        body.isKinematic = false;
+        body.angularVelocity = glm::vec3(1.5f, 0.75f, 1.5f * (i % 3));
+        world.Add<RigidBody>(e, std::move(body));
+    }
+    const int iterations = 100;
+    const float dt = 1.0f / 60.0f;
+    const glm::vec3 gravity(0.0f, -98.1f, 0.0f);
+
+    // The serial per-body loops the physics steps ran before the batch kernels
+    double perBody2DNs = MeasureNsPerEntity(n, iterations, [&]() {
+        world.View<RigidBody2D, Transform>().ForEach([&](Entity entity, RigidBody2DRef rb, Transform& transform) {
+            if (rb.isKinematic)
+                return;
+            if (rb.useGravity)
+                rb.force += glm::vec2(gravity.x, gravity.y) * rb.mass;
+            rb.velocity += rb.force * rb.inverseMass * dt;
+            if (!rb.freezeRotation)
+                rb.angularVelocity += rb.torque * rb.inverseMass * dt;
+            transform.position.x += rb.velocity.x * dt;
+            transform.position.y += rb.velocity.y * dt;
+            if (!rb.freezeRotation && std::abs(rb.angularVelocity) > 0.0001f)
+                transform.RotateZ(glm::degrees(rb.angularVelocity * dt));
+            rb.force = glm::vec2(0.0f);
+            rb.torque = 0.0f;
+        });
+    });
+    AC_LOG_INFO(LogCategory::Physics, "Integrate 2D per-body: " << perBody2DNs << " ns/body");
+
+    double perBody3DNs = MeasureNsPerEntity(n, iterations, [&]() {
+        world.View<RigidBody, Transform>().ForEach([&](Entity entity, RigidBodyRef rb, Transform& transform) {
+            if (rb.isKinematic)
+                return;
+            if (rb.useGravity)
+                rb.force += gravity * rb.mass;
+            rb.velocity += rb.force * rb.inverseMass * dt;
+            if (!rb.freezeRotation)
+                rb.angularVelocity += rb.torque * rb.inverseMass * dt;
+            transform.position += rb.velocity * dt;
+            if (!rb.freezeRotation && glm::length(rb.angularVelocity) > 0.0001f)
+                transform.RotateAxis(glm::normalize(rb.angularVelocity), glm::degrees(glm::length(rb.angularVelocity) * dt));
+            rb.force = glm::vec3(0.0f);
+            rb.torque = glm::vec3(0.0f);
+        });
+    });
+    AC_LOG_INFO(LogCategory::Physics, "Integrate 3D per-body: " << perBody3DNs << " ns/body");
+
+    for (int level = 0; level <= static_cast<int>(GetSimdLevel()); ++level) {
+        SimdLevel simd = static_cast<SimdLevel>(level);
+        double batch2DNs = MeasureNsPerEntity(n, iterations, [&]() {
+            PhysicsSystem::Integrate2D(world, dt, simd);
+        });
+        double batch3DNs = MeasureNsPerEntity(n, iterations, [&]() {
+            PhysicsSystem::Integrate3D(world, dt, simd);
+        });
+        AC_LOG_INFO(LogCategory::Physics, "Integrate 2D " << ToString(simd) << ": " << batch2DNs << " ns/body (" << perBody2DNs / batch2DNs << "x)");
+        AC_LOG_INFO(LogCategory::Physics, "Integrate 3D " << ToString(simd) << ": " << batch3DNs << " ns/body (" << perBody3DNs / batch3DNs << "x)");
+    }
+}
@@ -0,0 +1,47 @@
+#include "acpch.h"
+#include "Benchmark.h"
+#include "Achoium.h"
+using namespace ac;
+struct BenchmarkSpawnPosition {
+    float x, y;
+};
+struct BenchmarkSpawnHealth {
+    int value;
+};
+
+template <class Func>
+static double MeasureMs(Func&& func)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> duration = end - start;
+    return duration.count();
+}
+
+void BenchmarkEntitySpawn(int n) {
+    {
+        ac::World world;
+        double ms = MeasureMs([&]() {
+            for (int i = 0; i < n; ++i) {
+                Entity e = world.CreateEntity();
+                world.Add<BenchmarkSpawnPosition>(e, { 0, 0 });
+                world.Add<BenchmarkSpawnHealth>(e, { 100 });
+            }
+        });
+        ACMSG("CreateEntity + Add x" << n << ": " << ms << " ms");
+    }
+    {
+        ac::World world;
+        std::vector<Entity> ids;
+        double ms = MeasureMs([&]() {
+            ids = world.CreateEntities(n, BenchmarkSpawnPosition{ 0, 0 }, BenchmarkSpawnHealth{ 100 });
+        });
+        ACMSG("CreateEntities x" << n << ": " << ms << " ms");
+
+        double deleteMs = MeasureMs([&]() {
+            world.DeleteEntities(ids);
+        });
+        ACMSG("DeleteEntities x" << n << ": " << deleteMs << " ms");
+    }
+}
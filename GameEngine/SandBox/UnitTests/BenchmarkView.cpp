@@ -0,0 +1,68 @@
+#include "acpch.h"
+#include "Benchmark.h"
+#include "Achoium.h"
+using namespace ac;
+struct BenchmarkPosition {
+    float x, y;
+};
+struct BenchmarkVelocity {
+    float x, y;
+};
+
+template <class Func>
+static double MeasureNsPerEntity(int n, int iterations, Func&& func)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        func();
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::nano> duration = end - start;
+    return duration.count() / (static_cast<double>(n) * iterations);
+}
+
+void BenchmarkViewIteration(int n) {
+    ac::World world;
+    for (int i = 0; i < n; ++i) {
+        Entity e = world.CreateEntity();
+        world.Add<BenchmarkPosition>(e, { 0, 0 });
+        if (i % 2 == 0)
+            world.Add<BenchmarkVelocity>(e, { 1, 1 });
+    }
+    const int iterations = 100;
+
+    // Type-erased callback, the only form ForEach used to accept
+    std::function<void(BenchmarkPosition&, BenchmarkVelocity&)> erased = [](BenchmarkPosition& p, BenchmarkVelocity& v) {
+        p.x += v.x;
+        p.y += v.y;
+    };
+    double erasedNs = MeasureNsPerEntity(n, iterations, [&]() {
+        world.View<BenchmarkPosition, BenchmarkVelocity>().ForEach(erased);
+    });
+    ACMSG("View ForEach(std::function): " << erasedNs << " ns/entity");
+
+    // Allocates a vector of packs every call
+    double packedNs = MeasureNsPerEntity(n, iterations, [&]() {
+        for (auto& pack : world.View<BenchmarkPosition, BenchmarkVelocity>().GetPacked()) {
+            auto& [p, v] = pack.components;
+            p.x += v.x;
+            p.y += v.y;
+        }
+    });
+    ACMSG("View GetPacked: " << packedNs << " ns/entity");
+
+    double lambdaNs = MeasureNsPerEntity(n, iterations, [&]() {
+        world.View<BenchmarkPosition, BenchmarkVelocity>().ForEach([](BenchmarkPosition& p, BenchmarkVelocity& v) {
+            p.x += v.x;
+            p.y += v.y;
+        });
+    });
+    ACMSG("View ForEach(lambda): " << lambdaNs << " ns/entity");
+
+    double rangeNs = MeasureNsPerEntity(n, iterations, [&]() {
+        for (auto [id, p, v] : world.View<BenchmarkPosition, BenchmarkVelocity>()) {
+            p.x += v.x;
+            p.y += v.y;
+        }
+    });
+    ACMSG("View range-for: " << rangeNs << " ns/entity");
+}
@@ -0,0 +1,337 @@
+#include "acpch.h"
+#include "Achoium.h"
+#include "BroadphaseTest.h"
+using namespace ac;
+
+namespace
+{
+    // A collider of the 2D test scene; the proxy is rebuilt from it every frame
+    struct Body2D
+    {
+        BroadphaseProxy2D proxy;
+        glm::vec2 velocity{ 0, 0 };
+    };
+
+    // Every pair Broadphase2D::FindPairs should report, by testing them all
+    std::vector<BroadphasePair2D> ReferencePairs2D(const std::vector<BroadphaseProxy2D>& proxies, const CollisionLayer& layers)
+    {
+        std::vector<BroadphasePair2D> pairs;
+        for (uint32_t a = 0; a < proxies.size(); ++a)
+            for (uint32_t b = a + 1; b < proxies.size(); ++b)
+                if (proxies[a].aabb.Overlaps(proxies[b].aabb) && layers.ShouldCollide(proxies[a].layer, proxies[b].layer) &&
+                    !(proxies[a].sleeping && proxies[b].sleeping))
+                    pairs.push_back({ a, b });
+        return pairs;
+    }
+
+    bool SamePairs2D(const std::vector<BroadphasePair2D>& first, const std::vector<BroadphasePair2D>& second)
+    {
+        return std::equal(first.begin(), first.end(), second.begin(), second.end(),
+            [](const BroadphasePair2D& x, const BroadphasePair2D& y) { return x.a == y.a && x.b == y.b; });
+    }
+
+    BroadphaseProxy3D Box3D(uint64_t key, const glm::vec3& min, const glm::vec3& max, uint32_t layer = 0, bool isStatic = false)
+    {
+        BroadphaseProxy3D proxy;
+        proxy.key = key;
+        proxy.aabb = { min, max };
+        proxy.layer = layer;
+        proxy.isStatic = isStatic;
+        return proxy;
+    }
+
+    // Every pair SpatialHashGrid3D::FindPairs should report, by testing them all
+    std::vector<BroadphasePair3D> ReferencePairs3D(const std::vector<BroadphaseProxy3D>& proxies, const CollisionLayer& layers)
+    {
+        std::vector<BroadphasePair3D> pairs;
+        for (uint32_t a = 0; a < proxies.size(); ++a)
+            for (uint32_t b = a + 1; b < proxies.size(); ++b)
+                if (proxies[a].aabb.Overlaps(proxies[b].aabb) && layers.ShouldCollide(proxies[a].layer, proxies[b].layer) &&
+                    !(proxies[a].isStatic && proxies[b].isStatic))
+                    pairs.push_back({ a, b });
+        return pairs;
+    }
+
+    bool SamePairs3D(const std::vector<BroadphasePair3D>& first, const std::vector<BroadphasePair3D>& second)
+    {
+        return std::equal(first.begin(), first.end(), second.begin(), second.end(),
+            [](const BroadphasePair3D& x, const BroadphasePair3D& y) { return x.a == y.a && x.b == y.b; });
+    }
+}
+
+void TestBroadphaseMethodsAgree2D() {
+    const BroadphaseMethod2D methods[] = { BroadphaseMethod2D::BruteForce, BroadphaseMethod2D::AABBTree, BroadphaseMethod2D::SweepAndPrune };
+    const char* names[] = { "BruteForce", "AABBTree", "SweepAndPrune" };
+    Broadphase2D broadphases[] = { Broadphase2D(methods[0]), Broadphase2D(methods[1]), Broadphase2D(methods[2]) };
+    CollisionLayer layers;
+
+    // Colliders of many sizes on four layers; every third one never moves and every fifth one starts asleep
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coordinate(0.0f, 400.0f);
+    std::uniform_real_distribution<float> halfSize(1.0f, 15.0f);
+    std::uniform_real_distribution<float> speed(-6.0f, 6.0f);
+    std::vector<Body2D> bodies;
+    uint64_t nextKey = 1;
+    auto addBody = [&](uint32_t i) {
+        Body2D body;
+        glm::vec2 center(coordinate(rng), coordinate(rng));
+        glm::vec2 half(halfSize(rng), halfSize(rng));
+        body.proxy.key = nextKey++;
+        body.proxy.aabb = { center - half, center + half };
+        body.proxy.layer = i % 4;
+        body.proxy.sleeping = i % 5 == 0;
+        if (i % 3 != 0 && !body.proxy.sleeping)
+            body.velocity = glm::vec2(speed(rng), speed(rng));
+        bodies.push_back(body);
+    };
+    for (uint32_t i = 0; i < 300; ++i)
+        addBody(i);
+
+    size_t totalPairs = 0;
+    std::vector<BroadphaseProxy2D> proxies;
+    std::vector<BroadphasePair2D> pairs;
+    for (int frame = 0; frame < 40; ++frame) {
+        if (frame == 10) // Removed colliders are forgotten, and the others shift to new indices
+            std::erase_if(bodies, [](const Body2D& body) { return body.proxy.key % 7 == 0; });
+        if (frame == 15) { // Sleepers wake up and start moving
+            for (Body2D& body : bodies)
+                if (body.proxy.sleeping) {
+                    body.proxy.sleeping = false;
+                    body.velocity = glm::vec2(speed(rng), speed(rng));
+                }
+        }
+        if (frame == 20) { // The collision matrix changes between frames
+            layers.SetLayerCollision(1, 2, false);
+            layers.SetLayerCollision(3, 3, false);
+        }
+        if (frame == 25) { // Some of them fall asleep where they are
+            for (size_t i = 0; i < bodies.size(); i += 6) {
+                bodies[i].proxy.sleeping = true;
+                bodies[i].velocity = glm::vec2(0.0f);
+            }
+        }
+        if (frame == 30) { // New colliders appear
+            for (uint32_t i = 0; i < 20; ++i)
+                addBody(i);
+        }
+
+        proxies.clear();
+        for (Body2D& body : bodies) {
+            body.proxy.aabb.min += body.velocity;
+            body.proxy.aabb.max += body.velocity;
+            proxies.push_back(body.proxy);
+        }
+        std::vector<BroadphasePair2D> expected = ReferencePairs2D(proxies, layers);
+        totalPairs += expected.size();
+        for (int m = 0; m < 3; ++m) {
+            broadphases[m].FindPairs(proxies, layers, pairs);
+            ACASSERT(SamePairs2D(pairs, expected), "TestBroadphaseMethodsAgree2D failed: " << names[m] << " reported " << pairs.size()
+                << " pairs in frame " << frame << ", expected " << expected.size());
+        }
+    }
+    ACASSERT(totalPairs > 400, "TestBroadphaseMethodsAgree2D failed: the scene only produced " << totalPairs << " pairs");
+
+    ACMSG("TestBroadphaseMethodsAgree2D passed");
+}
+
+void TestSpatialHashStaticPairs() {
+    SpatialHashGrid3D grid(1.0f);
+    CollisionLayer layers;
+    std::vector<BroadphasePair3D> pairs;
+
+    // Two overlapping static boxes, and a dynamic one overlapping the second
+    std::vector<BroadphaseProxy3D> proxies = {
+        Box3D(1, glm::vec3(0.0f), glm::vec3(0.5f), 0, true),
+        Box3D(2, glm::vec3(0.25f), glm::vec3(0.75f), 0, true),
+        Box3D(3, glm::vec3(0.6f), glm::vec3(0.9f)),
+    };
+    grid.FindPairs(proxies, layers, pairs);
+    ACASSERT(pairs.size() == 1 && pairs[0].a == 1 && pairs[0].b == 2, "TestSpatialHashStaticPairs failed: static pair reported or dynamic pair missing");
+
+    // Turning the dynamic box static removes its pair too, turning it back restores it
+    proxies[2].isStatic = true;
+    grid.FindPairs(proxies, layers, pairs);
+    ACASSERT(pairs.empty(), "TestSpatialHashStaticPairs failed: pairs of static boxes reported");
+    proxies[2].isStatic = false;
+    grid.FindPairs(proxies, layers, pairs);
+    ACASSERT(pairs.size() == 1, "TestSpatialHashStaticPairs failed: pair missing after the box became dynamic again");
+
+    ACMSG("TestSpatialHashStaticPairs passed");
+}
+
+void TestSpatialHashSharedCells() {
+    SpatialHashGrid3D grid(1.0f);
+    CollisionLayer layers;
+    std::vector<BroadphasePair3D> pairs;
+
+    // Both boxes span 3x3x3 cells and share 2x2x2 of them
+    std::vector<BroadphaseProxy3D> proxies = {
+        Box3D(1, glm::vec3(0.5f), glm::vec3(2.5f)),
+        Box3D(2, glm::vec3(1.5f), glm::vec3(3.5f)),
+    };
+    grid.FindPairs(proxies, layers, pairs);
+    ACASSERT(grid.GetCellCount() == 27 + 27 - 8, "TestSpatialHashSharedCells failed: expected 46 cells, got " << grid.GetCellCount());
+    ACASSERT(pairs.size() == 1 && pairs[0].a == 0 && pairs[0].b == 1, "TestSpatialHashSharedCells failed: pair reported " << pairs.size() << " times");
+
+    // The same with a static box, which is looked up from the dynamic side
+    proxies[0].isStatic = true;
+    grid.FindPairs(proxies, layers, pairs);
+    ACASSERT(pairs.size() == 1, "TestSpatialHashSharedCells failed: static pair reported " << pairs.size() << " times");
+
+    // Sharing cells is not enough, the bounds have to overlap
+    proxies[0] = Box3D(1, glm::vec3(0.5f), glm::vec3(1.4f));
+    grid.FindPairs(proxies, layers, pairs);
+    ACASSERT(pairs.empty(), "TestSpatialHashSharedCells failed: pair reported for boxes that only share a cell");
+
+    ACMSG("TestSpatialHashSharedCells passed");
+}
+
+void TestSpatialHashLargeProxies() {
+    SpatialHashGrid3D grid(1.0f);
+    CollisionLayer layers;
+    std::vector<BroadphasePair3D> pairs;
+
+    // A static floor and a dynamic wall far too large for the cells, with small boxes around them
+    std::vector<BroadphaseProxy3D> proxies = {
+        Box3D(1, glm::vec3(0.5f, 0.0f, 0.5f), glm::vec3(0.9f)),              // on the floor
+        Box3D(2, glm::vec3(-100.0f, -1.0f, -100.0f), glm::vec3(100.0f, 0.0f, 100.0f), 0, true),
+        Box3D(3, glm::vec3(5.0f, 5.0f, 5.0f), glm::vec3(5.5f, 5.5f, 5.5f)), // in the air
+        Box3D(4, glm::vec3(-50.0f, -0.5f, 9.0f), glm::vec3(50.0f, 50.0f, 10.0f)),
+        Box3D(5, glm::vec3(0.0f, -0.5f, -20.0f), glm::vec3(1.0f, 0.5f, -19.0f), 0, true),
+    };
+    grid.FindPairs(proxies, layers, pairs);
+    ACASSERT(grid.GetProxyCount() == 5, "TestSpatialHashLargeProxies failed: expected 5 proxies, got " << grid.GetProxyCount());
+    ACASSERT(grid.GetCellCount() == 1 + 1 + 8, "TestSpatialHashLargeProxies failed: large proxies were put in the cells");
+    ACASSERT(SamePairs3D(pairs, ReferencePairs3D(proxies, layers)), "TestSpatialHashLargeProxies failed: large proxy pairs differ from the reference");
+    // The floor meets the small box and the wall, but not the static box sunk in it
+    ACASSERT(pairs.size() == 2, "TestSpatialHashLargeProxies failed: expected 2 pairs, got " << pairs.size());
+
+    // A box growing too large moves out of the cells, and back in when it shrinks
+    proxies[2].aabb.max = glm::vec3(20.0f);
+    grid.FindPairs(proxies, layers, pairs);
+    ACASSERT(grid.GetCellCount() == 1 + 8, "TestSpatialHashLargeProxies failed: grown box is still in the cells");
+    ACASSERT(SamePairs3D(pairs, ReferencePairs3D(proxies, layers)), "TestSpatialHashLargeProxies failed: pairs of two large proxies differ from the reference");
+    proxies[2].aabb.max = glm::vec3(5.5f);
+    grid.FindPairs(proxies, layers, pairs);
+    ACASSERT(grid.GetCellCount() == 1 + 1 + 8, "TestSpatialHashLargeProxies failed: shrunk box is not back in the cells");
+
+    // Removing the floor removes its pairs
+    proxies.erase(proxies.begin() + 1);
+    grid.FindPairs(proxies, layers, pairs);
+    ACASSERT(grid.GetProxyCount() == 4 && SamePairs3D(pairs, ReferencePairs3D(proxies, layers)), "TestSpatialHashLargeProxies failed: removed floor is still paired");
+
+    // A box covering the clamped cell coordinates on every axis is large, however many cells that would be
+    proxies.push_back(Box3D(6, glm::vec3(-1e30f), glm::vec3(1e30f)));
+    grid.FindPairs(proxies, layers, pairs);
+    ACASSERT(grid.GetCellCount() == 1 + 1 + 8, "TestSpatialHashLargeProxies failed: huge box was put in the cells");
+    ACASSERT(SamePairs3D(pairs, ReferencePairs3D(proxies, layers)), "TestSpatialHashLargeProxies failed: huge box pairs differ from the reference");
+
+    ACMSG("TestSpatialHashLargeProxies passed");
+}
+
+void TestSpatialHashLayers() {
+    SpatialHashGrid3D grid(1.0f);
+    CollisionLayer layers;
+    std::vector<BroadphasePair3D> pairs;
+
+    // Three overlapping boxes on layers 0, 1 and 2, and a large one on layer 1 touching the last two
+    std::vector<BroadphaseProxy3D> proxies = {
+        Box3D(1, glm::vec3(0.0f), glm::vec3(1.0f), 0),
+        Box3D(2, glm::vec3(0.5f), glm::vec3(1.5f), 1),
+        Box3D(3, glm::vec3(0.2f), glm::vec3(1.2f), 2),
+        Box3D(4, glm::vec3(-10.0f, -10.0f, 1.1f), glm::vec3(10.0f, 10.0f, 2.0f), 1),
+    };
+    grid.FindPairs(proxies, layers, pairs);
+    ACASSERT(pairs.size() == 5, "TestSpatialHashLayers failed: expected every overlapping pair before filtering, got " << pairs.size());
+
+    layers.SetLayerCollision(0, 1, false);
+    layers.SetLayerCollision(2, 2, false);
+    layers.SetLayerCollision(1, 1, false);
+    grid.FindPairs(proxies, layers, pairs);
+    ACASSERT(SamePairs3D(pairs, ReferencePairs3D(proxies, layers)), "TestSpatialHashLayers failed: pairs differ from the reference after the mask change");
+    ACASSERT(pairs.size() == 3, "TestSpatialHashLayers failed: expected 3 pairs after the mask change, got " << pairs.size());
+
+    // A layer colliding with nothing has no pairs at all, even with a large proxy
+    for (uint32_t layer = 0; layer < MAX_COLLISION_LAYERS; ++layer)
+        layers.SetLayerCollision(2, layer, false);
+    proxies[3].layer = 2;
+    grid.FindPairs(proxies, layers, pairs);
+    ACASSERT(pairs.empty(), "TestSpatialHashLayers failed: pairs reported for a layer colliding with nothing");
+
+    ACMSG("TestSpatialHashLayers passed");
+}
+
+void TestSpatialHashIncremental() {
+    SpatialHashGrid3D grid(4.0f);
+    CollisionLayer layers;
+    layers.SetLayerCollision(1, 3, false);
+
+    // Boxes drifting through the grid; every fourth one is static
+    std::mt19937 rng(18);
+    std::uniform_real_distribution<float> coordinate(0.0f, 100.0f);
+    std::uniform_real_distribution<float> halfSize(0.5f, 3.0f);
+    std::uniform_real_distribution<float> speed(-1.5f, 1.5f);
+    std::vector<BroadphaseProxy3D> proxies;
+    std::vector<glm::vec3> velocities;
+    uint64_t nextKey = 1;
+    auto addBox = [&](uint32_t i) {
+        glm::vec3 center(coordinate(rng), coordinate(rng), coordinate(rng));
+        glm::vec3 half(halfSize(rng));
+        proxies.push_back(Box3D(nextKey++, center - half, center + half, i % 4, i % 4 == 0));
+        velocities.push_back(i % 4 == 0 ? glm::vec3(0.0f) : glm::vec3(speed(rng), speed(rng), speed(rng)));
+    };
+    for (uint32_t i = 0; i < 400; ++i)
+        addBox(i);
+
+    size_t totalPairs = 0;
+    std::vector<BroadphasePair3D> pairs;
+    for (int frame = 0; frame < 40; ++frame) {
+        if (frame == 10) { // Remove a third of the boxes, the rest shift to new indices
+            for (size_t i = proxies.size(); i-- > 0;)
+                if (proxies[i].key % 3 == 0) {
+                    proxies.erase(proxies.begin() + i);
+                    velocities.erase(velocities.begin() + i);
+                }
+        }
+        if (frame == 20) { // Swap the order the boxes are passed in
+            std::reverse(proxies.begin(), proxies.end());
+            std::reverse(velocities.begin(), velocities.end());
+        }
+        if (frame == 25) { // Add new boxes into the freed slots
+            for (uint32_t i = 0; i < 50; ++i)
+                addBox(i);
+        }
+        for (size_t i = 0; i < proxies.size(); ++i) {
+            proxies[i].aabb.min += velocities[i];
+            proxies[i].aabb.max += velocities[i];
+        }
+
+        grid.FindPairs(proxies, layers, pairs);
+        std::vector<BroadphasePair3D> expected = ReferencePairs3D(proxies, layers);
+        totalPairs += expected.size();
+        ACASSERT(grid.GetProxyCount() == proxies.size(), "TestSpatialHashIncremental failed: grid holds " << grid.GetProxyCount()
+            << " proxies in frame " << frame << ", expected " << proxies.size());
+        ACASSERT(SamePairs3D(pairs, expected), "TestSpatialHashIncremental failed: reported " << pairs.size()
+            << " pairs in frame " << frame << ", expected " << expected.size());
+    }
+    ACASSERT(totalPairs > 200, "TestSpatialHashIncremental failed: the scene only produced " << totalPairs << " pairs");
+
+    // Once every box is gone, so is every cell
+    proxies.clear();
+    grid.FindPairs(proxies, layers, pairs);
+    ACASSERT(grid.GetProxyCount() == 0 && grid.GetCellCount() == 0, "TestSpatialHashIncremental failed: removed boxes left "
+        << grid.GetCellCount() << " cells behind");
+
+    ACMSG("TestSpatialHashIncremental passed");
+}
+
+void RunAllBroadphaseTests() {
+    TestBroadphaseMethodsAgree2D();
+    TestSpatialHashStaticPairs();
+    TestSpatialHashSharedCells();
+    TestSpatialHashLargeProxies();
+    TestSpatialHashLayers();
+    TestSpatialHashIncremental();
+
+    ACMSG("=== All Broadphase tests completed ===");
+}
@@ -0,0 +1,10 @@
+// BroadphaseTest.h
+#pragma once
+
+void TestBroadphaseMethodsAgree2D();
+void TestSpatialHashStaticPairs();
+void TestSpatialHashSharedCells();
+void TestSpatialHashLargeProxies();
+void TestSpatialHashLayers();
+void TestSpatialHashIncremental();
+void RunAllBroadphaseTests();
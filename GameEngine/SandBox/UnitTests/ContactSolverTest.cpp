@@ -0,0 +1,145 @@
+#include "acpch.h"
+#include "Achoium.h"
+#include "ContactSolverTest.h"
+#include "PhysicsTestWorld.h"
+using namespace ac;
+
+namespace
+{
+    const float BoxSize = 20.0f;
+    const float GroundTop = 10.0f;
+
+    // A column of boxes resting on a kinematic ground
+    struct StackScene : PhysicsTestWorld
+    {
+        std::vector<Entity> boxes;
+
+        explicit StackScene(int height)
+        {
+            AddStaticRect2D(glm::vec2(0.0f, 0.0f), 200.0f, 2.0f * GroundTop, 0.6f);
+            for (int i = 0; i < height; ++i)
+                boxes.push_back(AddBox2D(glm::vec2(0.0f, RestHeight(i)), BoxSize, 0.5f));
+        }
+
+        static float RestHeight(int i)
+        {
+            return GroundTop + BoxSize * 0.5f + BoxSize * static_cast<float>(i);
+        }
+    };
+}
+
+void TestContactSolverStack() {
+    // 30 Hz, half the rate the per-contact resolution needed to keep stacks up
+    StackScene scene(5);
+    const float dt = 1.0f / 30.0f;
+    for (int frame = 0; frame < 300; ++frame)
+        scene.Step2D(dt);
+
+    for (size_t i = 0; i < scene.boxes.size(); ++i) {
+        const Transform& transform = scene.world.Get<Transform>(scene.boxes[i]);
+        RigidBody2DRef body = scene.world.Get<RigidBody2D>(scene.boxes[i]);
+        // Each contact below a box keeps a little overlap
+        float sink = StackScene::RestHeight(static_cast<int>(i)) - transform.position.y;
+        ACASSERT(std::abs(sink) < 0.5f * static_cast<float>(i + 1), "TestContactSolverStack failed: box " << i << " sank by " << sink);
+        ACASSERT(std::abs(transform.position.x) < 0.5f, "TestContactSolverStack failed: box " << i << " slid to x = " << transform.position.x);
+        ACASSERT(glm::length(body.velocity) < 1.0f, "TestContactSolverStack failed: box " << i << " still moving at " << glm::length(body.velocity));
+        ACASSERT(std::abs(body.angularVelocity) < 0.01f, "TestContactSolverStack failed: box " << i << " still spinning");
+    }
+
+    ACMSG("TestContactSolverStack passed");
+}
+
+void TestContactSolverWarmStart() {
+    StackScene scene(3);
+    scene.world.GetResourse<PhysicsSleep>().enabled = false; // A sleeping stack reports no contacts
+    const float dt = 1.0f / 30.0f;
+    for (int frame = 0; frame < 60; ++frame)
+        scene.Step2D(dt);
+
+    // One cached pair per resting face, carrying the weight above it into the next step
+    ContactSolver2D& solver = scene.world.GetResourse<ContactSolver2D>();
+    ACASSERT(solver.GetCachedContactCount() == 3, "TestContactSolverWarmStart failed: " << solver.GetCachedContactCount() << " cached pairs, expected 3");
+
+    // Lifting the top box off the stack drops its pair from the cache
+    scene.world.Get<Transform>(scene.boxes.back()).position.y += 100.0f;
+    scene.Step2D(dt);
+    ACASSERT(solver.GetCachedContactCount() == 2, "TestContactSolverWarmStart failed: separated pair still cached");
+
+    ACMSG("TestContactSolverWarmStart passed");
+}
+
+void TestContactSolverThreadCount() {
+    // Enough side-by-side stacks for the islands and pairs to be split into several jobs
+    const int columns = 200;
+    std::vector<Transform> results[2];
+    for (int run = 0; run < 2; ++run) {
+        StackScene scene(4);
+        scene.world.GetResourse<ContactSolver2D>().maxThreads = run == 0 ? 1 : 0;
+        scene.world.GetResourse<PhysicsSleep>().enabled = false;
+
+        float width = columns * 2.0f * BoxSize;
+        scene.AddStaticRect2D(glm::vec2(width * 0.5f + 200.0f, 0.0f), width, 2.0f * GroundTop, 0.6f);
+        for (int column = 0; column < columns; ++column) {
+            for (int i = 0; i < 3; ++i) {
+                // Dropped a little apart and off center, so the stacks settle and tip differently
+                float x = 200.0f + (column + 0.5f) * 2.0f * BoxSize + 0.1f * i * (column % 7);
+                scene.boxes.push_back(scene.AddBox2D(glm::vec2(x, StackScene::RestHeight(i) + 2.0f * i), BoxSize, 0.5f));
+            }
+        }
+
+        const float dt = 1.0f / 60.0f;
+        for (int frame = 0; frame < 120; ++frame)
+            scene.Step2D(dt);
+        for (Entity box : scene.boxes)
+            results[run].push_back(scene.world.Get<Transform>(box));
+    }
+
+    // Islands are solved in the same order whichever thread takes them, so the results match to the bit
+    for (size_t i = 0; i < results[0].size(); ++i) {
+        ACASSERT(results[0][i].position == results[1][i].position && results[0][i].rotation == results[1][i].rotation,
+            "TestContactSolverThreadCount failed: box " << i << " ended elsewhere on several threads");
+    }
+
+    ACMSG("TestContactSolverThreadCount passed");
+}
+
+void TestContactSolverHandlerDeletesBody() {
+    StackScene scene(3);
+    scene.world.GetResourse<PhysicsSleep>().enabled = false;
+    const float dt = 1.0f / 30.0f;
+    for (int frame = 0; frame < 30; ++frame)
+        scene.Step2D(dt);
+
+    // A collision handler destroying the middle box must not corrupt the boxes the step still resolves
+    Entity middle = scene.boxes[1];
+    scene.world.GetResourse<EventManager>().AddListener<OnCollision>([&scene, middle](const OnCollision& collision) {
+        if ((collision.data.entityA == middle || collision.data.entityB == middle) && scene.world.IsAlive(middle))
+            scene.world.DeleteEntity(middle);
+        return true;
+    });
+    scene.Step2D(dt);
+    ACASSERT(!scene.world.IsAlive(middle), "TestContactSolverHandlerDeletesBody failed: the handler did not run");
+    for (size_t i : { size_t(0), size_t(2) }) {
+        const Transform& transform = scene.world.Get<const Transform>(scene.boxes[i]);
+        RigidBody2DConstRef body = scene.world.Get<const RigidBody2D>(scene.boxes[i]);
+        ACASSERT(std::abs(transform.position.y - StackScene::RestHeight(static_cast<int>(i))) < 1.0f && glm::length(body.velocity) < 10.0f,
+            "TestContactSolverHandlerDeletesBody failed: box " << i << " was written with another body's state");
+    }
+
+    // The top box falls into the gap
+    for (int frame = 0; frame < 20; ++frame)
+        scene.Step2D(dt);
+    ACASSERT(scene.world.Get<const Transform>(scene.boxes[2]).position.y < StackScene::RestHeight(2) - BoxSize * 0.5f,
+        "TestContactSolverHandlerDeletesBody failed: the top box did not fall");
+
+    ACMSG("TestContactSolverHandlerDeletesBody passed");
+}
+
+void RunAllContactSolverTests() {
+    TestContactSolverStack();
+    TestContactSolverWarmStart();
+    TestContactSolverThreadCount();
+    TestContactSolverHandlerDeletesBody();
+
+    ACMSG("=== All ContactSolver tests completed ===");
+}
@@ -0,0 +1,8 @@
+// ContactSolverTest.h
+#pragma once
+
+void TestContactSolverStack();
+void TestContactSolverWarmStart();
+void TestContactSolverThreadCount();
+void TestContactSolverHandlerDeletesBody();
+void RunAllContactSolverTests();
@@ -0,0 +1,158 @@
+#include "acpch.h"
+#include "Achoium.h"
+#include "ContinuousCollisionTest.h"
+#include "PhysicsTestWorld.h"
+using namespace ac;
+
+namespace
+{
+    // 30 Hz, at which a projectile at this speed covers many times the wall's thickness per step
+    const float Dt = 1.0f / 30.0f;
+    const float BulletSpeed = 6000.0f;
+    const float WallX = 300.0f;
+    const float WallThickness = 4.0f;
+
+    // A thin kinematic wall across the path of a fast circle
+    struct WallScene2D : PhysicsTestWorld
+    {
+        Entity projectile;
+
+        explicit WallScene2D(bool bullet)
+        {
+            AddStaticRect2D(glm::vec2(WallX, 0.0f), WallThickness, 400.0f, 0.3f);
+
+            projectile = world.CreateEntity();
+            world.Add<Transform>(projectile, Transform(glm::vec3(0.0f, 0.0f, 0.0f)));
+            world.Add<CircleCollider2D>(projectile, CircleCollider2D(2.0f));
+            RigidBody2D body(1.0f, 0.0f, 0.3f, false, false, true);
+            body.velocity = glm::vec2(BulletSpeed, 0.0f);
+            body.bullet = bullet;
+            world.Add<RigidBody2D>(projectile, std::move(body));
+        }
+
+        float Run(int steps)
+        {
+            for (int step = 0; step < steps; ++step)
+                Step2D(Dt);
+            return world.Get<Transform>(projectile).position.x;
+        }
+    };
+
+    // The same wall and projectile in 3D, a sphere flying at a thin box
+    struct WallScene3D : PhysicsTestWorld
+    {
+        Entity projectile;
+
+        explicit WallScene3D(bool bullet)
+        {
+            AddStaticBox3D(glm::vec3(WallX, 0.0f, 0.0f), glm::vec3(WallThickness, 400.0f, 400.0f), 0.3f);
+
+            projectile = world.CreateEntity();
+            world.Add<Transform>(projectile, Transform(glm::vec3(0.0f, 0.0f, 0.0f)));
+            world.Add<SphereCollider>(projectile, SphereCollider(2.0f));
+            RigidBody body(1.0f, 0.0f, 0.3f, false, false, true);
+            body.velocity = glm::vec3(BulletSpeed, 0.0f, 0.0f);
+            body.bullet = bullet;
+            world.Add<RigidBody>(projectile, std::move(body));
+        }
+
+        float Run(int steps)
+        {
+            for (int step = 0; step < steps; ++step)
+                Step3D(Dt);
+            return world.Get<Transform>(projectile).position.x;
+        }
+    };
+}
+
+void TestTimeOfImpact2D() {
+    Transform wallTransform(glm::vec3(10.0f, 0.0f, 0.0f));
+    RectCollider2D wall(2.0f, 20.0f);
+    wall.UpdateWorldVertices(wallTransform);
+    const float tolerance = 0.01f;
+
+    // A circle swept from x = -10 to 20 first touches the wall's face at x = 9 when its center is at x = 8
+    Transform circleTransform(glm::vec3(20.0f, 0.0f, 0.0f));
+    CircleCollider2D circle(1.0f);
+    float toi = -1.0f;
+    bool hit = TimeOfImpact2D(circle, circleTransform, glm::vec2(30.0f, 0.0f), wall, wallTransform, tolerance, toi);
+    ACASSERT(hit && std::abs(toi * 30.0f - 18.0f) < 0.1f, "TestTimeOfImpact2D failed: circle vs rect hit " << hit << " at " << toi);
+
+    // Two circles are swept exactly
+    Transform targetTransform(glm::vec3(10.0f, 0.0f, 0.0f));
+    CircleCollider2D target(1.0f);
+    hit = TimeOfImpact2D(circle, circleTransform, glm::vec2(30.0f, 0.0f), target, targetTransform, tolerance, toi);
+    ACASSERT(hit && std::abs(toi * 30.0f - 18.0f) < 0.001f, "TestTimeOfImpact2D failed: circle vs circle hit " << hit << " at " << toi);
+
+    // A box moving past the wall's end does not hit it
+    Transform boxTransform(glm::vec3(20.0f, 15.0f, 0.0f));
+    RectCollider2D box(2.0f, 2.0f);
+    box.UpdateWorldVertices(boxTransform);
+    hit = TimeOfImpact2D(box, boxTransform, glm::vec2(30.0f, 0.0f), wall, wallTransform, tolerance, toi);
+    ACASSERT(!hit, "TestTimeOfImpact2D failed: box passing the wall's end hit it");
+
+    // A box already touching the wall at the start is left to the narrowphase
+    boxTransform.position = glm::vec3(9.5f, 0.0f, 0.0f);
+    box.UpdateWorldVertices(boxTransform);
+    hit = TimeOfImpact2D(box, boxTransform, glm::vec2(0.5f, 0.0f), wall, wallTransform, tolerance, toi);
+    ACASSERT(!hit, "TestTimeOfImpact2D failed: overlap at the start reported as a hit");
+
+    ACMSG("TestTimeOfImpact2D passed");
+}
+
+void TestTimeOfImpact3D() {
+    Transform wallTransform(glm::vec3(10.0f, 0.0f, 0.0f));
+    BoxCollider wall(2.0f, 20.0f, 20.0f);
+    const float tolerance = 0.01f;
+
+    Transform sphereTransform(glm::vec3(20.0f, 0.0f, 0.0f));
+    SphereCollider sphere(1.0f);
+    float toi = -1.0f;
+    bool hit = TimeOfImpact3D(sphere, sphereTransform, glm::vec3(30.0f, 0.0f, 0.0f), wall, wallTransform, tolerance, toi);
+    ACASSERT(hit && std::abs(toi * 30.0f - 18.0f) < 0.1f, "TestTimeOfImpact3D failed: sphere vs box hit " << hit << " at " << toi);
+
+    SphereCollider target(1.0f);
+    hit = TimeOfImpact3D(sphere, sphereTransform, glm::vec3(30.0f, 0.0f, 0.0f), target, wallTransform, tolerance, toi);
+    ACASSERT(hit && std::abs(toi * 30.0f - 18.0f) < 0.001f, "TestTimeOfImpact3D failed: sphere vs sphere hit " << hit << " at " << toi);
+
+    hit = TimeOfImpact3D(sphere, sphereTransform, glm::vec3(0.0f, 0.0f, 30.0f), wall, wallTransform, tolerance, toi);
+    ACASSERT(!hit, "TestTimeOfImpact3D failed: sphere moving beside the wall hit it");
+
+    ACMSG("TestTimeOfImpact3D passed");
+}
+
+void TestBulletStopsAtThinWall2D() {
+    // Without the flag the projectile skips over the wall between two steps
+    WallScene2D tunneling(false);
+    float x = tunneling.Run(3);
+    ACASSERT(x > WallX, "TestBulletStopsAtThinWall2D failed: the control projectile did not tunnel (x = " << x << ")");
+
+    WallScene2D scene(true);
+    x = scene.Run(10);
+    ACASSERT(x < WallX - WallThickness * 0.5f, "TestBulletStopsAtThinWall2D failed: the bullet passed the wall (x = " << x << ")");
+    RigidBody2DRef body = scene.world.Get<RigidBody2D>(scene.projectile);
+    ACASSERT(body.velocity.x <= 0.0f, "TestBulletStopsAtThinWall2D failed: the bullet still moves into the wall at " << body.velocity.x);
+
+    ACMSG("TestBulletStopsAtThinWall2D passed");
+}
+
+void TestBulletStopsAtThinWall3D() {
+    WallScene3D tunneling(false);
+    float x = tunneling.Run(3);
+    ACASSERT(x > WallX, "TestBulletStopsAtThinWall3D failed: the control projectile did not tunnel (x = " << x << ")");
+
+    WallScene3D scene(true);
+    x = scene.Run(10);
+    ACASSERT(x < WallX - WallThickness * 0.5f, "TestBulletStopsAtThinWall3D failed: the bullet passed the wall (x = " << x << ")");
+
+    ACMSG("TestBulletStopsAtThinWall3D passed");
+}
+
+void RunAllContinuousCollisionTests() {
+    TestTimeOfImpact2D();
+    TestTimeOfImpact3D();
+    TestBulletStopsAtThinWall2D();
+    TestBulletStopsAtThinWall3D();
+
+    ACMSG("=== All ContinuousCollision tests completed ===");
+}
@@ -0,0 +1,8 @@
+// ContinuousCollisionTest.h
+#pragma once
+
+void TestTimeOfImpact2D();
+void TestTimeOfImpact3D();
+void TestBulletStopsAtThinWall2D();
+void TestBulletStopsAtThinWall3D();
+void RunAllContinuousCollisionTests();
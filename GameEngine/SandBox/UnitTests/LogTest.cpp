@@ -0,0 +1,95 @@
+#include "acpch.h"
+#include "Achoium.h"
+#include "LogTest.h"
+
+void TestLogRingBufferOrder() {
+    ac::LogRingBuffer<int, 4> buffer;
+    for (int i = 0; i < 4; ++i)
+        ACASSERT(buffer.TryPush([i](int& v) { v = i; }), "TestLogRingBufferOrder failed: push into non-full buffer failed");
+    ACASSERT(!buffer.TryPush([](int& v) { v = 99; }), "TestLogRingBufferOrder failed: push into full buffer succeeded");
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        ACASSERT(buffer.TryPop(value) && value == i, "TestLogRingBufferOrder failed: elements not popped in FIFO order");
+    }
+    ACASSERT(!buffer.TryPop(value), "TestLogRingBufferOrder failed: pop from empty buffer succeeded");
+
+    // Wrap around the cells a few times
+    for (int i = 0; i < 10; ++i) {
+        buffer.TryPush([i](int& v) { v = i; });
+        ACASSERT(buffer.TryPop(value) && value == i, "TestLogRingBufferOrder failed: wrap-around broke ordering");
+    }
+
+    ACMSG("TestLogRingBufferOrder passed");
+}
+
+void TestLogRingBufferConcurrent() {
+    ac::LogRingBuffer<int, 1024> buffer;
+    const int producerCount = 4;
+    const int perProducer = 20000;
+    std::atomic<int> producersDone{ 0 };
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producerCount; ++p) {
+        producers.emplace_back([&]() {
+            for (int i = 1; i <= perProducer; ++i)
+                while (!buffer.TryPush([i](int& v) { v = i; }))
+                    std::this_thread::yield();
+            producersDone.fetch_add(1);
+        });
+    }
+
+    long long sum = 0;
+    int popped = 0;
+    int value = 0;
+    while (popped < producerCount * perProducer) {
+        if (buffer.TryPop(value)) {
+            sum += value;
+            ++popped;
+        }
+        else
+            std::this_thread::yield();
+    }
+    for (std::thread& producer : producers)
+        producer.join();
+
+    ACASSERT(sum == (long long)producerCount * perProducer * (perProducer + 1) / 2,
+             "TestLogRingBufferConcurrent failed: elements lost or duplicated");
+    ACASSERT(!buffer.TryPop(value), "TestLogRingBufferConcurrent failed: buffer not empty after draining");
+
+    ACMSG("TestLogRingBufferConcurrent passed");
+}
+
+void TestLogFilters() {
+    ac::Logger& logger = ac::Logger::Get();
+    ACASSERT(logger.ShouldLog(ac::LogLevel::Info, ac::LogCategory::Physics),
+             "TestLogFilters failed: categories should be enabled by default");
+
+    logger.SetCategoryEnabled(ac::LogCategory::Physics, false);
+    ACASSERT(!logger.ShouldLog(ac::LogLevel::Error, ac::LogCategory::Physics) &&
+             logger.ShouldLog(ac::LogLevel::Info, ac::LogCategory::Render),
+             "TestLogFilters failed: disabling a category affected the wrong messages");
+    logger.SetCategoryEnabled(ac::LogCategory::Physics, true);
+
+    logger.SetLevel(ac::LogLevel::Warning);
+    ACASSERT(!logger.ShouldLog(ac::LogLevel::Info, ac::LogCategory::General) &&
+             logger.ShouldLog(ac::LogLevel::Warning, ac::LogCategory::General),
+             "TestLogFilters failed: runtime level not applied");
+    logger.SetLevel(ac::LogLevel::Trace);
+
+    // Disabled messages must not evaluate their arguments
+    int evaluated = 0;
+    logger.SetCategoryEnabled(ac::LogCategory::Audio, false);
+    AC_LOG_INFO(ac::LogCategory::Audio, "value " << ++evaluated);
+    logger.SetCategoryEnabled(ac::LogCategory::Audio, true);
+    ACASSERT(evaluated == 0, "TestLogFilters failed: filtered message was formatted");
+
+    ACMSG("TestLogFilters passed");
+}
+
+void RunAllLogTests() {
+    TestLogRingBufferOrder();
+    TestLogRingBufferConcurrent();
+    TestLogFilters();
+
+    ACMSG("=== All Log tests completed ===");
+}
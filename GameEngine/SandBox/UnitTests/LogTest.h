@@ -0,0 +1,7 @@
+// LogTest.h
+#pragma once
+
+void TestLogRingBufferOrder();
+void TestLogRingBufferConcurrent();
+void TestLogFilters();
+void RunAllLogTests();
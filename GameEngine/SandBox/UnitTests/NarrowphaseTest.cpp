@@ -0,0 +1,154 @@
+#include "acpch.h"
+#include "Achoium.h"
+#include "NarrowphaseTest.h"
+
+#if defined(_MSC_VER) && defined(_DEBUG)
+#include <crtdbg.h>
+#endif
+
+namespace
+{
+    // Heap allocations made by the test thread while counting is on; the logger thread is not counted
+    thread_local size_t s_allocationCount = 0;
+
+#if defined(_MSC_VER) && defined(_DEBUG)
+    thread_local bool s_countAllocations = false;
+
+    int CountAllocation(int allocType, void*, size_t, int, long, const unsigned char*, int)
+    {
+        if (s_countAllocations && (allocType == _HOOK_ALLOC || allocType == _HOOK_REALLOC))
+            ++s_allocationCount;
+        return 1;
+    }
+#endif
+
+    // Counts through the debug CRT's allocation hook while alive, so operator new is left alone for the rest of the executable
+    struct AllocationCounter
+    {
+        size_t Count() const { return s_allocationCount; }
+
+#if defined(_MSC_VER) && defined(_DEBUG)
+        static constexpr bool Available = true;
+
+        AllocationCounter()
+        {
+            s_allocationCount = 0;
+            s_countAllocations = true;
+            m_previousHook = _CrtSetAllocHook(CountAllocation);
+        }
+        ~AllocationCounter()
+        {
+            _CrtSetAllocHook(m_previousHook);
+            s_countAllocations = false;
+        }
+
+    private:
+        _CRT_ALLOC_HOOK m_previousHook;
+#else
+        static constexpr bool Available = false;
+#endif
+    };
+
+    // One collider of every shape on each side, every collider overlapping every collider of the other side
+    struct NarrowphaseScene
+    {
+        ac::CircleCollider2D circleA{ 0.6f };
+        ac::RectCollider2D rectA{ 1.2f, 0.8f };
+        ac::PolygonCollider2D polygonA{ { { -0.6f, -0.5f }, { 0.7f, -0.4f }, { 0.5f, 0.3f }, { 0.1f, 0.8f }, { -0.5f, 0.4f } } };
+        ac::CircleCollider2D circleB{ 0.5f };
+        ac::RectCollider2D rectB{ 0.9f, 1.1f };
+        ac::PolygonCollider2D polygonB{ { { -0.5f, -0.6f }, { 0.6f, -0.2f }, { -0.1f, 0.7f } } };
+        ac::Collider2D* first[3] = { &circleA, &rectA, &polygonA };
+        ac::Collider2D* second[3] = { &circleB, &rectB, &polygonB };
+        ac::Transform firstTransform;
+        ac::Transform secondTransform;
+
+        // Moves both sides to the given frame and refreshes the world-space caches
+        void Step(int frame)
+        {
+            float t = static_cast<float>(frame) * 0.01f;
+            firstTransform = ac::Transform(glm::vec3(-0.2f * std::cos(t), -0.2f * std::sin(t), 0.0f), t);
+            secondTransform = ac::Transform(glm::vec3(0.25f, 0.1f * std::sin(2.0f * t), 0.0f), -0.5f * t);
+            for (int i = 0; i < 3; ++i) {
+                first[i]->UpdateWorldVertices(firstTransform);
+                second[i]->UpdateWorldVertices(secondTransform);
+            }
+        }
+
+        // Runs every shape of the first side against every shape of the second, returns the number of hits
+        int CheckAllPairs(ac::Manifold2D (&manifolds)[3][3]) const
+        {
+            int hits = 0;
+            for (int a = 0; a < 3; ++a)
+                for (int b = 0; b < 3; ++b)
+                    hits += first[a]->CheckCollision(second[b], firstTransform, secondTransform, manifolds[a][b]) ? 1 : 0;
+            return hits;
+        }
+    };
+}
+
+void TestNarrowphaseContacts() {
+    NarrowphaseScene scene;
+    scene.Step(0);
+    ac::Manifold2D manifolds[3][3];
+    ACASSERT(scene.CheckAllPairs(manifolds) == 9, "TestNarrowphaseContacts failed: overlapping shapes not reported");
+
+    for (int a = 0; a < 3; ++a)
+        for (int b = 0; b < 3; ++b) {
+            const ac::Manifold2D& manifold = manifolds[a][b];
+            ACASSERT(manifold.pointCount >= 1 && manifold.pointCount <= ac::Manifold2D::MaxPoints,
+                "TestNarrowphaseContacts failed: contact point count out of range");
+            ACASSERT(std::abs(glm::length(manifold.normal) - 1.0f) < 0.001f, "TestNarrowphaseContacts failed: normal not unit length");
+            ACASSERT(manifold.penetrationDepth > 0.0f, "TestNarrowphaseContacts failed: overlapping shapes without penetration");
+
+            // Swapping the colliders flips the normal and keeps the depth
+            ac::Manifold2D swapped;
+            scene.second[b]->CheckCollision(scene.first[a], scene.secondTransform, scene.firstTransform, swapped);
+            ACASSERT(glm::length(manifold.normal + swapped.normal) < 0.01f, "TestNarrowphaseContacts failed: swapped normal not flipped");
+            ACASSERT(std::abs(manifold.penetrationDepth - swapped.penetrationDepth) < 0.001f, "TestNarrowphaseContacts failed: swapped depth differs");
+        }
+
+    // A manifold reused for a miss reports no contact points
+    ac::Transform far(glm::vec3(100.0f, 0.0f, 0.0f));
+    scene.rectB.UpdateWorldVertices(far);
+    ACASSERT(!scene.polygonA.CheckCollision(&scene.rectB, scene.firstTransform, far, manifolds[0][0]) && manifolds[0][0].pointCount == 0,
+        "TestNarrowphaseContacts failed: separated shapes reported as colliding");
+
+    ACMSG("TestNarrowphaseContacts passed");
+}
+
+void TestNarrowphaseAllocations() {
+    NarrowphaseScene scene;
+    ac::Manifold2D manifolds[3][3];
+
+    // The first update sizes the polygons' vertex caches
+    scene.Step(0);
+    scene.CheckAllPairs(manifolds);
+
+    const int frames = 1000;
+    int hits = 0;
+    size_t allocations = 0;
+    {
+        AllocationCounter counter;
+        for (int frame = 1; frame <= frames; ++frame) {
+            scene.Step(frame);
+            hits += scene.CheckAllPairs(manifolds);
+        }
+        allocations = counter.Count();
+    }
+
+    ACASSERT(hits > 0, "TestNarrowphaseAllocations failed: no contacts generated");
+    if (!AllocationCounter::Available) {
+        ACWARN("TestNarrowphaseAllocations: allocations are only counted with the MSVC debug CRT, count skipped");
+        return;
+    }
+    ACASSERT(allocations == 0, "TestNarrowphaseAllocations failed: " << allocations << " heap allocations in " << frames << " frames");
+    ACMSG("TestNarrowphaseAllocations passed");
+}
+
+void RunAllNarrowphaseTests() {
+    TestNarrowphaseContacts();
+    TestNarrowphaseAllocations();
+
+    ACMSG("=== All Narrowphase tests completed ===");
+}
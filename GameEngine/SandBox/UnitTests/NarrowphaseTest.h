@@ -0,0 +1,6 @@
+// NarrowphaseTest.h
+#pragma once
+
+void TestNarrowphaseContacts();
+void TestNarrowphaseAllocations();
+void RunAllNarrowphaseTests();
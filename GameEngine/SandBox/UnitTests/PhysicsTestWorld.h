@@ -0,0 +1,78 @@
+#pragma once
+#include "Achoium.h"
+
+/**
+ * @brief A world with the components and resources the physics steps need, shared by the physics tests.
+ *
+ * Step2D and Step3D advance it like the engine's fixed-update systems do:
+ * integration first, then collision detection and response. Tests add
+ * their own bodies with the helpers below and tune the resources through
+ * world.
+ */
+struct PhysicsTestWorld
+{
+    ac::World world;
+
+    explicit PhysicsTestWorld(ac::BroadphaseMethod2D broadphase = ac::BroadphaseMethod2D::AABBTree)
+    {
+        world.RegisterType<ac::Transform>();
+        world.RegisterType<ac::CircleCollider2D>();
+        world.RegisterType<ac::RectCollider2D>();
+        world.RegisterType<ac::PolygonCollider2D>();
+        world.RegisterType<ac::RigidBody2D>();
+        world.RegisterType<ac::BoxCollider>();
+        world.RegisterType<ac::SphereCollider>();
+        world.RegisterType<ac::RigidBody>();
+        world.AddResource<ac::CollisionLayer>(new ac::CollisionLayer());
+        world.AddResource<ac::Broadphase2D>(new ac::Broadphase2D(broadphase));
+        world.AddResource<ac::ContactSolver2D>(new ac::ContactSolver2D());
+        world.AddResource<ac::SpatialHashGrid3D>(new ac::SpatialHashGrid3D());
+        world.AddResource<ac::PhysicsSleep>(new ac::PhysicsSleep());
+        world.AddResource<ac::PhysicsIntegrationCache>(new ac::PhysicsIntegrationCache());
+        ac::PhysicsSystem::AddSleepListeners(world);
+    }
+
+    void Step2D(float dt, ac::SimdLevel simd = ac::SimdLevel::Scalar)
+    {
+        ac::PhysicsSystem::Integrate2D(world, dt, simd);
+        ac::PhysicsSystem::Collision2DSystem(world);
+    }
+
+    void Step3D(float dt, ac::SimdLevel simd = ac::SimdLevel::Scalar)
+    {
+        ac::PhysicsSystem::Integrate3D(world, dt, simd);
+        ac::PhysicsSystem::CollisionSystem(world);
+    }
+
+    // A kinematic rectangle, for grounds and walls
+    ac::Entity AddStaticRect2D(const glm::vec2& center, float width, float height, float friction)
+    {
+        ac::Entity entity = world.CreateEntity();
+        world.Add<ac::Transform>(entity, ac::Transform(glm::vec3(center, 0.0f)));
+        world.Add<ac::RectCollider2D>(entity, ac::RectCollider2D(width, height));
+        world.Add<ac::RigidBody2D>(entity, ac::RigidBody2D(0.0f, 0.0f, friction, false, true, true));
+        return entity;
+    }
+
+    // A kinematic box, for grounds and walls
+    ac::Entity AddStaticBox3D(const glm::vec3& center, const glm::vec3& size, float friction)
+    {
+        ac::Entity entity = world.CreateEntity();
+        world.Add<ac::Transform>(entity, ac::Transform(center));
+        world.Add<ac::BoxCollider>(entity, ac::BoxCollider(size.x, size.y, size.z));
+        world.Add<ac::RigidBody>(entity, ac::RigidBody(1.0f, 0.0f, friction, false, true, true));
+        return entity;
+    }
+
+    // A falling square of mass 1 that may rotate
+    ac::Entity AddBox2D(const glm::vec2& center, float size, float restitution)
+    {
+        ac::Entity entity = world.CreateEntity();
+        world.Add<ac::Transform>(entity, ac::Transform(glm::vec3(center, 0.0f)));
+        world.Add<ac::RectCollider2D>(entity, ac::RectCollider2D(size, size));
+        ac::RigidBody2D body(1.0f, restitution, 0.6f, true, false, false);
+        body.inertiaTensor = size * size / 6.0f; // m (w^2 + h^2) / 12
+        world.Add<ac::RigidBody2D>(entity, std::move(body));
+        return entity;
+    }
+};
@@ -0,0 +1,168 @@
+#include "acpch.h"
+#include "Achoium.h"
+#include "SleepTest.h"
+#include "PhysicsTestWorld.h"
+using namespace ac;
+
+namespace
+{
+    const float BoxSize = 20.0f;
+    const float GroundTop = 10.0f;
+    const float Dt = 1.0f / 60.0f;
+
+    // A column of boxes resting on a kinematic ground
+    struct SleepScene : PhysicsTestWorld
+    {
+        std::vector<Entity> boxes;
+
+        explicit SleepScene(int height)
+        {
+            AddStaticRect2D(glm::vec2(0.0f, 0.0f), 200.0f, 2.0f * GroundTop, 0.6f);
+            for (int i = 0; i < height; ++i)
+                boxes.push_back(AddBox(glm::vec2(0.0f, GroundTop + BoxSize * 0.5f + BoxSize * static_cast<float>(i))));
+        }
+
+        Entity AddBox(const glm::vec2& position)
+        {
+            return AddBox2D(position, BoxSize, 0.0f);
+        }
+
+        void Step()
+        {
+            Step2D(Dt);
+        }
+
+        bool IsSleeping(Entity box)
+        {
+            return world.Get<const RigidBody2D>(box).isSleeping;
+        }
+
+        // Steps until every box sleeps, at most maxSteps times
+        bool SettleAndSleep(int maxSteps)
+        {
+            for (int step = 0; step < maxSteps; ++step) {
+                Step();
+                if (std::all_of(boxes.begin(), boxes.end(), [this](Entity box) { return IsSleeping(box); }))
+                    return true;
+            }
+            return false;
+        }
+    };
+}
+
+void TestIslandBuilder() {
+    IslandBuilder islands;
+    islands.Reset(6);
+    islands.Link(4, 2);
+    islands.Link(5, 3);
+    islands.Link(2, 0);
+
+    // Islands come in the order of their lowest body, their bodies in increasing order
+    islands.Build();
+    ACASSERT(islands.GetIslandCount() == 3, "TestIslandBuilder failed: " << islands.GetIslandCount() << " islands, expected 3");
+    const std::vector<std::vector<uint32_t>> expected = { { 0, 2, 4 }, { 1 }, { 3, 5 } };
+    for (uint32_t island = 0; island < islands.GetIslandCount(); ++island) {
+        uint32_t count;
+        const uint32_t* bodies = islands.GetIslandBodies(island, count);
+        ACASSERT(std::vector<uint32_t>(bodies, bodies + count) == expected[island], "TestIslandBuilder failed: wrong bodies in island " << island);
+    }
+    ACASSERT(islands.Find(4) == islands.Find(0) && islands.Find(1) != islands.Find(0), "TestIslandBuilder failed: Find disagrees with the islands");
+
+    ACMSG("TestIslandBuilder passed");
+}
+
+void TestSleepStackFallsAsleep() {
+    SleepScene scene(3);
+    bool asleep = scene.SettleAndSleep(300);
+    ACASSERT(asleep, "TestSleepStackFallsAsleep failed: the stack never fell asleep");
+
+    // The boxes rest on each other, so they sleep as one island; the ground links nothing
+    PhysicsSleep& sleep = scene.world.GetResourse<PhysicsSleep>();
+    ACASSERT(sleep.bodies2D.GetIslandCount() == 1, "TestSleepStackFallsAsleep failed: " << sleep.bodies2D.GetIslandCount() << " sleeping islands, expected 1");
+
+    // Sleeping bodies are neither integrated nor pushed by the solver, nor marked changed
+    std::vector<glm::vec3> positions;
+    for (Entity box : scene.boxes)
+        positions.push_back(scene.world.Get<const Transform>(box).position);
+    uint32_t tick = scene.world.GetChangeTick();
+    for (int step = 0; step < 60; ++step)
+        scene.Step();
+    for (size_t i = 0; i < scene.boxes.size(); ++i) {
+        ACASSERT(scene.IsSleeping(scene.boxes[i]), "TestSleepStackFallsAsleep failed: box " << i << " woke up on its own");
+        ACASSERT(scene.world.Get<const Transform>(scene.boxes[i]).position == positions[i], "TestSleepStackFallsAsleep failed: sleeping box " << i << " moved");
+        ACASSERT(!scene.world.IsChanged<Transform>(scene.boxes[i], tick) && !scene.world.IsChanged<RigidBody2D>(scene.boxes[i], tick),
+            "TestSleepStackFallsAsleep failed: sleeping box " << i << " was marked changed");
+    }
+
+    ACMSG("TestSleepStackFallsAsleep passed");
+}
+
+void TestSleepImpulseWakesIsland() {
+    SleepScene scene(3);
+    bool asleep = scene.SettleAndSleep(300);
+    ACASSERT(asleep, "TestSleepImpulseWakesIsland failed: the stack never fell asleep");
+
+    // The impulse wakes the top box at once, the next step the rest of its island
+    scene.world.Get<RigidBody2D>(scene.boxes.back()).ApplyImpulse(glm::vec2(5.0f, 0.0f));
+    ACASSERT(!scene.IsSleeping(scene.boxes.back()), "TestSleepImpulseWakesIsland failed: the impulse did not wake the box");
+    scene.Step();
+    for (size_t i = 0; i < scene.boxes.size(); ++i)
+        ACASSERT(!scene.IsSleeping(scene.boxes[i]), "TestSleepImpulseWakesIsland failed: box " << i << " still sleeps");
+    ACASSERT(scene.world.GetResourse<PhysicsSleep>().bodies2D.GetIslandCount() == 0, "TestSleepImpulseWakesIsland failed: the island is still kept");
+
+    ACMSG("TestSleepImpulseWakesIsland passed");
+}
+
+void TestSleepContactWakesIsland() {
+    SleepScene scene(3);
+    bool asleep = scene.SettleAndSleep(300);
+    ACASSERT(asleep, "TestSleepContactWakesIsland failed: the stack never fell asleep");
+
+    // A box dropped on top wakes the whole stack when it lands
+    float top = scene.world.Get<const Transform>(scene.boxes.back()).position.y;
+    scene.AddBox(glm::vec2(0.0f, top + BoxSize * 3.0f));
+    bool woken = false;
+    for (int step = 0; step < 120 && !woken; ++step) {
+        scene.Step();
+        woken = !scene.IsSleeping(scene.boxes.front());
+    }
+    ACASSERT(woken, "TestSleepContactWakesIsland failed: the falling box did not wake the stack");
+
+    ACMSG("TestSleepContactWakesIsland passed");
+}
+
+void TestSleepRemovalWakesIsland() {
+    // Destroying the bottom box wakes the boxes it held up
+    SleepScene destroyed(3);
+    ACASSERT(destroyed.SettleAndSleep(300), "TestSleepRemovalWakesIsland failed: the stack never fell asleep");
+    destroyed.world.DeleteEntity(destroyed.boxes.front());
+    destroyed.Step();
+    for (size_t i = 1; i < destroyed.boxes.size(); ++i)
+        ACASSERT(!destroyed.IsSleeping(destroyed.boxes[i]), "TestSleepRemovalWakesIsland failed: box " << i << " sleeps after the bottom box was destroyed");
+
+    // So does taking away its collider, and the top box falls through it
+    SleepScene uncollided(3);
+    ACASSERT(uncollided.SettleAndSleep(300), "TestSleepRemovalWakesIsland failed: the stack never fell asleep");
+    uncollided.world.Delete<RectCollider2D>(uncollided.boxes[1]);
+    uncollided.Step();
+    for (size_t i = 0; i < uncollided.boxes.size(); ++i)
+        ACASSERT(!uncollided.IsSleeping(uncollided.boxes[i]), "TestSleepRemovalWakesIsland failed: box " << i << " sleeps after a collider was removed");
+    ACASSERT(uncollided.world.GetResourse<PhysicsSleep>().bodies2D.GetIslandCount() == 0, "TestSleepRemovalWakesIsland failed: the island is still kept");
+    float top = uncollided.world.Get<const Transform>(uncollided.boxes.back()).position.y;
+    for (int step = 0; step < 30; ++step)
+        uncollided.Step();
+    ACASSERT(uncollided.world.Get<const Transform>(uncollided.boxes.back()).position.y < top - BoxSize * 0.5f,
+        "TestSleepRemovalWakesIsland failed: the top box did not fall");
+
+    ACMSG("TestSleepRemovalWakesIsland passed");
+}
+
+void RunAllSleepTests() {
+    TestIslandBuilder();
+    TestSleepStackFallsAsleep();
+    TestSleepImpulseWakesIsland();
+    TestSleepContactWakesIsland();
+    TestSleepRemovalWakesIsland();
+
+    ACMSG("=== All Sleep tests completed ===");
+}
@@ -0,0 +1,9 @@
+// SleepTest.h
+#pragma once
+
+void TestIslandBuilder();
+void TestSleepStackFallsAsleep();
+void TestSleepImpulseWakesIsland();
+void TestSleepContactWakesIsland();
+void TestSleepRemovalWakesIsland();
+void RunAllSleepTests();
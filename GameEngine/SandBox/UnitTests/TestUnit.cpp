@@ -177,4 +177,12 @@ void StartTest() {
 
     RunAllWorldTests();
 
+    RunAllLogTests();
+
+    RunAllBroadphaseTests();
+    RunAllNarrowphaseTests();
+    RunAllContactSolverTests();
+    RunAllSleepTests();
+    RunAllContinuousCollisionTests();
+
 }
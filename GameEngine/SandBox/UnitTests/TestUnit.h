@@ -1,9 +1,15 @@
 // TestUnit.h
 #pragma once
 #include "TimeTest.h"
+#include "LogTest.h"
 #include "Benchmark.h"
 #include "WorldTest.h"
 #include "TestPhysics.h"
+#include "NarrowphaseTest.h"
+#include "ContactSolverTest.h"
+#include "SleepTest.h"
+#include "ContinuousCollisionTest.h"
+#include "BroadphaseTest.h"
 using namespace ac;
 struct TestComponent {
     int value;
@@ -117,6 +117,48 @@ void TestGetFrameRate() {
     ACMSG("TestGetFrameRate passed");
 }
 
+void TestTimeFixedStep() {
+    ac::Time time;
+    const float step = 1.0f / 60.0f;
+    ACASSERT(time.FixedDelta() == step, "TestTimeFixedStep failed: FixedDelta should default to 1/60 s");
+    ACASSERT(time.FixedStepCount() == 0, "TestTimeFixedStep failed: no fixed step should be due before the first frame");
+
+    // Two and a half steps: two run now, half a step is left for the next frame
+    time.Advance(step * 2.5f);
+    ACASSERT(time.FixedStepCount() == 2, "TestTimeFixedStep failed: expected 2 fixed steps, got " << time.FixedStepCount());
+    ACASSERT(std::abs(time.InterpolationAlpha() - 0.5f) < 1e-3f, "TestTimeFixedStep failed: expected alpha 0.5, got " << time.InterpolationAlpha());
+
+    // The remainder carries over
+    time.Advance(step * 0.75f);
+    ACASSERT(time.FixedStepCount() == 1, "TestTimeFixedStep failed: leftover time should complete a step");
+    ACASSERT(std::abs(time.InterpolationAlpha() - 0.25f) < 1e-3f, "TestTimeFixedStep failed: expected alpha 0.25, got " << time.InterpolationAlpha());
+
+    // A frame shorter than a step runs none
+    time.Advance(step * 0.5f);
+    ACASSERT(time.FixedStepCount() == 0, "TestTimeFixedStep failed: a short frame should not run a fixed step");
+    ACASSERT(std::abs(time.FixedTime() - 3.0 * step) < 1e-5, "TestTimeFixedStep failed: FixedTime should count the steps run");
+
+    // Changing the step keeps the fraction of a step pending
+    float alpha = time.InterpolationAlpha();
+    time.SetFixedDelta(1.0f / 30.0f);
+    ACASSERT(std::abs(time.InterpolationAlpha() - alpha) < 1e-5f, "TestTimeFixedStep failed: SetFixedDelta should keep the interpolation alpha");
+    ACMSG("TestTimeFixedStep passed");
+}
+
+void TestTimeFixedStepClamp() {
+    ac::Time time;
+    time.SetMaxFixedSteps(3);
+
+    // A half second hitch would need 30 steps; only 3 run and all but a quarter step is dropped
+    time.Advance(0.5f + time.FixedDelta() * 0.25f);
+    ACASSERT(time.FixedStepCount() == 3, "TestTimeFixedStepClamp failed: expected 3 fixed steps, got " << time.FixedStepCount());
+    ACASSERT(time.InterpolationAlpha() >= 0.0f && time.InterpolationAlpha() < 1.0f, "TestTimeFixedStepClamp failed: alpha out of [0, 1)");
+
+    time.Advance(time.FixedDelta());
+    ACASSERT(time.FixedStepCount() == 1, "TestTimeFixedStepClamp failed: the dropped time should not run on the next frame");
+    ACMSG("TestTimeFixedStepClamp passed");
+}
+
 void TestAllTimeMethods() {
     TestTimeConstructor();
     TestTimeUpdate();
@@ -126,5 +168,7 @@ void TestAllTimeMethods() {
     TestCurTime();
     TestRealCurTime();
     TestGetFrameRate();
+    TestTimeFixedStep();
+    TestTimeFixedStepClamp();
     ACMSG("All Time class tests completed");
 }
\ No newline at end of file
@@ -9,4 +9,6 @@ void TestTimeScale();
 void TestCurTime();
 void TestRealCurTime();
 void TestGetFrameRate();
+void TestTimeFixedStep();
+void TestTimeFixedStepClamp();
 void TestAllTimeMethods();
\ No newline at end of file
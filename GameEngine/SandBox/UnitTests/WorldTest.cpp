@@ -11,6 +11,40 @@ struct TestWorldComponentB {
     float value;
 };
 
+struct TestWorldFlag {
+};
+
+// Never added to any entity
+struct TestWorldUnusedComponent {
+    int value;
+};
+
+// Stored field by field through its SoALayout
+struct TestWorldParticle {
+    float position = 0.0f;
+    float velocity = 0.0f;
+    bool frozen = false;
+};
+
+struct TestWorldParticleRef {
+    float& position;
+    float& velocity;
+    bool& frozen;
+};
+
+struct TestWorldParticleConstRef {
+    const float& position;
+    const float& velocity;
+    const bool& frozen;
+};
+
+template <>
+struct ac::SoALayout<TestWorldParticle> {
+    using Fields = ac::SoAFields<&TestWorldParticle::position, &TestWorldParticle::velocity, &TestWorldParticle::frozen>;
+    using Ref = TestWorldParticleRef;
+    using ConstRef = TestWorldParticleConstRef;
+};
+
 // Test resources
 struct TestWorldResource {
     std::string name;
@@ -176,6 +210,35 @@ void TestWorldDeleteEntity() {
     ACMSG("TestWorldDeleteEntity passed");
 }
 
+void TestWorldStaleEntityHandle() {
+    ac::World world;
+
+    auto entity1 = world.CreateEntity("Entity1");
+    world.Add<TestWorldComponent>(entity1, {1});
+    world.DeleteEntity(entity1);
+
+    // The index is recycled with a new generation
+    auto entity2 = world.CreateEntity("Entity2");
+    world.Add<TestWorldComponent>(entity2, {2});
+
+    ACASSERT(ac::EntityIndex(entity1) == ac::EntityIndex(entity2) && entity1 != entity2,
+             "TestWorldStaleEntityHandle failed: recycled entity should keep its index but change generation");
+    ACASSERT(ac::EntityGeneration(entity2) == ac::EntityGeneration(entity1) + 1,
+             "TestWorldStaleEntityHandle failed: generation was not bumped on delete");
+
+    // The stale handle must not alias the new entity
+    ACASSERT(!world.IsAlive(entity1) && world.IsAlive(entity2),
+             "TestWorldStaleEntityHandle failed: stale handle reported alive");
+    ACASSERT(!world.Has<TestWorldComponent>(entity1),
+             "TestWorldStaleEntityHandle failed: stale handle reported component");
+    ACASSERT(world.GetPtr<TestWorldComponent>(entity1) == nullptr,
+             "TestWorldStaleEntityHandle failed: stale handle returned component");
+    ACASSERT(world.Get<TestWorldComponent>(entity2).value == 2,
+             "TestWorldStaleEntityHandle failed: new entity lost its component");
+
+    ACMSG("TestWorldStaleEntityHandle passed");
+}
+
 void TestWorldHasMethods() {
     ac::World world;
     
@@ -283,6 +346,608 @@ void TestWorldSimpleView() {
     ACMSG("TestWorldSimpleView passed");
 }
 
+void TestWorldArchetypeStorage() {
+    ac::World world;
+    world.RegisterType<TestWorldComponent>(ac::ComponentStorage::Archetype);
+    world.RegisterType<TestWorldComponentB>(ac::ComponentStorage::Archetype);
+    world.RegisterType<int>();
+
+    auto entity1 = world.CreateEntity("Entity1"); // Component + ComponentB
+    auto entity2 = world.CreateEntity("Entity2"); // Component only
+    auto entity3 = world.CreateEntity("Entity3"); // Component + ComponentB + int
+
+    world.Add<TestWorldComponent>(entity1, {1});
+    world.Add<TestWorldComponentB>(entity1, {1.5f});
+    world.Add<TestWorldComponent>(entity2, {2});
+    world.Add<TestWorldComponent>(entity3, {3});
+    world.Add<TestWorldComponentB>(entity3, {3.5f});
+    world.Add<int>(entity3, 30);
+
+    // Components must survive moving between archetype tables
+    ACASSERT(world.Get<TestWorldComponent>(entity1).value == 1 &&
+             world.Get<TestWorldComponent>(entity3).value == 3,
+             "TestWorldArchetypeStorage failed: component value lost after archetype move");
+    ACASSERT(world.GetPtr<TestWorldComponentB>(entity2) == nullptr,
+             "TestWorldArchetypeStorage failed: missing component should return nullptr");
+
+    // View over archetype components only walks matching tables
+    int count = 0;
+    float sum = 0;
+    world.View<TestWorldComponent, TestWorldComponentB>().ForEach([&](ac::Entity id, TestWorldComponent& a, TestWorldComponentB& b) {
+        ACASSERT(id != entity2, "TestWorldArchetypeStorage failed: unexpected entity in archetype view");
+        ++count;
+        sum += a.value + b.value;
+    });
+    ACASSERT(count == 2 && sum == 9.0f, "TestWorldArchetypeStorage failed: archetype view iterated wrong entities");
+
+    // Mixed view over archetype and sparse set components
+    count = 0;
+    world.View<TestWorldComponent, int>().ForEach([&](ac::Entity id, TestWorldComponent& a, int& i) {
+        ACASSERT(id == entity3 && a.value == 3 && i == 30, "TestWorldArchetypeStorage failed: mixed view returned wrong data");
+        ++count;
+    });
+    ACASSERT(count == 1, "TestWorldArchetypeStorage failed: mixed view should contain exactly 1 entity");
+
+    // Removing a component moves the entity to a smaller archetype
+    world.Delete<TestWorldComponentB>(entity1);
+    ACASSERT(!world.Has<TestWorldComponentB>(entity1) && world.Get<TestWorldComponent>(entity1).value == 1,
+             "TestWorldArchetypeStorage failed: delete component corrupted archetype row");
+    ACASSERT(world.Get<TestWorldComponentB>(entity3).value == 3.5f,
+             "TestWorldArchetypeStorage failed: swap-remove corrupted other entity");
+
+    // Deleting an entity removes its row from every storage
+    world.DeleteEntity(entity3);
+    count = 0;
+    world.View<TestWorldComponent>().ForEach([&](TestWorldComponent& a) {
+        ++count;
+    });
+    ACASSERT(count == 2, "TestWorldArchetypeStorage failed: deleted entity still in archetype view");
+    ACASSERT(world.Get<TestWorldComponent>(entity2).value == 2,
+             "TestWorldArchetypeStorage failed: delete entity corrupted other entity");
+
+    // Removing the only archetype component of an entity drops it from the storage
+    world.Delete<TestWorldComponent>(entity2);
+    ACASSERT(!world.Has<TestWorldComponent>(entity2) && world.IsAlive(entity2),
+             "TestWorldArchetypeStorage failed: deleting the last archetype component failed");
+    ACASSERT(world.GetComponentCount<TestWorldComponent>() == 1 && world.GetComponentCount<TestWorldComponentB>() == 0,
+             "TestWorldArchetypeStorage failed: component count wrong after deleting the last archetype component");
+
+    ACMSG("TestWorldArchetypeStorage passed");
+}
+
+void TestWorldSoAStorage() {
+    ac::World world;
+    world.RegisterType<TestWorldParticle>();
+    world.RegisterType<TestWorldComponent>();
+
+    float addedPosition = -1.0f;
+    world.GetResourse<ac::EventManager>().AddListener<ac::OnAdded<TestWorldParticle>>(
+        [&addedPosition](const ac::OnAdded<TestWorldParticle>& event) {
+            addedPosition = event.component.position;
+            return true;
+        });
+
+    std::vector<ac::Entity> entities;
+    for (int i = 0; i < 4; ++i) {
+        entities.push_back(world.CreateEntity());
+        world.Add<TestWorldParticle>(entities[i], { float(i), 1.0f, i == 2 });
+    }
+    world.Add<TestWorldComponent>(entities[1], { 10 });
+    world.Add<TestWorldComponent>(entities[3], { 30 });
+    ACASSERT(addedPosition == 3.0f, "TestWorldSoAStorage failed: OnAdded did not see the stored fields");
+
+    // Get hands out a proxy whose members refer to the stored fields
+    TestWorldParticleRef particle = world.Get<TestWorldParticle>(entities[1]);
+    particle.velocity = 2.0f;
+    ACASSERT(world.Get<const TestWorldParticle>(entities[1]).velocity == 2.0f,
+             "TestWorldSoAStorage failed: write through proxy was lost");
+
+    // Every field lives in its own column, row-aligned with the pool's entities
+    ac::SparseSet<TestWorldParticle>* pool = &world.GetSoAPool<TestWorldParticle>();
+    std::span<float> positions = pool->Columns().Column<&TestWorldParticle::position>();
+    std::span<bool> frozen = pool->Columns().Column<&TestWorldParticle::frozen>();
+    ACASSERT(positions.size() == 4 && positions[2] == 2.0f && frozen[2] && !frozen[3],
+             "TestWorldSoAStorage failed: columns do not match the added components");
+
+    // Views hand out proxies for required and SoAPtr for optional SoA components
+    world.View<TestWorldParticle>().ForEach([](TestWorldParticleRef p) {
+        if (!p.frozen)
+            p.position += p.velocity;
+    });
+    float sum = 0.0f;
+    int count = 0;
+    world.View<TestWorldComponent>(ac::Optional<const TestWorldParticle>{}).ForEach(
+        [&](ac::Entity id, TestWorldComponent& c, ac::ComponentPtr<const TestWorldParticle> p) {
+            ACASSERT(p != nullptr, "TestWorldSoAStorage failed: optional SoA component missing");
+            sum += p->position;
+            ++count;
+        });
+    ACASSERT(count == 2 && sum == (1.0f + 2.0f) + (3.0f + 1.0f),
+             "TestWorldSoAStorage failed: view did not integrate through proxies");
+    for (auto [id, p, c] : world.View<const TestWorldParticle, TestWorldComponent>())
+        ACASSERT(p.position == (id == entities[1] ? 3.0f : 4.0f), "TestWorldSoAStorage failed: range-for returned wrong proxy");
+
+    // Writing fields keeps rows in place, so the layout version only moves when rows do
+    uint64_t layout = world.GetLayoutVersion<TestWorldParticle>();
+    world.Get<TestWorldParticle>(entities[3]).velocity = 0.5f;
+    ACASSERT(world.GetLayoutVersion<TestWorldParticle>() == layout,
+             "TestWorldSoAStorage failed: field write changed the layout version");
+
+    // Swap-remove moves the last row of every column into the freed slot
+    world.DeleteEntity(entities[0]);
+    ACASSERT(world.GetLayoutVersion<TestWorldParticle>() != layout,
+             "TestWorldSoAStorage failed: delete did not change the layout version");
+    ACASSERT(pool->Size() == 3 && world.Get<const TestWorldParticle>(entities[3]).position == 4.0f &&
+             world.Get<const TestWorldParticle>(entities[2]).frozen,
+             "TestWorldSoAStorage failed: delete corrupted other rows");
+    ACASSERT(world.GetPtr<TestWorldParticle>(entities[0]) == nullptr,
+             "TestWorldSoAStorage failed: deleted entity should return nullptr");
+
+    ACMSG("TestWorldSoAStorage passed");
+}
+
+void TestSparseSetPaging() {
+    ac::SparseSet<int> set;
+
+    // Ids far apart land in separate pages without touching the ones in between
+    set.Set(3, 3);
+    set.Set(100000, 100000);
+    set.Set(5000000, 5000000);
+
+    ACASSERT(set.Size() == 3, "TestSparseSetPaging failed: wrong size after insert");
+    ACASSERT(set.Contains(100000) && *set.Get(5000000) == 5000000,
+             "TestSparseSetPaging failed: lookup of high entity ID failed");
+    ACASSERT(!set.Contains(4) && !set.Contains(99999999) && set.Get(99999999) == nullptr,
+             "TestSparseSetPaging failed: unknown or out of range ID reported as present");
+
+    // Deleting keeps the remaining entries reachable, and emptied pages can be reused
+    set.Delete(3);
+    ACASSERT(!set.Contains(3) && set.Contains(5000000) && set.GetRef(100000) == 100000,
+             "TestSparseSetPaging failed: delete corrupted other entries");
+    set.Set(7, 7);
+    ACASSERT(set.Contains(7) && set.Size() == 3, "TestSparseSetPaging failed: re-adding into freed page failed");
+
+    set.Clear();
+    ACASSERT(set.Size() == 0 && !set.Contains(100000), "TestSparseSetPaging failed: clear did not remove entries");
+
+    ACMSG("TestSparseSetPaging passed");
+}
+
+void TestWorldTypeID() {
+    size_t idA = ac::TypeID<ac::ComponentFamily>::Get<TestWorldComponent>();
+    size_t idB = ac::TypeID<ac::ComponentFamily>::Get<TestWorldComponentB>();
+
+    ACASSERT(idA != idB, "TestWorldTypeID failed: different types share an id");
+    ACASSERT(idA == ac::TypeID<ac::ComponentFamily>::Get<TestWorldComponent>(),
+             "TestWorldTypeID failed: id is not stable");
+    ACASSERT(idA == ac::TypeID<ac::ComponentFamily>::Get<const TestWorldComponent>(),
+             "TestWorldTypeID failed: const type should share the id of its type");
+
+    // Bitmask indices are per world even though type ids are global
+    ac::World world1;
+    ac::World world2;
+    world1.RegisterType<TestWorldComponent>();
+    world2.RegisterType<TestWorldComponentB>();
+    world2.RegisterType<TestWorldComponent>();
+    auto entity = world2.CreateEntity();
+    world2.Add<TestWorldComponent>(entity, {5});
+    ACASSERT(world2.Has<TestWorldComponent>(entity) && !world2.Has<TestWorldComponentB>(entity),
+             "TestWorldTypeID failed: component lookup used the wrong bitmask index");
+
+    ACMSG("TestWorldTypeID passed");
+}
+
+void TestWorldViewIteration() {
+    ac::World world;
+    std::vector<ac::Entity> entities;
+    for (int i = 0; i < 10; ++i) {
+        auto entity = world.CreateEntity();
+        world.Add<TestWorldComponent>(entity, {i});
+        if (i % 2 == 0)
+            world.Add<TestWorldComponentB>(entity, {i * 0.5f});
+        entities.push_back(entity);
+    }
+
+    // Range-for yields the entity and references to its components
+    int count = 0;
+    for (auto [id, a, b] : world.View<TestWorldComponent, TestWorldComponentB>()) {
+        ACASSERT(a.value % 2 == 0 && b.value == a.value * 0.5f,
+                 "TestWorldViewIteration failed: range-for returned wrong components");
+        a.value += 100;
+        ++count;
+    }
+    ACASSERT(count == 5, "TestWorldViewIteration failed: range-for should visit 5 entities");
+    ACASSERT(world.Get<TestWorldComponent>(entities[0]).value == 100,
+             "TestWorldViewIteration failed: range-for should give mutable references");
+
+    // Removing the current entity inside ForEach must not skip the others
+    count = 0;
+    world.View<TestWorldComponent>().ForEach([&](ac::Entity id, TestWorldComponent& a) {
+        ++count;
+        if (a.value < 100)
+            world.DeleteEntity(id);
+    });
+    ACASSERT(count == 10, "TestWorldViewIteration failed: ForEach skipped entities while deleting");
+    ACASSERT(world.GetEntityCount() == 5, "TestWorldViewIteration failed: wrong entity count after deleting in ForEach");
+
+    ACMSG("TestWorldViewIteration passed");
+}
+
+void TestWorldParallelForEach() {
+    ac::World world;
+    world.RegisterType<TestWorldComponentB>(ac::ComponentStorage::Archetype);
+    const int count = 10000;
+    for (int i = 0; i < count; ++i) {
+        auto entity = world.CreateEntity();
+        world.Add<TestWorldComponent>(entity, {i});
+        world.Add<TestWorldComponentB>(entity, {1.0f});
+    }
+
+    // Every entity must be visited exactly once across all chunks
+    world.View<TestWorldComponent>().ParallelForEach([](TestWorldComponent& a) {
+        a.value += 1;
+    }, 64);
+    long long sum = 0;
+    world.View<TestWorldComponent>().ForEach([&](TestWorldComponent& a) {
+        sum += a.value;
+    });
+    ACASSERT(sum == (long long)count * (count + 1) / 2,
+             "TestWorldParallelForEach failed: sparse set entities visited wrong number of times");
+
+    // Archetype tables are split into chunks as well
+    std::atomic<int> visited{ 0 };
+    world.View<TestWorldComponentB>().ParallelForEach([&](ac::Entity id, TestWorldComponentB& b) {
+        b.value *= 2.0f;
+        visited.fetch_add(1);
+    }, 100);
+    ACASSERT(visited == count && world.Get<TestWorldComponentB>(0).value == 2.0f,
+             "TestWorldParallelForEach failed: archetype entities visited wrong number of times");
+
+    ACMSG("TestWorldParallelForEach passed");
+}
+
+void TestWorldCommandBuffer() {
+    ac::World world;
+    std::vector<ac::Entity> entities;
+    for (int i = 0; i < 100; ++i) {
+        auto entity = world.CreateEntity();
+        world.Add<TestWorldComponent>(entity, {i});
+        entities.push_back(entity);
+    }
+
+    // Structural changes recorded during iteration are applied only at playback
+    ac::CommandBuffer cmd;
+    world.View<TestWorldComponent>().ForEach([&](ac::Entity id, TestWorldComponent& a) {
+        if (a.value % 2 == 1)
+            cmd.DeleteEntity(id);
+        else
+            cmd.Add<TestWorldComponentB>(id, {1.0f});
+    });
+    ac::Entity spawned = cmd.CreateEntity("Spawned");
+    cmd.Add<TestWorldComponent>(spawned, {1000});
+    cmd.Add<TestWorldComponentB>(spawned, {2.0f});
+    ACASSERT(world.GetEntityCount() == 100 && ac::CommandBuffer::IsDeferred(spawned),
+             "TestWorldCommandBuffer failed: commands were applied before playback");
+
+    int addedEvents = 0;
+    size_t storedWhenNotified = 0;
+    world.GetResourse<ac::EventManager>().AddListener<ac::OnAdded<TestWorldComponentB>>([&](const ac::OnAdded<TestWorldComponentB>& event) {
+        if (addedEvents++ == 0)
+            event.world.View<TestWorldComponentB>().ForEach([&](TestWorldComponentB&) { ++storedWhenNotified; });
+        return true;
+    });
+    cmd.Playback(world);
+
+    ACASSERT(cmd.Empty(), "TestWorldCommandBuffer failed: buffer not cleared by playback");
+    ACASSERT(world.GetEntityCount() == 51, "TestWorldCommandBuffer failed: wrong entity count after playback");
+    ACASSERT(!world.IsAlive(entities[1]) && world.Has<TestWorldComponentB>(entities[0]),
+             "TestWorldCommandBuffer failed: recorded commands not applied");
+    ACASSERT(addedEvents == 51 && storedWhenNotified == 51,
+             "TestWorldCommandBuffer failed: OnAdded events did not fire after the whole batch");
+    int spawnedCount = 0;
+    world.View<TestWorldComponent, TestWorldComponentB>().ForEach([&](TestWorldComponent& a, TestWorldComponentB& b) {
+        if (a.value == 1000 && b.value == 2.0f)
+            ++spawnedCount;
+    });
+    ACASSERT(spawnedCount == 1, "TestWorldCommandBuffer failed: deferred entity not created with its components");
+
+    // Commands for entities deleted before playback are skipped
+    cmd.Delete<TestWorldComponent>(entities[0]);
+    cmd.Add<TestWorldComponent>(entities[2], {5});
+    world.DeleteEntity(entities[2]);
+    cmd.Playback(world);
+    ACASSERT(!world.Has<TestWorldComponent>(entities[0]) && !world.IsAlive(entities[2]),
+             "TestWorldCommandBuffer failed: stale commands not skipped");
+
+    // Deletes fire OnDeleted while the whole batch is still stored, then one OnDeletedBatch once it is gone
+    std::vector<ac::Entity> withB;
+    world.View<TestWorldComponentB>().ForEach([&](ac::Entity id, TestWorldComponentB&) { withB.push_back(id); });
+    withB.resize(withB.size() / 2);
+    size_t deletedEvents = 0;
+    size_t storedWhenDeleted = 0;
+    int deletedBatchEvents = 0;
+    size_t deletedBatchSize = 0;
+    size_t storedAfterBatch = 0;
+    world.GetResourse<ac::EventManager>().AddListener<ac::OnDeleted<TestWorldComponentB>>([&](const ac::OnDeleted<TestWorldComponentB>& event) {
+        if (deletedEvents++ == 0)
+            event.world.View<TestWorldComponentB>().ForEach([&](TestWorldComponentB&) { ++storedWhenDeleted; });
+        return true;
+    });
+    world.GetResourse<ac::EventManager>().AddListener<ac::OnDeletedBatch<TestWorldComponentB>>([&](const ac::OnDeletedBatch<TestWorldComponentB>& event) {
+        ++deletedBatchEvents;
+        deletedBatchSize = event.IDs.size();
+        event.world.View<TestWorldComponentB>().ForEach([&](TestWorldComponentB&) { ++storedAfterBatch; });
+        return true;
+    });
+    size_t storedBefore = 0;
+    world.View<TestWorldComponentB>().ForEach([&](TestWorldComponentB&) { ++storedBefore; });
+    for (ac::Entity id : withB)
+        cmd.Delete<TestWorldComponentB>(id);
+    cmd.Delete<TestWorldComponentB>(withB[0]);
+    cmd.Playback(world);
+    ACASSERT(deletedEvents == withB.size() && storedWhenDeleted == storedBefore,
+             "TestWorldCommandBuffer failed: OnDeleted events did not fire before the batch was removed");
+    ACASSERT(deletedBatchEvents == 1 && deletedBatchSize == withB.size() && storedAfterBatch == storedBefore - withB.size(),
+             "TestWorldCommandBuffer failed: OnDeletedBatch not fired once after the batch was removed");
+
+    // Per-thread buffers record from parallel iteration and flush at the end of the phase
+    world.View<TestWorldComponentB>().ParallelForEach([&](ac::Entity id, TestWorldComponentB&) {
+        world.GetCommandBuffer().Delete<TestWorldComponentB>(id);
+    }, 4);
+    world.RunUpdateSystems();
+    int remaining = 0;
+    world.View<TestWorldComponentB>().ForEach([&](TestWorldComponentB&) { ++remaining; });
+    ACASSERT(remaining == 0, "TestWorldCommandBuffer failed: per-thread buffers not flushed");
+
+    ACMSG("TestWorldCommandBuffer passed");
+}
+
+void TestWorldBatchOperations() {
+    ac::World world;
+    int addedEvents = 0;
+    int batchEvents = 0;
+    size_t batchSize = 0;
+    world.GetResourse<ac::EventManager>().AddListener<ac::OnAdded<TestWorldComponent>>([&](const ac::OnAdded<TestWorldComponent>&) {
+        ++addedEvents;
+        return true;
+    });
+    world.GetResourse<ac::EventManager>().AddListener<ac::OnAddedBatch<TestWorldComponentB>>([&](const ac::OnAddedBatch<TestWorldComponentB>& event) {
+        ++batchEvents;
+        batchSize = event.IDs.size();
+        return true;
+    });
+
+    // Every new entity gets a copy of the prototype components
+    std::vector<ac::Entity> ids = world.CreateEntities(1000, TestWorldComponent{3}, TestWorldComponentB{1.5f});
+    ACASSERT(ids.size() == 1000 && world.GetEntityCount() == 1000,
+             "TestWorldBatchOperations failed: wrong number of entities created");
+    int matching = 0;
+    world.View<TestWorldComponent, TestWorldComponentB>().ForEach([&](TestWorldComponent& a, TestWorldComponentB& b) {
+        if (a.value == 3 && b.value == 1.5f)
+            ++matching;
+    });
+    ACASSERT(matching == 1000, "TestWorldBatchOperations failed: prototype components not copied");
+    ACASSERT(addedEvents == 1000, "TestWorldBatchOperations failed: OnAdded not fired per entity");
+    ACASSERT(batchEvents == 1 && batchSize == 1000, "TestWorldBatchOperations failed: OnAddedBatch not fired once per type");
+
+    // AddBatch writes one component per entity
+    std::vector<ac::Entity> firstHalf(ids.begin(), ids.begin() + 500);
+    std::vector<TestWorldComponent> values;
+    for (int i = 0; i < 500; ++i)
+        values.push_back({i});
+    world.AddBatch<TestWorldComponent>(firstHalf, values);
+    ACASSERT(world.Get<TestWorldComponent>(ids[42]).value == 42 && world.Get<TestWorldComponent>(ids[700]).value == 3,
+             "TestWorldBatchOperations failed: AddBatch stored wrong components");
+
+    // DeleteEntities removes the entities with all their components and recycles their indices
+    int deletedBatchEvents = 0;
+    size_t deletedBatchSize = 0;
+    world.GetResourse<ac::EventManager>().AddListener<ac::OnDeletedBatch<TestWorldComponent>>([&](const ac::OnDeletedBatch<TestWorldComponent>& event) {
+        ++deletedBatchEvents;
+        deletedBatchSize = event.IDs.size();
+        ACASSERT(!event.world.IsAlive(event.IDs[0]), "TestWorldBatchOperations failed: OnDeletedBatch fired before the entities were deleted");
+        return true;
+    });
+    firstHalf.push_back(firstHalf[0]);
+    world.DeleteEntities(firstHalf);
+    ACASSERT(deletedBatchEvents == 1 && deletedBatchSize == 500, "TestWorldBatchOperations failed: OnDeletedBatch not fired once per type");
+    ACASSERT(world.GetEntityCount() == 500 && !world.IsAlive(ids[0]) && world.IsAlive(ids[500]),
+             "TestWorldBatchOperations failed: DeleteEntities removed wrong entities");
+    std::vector<ac::Entity> recycled = world.CreateEntities(600);
+    ACASSERT(world.GetEntityCount() == 1100 && !world.Has<TestWorldComponent>(recycled[0]) &&
+             ac::EntityIndex(recycled[0]) < 1000 && recycled[0] != ids[ac::EntityIndex(recycled[0])],
+             "TestWorldBatchOperations failed: recycled entities not fresh");
+
+    ACMSG("TestWorldBatchOperations passed");
+}
+
+void TestWorldViewFilters() {
+    for (ac::ComponentStorage storage : { ac::ComponentStorage::SparseSet, ac::ComponentStorage::Archetype }) {
+        ac::World world;
+        world.RegisterType<TestWorldComponent>(storage);
+        world.RegisterType<TestWorldComponentB>(storage);
+        // Entities 0-4 have A, even ones also have B, entity 3 is tagged with the sparse flag
+        std::vector<ac::Entity> ids = world.CreateEntities(5, TestWorldComponent{1});
+        for (int i = 0; i < 5; i += 2)
+            world.Add<TestWorldComponentB>(ids[i], {float(i)});
+        world.Add<TestWorldFlag>(ids[3], {});
+
+        // Exclude skips entities carrying any excluded component, whatever its storage
+        std::vector<ac::Entity> visited;
+        world.View<TestWorldComponent>(ac::Exclude<TestWorldComponentB, TestWorldFlag>{}).ForEach([&](ac::Entity id, TestWorldComponent&) {
+            visited.push_back(id);
+        });
+        ACASSERT(visited.size() == 1 && visited[0] == ids[1], "TestWorldViewFilters failed: Exclude did not skip entities");
+
+        // Excluding a component that was never registered excludes nothing
+        int count = 0;
+        world.View<const TestWorldComponent>(ac::Exclude<TestWorldUnusedComponent>{}).ForEach([&](const TestWorldComponent&) { ++count; });
+        ACASSERT(count == 5, "TestWorldViewFilters failed: unregistered Exclude filtered entities");
+
+        // Optional components come through as pointers, nullptr when absent
+        int withB = 0;
+        int withoutB = 0;
+        world.View<TestWorldComponent>(ac::Optional<const TestWorldComponentB>{}).ForEach(
+            [&](ac::Entity id, TestWorldComponent&, const TestWorldComponentB* b) {
+                if (b != nullptr && b->value == float(ac::EntityIndex(id) - ac::EntityIndex(ids[0])))
+                    ++withB;
+                else if (b == nullptr)
+                    ++withoutB;
+            });
+        ACASSERT(withB == 3 && withoutB == 2, "TestWorldViewFilters failed: Optional pointers are wrong");
+
+        // Filters combine and work with range-for and GetPacked
+        count = 0;
+        for (auto [id, a, flag] : world.View<TestWorldComponent>(ac::Exclude<TestWorldComponentB>{}, ac::Optional<TestWorldFlag>{})) {
+            ACASSERT((flag != nullptr) == (id == ids[3]), "TestWorldViewFilters failed: Optional wrong in range-for");
+            ++count;
+        }
+        auto packed = world.View<TestWorldComponent>(ac::Optional<TestWorldUnusedComponent>{}).GetPacked();
+        ACASSERT(count == 2 && packed.size() == 5 && std::get<1>(packed[0].components) == nullptr,
+                 "TestWorldViewFilters failed: combined filters or unregistered Optional");
+    }
+
+    ACMSG("TestWorldViewFilters passed");
+}
+
+// Collects the entities a query visits, sorted for comparison
+template <class QueryView>
+std::vector<ac::Entity> CollectQuery(QueryView&& view) {
+    std::vector<ac::Entity> visited;
+    view.ForEach([&](ac::Entity id, auto&&...) { visited.push_back(id); });
+    std::sort(visited.begin(), visited.end());
+    return visited;
+}
+
+void TestWorldQuery() {
+    for (ac::ComponentStorage storage : { ac::ComponentStorage::SparseSet, ac::ComponentStorage::Archetype }) {
+        ac::World world;
+        world.RegisterType<TestWorldComponent>(storage);
+        world.RegisterType<TestWorldComponentB>(storage);
+        std::vector<ac::Entity> ids = world.CreateEntities(6, TestWorldComponent{1});
+        for (int i = 0; i < 6; i += 2)
+            world.Add<TestWorldComponentB>(ids[i], {float(i)});
+
+        // A new query picks up the entities that already match
+        auto query = [&world]() { return world.Query<TestWorldComponent, const TestWorldComponentB>(ac::Exclude<TestWorldFlag>{}); };
+        ACASSERT(CollectQuery(query()) == std::vector<ac::Entity>({ ids[0], ids[2], ids[4] }),
+                 "TestWorldQuery failed: initial members are wrong");
+
+        // Adding and deleting components and entities keeps the members in sync
+        world.Add<TestWorldFlag>(ids[2], {});
+        world.Add<TestWorldComponentB>(ids[1], {1.0f});
+        world.Delete<TestWorldComponentB>(ids[0]);
+        world.DeleteEntity(ids[4]);
+        std::vector<ac::Entity> spawned = world.CreateEntities(2, TestWorldComponent{2}, TestWorldComponentB{2.0f});
+        std::vector<ac::Entity> expected = { ids[1], spawned[0], spawned[1] };
+        std::sort(expected.begin(), expected.end());
+        ACASSERT(CollectQuery(query()) == expected, "TestWorldQuery failed: members not updated incrementally");
+        world.Delete<TestWorldFlag>(ids[2]);
+        expected.push_back(ids[2]);
+        std::sort(expected.begin(), expected.end());
+        ACASSERT(CollectQuery(query()) == expected, "TestWorldQuery failed: removing an excluded component");
+
+        // Removing the visited component inside the loop still visits every member once
+        int visited = 0;
+        query().ForEach([&](ac::Entity id, TestWorldComponent&, const TestWorldComponentB&) {
+            ++visited;
+            if (storage == ac::ComponentStorage::SparseSet)
+                world.Delete<TestWorldComponentB>(id);
+        });
+        ACASSERT(visited == 4, "TestWorldQuery failed: deleting during iteration skipped members");
+
+        // Excluded components registered after the query still exclude
+        auto unusedQuery = [&world]() { return world.Query<const TestWorldComponent>(ac::Exclude<TestWorldUnusedComponent>{}); };
+        size_t before = CollectQuery(unusedQuery()).size();
+        world.Add<TestWorldUnusedComponent>(ids[3], {});
+        ACASSERT(before == 7 && CollectQuery(unusedQuery()).size() == 6,
+                 "TestWorldQuery failed: exclusion registered late was ignored");
+    }
+
+    ACMSG("TestWorldQuery passed");
+}
+
+// Counts the entities whose TestWorldComponent changed since the system last ran
+int changedSeenBySystem = 0;
+void TestChangedComponentSystem(ac::World& world) {
+    changedSeenBySystem = 0;
+    world.View<const TestWorldComponent>().Changed<TestWorldComponent>().ForEach([](const TestWorldComponent&) {
+        ++changedSeenBySystem;
+    });
+}
+
+void TestWorldChangeDetection() {
+    ac::World world;
+    std::vector<ac::Entity> ids = world.CreateEntities(10, TestWorldComponent{0});
+
+    // Const access leaves the ticks alone, mutable access stamps the component
+    uint32_t since = world.GetChangeTick();
+    int constRead = world.Get<const TestWorldComponent>(ids[0]).value;
+    world.View<const TestWorldComponent>().ForEach([&](const TestWorldComponent& a) {
+        constRead += a.value;
+    });
+    world.Get<TestWorldComponent>(ids[3]).value = 7;
+    std::vector<ac::Entity> changed;
+    world.View<const TestWorldComponent>().Changed<TestWorldComponent>(since).ForEach([&](ac::Entity id, const TestWorldComponent&) {
+        changed.push_back(id);
+    });
+    ACASSERT(constRead == 0 && changed.size() == 1 && changed[0] == ids[3],
+             "TestWorldChangeDetection failed: Changed filter did not isolate the mutated component");
+
+    // Added only reports components inserted after the tick
+    ac::Entity late = world.CreateEntity();
+    world.Add<TestWorldComponent>(late, {1});
+    int added = 0;
+    for (auto [id, a] : world.View<const TestWorldComponent>().Added<TestWorldComponent>(since)) {
+        ACASSERT(id == late, "TestWorldChangeDetection failed: Added filter visited an old component");
+        ++added;
+    }
+    ACASSERT(added == 1, "TestWorldChangeDetection failed: Added filter missed the new component");
+
+    // Mutable views stamp every entity they visit
+    since = world.GetChangeTick();
+    world.View<TestWorldComponent>().ForEach([](TestWorldComponent&) {});
+    int touched = 0;
+    world.View<const TestWorldComponent>().Changed<TestWorldComponent>(since).ForEach([&](const TestWorldComponent&) {
+        ++touched;
+    });
+    ACASSERT(touched == 11, "TestWorldChangeDetection failed: mutable view did not stamp its components");
+
+    // Inside a system Changed<T>() compares against the system's previous run
+    world.AddUpdateSystem(TestChangedComponentSystem, 0, ac::SystemAccess().Read<TestWorldComponent>());
+    world.RunUpdateSystems();
+    ACASSERT(changedSeenBySystem == 11, "TestWorldChangeDetection failed: first run should see every component");
+    world.RunUpdateSystems();
+    ACASSERT(changedSeenBySystem == 0, "TestWorldChangeDetection failed: unchanged components were visited");
+    world.Get<TestWorldComponent>(ids[5]).value = 2;
+    world.RunUpdateSystems();
+    ACASSERT(changedSeenBySystem == 1, "TestWorldChangeDetection failed: change between runs was missed");
+
+    // IsChanged checks a single entity against an explicit tick without stamping it
+    since = world.GetChangeTick();
+    world.Get<TestWorldComponent>(ids[6]).value = 3;
+    ACASSERT(world.IsChanged<TestWorldComponent>(ids[6], since) && !world.IsChanged<TestWorldComponent>(ids[7], since) &&
+             !world.IsChanged<TestWorldComponentB>(ids[6], since),
+             "TestWorldChangeDetection failed: IsChanged reported the wrong entities");
+
+    // Archetype storage keeps the ticks with the rows when entities move between tables
+    ac::World archetypeWorld;
+    archetypeWorld.RegisterType<TestWorldComponent>(ac::ComponentStorage::Archetype);
+    archetypeWorld.RegisterType<TestWorldComponentB>(ac::ComponentStorage::Archetype);
+    std::vector<ac::Entity> rows = archetypeWorld.CreateEntities(4, TestWorldComponent{0});
+    since = archetypeWorld.GetChangeTick();
+    archetypeWorld.Get<TestWorldComponent>(rows[2]).value = 5;
+    archetypeWorld.Add<TestWorldComponentB>(rows[0], {1.0f});
+    changed.clear();
+    archetypeWorld.View<const TestWorldComponent>().Changed<TestWorldComponent>(since).ForEach([&](ac::Entity id, const TestWorldComponent&) {
+        changed.push_back(id);
+    });
+    ACASSERT(changed.size() == 1 && changed[0] == rows[2],
+             "TestWorldChangeDetection failed: archetype ticks not kept with their rows");
+
+    ACMSG("TestWorldChangeDetection passed");
+}
+
 void TestWorldReset() {
     ac::World world;
     
@@ -412,6 +1077,129 @@ void TestWorldOnDeletedEvent() {
     ACMSG("TestWorldOnDeletedEvent passed");
 }
 
+// Registers the components of a transform hierarchy, as InitEngine does
+void RegisterHierarchyTypes(ac::World& world) {
+    world.RegisterType<ac::Transform>();
+    world.RegisterType<ac::Parent>();
+    world.RegisterType<ac::Children>();
+    world.RegisterType<ac::WorldTransform>();
+}
+
+void TestWorldHierarchy() {
+    ac::World world;
+    RegisterHierarchyTypes(world);
+    ac::Entity root = world.CreateEntity();
+    ac::Entity child = world.CreateEntity();
+    ac::Entity grandChild = world.CreateEntity();
+    ac::Entity other = world.CreateEntity();
+
+    // SetParent keeps the Parent of the child and the Children of the parent in sync
+    ac::SetParent(world, child, root);
+    ac::SetParent(world, grandChild, child);
+    ACASSERT(world.Get<const ac::Parent>(child).entity == root &&
+             world.Get<const ac::Children>(root).entities == std::vector<ac::Entity>({ child }),
+             "TestWorldHierarchy failed: SetParent did not link parent and child");
+    // SetParent asserts when the new parent is a descendant, so root cannot be parented to grandChild
+    ACASSERT(ac::IsDescendant(world, grandChild, root) && !ac::IsDescendant(world, root, grandChild) &&
+             !ac::IsDescendant(world, other, root),
+             "TestWorldHierarchy failed: IsDescendant would not catch a cycle");
+
+    // Reparenting detaches the child from its previous parent
+    ac::SetParent(world, grandChild, other);
+    ACASSERT(world.Get<const ac::Children>(child).entities.empty() &&
+             world.Get<const ac::Children>(other).entities == std::vector<ac::Entity>({ grandChild }) &&
+             !ac::IsDescendant(world, grandChild, root),
+             "TestWorldHierarchy failed: reparenting left the child under its old parent");
+
+    ac::RemoveParent(world, grandChild);
+    ACASSERT(!world.Has<ac::Parent>(grandChild) && world.Get<const ac::Children>(other).entities.empty(),
+             "TestWorldHierarchy failed: RemoveParent did not detach the child");
+
+    // DeleteHierarchy takes every descendant along and leaves the rest alone
+    ac::SetParent(world, grandChild, child);
+    ac::SetParent(world, child, other);
+    ac::DeleteHierarchy(world, child);
+    ACASSERT(!world.IsAlive(child) && !world.IsAlive(grandChild) && world.IsAlive(root) && world.IsAlive(other),
+             "TestWorldHierarchy failed: DeleteHierarchy deleted the wrong entities");
+    ACASSERT(world.Get<const ac::Children>(other).entities.empty(),
+             "TestWorldHierarchy failed: DeleteHierarchy left the root in its parent's Children");
+
+    ACMSG("TestWorldHierarchy passed");
+}
+
+void TestWorldTransformPropagation() {
+    ac::World world;
+    RegisterHierarchyTypes(world);
+    world.AddUpdateSystem(ac::TransformPropagationSystem, 0);
+    auto position = [&world](ac::Entity entity) { return world.Get<const ac::WorldTransform>(entity).Position(); };
+
+    ac::Entity root = world.CreateEntity();
+    ac::Entity left = world.CreateEntity();
+    ac::Entity leftLeaf = world.CreateEntity();
+    ac::Entity right = world.CreateEntity();
+    ac::Entity loose = world.CreateEntity();
+    world.Add<ac::Transform>(root, ac::Transform(glm::vec3(100.0f, 0.0f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), 2.0f));
+    world.Add<ac::Transform>(left, ac::Transform(glm::vec3(-1.0f, 0.0f, 0.0f)));
+    world.Add<ac::Transform>(leftLeaf, ac::Transform(glm::vec3(0.0f, 1.0f, 0.0f)));
+    world.Add<ac::Transform>(right, ac::Transform(glm::vec3(1.0f, 0.0f, 0.0f)));
+    world.Add<ac::Transform>(loose, ac::Transform(glm::vec3(5.0f, 5.0f, 0.0f)));
+    ac::SetParent(world, left, root);
+    ac::SetParent(world, leftLeaf, left);
+    ac::SetParent(world, right, root);
+
+    // Every entity with a Transform gets a WorldTransform, composed with its parents'
+    world.RunUpdateSystems();
+    ACASSERT(world.Has<ac::WorldTransform>(root) && world.Has<ac::WorldTransform>(loose),
+             "TestWorldTransformPropagation failed: missing WorldTransforms not added");
+    ACASSERT(position(loose) == glm::vec3(5.0f, 5.0f, 0.0f) && position(right) == glm::vec3(102.0f, 0.0f, 0.0f) &&
+             position(leftLeaf) == glm::vec3(98.0f, 2.0f, 0.0f),
+             "TestWorldTransformPropagation failed: world positions not composed with the parents'");
+
+    // Moving one branch recomputes it and everything below it, and never visits the clean branch
+    world.Get<ac::WorldTransform>(right).matrix[3] = glm::vec4(-7.0f, -7.0f, -7.0f, 1.0f);
+    uint32_t since = world.GetChangeTick();
+    world.Get<ac::Transform>(left).position.x = -2.0f;
+    world.RunUpdateSystems();
+    ACASSERT(position(leftLeaf) == glm::vec3(96.0f, 2.0f, 0.0f),
+             "TestWorldTransformPropagation failed: the child of a moved entity was not recomputed");
+    ACASSERT(!world.IsChanged<ac::WorldTransform>(root, since) && !world.IsChanged<ac::WorldTransform>(loose, since) &&
+             position(right) == glm::vec3(-7.0f, -7.0f, -7.0f),
+             "TestWorldTransformPropagation failed: a clean branch was recomputed");
+
+    // Moving the root recomputes the whole hierarchy
+    world.Get<ac::Transform>(root).position.x = 0.0f;
+    world.RunUpdateSystems();
+    ACASSERT(position(right) == glm::vec3(2.0f, 0.0f, 0.0f) && position(leftLeaf) == glm::vec3(-4.0f, 2.0f, 0.0f),
+             "TestWorldTransformPropagation failed: moving the root did not update its descendants");
+
+    // Children of a deleted parent become roots in world space
+    world.DeleteEntity(left);
+    world.RunUpdateSystems();
+    ACASSERT(!world.Has<ac::Parent>(leftLeaf) && position(leftLeaf) == glm::vec3(0.0f, 1.0f, 0.0f),
+             "TestWorldTransformPropagation failed: orphan not turned into a root");
+
+    // Independent hierarchies are spread over the workers and all end up right
+    std::vector<ac::Entity> leaves;
+    for (int i = 0; i < 200; ++i) {
+        ac::Entity parent = world.CreateEntity();
+        world.Add<ac::Transform>(parent, ac::Transform(glm::vec3(float(i), 0.0f, 0.0f)));
+        for (int depth = 0; depth < 4; ++depth) {
+            ac::Entity child = world.CreateEntity();
+            world.Add<ac::Transform>(child, ac::Transform(glm::vec3(0.0f, 1.0f, 0.0f)));
+            ac::SetParent(world, child, parent);
+            parent = child;
+        }
+        leaves.push_back(parent);
+    }
+    world.RunUpdateSystems();
+    bool allRight = true;
+    for (int i = 0; i < 200; ++i)
+        allRight = allRight && position(leaves[i]) == glm::vec3(float(i), 4.0f, 0.0f);
+    ACASSERT(allRight, "TestWorldTransformPropagation failed: parallel hierarchies computed wrong positions");
+
+    ACMSG("TestWorldTransformPropagation passed");
+}
+
 // System-related tests implementation for WorldTest.cpp
 
 // Tracking structure to test system execution
@@ -521,6 +1309,39 @@ void TestWorldExecuteSystems() {
     ACMSG("TestWorldExecuteSystems passed");
 }
 
+void TestFixedUpdateSystem(ac::World& world) {
+    systemTracker.executionOrder.push_back(4);
+}
+
+void TestWorldFixedUpdatePhase() {
+    ac::World world;
+    systemTracker.Reset();
+
+    world.AddPreUpdateSystem(TestPreUpdateSystem, 0);
+    world.AddFixedUpdateSystem(TestFixedUpdateSystem, 0);
+    world.AddUpdateSystem(TestUpdateSystem, 0);
+    world.AddPostUpdateSystem(TestPostUpdateSystem, 0);
+
+    // Once per Update by default, between pre-update and update
+    world.Update();
+    std::vector<int> expected = { 1, 4, 2, 3 };
+    ACASSERT(systemTracker.executionOrder == expected, "TestWorldFixedUpdatePhase failed: fixed-update phase should run once between pre-update and update");
+
+    systemTracker.Reset();
+    world.SetFixedUpdateCount(3);
+    world.Update();
+    expected = { 1, 4, 4, 4, 2, 3 };
+    ACASSERT(systemTracker.executionOrder == expected, "TestWorldFixedUpdatePhase failed: fixed-update phase should run as many times as set");
+
+    systemTracker.Reset();
+    world.SetFixedUpdateCount(0);
+    world.Update();
+    expected = { 1, 2, 3 };
+    ACASSERT(systemTracker.executionOrder == expected, "TestWorldFixedUpdatePhase failed: fixed-update phase should be skipped with a count of 0");
+
+    ACMSG("TestWorldFixedUpdatePhase passed");
+}
+
 void TestWorldSystemPriority() {
     ac::World world;
     systemTracker.Reset();
@@ -560,6 +1381,288 @@ void TestWorldSystemPriority() {
     ACMSG("TestWorldSystemPriority passed");
 }
 
+// Systems with declared access for the scheduler test
+void TestWriteComponentSystem(ac::World& world) {
+    world.View<TestWorldComponent>().ForEach([](TestWorldComponent& a) {
+        a.value += 1;
+    });
+}
+
+void TestReadComponentSystem(ac::World& world) {
+    int sum = 0;
+    world.View<TestWorldComponent>().ForEach([&](const TestWorldComponent& a) {
+        sum += a.value;
+    });
+    world.GetResourse<TestWorldResource>().data = sum;
+}
+
+void TestIndependentSystem(ac::World& world) {
+    world.View<TestWorldComponentB>().ForEach([](TestWorldComponentB& b) {
+        b.value += 1.0f;
+    });
+}
+
+void TestWorldSystemScheduler() {
+    ac::World world;
+    world.AddResource<TestWorldResource>(new TestWorldResource{ "Sum", 0 });
+    for (int i = 0; i < 100; ++i) {
+        auto entity = world.CreateEntity();
+        world.Add<TestWorldComponent>(entity, {0});
+        world.Add<TestWorldComponentB>(entity, {0.0f});
+    }
+
+    // The reader conflicts with the writer, so priority keeps it after the writer
+    world.AddUpdateSystem(TestReadComponentSystem, 5,
+        ac::SystemAccess().Read<TestWorldComponent>().WriteResource<TestWorldResource>());
+    world.AddUpdateSystem(TestWriteComponentSystem, 0,
+        ac::SystemAccess().Write<TestWorldComponent>());
+    // Touches unrelated data and may run alongside both
+    world.AddUpdateSystem(TestIndependentSystem, 0,
+        ac::SystemAccess().Write<TestWorldComponentB>());
+
+    for (int frame = 1; frame <= 10; ++frame) {
+        world.RunUpdateSystems();
+        ACASSERT(world.GetResourse<TestWorldResource>().data == frame * 100,
+                 "TestWorldSystemScheduler failed: reader did not run after writer");
+    }
+    float sumB = 0;
+    world.View<TestWorldComponentB>().ForEach([&](TestWorldComponentB& b) {
+        sumB += b.value;
+    });
+    ACASSERT(sumB == 1000.0f, "TestWorldSystemScheduler failed: independent system did not run every frame");
+
+    ACMSG("TestWorldSystemScheduler passed");
+}
+
+// Records what the systems of the scheduler tests saw
+struct SchedulerProbe {
+    std::mutex mutex;
+    std::vector<int> order;
+    std::vector<std::thread::id> threads;
+    std::atomic<int> arrived{ 0 };
+    std::atomic<int> met{ 0 };
+    std::atomic<int> running{ 0 };
+    std::atomic<bool> exclusiveRunning{ false };
+    std::atomic<bool> overlapped{ false };
+
+    void Reset() {
+        order.clear();
+        threads.clear();
+        arrived = 0;
+        met = 0;
+        running = 0;
+        exclusiveRunning = false;
+        overlapped = false;
+    }
+
+    void Record(int id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(id);
+        threads.push_back(std::this_thread::get_id());
+    }
+
+    // Waits until two systems are inside at once; only possible if they run concurrently
+    void Rendezvous() {
+        ++arrived;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (arrived < 2) {
+            if (std::chrono::steady_clock::now() > deadline)
+                return;
+            std::this_thread::yield();
+        }
+        ++met;
+    }
+
+    // Runs for a while, noting any other system running next to an exclusive one
+    void Occupy(int id, bool exclusive) {
+        if (exclusive)
+            exclusiveRunning = true;
+        if (++running != 1 && exclusive)
+            overlapped = true;
+        if (!exclusive && exclusiveRunning)
+            overlapped = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        if (exclusive && running != 1)
+            overlapped = true;
+        Record(id);
+        --running;
+        if (exclusive)
+            exclusiveRunning = false;
+    }
+};
+SchedulerProbe schedulerProbe;
+
+void TestSchedulerRendezvousSystem(ac::World& world) { schedulerProbe.Rendezvous(); }
+void TestSchedulerOrderSystemA(ac::World& world) { schedulerProbe.Record(1); }
+void TestSchedulerOrderSystemB(ac::World& world) { schedulerProbe.Record(2); }
+void TestSchedulerOrderSystemC(ac::World& world) { schedulerProbe.Record(3); }
+void TestSchedulerOccupySystemA(ac::World& world) { schedulerProbe.Occupy(11, false); }
+void TestSchedulerOccupySystemB(ac::World& world) { schedulerProbe.Occupy(12, false); }
+void TestSchedulerOccupyExclusiveSystem(ac::World& world) { schedulerProbe.Occupy(13, true); }
+void TestSchedulerOccupySystemC(ac::World& world) { schedulerProbe.Occupy(14, false); }
+
+void TestSystemAccessConflicts() {
+    using ac::SystemAccess;
+
+    // Readers share, a writer conflicts with readers and writers of the same data
+    ACASSERT(!SystemAccess().Read<TestWorldComponent>().ConflictsWith(SystemAccess().Read<TestWorldComponent>()),
+             "TestSystemAccessConflicts failed: two readers conflict");
+    ACASSERT(SystemAccess().Write<TestWorldComponent>().ConflictsWith(SystemAccess().Read<TestWorldComponent>()),
+             "TestSystemAccessConflicts failed: writer does not conflict with a reader");
+    ACASSERT(SystemAccess().Read<TestWorldComponent>().ConflictsWith(SystemAccess().Write<TestWorldComponent>()),
+             "TestSystemAccessConflicts failed: reader does not conflict with a writer");
+    ACASSERT(SystemAccess().Write<TestWorldComponent>().ConflictsWith(SystemAccess().Write<TestWorldComponentB, TestWorldComponent>()),
+             "TestSystemAccessConflicts failed: two writers of one component do not conflict");
+    ACASSERT(!SystemAccess().Write<TestWorldComponent>().ConflictsWith(SystemAccess().Write<TestWorldComponentB>().Read<TestWorldFlag>()),
+             "TestSystemAccessConflicts failed: disjoint components conflict");
+
+    // Resources are tracked apart from components
+    ACASSERT(SystemAccess().WriteResource<TestWorldResource>().ConflictsWith(SystemAccess().ReadResource<TestWorldResource>()),
+             "TestSystemAccessConflicts failed: resource writer does not conflict with a reader");
+    ACASSERT(!SystemAccess().ReadResource<TestWorldResource>().ConflictsWith(SystemAccess().ReadResource<TestWorldResource>()),
+             "TestSystemAccessConflicts failed: two resource readers conflict");
+    ACASSERT(!SystemAccess().WriteResource<TestWorldResource>().ConflictsWith(SystemAccess().Write<TestWorldComponent>()),
+             "TestSystemAccessConflicts failed: a resource conflicts with a component");
+
+    // Without a declaration a system is exclusive and stays on the main thread
+    ACASSERT(SystemAccess().IsExclusive() && SystemAccess().IsMainThread(),
+             "TestSystemAccessConflicts failed: undeclared access is not exclusive");
+    ACASSERT(SystemAccess().ConflictsWith(SystemAccess().Read<TestWorldFlag>()) && SystemAccess().Read<TestWorldFlag>().ConflictsWith(SystemAccess()),
+             "TestSystemAccessConflicts failed: exclusive access does not conflict with everything");
+    ACASSERT(SystemAccess().MainThread().IsExclusive(),
+             "TestSystemAccessConflicts failed: MainThread alone declared access");
+    ACASSERT(!SystemAccess().Read<TestWorldFlag>().IsMainThread() && SystemAccess().Read<TestWorldFlag>().MainThread().IsMainThread(),
+             "TestSystemAccessConflicts failed: MainThread not recorded");
+
+    ACMSG("TestSystemAccessConflicts passed");
+}
+
+void TestWorldSystemConcurrency() {
+    ac::World world;
+
+    // Each system waits for the other one, which only succeeds if they run at the same time
+    world.AddUpdateSystem(TestSchedulerRendezvousSystem, 0, ac::SystemAccess().Write<TestWorldComponent>());
+    world.AddUpdateSystem(TestSchedulerRendezvousSystem, 0, ac::SystemAccess().Write<TestWorldComponentB>());
+
+    for (int frame = 0; frame < 5; ++frame) {
+        schedulerProbe.Reset();
+        world.RunUpdateSystems();
+        ACASSERT(schedulerProbe.met == 2, "TestWorldSystemConcurrency failed: systems with disjoint access did not run concurrently");
+    }
+
+    ACMSG("TestWorldSystemConcurrency passed");
+}
+
+void TestWorldSystemAccessPriority() {
+    ac::World world;
+
+    // All three write the same component, so they run one after another in priority order
+    world.AddUpdateSystem(TestSchedulerOrderSystemC, 9, ac::SystemAccess().Write<TestWorldComponent>());
+    world.AddUpdateSystem(TestSchedulerOrderSystemA, 0, ac::SystemAccess().Write<TestWorldComponent>());
+    world.AddUpdateSystem(TestSchedulerOrderSystemB, 5, ac::SystemAccess().Read<TestWorldComponent>());
+
+    for (int frame = 0; frame < 20; ++frame) {
+        schedulerProbe.Reset();
+        world.RunUpdateSystems();
+        ACASSERT(schedulerProbe.order == std::vector<int>({ 1, 2, 3 }), "TestWorldSystemAccessPriority failed: conflicting systems ran out of priority order");
+    }
+
+    ACMSG("TestWorldSystemAccessPriority passed");
+}
+
+// Thread the system recorded as id ran on
+std::thread::id SchedulerThreadOf(int id) {
+    auto it = std::find(schedulerProbe.order.begin(), schedulerProbe.order.end(), id);
+    return it == schedulerProbe.order.end() ? std::thread::id() : schedulerProbe.threads[it - schedulerProbe.order.begin()];
+}
+
+void TestWorldSystemMainThread() {
+    ac::World world;
+    std::thread::id mainThread = std::this_thread::get_id();
+
+    // A pinned and an undeclared system next to worker systems that keep the pool busy
+    world.AddUpdateSystem(TestSchedulerOccupySystemA, 0, ac::SystemAccess().Write<TestWorldComponent>());
+    world.AddUpdateSystem(TestSchedulerOccupySystemB, 0, ac::SystemAccess().Write<TestWorldComponentB>());
+    world.AddUpdateSystem(TestSchedulerOrderSystemA, 0, ac::SystemAccess().Read<TestWorldFlag>().MainThread());
+    world.AddPostUpdateSystem(TestSchedulerOrderSystemB, 0);
+
+    for (int frame = 0; frame < 20; ++frame) {
+        schedulerProbe.Reset();
+        world.Update();
+        ACASSERT(schedulerProbe.order.size() == 4, "TestWorldSystemMainThread failed: not every system ran");
+        ACASSERT(SchedulerThreadOf(1) == mainThread, "TestWorldSystemMainThread failed: MainThread system left the main thread");
+        ACASSERT(SchedulerThreadOf(2) == mainThread, "TestWorldSystemMainThread failed: undeclared system left the main thread");
+    }
+
+    ACMSG("TestWorldSystemMainThread passed");
+}
+
+void TestWorldSystemExclusiveFallback() {
+    ac::World world;
+    std::thread::id mainThread = std::this_thread::get_id();
+
+    // The undeclared system waits for both earlier systems and holds back the later one
+    world.AddUpdateSystem(TestSchedulerOccupySystemA, 0, ac::SystemAccess().Write<TestWorldComponent>());
+    world.AddUpdateSystem(TestSchedulerOccupySystemB, 0, ac::SystemAccess().Write<TestWorldComponentB>());
+    world.AddUpdateSystem(TestSchedulerOccupyExclusiveSystem, 5);
+    world.AddUpdateSystem(TestSchedulerOccupySystemC, 9, ac::SystemAccess().Read<TestWorldFlag>());
+
+    for (int frame = 0; frame < 20; ++frame) {
+        schedulerProbe.Reset();
+        world.RunUpdateSystems();
+        ACASSERT(!schedulerProbe.overlapped, "TestWorldSystemExclusiveFallback failed: a system ran next to an undeclared one");
+        ACASSERT(schedulerProbe.order.size() == 4 && schedulerProbe.order[2] == 13 && schedulerProbe.order[3] == 14,
+                 "TestWorldSystemExclusiveFallback failed: undeclared system did not run between the others");
+        ACASSERT(SchedulerThreadOf(13) == mainThread, "TestWorldSystemExclusiveFallback failed: undeclared system left the main thread");
+    }
+
+    ACMSG("TestWorldSystemExclusiveFallback passed");
+}
+
+// Ticks seen by the chunks of a ParallelFor inside a system
+struct JobTickProbe {
+    uint32_t systemTick = 0;
+    std::vector<uint32_t> chunkTicks;
+    std::vector<std::thread::id> chunkThreads;
+};
+JobTickProbe jobTickProbe;
+
+void TestJobTickSystem(ac::World& world) {
+    jobTickProbe.systemTick = world.GetChangeTick();
+    world.GetJobSystem().ParallelFor(jobTickProbe.chunkTicks.size(), 1, [&world](size_t begin, size_t end) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        for (size_t i = begin; i < end; ++i) {
+            jobTickProbe.chunkTicks[i] = world.GetChangeTick();
+            jobTickProbe.chunkThreads[i] = std::this_thread::get_id();
+        }
+    });
+}
+
+void TestWorldChangeTickInJobs() {
+    ac::World world;
+    world.AddUpdateSystem(TestJobTickSystem, 0, ac::SystemAccess().Write<TestWorldComponent>());
+    jobTickProbe.chunkTicks.assign(64, 0);
+    jobTickProbe.chunkThreads.assign(64, std::thread::id());
+
+    // Chunks run on workers get the system's tick, like the thread running the system
+    world.RunUpdateSystems();
+    std::set<std::thread::id> threads(jobTickProbe.chunkThreads.begin(), jobTickProbe.chunkThreads.end());
+    for (size_t i = 0; i < jobTickProbe.chunkTicks.size(); ++i)
+        ACASSERT(jobTickProbe.chunkTicks[i] == jobTickProbe.systemTick, "TestWorldChangeTickInJobs failed: chunk " << i
+                 << " stamped tick " << jobTickProbe.chunkTicks[i] << " instead of the system's " << jobTickProbe.systemTick);
+    if (threads.size() < 2)
+        ACWARN("TestWorldChangeTickInJobs: every chunk ran on one thread, the worker path was not exercised");
+
+    // Outside systems the jobs stamp the world tick again
+    std::atomic<uint32_t> outside{ 0 };
+    world.GetJobSystem().Submit([&world, &outside]() { outside = world.GetChangeTick(); });
+    while (outside.load() == 0)
+        world.GetJobSystem().TryRunOne();
+    ACASSERT(outside.load() != jobTickProbe.systemTick, "TestWorldChangeTickInJobs failed: a job outside systems kept the system's tick");
+
+    ACMSG("TestWorldChangeTickInJobs passed");
+}
+
 void TestWorldSystemInvalidPriority() {
     ac::World world;
     systemTracker.Reset();
@@ -604,18 +1707,40 @@ void RunAllWorldTests() {
     TestWorldAddComponent();
     TestWorldDeleteComponent();
     TestWorldDeleteEntity();
+    TestWorldStaleEntityHandle();
     TestWorldHasMethods();
     TestWorldResourceSystem();
     TestWorldSimpleView();
+    TestWorldViewIteration();
+    TestWorldViewFilters();
+    TestWorldQuery();
+    TestWorldParallelForEach();
+    TestWorldCommandBuffer();
+    TestWorldBatchOperations();
+    TestWorldChangeDetection();
+    TestWorldArchetypeStorage();
+    TestWorldSoAStorage();
+    TestSparseSetPaging();
+    TestWorldTypeID();
     TestWorldReset();
     TestWorldGetEntityCount();
     TestWorldGetPoolCount();
     TestWorldOnAddedEvent();
     TestWorldOnDeletedEvent();
+    TestWorldHierarchy();
+    TestWorldTransformPropagation();
 
     TestWorldAddSystems();
     TestWorldExecuteSystems();
+    TestWorldFixedUpdatePhase();
     TestWorldSystemPriority();
+    TestWorldSystemScheduler();
+    TestSystemAccessConflicts();
+    TestWorldSystemConcurrency();
+    TestWorldSystemAccessPriority();
+    TestWorldSystemMainThread();
+    TestWorldSystemExclusiveFallback();
+    TestWorldChangeTickInJobs();
     //TestWorldSystemInvalidPriority();
     
     ACMSG("=== All World class tests completed ===");
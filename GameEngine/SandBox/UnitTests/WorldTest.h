@@ -7,18 +7,40 @@ void TestWorldRegisterType();
 void TestWorldAddComponent();
 void TestWorldDeleteComponent();
 void TestWorldDeleteEntity();
+void TestWorldStaleEntityHandle();
 void TestWorldHasMethods();
 void TestWorldResourceSystem();
 void TestWorldSimpleView();
+void TestWorldViewIteration();
+void TestWorldViewFilters();
+void TestWorldQuery();
+void TestWorldParallelForEach();
+void TestWorldCommandBuffer();
+void TestWorldBatchOperations();
+void TestWorldChangeDetection();
+void TestWorldArchetypeStorage();
+void TestWorldSoAStorage();
+void TestSparseSetPaging();
+void TestWorldTypeID();
 void TestWorldReset();
 void TestWorldGetEntityCount();
 void TestWorldGetPoolCount();
 void TestWorldOnAddedEvent();
 void TestWorldOnDeletedEvent();
+void TestWorldHierarchy();
+void TestWorldTransformPropagation();
 
 void TestWorldAddSystems();
 void TestWorldExecuteSystems();
+void TestWorldFixedUpdatePhase();
 void TestWorldSystemPriority();
+void TestWorldSystemScheduler();
+void TestSystemAccessConflicts();
+void TestWorldSystemConcurrency();
+void TestWorldSystemAccessPriority();
+void TestWorldSystemMainThread();
+void TestWorldSystemExclusiveFallback();
+void TestWorldChangeTickInJobs();
 void TestWorldSystemInvalidPriority();
 
 // Main test runner function